@@ -0,0 +1,305 @@
+/*
+ * WCN_SIMD benchmark harness: timer, sample statistics, a minimal JSON
+ * writer, cache sizes and test data shared by the benchmark programs in
+ * this directory. Header-only.
+ */
+
+#ifndef WCN_BENCH_HARNESS_H
+#define WCN_BENCH_HARNESS_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <WCN_SIMD.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+static inline double bench_now_ns(void) {
+  static LARGE_INTEGER freq;
+  LARGE_INTEGER counter;
+  if (freq.QuadPart == 0)
+    QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart * 1e9 / (double)freq.QuadPart;
+}
+#else
+#include <time.h>
+static inline double bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+#endif
+
+/* ========== Statistics ========== */
+
+typedef struct {
+  double min, p10, median, p90, max, mean, stddev;
+} bench_stats;
+
+static inline int bench_cmp_double(const void *a, const void *b) {
+  const double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* Linear interpolation between closest ranks; v must be sorted */
+static inline double bench_percentile(const double *v, size_t n,
+                                      double p) {
+  const double rank = p * (double)(n - 1);
+  const size_t lo = (size_t)rank;
+  if (lo + 1 >= n)
+    return v[n - 1];
+  return v[lo] + (rank - (double)lo) * (v[lo + 1] - v[lo]);
+}
+
+/* Sorts v in place */
+static inline bench_stats bench_compute_stats(double *v, size_t n) {
+  bench_stats s;
+  memset(&s, 0, sizeof(s));
+  if (n == 0)
+    return s;
+  qsort(v, n, sizeof(double), bench_cmp_double);
+  double sum = 0.0, sq = 0.0;
+  for (size_t i = 0; i < n; i++)
+    sum += v[i];
+  s.mean = sum / (double)n;
+  for (size_t i = 0; i < n; i++)
+    sq += (v[i] - s.mean) * (v[i] - s.mean);
+  s.stddev = n > 1 ? sqrt(sq / (double)(n - 1)) : 0.0;
+  s.min = v[0];
+  s.max = v[n - 1];
+  s.p10 = bench_percentile(v, n, 0.10);
+  s.median = bench_percentile(v, n, 0.50);
+  s.p90 = bench_percentile(v, n, 0.90);
+  return s;
+}
+
+/* ========== JSON Writer ========== */
+
+/* Tracks whether a separator is needed at each nesting level */
+typedef struct {
+  FILE *out;
+  int depth;
+  int need_comma[16];
+} bench_json;
+
+static inline void bench_json_init(bench_json *j, FILE *out) {
+  memset(j, 0, sizeof(*j));
+  j->out = out;
+}
+
+static inline void bench_json_indent(bench_json *j) {
+  fputc('\n', j->out);
+  for (int i = 0; i < j->depth; i++)
+    fputs("  ", j->out);
+}
+
+static inline void bench_json_sep(bench_json *j) {
+  if (j->need_comma[j->depth])
+    fputc(',', j->out);
+  j->need_comma[j->depth] = 1;
+  if (j->depth > 0)
+    bench_json_indent(j);
+}
+
+static inline void bench_json_string(FILE *out, const char *s) {
+  fputc('"', out);
+  for (; *s; s++) {
+    const unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\')
+      fprintf(out, "\\%c", c);
+    else if (c < 0x20)
+      fprintf(out, "\\u%04x", c);
+    else
+      fputc(c, out);
+  }
+  fputc('"', out);
+}
+
+static inline void bench_json_key(bench_json *j, const char *key) {
+  bench_json_sep(j);
+  if (key != NULL) {
+    bench_json_string(j->out, key);
+    fputs(": ", j->out);
+  }
+}
+
+/* key is NULL inside arrays */
+static inline void bench_json_open(bench_json *j, const char *key,
+                                   char bracket) {
+  bench_json_key(j, key);
+  fputc(bracket, j->out);
+  j->need_comma[++j->depth] = 0;
+}
+
+static inline void bench_json_close(bench_json *j, char bracket) {
+  const int had_items = j->need_comma[j->depth];
+  j->depth--;
+  if (had_items)
+    bench_json_indent(j);
+  fputc(bracket, j->out);
+  if (j->depth == 0)
+    fputc('\n', j->out);
+}
+
+static inline void bench_json_str(bench_json *j, const char *key,
+                                  const char *value) {
+  bench_json_key(j, key);
+  if (value != NULL)
+    bench_json_string(j->out, value);
+  else
+    fputs("null", j->out);
+}
+
+static inline void bench_json_u64(bench_json *j, const char *key,
+                                  uint64_t value) {
+  bench_json_key(j, key);
+  fprintf(j->out, "%llu", (unsigned long long)value);
+}
+
+static inline void bench_json_bool(bench_json *j, const char *key,
+                                   int value) {
+  bench_json_key(j, key);
+  fputs(value ? "true" : "false", j->out);
+}
+
+/* Non-finite values have no JSON spelling and become null */
+static inline void bench_json_num(bench_json *j, const char *key,
+                                  double value) {
+  bench_json_key(j, key);
+  if (value != value || value > 1e308 || value < -1e308)
+    fputs("null", j->out);
+  else
+    fprintf(j->out, "%.6g", value);
+}
+
+static inline void bench_json_stats(bench_json *j, const char *key,
+                                    const bench_stats *s) {
+  bench_json_open(j, key, '{');
+  bench_json_num(j, "min", s->min);
+  bench_json_num(j, "p10", s->p10);
+  bench_json_num(j, "median", s->median);
+  bench_json_num(j, "p90", s->p90);
+  bench_json_num(j, "max", s->max);
+  bench_json_num(j, "mean", s->mean);
+  bench_json_num(j, "stddev", s->stddev);
+  bench_json_close(j, '}');
+}
+
+/* ========== Misc ========== */
+
+/* Parse a size with an optional K/M/G (binary) suffix; 0 on error */
+static inline size_t bench_parse_size(const char *s) {
+  char *end;
+  unsigned long long v = strtoull(s, &end, 10);
+  switch (*end) {
+  case 'k':
+  case 'K':
+    v <<= 10;
+    end++;
+    break;
+  case 'm':
+  case 'M':
+    v <<= 20;
+    end++;
+    break;
+  case 'g':
+  case 'G':
+    v <<= 30;
+    end++;
+    break;
+  default:
+    break;
+  }
+  return *end == '\0' ? (size_t)v : 0;
+}
+
+/* "4K", "16M", ... for sizes that are a multiple of the unit */
+static inline const char *bench_format_size(size_t bytes, char *buf,
+                                            size_t len) {
+  if (bytes >= ((size_t)1 << 30) && bytes % ((size_t)1 << 30) == 0)
+    snprintf(buf, len, "%zuG", bytes >> 30);
+  else if (bytes >= ((size_t)1 << 20) && bytes % ((size_t)1 << 20) == 0)
+    snprintf(buf, len, "%zuM", bytes >> 20);
+  else if (bytes >= 1024 && bytes % 1024 == 0)
+    snprintf(buf, len, "%zuK", bytes >> 10);
+  else
+    snprintf(buf, len, "%zu", bytes);
+  return buf;
+}
+
+/* ========== Caches and Test Data ========== */
+
+/* Data/unified cache sizes by level (index 1..3) as the library detected
+ * them; 0 when unknown */
+static inline void bench_detect_caches(size_t size[4]) {
+  const wcn_simd_features_t *f = wcn_simd_get_features();
+  size[0] = 0;
+  size[1] = f->l1d_cache_size;
+  size[2] = f->l2_cache_size;
+  size[3] = f->l3_cache_size;
+}
+
+/* Smallest cache level that holds the working set */
+static inline const char *bench_resident_level(const size_t cache[4],
+                                               size_t bytes) {
+  static const char *const names[] = {NULL, "L1", "L2", "L3"};
+  if (cache[1] == 0)
+    return NULL;
+  for (int level = 1; level <= 3; level++)
+    if (cache[level] != 0 && bytes <= cache[level])
+      return names[level];
+  return "DRAM";
+}
+
+/* Largest working set of a default sweep: far enough past the last-level
+ * cache to measure DRAM, at most 1 GiB */
+static inline size_t bench_dram_bytes(const size_t cache[4]) {
+  const size_t llc = cache[3] ? cache[3] : cache[2];
+  size_t bytes = (size_t)64 << 20;
+  while (bytes < 2 * llc && bytes < ((size_t)1 << 30))
+    bytes *= 4;
+  return bytes;
+}
+
+/* Fill one array of element type "f32", "f64", "f16", "bf16" or an integer
+ * type: a ramp for the first operand, small values for the second and ones
+ * for the output, so that repeated calls never reach inf/NaN or denormals;
+ * integer kernels take any bit pattern. The 16-bit float kernels read
+ * 16-bit inputs and write float, so their output gets float ones. */
+static inline void bench_fill_array(const char *type, unsigned char *p,
+                                    size_t bytes, int which) {
+  const int f16 = strcmp(type, "f16") == 0;
+  if ((f16 || strcmp(type, "bf16") == 0) && which < 2) {
+    uint16_t *h = (uint16_t *)p;
+    for (size_t i = 0; i < bytes / sizeof(uint16_t); i++) {
+      const float f = which == 0 ? 0.5f + (float)(i % 1024) / 1024.0f
+                                 : 1e-3f * (float)(1 + (i * 7) % 13);
+      h[i] = f16 ? wcn_float_to_f16(f) : wcn_float_to_bf16(f);
+    }
+  } else if (strcmp(type, "f64") == 0) {
+    double *d = (double *)p;
+    for (size_t i = 0; i < bytes / sizeof(double); i++)
+      d[i] = which == 0   ? 0.5 + (double)(i % 1024) / 1024.0
+             : which == 1 ? 1e-3 * (double)(1 + (i * 7) % 13)
+                          : 1.0;
+  } else if (strcmp(type, "f32") == 0 || f16 || strcmp(type, "bf16") == 0) {
+    float *f = (float *)p;
+    for (size_t i = 0; i < bytes / sizeof(float); i++)
+      f[i] = which == 0   ? 0.5f + (float)(i % 1024) / 1024.0f
+             : which == 1 ? 1e-3f * (float)(1 + (i * 7) % 13)
+                          : 1.0f;
+  } else {
+    for (size_t i = 0; i < bytes; i++)
+      p[i] = (unsigned char)(i * (31 + 2 * which) % 97);
+  }
+}
+
+#endif /* WCN_BENCH_HARNESS_H */
@@ -0,0 +1,195 @@
+/*
+ * WCN_SIMD benchmark harness: hardware performance counters through Linux
+ * perf_event_open(2). Header-only, like bench_harness.h.
+ *
+ * Counters cover user space of the calling thread and of the threads it
+ * creates afterwards (inherit), so open them before the library starts
+ * its workers. Each counter is opened on its own instead of as one group
+ * so that the kernel can multiplex more events than the PMU has counters;
+ * readings are scaled by enabled/running time. Counters the kernel or PMU
+ * refuses -- no PMU in a VM or container, perf_event_paranoid, an event
+ * this CPU lacks -- stay closed and read as NAN. On other systems nothing
+ * opens.
+ *
+ * The 256/512-bit FP counters are Intel's FP_ARITH_INST_RETIRED packed
+ * single+double umasks: retired vector FP arithmetic instructions, with
+ * FMA counted twice. Other vendors encode these events differently, so
+ * they are only opened on Intel.
+ */
+
+#ifndef WCN_BENCH_PERF_H
+#define WCN_BENCH_PERF_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef enum {
+  BENCH_PERF_CYCLES,
+  BENCH_PERF_INSTRUCTIONS,
+  BENCH_PERF_L1D_MISSES,
+  BENCH_PERF_LLC_MISSES,
+  BENCH_PERF_BRANCH_MISSES,
+  BENCH_PERF_FP_256,
+  BENCH_PERF_FP_512,
+  BENCH_PERF_COUNT
+} bench_perf_event;
+
+static const char *const bench_perf_names[BENCH_PERF_COUNT] = {
+    "cycles",        "instructions", "l1d_misses", "llc_misses",
+    "branch_misses", "fp_256b_ops",  "fp_512b_ops"};
+
+typedef struct {
+  int fd[BENCH_PERF_COUNT];
+  int opened;      /* number of counters open */
+  int first_errno; /* why the first counter failed, 0 if none did */
+} bench_perf;
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static inline int bench_perf_is_intel(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  char line[256];
+  int intel = 0;
+  FILE *f = fopen("/proc/cpuinfo", "r");
+  if (f == NULL)
+    return 0;
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (strncmp(line, "vendor_id", 9) == 0) {
+      intel = strstr(line, "GenuineIntel") != NULL;
+      break;
+    }
+  }
+  fclose(f);
+  return intel;
+#else
+  return 0;
+#endif
+}
+
+static inline int bench_perf_open_one(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.inherit = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#define BENCH_PERF_CACHE(cache)                                                \
+  ((uint64_t)(cache) | ((uint64_t)PERF_COUNT_HW_CACHE_OP_READ << 8) |          \
+   ((uint64_t)PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+/* Returns the number of counters opened */
+static inline int bench_perf_open(bench_perf *p) {
+  const struct {
+    uint32_t type;
+    uint64_t config;
+  } ev[BENCH_PERF_COUNT] = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HW_CACHE, BENCH_PERF_CACHE(PERF_COUNT_HW_CACHE_L1D)},
+      {PERF_TYPE_HW_CACHE, BENCH_PERF_CACHE(PERF_COUNT_HW_CACHE_LL)},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      /* FP_ARITH_INST_RETIRED: event 0xC7, umask 256B_PACKED_{D,S} */
+      {PERF_TYPE_RAW, 0xC7 | (0x30 << 8)},
+      /* umask 512B_PACKED_{D,S} */
+      {PERF_TYPE_RAW, 0xC7 | (0xC0 << 8)},
+  };
+  const int intel = bench_perf_is_intel();
+  p->opened = 0;
+  p->first_errno = 0;
+  for (int i = 0; i < BENCH_PERF_COUNT; i++) {
+    p->fd[i] = -1;
+    if (ev[i].type == PERF_TYPE_RAW && !intel)
+      continue;
+    p->fd[i] = bench_perf_open_one(ev[i].type, ev[i].config);
+    if (p->fd[i] >= 0)
+      p->opened++;
+    else if (p->first_errno == 0)
+      p->first_errno = errno;
+  }
+  return p->opened;
+}
+
+static inline void bench_perf_close(bench_perf *p) {
+  for (int i = 0; i < BENCH_PERF_COUNT; i++) {
+    if (p->fd[i] >= 0)
+      close(p->fd[i]);
+    p->fd[i] = -1;
+  }
+  p->opened = 0;
+}
+
+static inline void bench_perf_start(bench_perf *p) {
+  for (int i = 0; i < BENCH_PERF_COUNT; i++) {
+    if (p->fd[i] >= 0) {
+      ioctl(p->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(p->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+/* Counts since bench_perf_start(), scaled for multiplexing; NAN for
+ * counters that are not open or never got scheduled */
+static inline void bench_perf_stop(bench_perf *p,
+                                   double value[BENCH_PERF_COUNT]) {
+  for (int i = 0; i < BENCH_PERF_COUNT; i++)
+    if (p->fd[i] >= 0)
+      ioctl(p->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+  for (int i = 0; i < BENCH_PERF_COUNT; i++) {
+    uint64_t r[3]; /* value, time enabled, time running */
+    value[i] = NAN;
+    if (p->fd[i] < 0 || read(p->fd[i], r, sizeof(r)) != sizeof(r))
+      continue;
+    if (r[2] != 0)
+      value[i] = (double)r[0] * ((double)r[1] / (double)r[2]);
+  }
+}
+
+static inline const char *bench_perf_error(const bench_perf *p) {
+  return p->first_errno != 0 ? strerror(p->first_errno) : NULL;
+}
+
+#else /* !__linux__ */
+
+static inline int bench_perf_open(bench_perf *p) {
+  for (int i = 0; i < BENCH_PERF_COUNT; i++)
+    p->fd[i] = -1;
+  p->opened = 0;
+  p->first_errno = 0;
+  return 0;
+}
+
+static inline void bench_perf_close(bench_perf *p) { (void)p; }
+
+static inline void bench_perf_start(bench_perf *p) { (void)p; }
+
+static inline void bench_perf_stop(bench_perf *p,
+                                   double value[BENCH_PERF_COUNT]) {
+  (void)p;
+  for (int i = 0; i < BENCH_PERF_COUNT; i++)
+    value[i] = NAN;
+}
+
+static inline const char *bench_perf_error(const bench_perf *p) {
+  (void)p;
+  return "perf_event_open is Linux-only";
+}
+
+#endif /* __linux__ */
+
+#endif /* WCN_BENCH_PERF_H */
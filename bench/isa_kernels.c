@@ -0,0 +1,16 @@
+/*
+ * wcn_isa_bench kernels: the library's complete kernel set
+ * (wcn_kernels_impl.h), compiled by the build once per x86 ISA level with
+ * that level's flags. WCN_ISA_TABLE names the resulting table, e.g.
+ * wcn_isa_kernels_avx2.
+ */
+
+#if !defined(WCN_ISA_TABLE)
+#error "WCN_ISA_TABLE must be defined"
+#endif
+
+/* The bench tables run outside the library's statistics */
+#undef WCN_SIMD_STATS
+
+#define WCN_KERNEL_TABLE WCN_ISA_TABLE
+#include "wcn_kernels_impl.h"
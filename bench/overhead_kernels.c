@@ -0,0 +1,159 @@
+/*
+ * wcn_overhead_bench kernels (see overhead_kernels.h). The raw and wcn_
+ * versions of each kernel have the same structure statement for statement,
+ * so any difference in time or generated code comes from the wrapper
+ * types. OVH_INDEX and OVH_NAME are set by the build for every copy.
+ */
+
+#include "overhead_kernels.h"
+#include <WCN_SIMD.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if !defined(OVH_INDEX) || !defined(OVH_NAME)
+#error "OVH_INDEX and OVH_NAME must be defined"
+#endif
+
+#define OVH_CAT2(a, b) a##b
+#define OVH_CAT(a, b) OVH_CAT2(a, b)
+#define OVH_FN(name) OVH_CAT(name##_, OVH_INDEX)
+
+/* Histogram counters are 8 bits wide; flush them before they wrap */
+#define HIST_BLOCK (255 * 16)
+
+static unsigned ctz32(unsigned x) {
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanForward(&i, x);
+  return (unsigned)i;
+#else
+  return (unsigned)__builtin_ctz(x);
+#endif
+}
+
+/* ========== SAXPY ========== */
+
+static void OVH_FN(saxpy_raw)(float a, const float *x, float *y, size_t n) {
+  const __m128 va = _mm_set1_ps(a);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+#if defined(WCN_X86_FMA)
+    const __m128 r = _mm_fmadd_ps(va, _mm_loadu_ps(x + i), _mm_loadu_ps(y + i));
+#else
+    const __m128 r =
+        _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(x + i)), _mm_loadu_ps(y + i));
+#endif
+    _mm_storeu_ps(y + i, r);
+  }
+  for (; i < n; i++)
+    y[i] = a * x[i] + y[i];
+}
+
+static void OVH_FN(saxpy_wcn)(float a, const float *x, float *y, size_t n) {
+  const wcn_v128f_t va = wcn_simd_set1_f32(a);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const wcn_v128f_t r = wcn_simd_fmadd_f32(va, wcn_simd_load_f32(x + i),
+                                             wcn_simd_load_f32(y + i));
+    wcn_simd_store_f32(y + i, r);
+  }
+  for (; i < n; i++)
+    y[i] = a * x[i] + y[i];
+}
+
+/* ========== Nibble Histogram ========== */
+
+/* Sixteen 8-bit counter vectors plus sixteen bin constants: more live
+ * vectors than SSE2 has registers, which is where spills show up */
+static void OVH_FN(hist_raw)(const uint8_t *p, size_t n, uint32_t bins[16]) {
+  const __m128i low = _mm_set1_epi8(0x0F);
+  uint8_t lanes[16];
+  size_t i = 0;
+  memset(bins, 0, 16 * sizeof(bins[0]));
+  while (i + 16 <= n) {
+    const size_t end = n - i > HIST_BLOCK ? i + HIST_BLOCK : n;
+    __m128i cnt[16];
+    for (int b = 0; b < 16; b++)
+      cnt[b] = _mm_setzero_si128();
+    for (; i + 16 <= end; i += 16) {
+      const __m128i v =
+          _mm_and_si128(_mm_loadu_si128((const __m128i *)(p + i)), low);
+      for (int b = 0; b < 16; b++)
+        cnt[b] = _mm_sub_epi8(cnt[b], _mm_cmpeq_epi8(v, _mm_set1_epi8(b)));
+    }
+    for (int b = 0; b < 16; b++) {
+      _mm_storeu_si128((__m128i *)lanes, cnt[b]);
+      for (int l = 0; l < 16; l++)
+        bins[b] += lanes[l];
+    }
+  }
+  for (; i < n; i++)
+    bins[p[i] & 0x0F]++;
+}
+
+static void OVH_FN(hist_wcn)(const uint8_t *p, size_t n, uint32_t bins[16]) {
+  const wcn_v128i_t low = wcn_simd_set1_i8(0x0F);
+  uint8_t lanes[16];
+  size_t i = 0;
+  memset(bins, 0, 16 * sizeof(bins[0]));
+  while (i + 16 <= n) {
+    const size_t end = n - i > HIST_BLOCK ? i + HIST_BLOCK : n;
+    wcn_v128i_t cnt[16];
+    for (int b = 0; b < 16; b++)
+      cnt[b] = wcn_simd_setzero_i128();
+    for (; i + 16 <= end; i += 16) {
+      const wcn_v128i_t v = wcn_simd_and_i128(wcn_simd_load_i128(p + i), low);
+      for (int b = 0; b < 16; b++)
+        cnt[b] = wcn_simd_sub_i8(
+            cnt[b], wcn_simd_cmpeq_i8(v, wcn_simd_set1_i8((int8_t)b)));
+    }
+    for (int b = 0; b < 16; b++) {
+      wcn_simd_store_i128(lanes, cnt[b]);
+      for (int l = 0; l < 16; l++)
+        bins[b] += lanes[l];
+    }
+  }
+  for (; i < n; i++)
+    bins[p[i] & 0x0F]++;
+}
+
+/* ========== Byte Scan ========== */
+
+static size_t OVH_FN(scan_raw)(const uint8_t *p, size_t n, uint8_t c) {
+  const __m128i needle = _mm_set1_epi8((char)c);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const int m = _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), needle));
+    if (m != 0)
+      return i + ctz32((unsigned)m);
+  }
+  for (; i < n; i++)
+    if (p[i] == c)
+      return i;
+  return n;
+}
+
+static size_t OVH_FN(scan_wcn)(const uint8_t *p, size_t n, uint8_t c) {
+  const wcn_v128i_t needle = wcn_simd_set1_i8((int8_t)c);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const int m = wcn_simd_movemask_i8(
+        wcn_simd_cmpeq_i8(wcn_simd_load_i128(p + i), needle));
+    if (m != 0)
+      return i + ctz32((unsigned)m);
+  }
+  for (; i < n; i++)
+    if (p[i] == c)
+      return i;
+  return n;
+}
+
+const ovh_level OVH_FN(ovh_level) = {
+    OVH_NAME,
+    OVH_FN(saxpy_raw), OVH_FN(saxpy_wcn), OVH_FN(hist_raw),
+    OVH_FN(hist_wcn),  OVH_FN(scan_raw),  OVH_FN(scan_wcn),
+};
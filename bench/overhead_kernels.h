@@ -0,0 +1,30 @@
+/*
+ * Kernels of wcn_overhead_bench, each written twice: with raw SSE2/FMA
+ * intrinsics and with the wcn_simd_* unified API. overhead_kernels.c is
+ * compiled once per optimization level; every copy exports one
+ * ovh_level table named ovh_level_<index>.
+ */
+
+#ifndef WCN_OVERHEAD_KERNELS_H
+#define WCN_OVERHEAD_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* y[i] = a * x[i] + y[i] */
+typedef void (*ovh_saxpy_fn)(float a, const float *x, float *y, size_t n);
+
+/* bins[v] = number of bytes whose low nibble is v */
+typedef void (*ovh_hist_fn)(const uint8_t *p, size_t n, uint32_t bins[16]);
+
+/* Index of the first byte equal to c, n if none */
+typedef size_t (*ovh_scan_fn)(const uint8_t *p, size_t n, uint8_t c);
+
+typedef struct {
+  const char *name; /* optimization flags, e.g. "-O2" */
+  ovh_saxpy_fn saxpy_raw, saxpy_wcn;
+  ovh_hist_fn hist_raw, hist_wcn;
+  ovh_scan_fn scan_raw, scan_wcn;
+} ovh_level;
+
+#endif /* WCN_OVERHEAD_KERNELS_H */
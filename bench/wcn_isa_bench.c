@@ -0,0 +1,589 @@
+/*
+ * wcn_isa_bench: what each x86 ISA level buys per kernel. The build
+ * compiles the library's kernel set (isa_kernels.c) at SSE2, SSE4.1, AVX,
+ * AVX2+FMA and AVX-512 into this one binary; the levels that the CPU and
+ * OS support according to wcn_simd_get_features() are timed on the same
+ * buffers, single-threaded.
+ *
+ * Working sets are picked per size class: half of the L1, L2 and L3 data
+ * caches, and bench_dram_bytes() (or --max-bytes) for DRAM. Each kernel
+ * prints one row per class with the baseline ns per element and the
+ * speedup of every level over the baseline (the first level the CPU runs,
+ * SSE2 on any x86-64). Levels that were not built or that the CPU lacks
+ * show "-". --output FILE also writes every timing as JSON.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#define _POSIX_C_SOURCE 200112L
+#include "bench_harness.h"
+#include "wcn_kernels.h"
+
+#if !defined(WCN_ISA_SSE2)
+#error "the SSE2 level is the baseline and must always be built"
+#endif
+
+/* wcn_simd_memcpy_aligned()'s default switch to non-temporal stores */
+#define ISA_STREAM_BYTES ((size_t)4 << 20)
+
+/* ========== ISA Levels ========== */
+
+extern const wcn_kernel_table_t wcn_isa_kernels_sse2;
+#if defined(WCN_ISA_SSE41)
+extern const wcn_kernel_table_t wcn_isa_kernels_sse41;
+#endif
+#if defined(WCN_ISA_AVX)
+extern const wcn_kernel_table_t wcn_isa_kernels_avx;
+#endif
+#if defined(WCN_ISA_AVX2)
+extern const wcn_kernel_table_t wcn_isa_kernels_avx2;
+#endif
+#if defined(WCN_ISA_AVX512)
+extern const wcn_kernel_table_t wcn_isa_kernels_avx512;
+#endif
+
+typedef int (*isa_supported_fn)(const wcn_simd_features_t *);
+
+static int has_sse2(const wcn_simd_features_t *f) { return f->has_sse2; }
+
+static int has_sse41(const wcn_simd_features_t *f) { return f->has_sse4_1; }
+
+static int has_avx(const wcn_simd_features_t *f) { return f->has_avx; }
+
+static int has_avx2_fma(const wcn_simd_features_t *f) {
+  return f->has_avx2 && f->has_fma && f->has_f16c;
+}
+
+/* The same F/BW/DQ/VL set the library's AVX-512 kernels are built for */
+static int has_avx512(const wcn_simd_features_t *f) {
+  return f->has_avx512f && f->has_avx512bw && f->has_avx512dq &&
+         f->has_avx512vl;
+}
+
+static const struct {
+  const char *name;
+  const wcn_kernel_table_t *table; /* NULL if not built */
+  isa_supported_fn supported;
+} g_isas[] = {
+    {"sse2", &wcn_isa_kernels_sse2, has_sse2},
+#if defined(WCN_ISA_SSE41)
+    {"sse4.1", &wcn_isa_kernels_sse41, has_sse41},
+#else
+    {"sse4.1", NULL, has_sse41},
+#endif
+#if defined(WCN_ISA_AVX)
+    {"avx", &wcn_isa_kernels_avx, has_avx},
+#else
+    {"avx", NULL, has_avx},
+#endif
+#if defined(WCN_ISA_AVX2)
+    {"avx2+fma", &wcn_isa_kernels_avx2, has_avx2_fma},
+#else
+    {"avx2+fma", NULL, has_avx2_fma},
+#endif
+#if defined(WCN_ISA_AVX512)
+    {"avx512", &wcn_isa_kernels_avx512, has_avx512},
+#else
+    {"avx512", NULL, has_avx512},
+#endif
+};
+
+#define ISA_COUNT (sizeof(g_isas) / sizeof(g_isas[0]))
+
+/* ========== Kernels ========== */
+
+typedef struct {
+  const wcn_kernel_table_t *t; /* level under test */
+  unsigned char *a, *b, *c;    /* inputs a, b; output (or in/out) c */
+  const wcn_expr_plan_t *plan;
+} isa_bufs;
+
+static volatile double g_sink;
+
+typedef struct {
+  const char *name;
+  const char *type;
+  size_t elem_size;
+  unsigned arrays; /* distinct arrays touched (working set) */
+  void (*run)(const isa_bufs *, size_t);
+} isa_kernel;
+
+#define ISA_BINARY(fn, T)                                                      \
+  static void run_##fn(const isa_bufs *p, size_t n) {                          \
+    p->t->fn((const T *)p->a, (const T *)p->b, (T *)p->c, n);                  \
+  }
+#define ISA_SCALE(fn, T)                                                       \
+  static void run_##fn(const isa_bufs *p, size_t n) {                          \
+    p->t->fn((const T *)p->a, (T)1.0001, (T *)p->c, n);                        \
+  }
+#define ISA_DOT(fn, T)                                                         \
+  static void run_##fn(const isa_bufs *p, size_t n) {                          \
+    g_sink += (double)p->t->fn((const T *)p->a, (const T *)p->b, n);           \
+  }
+#define ISA_REDUCE(fn, T)                                                      \
+  static void run_##fn(const isa_bufs *p, size_t n) {                          \
+    g_sink += (double)p->t->fn((const T *)p->a, n);                            \
+  }
+#define ISA_MATH(fn, mode, name)                                               \
+  static void run_##name(const isa_bufs *p, size_t n) {                        \
+    p->t->math_f32(fn, mode, (const float *)p->a, NULL, (float *)p->c, NULL,   \
+                   n);                                                         \
+  }
+
+ISA_BINARY(add_array_f32, float)
+ISA_BINARY(mul_array_f32, float)
+ISA_SCALE(scale_array_f32, float)
+ISA_BINARY(fmadd_array_f32, float)
+ISA_DOT(dot_product_f32, float)
+ISA_DOT(dot_product_kahan_f32, float)
+ISA_DOT(dot_product_pairwise_f32, float)
+ISA_REDUCE(reduce_sum_f32, float)
+ISA_REDUCE(reduce_sum_pairwise_f32, float)
+ISA_REDUCE(reduce_min_f32, float)
+ISA_REDUCE(reduce_max_f32, float)
+
+ISA_BINARY(add_array_f64, double)
+ISA_BINARY(mul_array_f64, double)
+ISA_SCALE(scale_array_f64, double)
+ISA_BINARY(fmadd_array_f64, double)
+ISA_DOT(dot_product_f64, double)
+ISA_REDUCE(reduce_sum_f64, double)
+ISA_REDUCE(reduce_min_f64, double)
+ISA_REDUCE(reduce_max_f64, double)
+
+ISA_REDUCE(reduce_sum_i32, int32_t)
+ISA_REDUCE(reduce_sum_i16, int16_t)
+ISA_REDUCE(reduce_sum_u8, uint8_t)
+ISA_REDUCE(reduce_min_i8, int8_t)
+ISA_REDUCE(reduce_max_i8, int8_t)
+ISA_REDUCE(reduce_min_u8, uint8_t)
+ISA_REDUCE(reduce_max_u8, uint8_t)
+ISA_REDUCE(reduce_min_i16, int16_t)
+ISA_REDUCE(reduce_max_i16, int16_t)
+ISA_REDUCE(reduce_min_i32, int32_t)
+ISA_REDUCE(reduce_max_i32, int32_t)
+
+ISA_BINARY(adds_array_i8, int8_t)
+ISA_BINARY(subs_array_i8, int8_t)
+ISA_BINARY(adds_array_u8, uint8_t)
+ISA_BINARY(subs_array_u8, uint8_t)
+ISA_BINARY(adds_array_i16, int16_t)
+ISA_BINARY(subs_array_i16, int16_t)
+ISA_BINARY(adds_array_u16, uint16_t)
+ISA_BINARY(subs_array_u16, uint16_t)
+
+static void run_memcpy(const isa_bufs *p, size_t n) {
+  p->t->memcpy_bytes(p->c, p->a, n, n >= ISA_STREAM_BYTES);
+}
+
+static void run_memset(const isa_bufs *p, size_t n) {
+  p->t->memset_bytes(p->a, 0x5a, n, n >= ISA_STREAM_BYTES);
+}
+
+ISA_MATH(WCN_MATH_FN_EXP, WCN_MATH_ACCURATE, exp_array_f32)
+ISA_MATH(WCN_MATH_FN_EXP, WCN_MATH_FAST, exp_array_f32_fast)
+ISA_MATH(WCN_MATH_FN_LOG, WCN_MATH_ACCURATE, log_array_f32)
+ISA_MATH(WCN_MATH_FN_SIN, WCN_MATH_ACCURATE, sin_array_f32)
+ISA_MATH(WCN_MATH_FN_TANH, WCN_MATH_ACCURATE, tanh_array_f32)
+
+ISA_DOT(dot_product_f16, uint16_t)
+ISA_DOT(dot_product_bf16, uint16_t)
+
+static void run_f16_to_f32(const isa_bufs *p, size_t n) {
+  p->t->f16_to_f32((const uint16_t *)p->a, (float *)p->c, n);
+}
+
+static void run_f32_to_f16(const isa_bufs *p, size_t n) {
+  p->t->f32_to_f16((const float *)p->a, (uint16_t *)p->c, n);
+}
+
+static void run_dot_u8i8_i32(const isa_bufs *p, size_t n) {
+  g_sink += (double)p->t->dot_u8i8_i32((const uint8_t *)p->a,
+                                       (const int8_t *)p->b, n);
+}
+
+static void run_gemv_u8i8_i32(const isa_bufs *p, size_t n) {
+  p->t->gemv_u8i8_i32((const int8_t *)p->a, (const uint8_t *)p->b,
+                      (int32_t *)p->c, n / 256, 256);
+}
+
+/* As in wcn_simd_bench: (n / 64) x 64 times 64 x 64 with ldb = 0. The
+ * packing scratch is kept across calls and grows with n. */
+static void run_sgemm(const isa_bufs *p, size_t n) {
+  static float *pack;
+  static size_t pack_floats;
+  const size_t need = p->t->sgemm_pack_floats(n / 64, 64, 64);
+  if (need > pack_floats) {
+    wcn_aligned_free(pack);
+    pack = (float *)wcn_aligned_alloc(need * sizeof(float), 64);
+    pack_floats = pack != NULL ? need : 0;
+  }
+  if (pack == NULL || n < 64) {
+    return;
+  }
+  wcn_sgemm_args_t args = {0};
+  args.m = n / 64;
+  args.n = 64;
+  args.k = 64;
+  args.a = (const float *)p->a;
+  args.b = (const float *)p->b;
+  args.c = (float *)p->c;
+  args.lda = 64;
+  args.ldc = 64;
+  args.alpha = 1.0f;
+  p->t->sgemm_f32(&args, pack);
+}
+
+/* As in wcn_simd_bench: (n / 256) x 256 to 256 x (n / 256) */
+static void run_transpose_f32(const isa_bufs *p, size_t n) {
+  p->t->transpose_f32((const float *)p->a, 256, (float *)p->c, n / 256,
+                      n / 256, 256, n * sizeof(float) >= ISA_STREAM_BYTES);
+}
+
+static void run_transpose_u8(const isa_bufs *p, size_t n) {
+  p->t->transpose_u8((const uint8_t *)p->a, 256, (uint8_t *)p->c, n / 256,
+                     n / 256, 256, n >= ISA_STREAM_BYTES);
+}
+
+/* As in wcn_simd_bench: 32 taps from b. The kernel reads 31 samples past
+ * its last output, so the final 31 outputs are left out. */
+static void run_fir_f32(const isa_bufs *p, size_t n) {
+  if (n < 32) {
+    return;
+  }
+  p->t->fir_f32((const float *)p->a, (float *)p->c, n - 31,
+                (const float *)p->b, 32);
+}
+
+/* As in wcn_simd_bench: n / 2048 transforms of 1024 points */
+static void run_fft_c2c(const isa_bufs *p, size_t n) {
+  WCN_ALIGN(64) static float work[2048];
+  const wcn_fft_plan_t *plan = wcn_simd_fft_plan_c2c(1024);
+  for (size_t i = 0; i + 2048 <= n; i += 2048) {
+    p->t->fft_c2c(plan, (const float *)p->a + i, (float *)p->c + i, work, 0);
+  }
+}
+
+static void run_softmax_f32(const isa_bufs *p, size_t n) {
+  p->t->softmax_rows_f32((const float *)p->a, (float *)p->c, NULL, 1, n);
+}
+
+/* out = 0.5 * a + 2 * b, as in wcn_simd_bench */
+static void run_expr_eval(const isa_bufs *p, size_t n) {
+  const float *in[2] = {(const float *)p->a, (const float *)p->b};
+  p->t->expr_eval_f32(p->plan, in, (float *)p->c, n);
+}
+
+static const isa_kernel g_kernels[] = {
+    {"add_array_f32", "f32", 4, 3, run_add_array_f32},
+    {"mul_array_f32", "f32", 4, 3, run_mul_array_f32},
+    {"scale_array_f32", "f32", 4, 2, run_scale_array_f32},
+    {"fmadd_array_f32", "f32", 4, 3, run_fmadd_array_f32},
+    {"dot_product_f32", "f32", 4, 2, run_dot_product_f32},
+    {"dot_product_kahan_f32", "f32", 4, 2, run_dot_product_kahan_f32},
+    {"dot_product_pairwise_f32", "f32", 4, 2, run_dot_product_pairwise_f32},
+    {"reduce_sum_f32", "f32", 4, 1, run_reduce_sum_f32},
+    {"reduce_sum_pairwise_f32", "f32", 4, 1, run_reduce_sum_pairwise_f32},
+    {"reduce_min_f32", "f32", 4, 1, run_reduce_min_f32},
+    {"reduce_max_f32", "f32", 4, 1, run_reduce_max_f32},
+    {"add_array_f64", "f64", 8, 3, run_add_array_f64},
+    {"mul_array_f64", "f64", 8, 3, run_mul_array_f64},
+    {"scale_array_f64", "f64", 8, 2, run_scale_array_f64},
+    {"fmadd_array_f64", "f64", 8, 3, run_fmadd_array_f64},
+    {"dot_product_f64", "f64", 8, 2, run_dot_product_f64},
+    {"reduce_sum_f64", "f64", 8, 1, run_reduce_sum_f64},
+    {"reduce_min_f64", "f64", 8, 1, run_reduce_min_f64},
+    {"reduce_max_f64", "f64", 8, 1, run_reduce_max_f64},
+    {"reduce_sum_i32", "i32", 4, 1, run_reduce_sum_i32},
+    {"reduce_sum_i16", "i16", 2, 1, run_reduce_sum_i16},
+    {"reduce_sum_u8", "u8", 1, 1, run_reduce_sum_u8},
+    {"reduce_min_i8", "i8", 1, 1, run_reduce_min_i8},
+    {"reduce_max_i8", "i8", 1, 1, run_reduce_max_i8},
+    {"reduce_min_u8", "u8", 1, 1, run_reduce_min_u8},
+    {"reduce_max_u8", "u8", 1, 1, run_reduce_max_u8},
+    {"reduce_min_i16", "i16", 2, 1, run_reduce_min_i16},
+    {"reduce_max_i16", "i16", 2, 1, run_reduce_max_i16},
+    {"reduce_min_i32", "i32", 4, 1, run_reduce_min_i32},
+    {"reduce_max_i32", "i32", 4, 1, run_reduce_max_i32},
+    {"adds_array_i8", "i8", 1, 3, run_adds_array_i8},
+    {"subs_array_i8", "i8", 1, 3, run_subs_array_i8},
+    {"adds_array_u8", "u8", 1, 3, run_adds_array_u8},
+    {"subs_array_u8", "u8", 1, 3, run_subs_array_u8},
+    {"adds_array_i16", "i16", 2, 3, run_adds_array_i16},
+    {"subs_array_i16", "i16", 2, 3, run_subs_array_i16},
+    {"adds_array_u16", "u16", 2, 3, run_adds_array_u16},
+    {"subs_array_u16", "u16", 2, 3, run_subs_array_u16},
+    {"memcpy_aligned", "u8", 1, 2, run_memcpy},
+    {"memset_aligned", "u8", 1, 1, run_memset},
+    {"expr_eval", "f32", 4, 3, run_expr_eval},
+    {"exp_array_f32", "f32", 4, 2, run_exp_array_f32},
+    {"exp_array_f32_fast", "f32", 4, 2, run_exp_array_f32_fast},
+    {"log_array_f32", "f32", 4, 2, run_log_array_f32},
+    {"sin_array_f32", "f32", 4, 2, run_sin_array_f32},
+    {"tanh_array_f32", "f32", 4, 2, run_tanh_array_f32},
+    {"softmax_f32", "f32", 4, 2, run_softmax_f32},
+    {"dot_product_f16", "f16", 2, 2, run_dot_product_f16},
+    {"dot_product_bf16", "bf16", 2, 2, run_dot_product_bf16},
+    {"f16_to_f32", "f16", 2, 2, run_f16_to_f32},
+    {"f32_to_f16", "f32", 4, 2, run_f32_to_f16},
+    {"dot_u8i8_i32", "u8", 1, 2, run_dot_u8i8_i32},
+    {"gemv_u8i8_i32", "i8", 1, 1, run_gemv_u8i8_i32},
+    {"sgemm", "f32", 4, 2, run_sgemm},
+    {"transpose_f32", "f32", 4, 2, run_transpose_f32},
+    {"transpose_u8", "u8", 1, 2, run_transpose_u8},
+    {"fir_f32", "f32", 4, 2, run_fir_f32},
+    {"fft_c2c", "f32", 4, 2, run_fft_c2c},
+};
+
+#define KERNEL_COUNT (sizeof(g_kernels) / sizeof(g_kernels[0]))
+
+/* ========== Options ========== */
+
+typedef struct {
+  size_t max_bytes; /* DRAM working set, 0 = bench_dram_bytes() */
+  unsigned samples;
+  double min_sample_ns;
+  const char *filter;
+  const char *output;
+} isa_options;
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --max-bytes SIZE     DRAM working set (default: past the LLC)\n"
+          "  --samples N          timed samples per case (default 11)\n"
+          "  --min-sample-us US   minimum duration of a sample (default "
+          "1000)\n"
+          "  --filter TEXT        only kernels whose name contains TEXT\n"
+          "  --output FILE        also write the results as JSON\n"
+          "  --quick              3 samples of at least 200 us\n",
+          argv0);
+}
+
+static int parse_options(int argc, char **argv, isa_options *o) {
+  o->max_bytes = 0;
+  o->samples = 11;
+  o->min_sample_ns = 1e6;
+  o->filter = NULL;
+  o->output = NULL;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--quick") == 0) {
+      o->samples = 3;
+      o->min_sample_ns = 2e5;
+      continue;
+    }
+    if (val == NULL)
+      return -1;
+    i++;
+    if (strcmp(arg, "--max-bytes") == 0) {
+      if ((o->max_bytes = bench_parse_size(val)) == 0)
+        return -1;
+    } else if (strcmp(arg, "--samples") == 0) {
+      o->samples = (unsigned)strtoul(val, NULL, 10);
+      if (o->samples == 0)
+        return -1;
+    } else if (strcmp(arg, "--min-sample-us") == 0) {
+      o->min_sample_ns = strtod(val, NULL) * 1e3;
+    } else if (strcmp(arg, "--filter") == 0) {
+      o->filter = val;
+    } else if (strcmp(arg, "--output") == 0) {
+      o->output = val;
+    } else {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* ========== Measurement ========== */
+
+/* Median ns per call over the samples */
+static double measure(const isa_kernel *k, const isa_bufs *bufs, size_t n,
+                      const isa_options *o, double *samples) {
+  k->run(bufs, n);
+  double t0 = bench_now_ns();
+  k->run(bufs, n);
+  const double once = bench_now_ns() - t0;
+  size_t iterations = 1;
+  if (once < o->min_sample_ns)
+    iterations = (size_t)(o->min_sample_ns / (once > 1.0 ? once : 1.0)) + 1;
+
+  for (unsigned s = 0; s < o->samples; s++) {
+    t0 = bench_now_ns();
+    for (size_t it = 0; it < iterations; it++)
+      k->run(bufs, n);
+    samples[s] = (bench_now_ns() - t0) / (double)iterations;
+  }
+  return bench_compute_stats(samples, o->samples).median;
+}
+
+/* ========== Main ========== */
+
+typedef struct {
+  const char *name; /* resident level, or "-" with unknown caches */
+  size_t bytes;
+} size_class;
+
+int main(int argc, char **argv) {
+  isa_options opt;
+  if (parse_options(argc, argv, &opt) != 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  wcn_simd_init();
+  const wcn_simd_features_t *features = wcn_simd_get_features();
+  int run[ISA_COUNT];
+  for (size_t v = 0; v < ISA_COUNT; v++)
+    run[v] = g_isas[v].table != NULL && g_isas[v].supported(features);
+
+  size_t cache[4];
+  bench_detect_caches(cache);
+  if (opt.max_bytes == 0)
+    opt.max_bytes = bench_dram_bytes(cache);
+
+  /* Half of each cache level, then DRAM; fixed sizes if caches are unknown */
+  size_class classes[4];
+  size_t class_count = 0;
+  for (int level = 1; level <= 3; level++) {
+    const size_t bytes = cache[1] != 0 ? cache[level] / 2
+                                       : (size_t)16 << (10 + 4 * (level - 1));
+    if (bytes == 0 || bytes >= opt.max_bytes ||
+        (class_count > 0 && bytes <= classes[class_count - 1].bytes))
+      continue;
+    classes[class_count].bytes = bytes;
+    classes[class_count++].name = bench_resident_level(cache, bytes);
+  }
+  classes[class_count].bytes = opt.max_bytes;
+  classes[class_count++].name = bench_resident_level(cache, opt.max_bytes);
+
+  const size_t buf_bytes = opt.max_bytes + 64;
+  unsigned char *base_a = wcn_aligned_alloc(buf_bytes, 64);
+  unsigned char *base_b = wcn_aligned_alloc(buf_bytes / 2, 64);
+  /* c is reset per size class, up to the full max_bytes */
+  unsigned char *base_c = wcn_aligned_alloc(buf_bytes, 64);
+  double *samples = (double *)malloc(opt.samples * sizeof(double));
+  if (!base_a || !base_b || !base_c || !samples) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  wcn_expr_t *e = wcn_expr_create();
+  wcn_expr_node_t y = wcn_expr_fma(
+      e, wcn_expr_const(e, 0.5f), wcn_expr_input(e, 0),
+      wcn_expr_mul(e, wcn_expr_const(e, 2.0f), wcn_expr_input(e, 1)));
+  wcn_expr_plan_t *plan = wcn_expr_compile(e, y);
+  wcn_expr_destroy(e);
+
+  FILE *out = NULL;
+  bench_json j;
+  if (opt.output != NULL) {
+    if ((out = fopen(opt.output, "w")) == NULL) {
+      perror(opt.output);
+      return 1;
+    }
+    bench_json_init(&j, out);
+    bench_json_open(&j, NULL, '{');
+    bench_json_u64(&j, "schema", 1);
+#if defined(__VERSION__)
+    bench_json_str(&j, "compiler", __VERSION__);
+#elif defined(_MSC_FULL_VER)
+    bench_json_u64(&j, "compiler_msc", _MSC_FULL_VER);
+#endif
+    bench_json_open(&j, "levels", '[');
+    for (size_t v = 0; v < ISA_COUNT; v++) {
+      bench_json_open(&j, NULL, '{');
+      bench_json_str(&j, "isa", g_isas[v].name);
+      bench_json_bool(&j, "built", g_isas[v].table != NULL);
+      bench_json_bool(&j, "supported", g_isas[v].supported(features));
+      bench_json_str(&j, "impl",
+                     g_isas[v].table ? g_isas[v].table->name : NULL);
+      bench_json_close(&j, '}');
+    }
+    bench_json_close(&j, ']');
+    bench_json_open(&j, "results", '[');
+  }
+
+  size_t baseline = 0;
+  while (!run[baseline])
+    baseline++;
+  printf("Speedup over %s per size class; ns/elem is %s's time\n",
+         g_isas[baseline].name, g_isas[baseline].name);
+
+  for (size_t ki = 0; ki < KERNEL_COUNT; ki++) {
+    const isa_kernel *k = &g_kernels[ki];
+    if (opt.filter != NULL && strstr(k->name, opt.filter) == NULL)
+      continue;
+    if (k->run == run_expr_eval && plan == NULL)
+      continue;
+    bench_fill_array(k->type, base_a, buf_bytes, 0);
+    bench_fill_array(k->type, base_b, buf_bytes / 2, 1);
+    bench_fill_array(k->type, base_c, buf_bytes, 2);
+
+    printf("\n%-26s %10s", k->name, "ns/elem");
+    for (size_t v = 0; v < ISA_COUNT; v++)
+      printf(" %9s", g_isas[v].name);
+    printf("\n");
+
+    for (size_t ci = 0; ci < class_count; ci++) {
+      const size_t n = classes[ci].bytes / (k->elem_size * k->arrays);
+      double ns[ISA_COUNT];
+      char sz[32];
+      if (n == 0)
+        continue;
+      for (size_t v = 0; v < ISA_COUNT; v++) {
+        ns[v] = NAN;
+        if (!run[v])
+          continue;
+        const isa_bufs bufs = {g_isas[v].table, base_a, base_b, base_c, plan};
+        /* Outputs are in/out for some kernels: start every level alike */
+        bench_fill_array(k->type, base_c, classes[ci].bytes, 2);
+        ns[v] = measure(k, &bufs, n, &opt, samples) / (double)n;
+      }
+
+      printf("  %-5s %-8s %10.4f", classes[ci].name ? classes[ci].name : "-",
+             bench_format_size(classes[ci].bytes, sz, sizeof(sz)),
+             ns[baseline]);
+      for (size_t v = 0; v < ISA_COUNT; v++) {
+        if (isnan(ns[v]))
+          printf(" %9s", "-");
+        else
+          printf(" %8.2fx", ns[baseline] / ns[v]);
+      }
+      printf("\n");
+      fflush(stdout);
+
+      if (out == NULL)
+        continue;
+      for (size_t v = 0; v < ISA_COUNT; v++) {
+        if (!run[v])
+          continue;
+        bench_json_open(&j, NULL, '{');
+        bench_json_str(&j, "kernel", k->name);
+        bench_json_str(&j, "type", k->type);
+        bench_json_str(&j, "isa", g_isas[v].name);
+        bench_json_str(&j, "resident", classes[ci].name);
+        bench_json_u64(&j, "working_set_bytes", classes[ci].bytes);
+        bench_json_u64(&j, "elements", n);
+        bench_json_num(&j, "ns_per_element", ns[v]);
+        bench_json_num(&j, "speedup", ns[baseline] / ns[v]);
+        bench_json_close(&j, '}');
+      }
+    }
+  }
+
+  if (out != NULL) {
+    bench_json_close(&j, ']');
+    bench_json_close(&j, '}');
+    fclose(out);
+  }
+  wcn_expr_plan_destroy(plan);
+  free(samples);
+  wcn_aligned_free(base_a);
+  wcn_aligned_free(base_b);
+  wcn_aligned_free(base_c);
+  return g_sink == 12345.678 ? 3 : 0;
+}
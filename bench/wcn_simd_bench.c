@@ -0,0 +1,598 @@
+/*
+ * wcn_simd_bench: sweeps every exported array kernel over working-set
+ * sizes from L1-resident to DRAM-resident, with vector-aligned and
+ * misaligned buffers, and writes the results as JSON.
+ *
+ * Each case is timed as a number of samples; a sample repeats the call
+ * often enough to last at least --min-sample-us. Statistics are over the
+ * per-call time of the samples. Throughput figures use the median:
+ *
+ *   ns_per_element  median ns per call / elements
+ *   gb_per_s        bytes read + written by one call (no write-allocate
+ *                   traffic) / median
+ *   gops_per_s      arithmetic operations per call / median; floating-point
+ *                   operations for the f32/f64 kernels (GFLOP/s), integer
+ *                   operations for the others, 0 for memcpy/memset
+ *
+ * With --perf, hardware counters (bench_perf.h) run during the timed
+ * samples and each case also reports cycles, instructions, cache and
+ * branch misses and vector FP instructions per element, and IPC. Counters
+ * that cannot be opened are reported as null.
+ *
+ * JSON goes to stdout (or --output FILE), one progress line per case to
+ * stderr. Run with --help for the options.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#define _POSIX_C_SOURCE 200112L
+#include "bench_harness.h"
+#include "bench_perf.h"
+#include <WCN_SIMD.h>
+
+/* ========== Buffers ========== */
+
+/* Single-array kernels use a, two-array kernels a and c */
+typedef struct {
+  unsigned char *a, *b, *c; /* inputs a, b; output (or in/out) c */
+  const wcn_expr_plan_t *plan;
+} bench_bufs;
+
+static volatile double g_sink;
+
+/* ========== Kernel Table ========== */
+
+typedef struct {
+  const char *name;
+  const char *type;
+  size_t elem_size;
+  unsigned arrays;       /* distinct arrays touched (working set) */
+  unsigned traffic;      /* elements read + written per element */
+  unsigned ops;          /* arithmetic operations per element */
+  void (*run)(const bench_bufs *, size_t);
+} bench_kernel;
+
+#define BENCH_BINARY(fn, T)                                                    \
+  static void run_##fn(const bench_bufs *p, size_t n) {                        \
+    wcn_simd_##fn((const T *)p->a, (const T *)p->b, (T *)p->c, n);             \
+  }
+#define BENCH_SCALE(fn, T)                                                     \
+  static void run_##fn(const bench_bufs *p, size_t n) {                        \
+    wcn_simd_##fn((const T *)p->a, (T)1.0001, (T *)p->c, n);                   \
+  }
+#define BENCH_DOT(fn, T)                                                       \
+  static void run_##fn(const bench_bufs *p, size_t n) {                        \
+    g_sink += (double)wcn_simd_##fn((const T *)p->a, (const T *)p->b, n);      \
+  }
+#define BENCH_REDUCE(fn, T)                                                    \
+  static void run_##fn(const bench_bufs *p, size_t n) {                        \
+    g_sink += (double)wcn_simd_##fn((const T *)p->a, n);                       \
+  }
+#define BENCH_MATH(fn, mode, tag)                                              \
+  static void run_##fn##tag(const bench_bufs *p, size_t n) {                   \
+    wcn_simd_##fn((const float *)p->a, (float *)p->c, n, mode);                \
+  }
+
+BENCH_BINARY(add_array_f32, float)
+BENCH_BINARY(mul_array_f32, float)
+BENCH_SCALE(scale_array_f32, float)
+BENCH_BINARY(fmadd_array_f32, float)
+BENCH_DOT(dot_product_f32, float)
+BENCH_DOT(dot_product_kahan_f32, float)
+BENCH_DOT(dot_product_pairwise_f32, float)
+BENCH_REDUCE(reduce_sum_f32, float)
+BENCH_REDUCE(reduce_sum_pairwise_f32, float)
+BENCH_REDUCE(reduce_min_f32, float)
+BENCH_REDUCE(reduce_max_f32, float)
+
+BENCH_BINARY(add_array_f64, double)
+BENCH_BINARY(mul_array_f64, double)
+BENCH_SCALE(scale_array_f64, double)
+BENCH_BINARY(fmadd_array_f64, double)
+BENCH_DOT(dot_product_f64, double)
+BENCH_REDUCE(reduce_sum_f64, double)
+BENCH_REDUCE(reduce_min_f64, double)
+BENCH_REDUCE(reduce_max_f64, double)
+
+BENCH_REDUCE(reduce_sum_i32, int32_t)
+BENCH_REDUCE(reduce_sum_i16, int16_t)
+BENCH_REDUCE(reduce_sum_u8, uint8_t)
+BENCH_REDUCE(reduce_min_i8, int8_t)
+BENCH_REDUCE(reduce_max_i8, int8_t)
+BENCH_REDUCE(reduce_min_u8, uint8_t)
+BENCH_REDUCE(reduce_max_u8, uint8_t)
+BENCH_REDUCE(reduce_min_i16, int16_t)
+BENCH_REDUCE(reduce_max_i16, int16_t)
+BENCH_REDUCE(reduce_min_i32, int32_t)
+BENCH_REDUCE(reduce_max_i32, int32_t)
+
+BENCH_BINARY(adds_array_i8, int8_t)
+BENCH_BINARY(subs_array_i8, int8_t)
+BENCH_BINARY(adds_array_u8, uint8_t)
+BENCH_BINARY(subs_array_u8, uint8_t)
+BENCH_BINARY(adds_array_i16, int16_t)
+BENCH_BINARY(subs_array_i16, int16_t)
+BENCH_BINARY(adds_array_u16, uint16_t)
+BENCH_BINARY(subs_array_u16, uint16_t)
+
+BENCH_MATH(exp_array_f32, WCN_MATH_ACCURATE, )
+BENCH_MATH(exp_array_f32, WCN_MATH_FAST, _fast)
+BENCH_MATH(log_array_f32, WCN_MATH_ACCURATE, )
+BENCH_MATH(log_array_f32, WCN_MATH_FAST, _fast)
+BENCH_MATH(sin_array_f32, WCN_MATH_ACCURATE, )
+BENCH_MATH(sin_array_f32, WCN_MATH_FAST, _fast)
+BENCH_MATH(tanh_array_f32, WCN_MATH_ACCURATE, )
+BENCH_MATH(erf_array_f32, WCN_MATH_ACCURATE, )
+
+BENCH_DOT(dot_product_f16, wcn_f16_t)
+BENCH_DOT(dot_product_bf16, wcn_bf16_t)
+BENCH_REDUCE(reduce_sum_f16, wcn_f16_t)
+
+static void run_fmadd_array_f16(const bench_bufs *p, size_t n) {
+  wcn_simd_fmadd_array_f16((const wcn_f16_t *)p->a, (const wcn_f16_t *)p->b,
+                           (float *)p->c, n);
+}
+
+static void run_f16_to_f32(const bench_bufs *p, size_t n) {
+  wcn_simd_f16_to_f32((const wcn_f16_t *)p->a, (float *)p->c, n);
+}
+
+static void run_dot_u8i8_i32(const bench_bufs *p, size_t n) {
+  g_sink += (double)wcn_simd_dot_u8i8_i32((const uint8_t *)p->a,
+                                          (const int8_t *)p->b, n);
+}
+
+/* n bytes of w as rows of 256 columns; x from b, y into c */
+static void run_gemv_u8i8_i32(const bench_bufs *p, size_t n) {
+  wcn_simd_gemv_u8i8_i32((const int8_t *)p->a, (const uint8_t *)p->b,
+                         (int32_t *)p->c, n / 256, 256);
+}
+
+/* (n / 64) x 64 times 64 x 64. op(B) repeats the first 64 floats of b
+ * (ldb = 0), so the working set is A and C at every size. */
+static void run_sgemm(const bench_bufs *p, size_t n) {
+  wcn_simd_sgemm(WCN_GEMM_NO_TRANS, WCN_GEMM_NO_TRANS, n / 64, 64, 64, 1.0f,
+                 (const float *)p->a, 64, (const float *)p->b, 0, 0.0f,
+                 (float *)p->c, 64);
+}
+
+/* (n / 256) x 256 to 256 x (n / 256) */
+static void run_transpose_f32(const bench_bufs *p, size_t n) {
+  wcn_simd_transpose_f32((const float *)p->a, (float *)p->c, n / 256, 256);
+}
+
+static void run_transpose_u8(const bench_bufs *p, size_t n) {
+  wcn_simd_transpose_u8((const uint8_t *)p->a, (uint8_t *)p->c, n / 256,
+                        256);
+}
+
+/* a filtered by the first 32 floats of b into c */
+static void run_fir_f32(const bench_bufs *p, size_t n) {
+  wcn_simd_fir_f32((const float *)p->a, (float *)p->c, n,
+                   (const float *)p->b, 32);
+}
+
+/* n / 2048 forward transforms of 1024 complex points from a into c */
+static void run_fft_c2c(const bench_bufs *p, size_t n) {
+  const wcn_fft_plan_t *plan = wcn_simd_fft_plan_c2c(1024);
+  for (size_t i = 0; i + 2048 <= n; i += 2048) {
+    wcn_simd_fft_c2c(plan, (const float *)p->a + i, (float *)p->c + i,
+                     WCN_FFT_FORWARD);
+  }
+}
+
+static void run_softmax_f32(const bench_bufs *p, size_t n) {
+  wcn_simd_softmax_f32((const float *)p->a, (float *)p->c, n);
+}
+
+static void run_logsumexp_f32(const bench_bufs *p, size_t n) {
+  g_sink += (double)wcn_simd_logsumexp_f32((const float *)p->a, n);
+}
+
+/* a in [0.5, 1.5) raised to b in (0, 0.014) */
+static void run_pow_array_f32(const bench_bufs *p, size_t n) {
+  wcn_simd_pow_array_f32((const float *)p->a, (const float *)p->b,
+                         (float *)p->c, n, WCN_MATH_ACCURATE);
+}
+
+static void run_memcpy_aligned(const bench_bufs *p, size_t n) {
+  wcn_simd_memcpy_aligned(p->c, p->a, n);
+}
+
+static void run_memset_aligned(const bench_bufs *p, size_t n) {
+  wcn_simd_memset_aligned(p->a, 0x5a, n);
+}
+
+/* out = 0.5 * a + 2 * b, a fused three-operation expression */
+static void run_expr_eval(const bench_bufs *p, size_t n) {
+  const float *in[2] = {(const float *)p->a, (const float *)p->b};
+  wcn_expr_eval(p->plan, in, (float *)p->c, n);
+}
+
+static const bench_kernel g_kernels[] = {
+    {"add_array_f32", "f32", 4, 3, 3, 1, run_add_array_f32},
+    {"mul_array_f32", "f32", 4, 3, 3, 1, run_mul_array_f32},
+    {"scale_array_f32", "f32", 4, 2, 2, 1, run_scale_array_f32},
+    {"fmadd_array_f32", "f32", 4, 3, 4, 2, run_fmadd_array_f32},
+    {"dot_product_f32", "f32", 4, 2, 2, 2, run_dot_product_f32},
+    {"dot_product_kahan_f32", "f32", 4, 2, 2, 2, run_dot_product_kahan_f32},
+    {"dot_product_pairwise_f32", "f32", 4, 2, 2, 2,
+     run_dot_product_pairwise_f32},
+    {"reduce_sum_f32", "f32", 4, 1, 1, 1, run_reduce_sum_f32},
+    {"reduce_sum_pairwise_f32", "f32", 4, 1, 1, 1,
+     run_reduce_sum_pairwise_f32},
+    {"reduce_min_f32", "f32", 4, 1, 1, 1, run_reduce_min_f32},
+    {"reduce_max_f32", "f32", 4, 1, 1, 1, run_reduce_max_f32},
+    {"add_array_f64", "f64", 8, 3, 3, 1, run_add_array_f64},
+    {"mul_array_f64", "f64", 8, 3, 3, 1, run_mul_array_f64},
+    {"scale_array_f64", "f64", 8, 2, 2, 1, run_scale_array_f64},
+    {"fmadd_array_f64", "f64", 8, 3, 4, 2, run_fmadd_array_f64},
+    {"dot_product_f64", "f64", 8, 2, 2, 2, run_dot_product_f64},
+    {"reduce_sum_f64", "f64", 8, 1, 1, 1, run_reduce_sum_f64},
+    {"reduce_min_f64", "f64", 8, 1, 1, 1, run_reduce_min_f64},
+    {"reduce_max_f64", "f64", 8, 1, 1, 1, run_reduce_max_f64},
+    {"reduce_sum_i32", "i32", 4, 1, 1, 1, run_reduce_sum_i32},
+    {"reduce_sum_i16", "i16", 2, 1, 1, 1, run_reduce_sum_i16},
+    {"reduce_sum_u8", "u8", 1, 1, 1, 1, run_reduce_sum_u8},
+    {"reduce_min_i8", "i8", 1, 1, 1, 1, run_reduce_min_i8},
+    {"reduce_max_i8", "i8", 1, 1, 1, 1, run_reduce_max_i8},
+    {"reduce_min_u8", "u8", 1, 1, 1, 1, run_reduce_min_u8},
+    {"reduce_max_u8", "u8", 1, 1, 1, 1, run_reduce_max_u8},
+    {"reduce_min_i16", "i16", 2, 1, 1, 1, run_reduce_min_i16},
+    {"reduce_max_i16", "i16", 2, 1, 1, 1, run_reduce_max_i16},
+    {"reduce_min_i32", "i32", 4, 1, 1, 1, run_reduce_min_i32},
+    {"reduce_max_i32", "i32", 4, 1, 1, 1, run_reduce_max_i32},
+    {"adds_array_i8", "i8", 1, 3, 3, 1, run_adds_array_i8},
+    {"subs_array_i8", "i8", 1, 3, 3, 1, run_subs_array_i8},
+    {"adds_array_u8", "u8", 1, 3, 3, 1, run_adds_array_u8},
+    {"subs_array_u8", "u8", 1, 3, 3, 1, run_subs_array_u8},
+    {"adds_array_i16", "i16", 2, 3, 3, 1, run_adds_array_i16},
+    {"subs_array_i16", "i16", 2, 3, 3, 1, run_subs_array_i16},
+    {"adds_array_u16", "u16", 2, 3, 3, 1, run_adds_array_u16},
+    {"subs_array_u16", "u16", 2, 3, 3, 1, run_subs_array_u16},
+    {"memcpy_aligned", "u8", 1, 2, 2, 0, run_memcpy_aligned},
+    {"memset_aligned", "u8", 1, 1, 1, 0, run_memset_aligned},
+    {"expr_eval", "f32", 4, 3, 3, 3, run_expr_eval},
+    /* One function evaluation counts as one operation */
+    {"exp_array_f32", "f32", 4, 2, 2, 1, run_exp_array_f32},
+    {"exp_array_f32_fast", "f32", 4, 2, 2, 1, run_exp_array_f32_fast},
+    {"log_array_f32", "f32", 4, 2, 2, 1, run_log_array_f32},
+    {"log_array_f32_fast", "f32", 4, 2, 2, 1, run_log_array_f32_fast},
+    {"sin_array_f32", "f32", 4, 2, 2, 1, run_sin_array_f32},
+    {"sin_array_f32_fast", "f32", 4, 2, 2, 1, run_sin_array_f32_fast},
+    {"tanh_array_f32", "f32", 4, 2, 2, 1, run_tanh_array_f32},
+    {"erf_array_f32", "f32", 4, 2, 2, 1, run_erf_array_f32},
+    {"pow_array_f32", "f32", 4, 3, 3, 1, run_pow_array_f32},
+    {"softmax_f32", "f32", 4, 2, 3, 2, run_softmax_f32},
+    {"logsumexp_f32", "f32", 4, 1, 1, 1, run_logsumexp_f32},
+    /* 16-bit inputs; traffic in 16-bit units, a float counting as two */
+    {"dot_product_f16", "f16", 2, 2, 2, 2, run_dot_product_f16},
+    {"dot_product_bf16", "bf16", 2, 2, 2, 2, run_dot_product_bf16},
+    {"reduce_sum_f16", "f16", 2, 1, 1, 1, run_reduce_sum_f16},
+    {"fmadd_array_f16", "f16", 2, 3, 6, 2, run_fmadd_array_f16},
+    {"f16_to_f32", "f16", 2, 2, 3, 1, run_f16_to_f32},
+    /* Quantized u8 x i8; the GEMV streams w and reuses x */
+    {"dot_u8i8_i32", "u8", 1, 2, 2, 2, run_dot_u8i8_i32},
+    {"gemv_u8i8_i32", "i8", 1, 1, 1, 2, run_gemv_u8i8_i32},
+    /* Per element of A: 64 multiply-adds, and one element of C written */
+    {"sgemm", "f32", 4, 2, 2, 128, run_sgemm},
+    {"transpose_f32", "f32", 4, 2, 2, 0, run_transpose_f32},
+    {"transpose_u8", "u8", 1, 2, 2, 0, run_transpose_u8},
+    /* 32 taps: 32 multiply-adds per output */
+    {"fir_f32", "f32", 4, 2, 2, 64, run_fir_f32},
+    /* 5 N log2 N flops per 1024-point transform: 25 per float */
+    {"fft_c2c", "f32", 4, 2, 2, 25, run_fft_c2c},
+};
+
+#define KERNEL_COUNT (sizeof(g_kernels) / sizeof(g_kernels[0]))
+
+/* ========== Options ========== */
+
+typedef struct {
+  size_t min_bytes, max_bytes;
+  unsigned samples;
+  double min_sample_ns;
+  unsigned threads;
+  const char *filter;
+  const char *output;
+  int perf;
+  int quiet;
+} bench_options;
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --min-bytes N       smallest working set (default 4K)\n"
+          "  --max-bytes N       largest working set (default: past twice\n"
+          "                      the last-level cache, 64M to 1G)\n"
+          "  --samples N         samples per case (default 21)\n"
+          "  --min-sample-us N   minimum duration of a sample (default 1000)\n"
+          "  --threads N         wcn_simd_set_max_threads() (default 1)\n"
+          "  --filter TEXT       only kernels whose name contains TEXT\n"
+          "  --output FILE       write JSON to FILE instead of stdout\n"
+          "  --perf              read hardware performance counters\n"
+          "  --quick             --samples 5 --min-sample-us 200\n"
+          "  --quiet             no progress lines\n"
+          "Sizes take an optional K/M/G suffix.\n",
+          argv0);
+}
+
+static int parse_options(int argc, char **argv, bench_options *o) {
+  o->min_bytes = (size_t)4 << 10;
+  o->max_bytes = 0;
+  o->samples = 21;
+  o->min_sample_ns = 1e6;
+  o->threads = 1;
+  o->filter = NULL;
+  o->output = NULL;
+  o->perf = 0;
+  o->quiet = 0;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--quick") == 0) {
+      o->samples = 5;
+      o->min_sample_ns = 2e5;
+      continue;
+    }
+    if (strcmp(arg, "--quiet") == 0) {
+      o->quiet = 1;
+      continue;
+    }
+    if (strcmp(arg, "--perf") == 0) {
+      o->perf = 1;
+      continue;
+    }
+    if (val == NULL)
+      return -1;
+    i++;
+    if (strcmp(arg, "--min-bytes") == 0)
+      o->min_bytes = bench_parse_size(val);
+    else if (strcmp(arg, "--max-bytes") == 0)
+      o->max_bytes = bench_parse_size(val);
+    else if (strcmp(arg, "--samples") == 0)
+      o->samples = (unsigned)strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--min-sample-us") == 0)
+      o->min_sample_ns = strtod(val, NULL) * 1e3;
+    else if (strcmp(arg, "--threads") == 0)
+      o->threads = (unsigned)strtoul(val, NULL, 10);
+    else if (strcmp(arg, "--filter") == 0)
+      o->filter = val;
+    else if (strcmp(arg, "--output") == 0)
+      o->output = val;
+    else
+      return -1;
+  }
+  if (o->min_bytes == 0 || o->samples == 0)
+    return -1;
+  return 0;
+}
+
+/* ========== Measurement ========== */
+
+typedef struct {
+  size_t iterations;
+  bench_stats ns_per_call;
+  double counters[BENCH_PERF_COUNT]; /* per call, NAN if not counted */
+} bench_result;
+
+/* perf is NULL when counters are off */
+static bench_result measure(const bench_kernel *k, const bench_bufs *bufs,
+                            size_t n, const bench_options *o,
+                            bench_perf *perf, double *samples) {
+  bench_result r;
+
+  /* Warm up (page faults, caches, lazy init), then size the sample */
+  k->run(bufs, n);
+  double t0 = bench_now_ns();
+  k->run(bufs, n);
+  double once = bench_now_ns() - t0;
+  r.iterations = 1;
+  if (once < o->min_sample_ns)
+    r.iterations = (size_t)(o->min_sample_ns / (once > 1.0 ? once : 1.0)) + 1;
+
+  if (perf != NULL)
+    bench_perf_start(perf);
+  for (unsigned s = 0; s < o->samples; s++) {
+    t0 = bench_now_ns();
+    for (size_t it = 0; it < r.iterations; it++)
+      k->run(bufs, n);
+    samples[s] = (bench_now_ns() - t0) / (double)r.iterations;
+  }
+  const double calls = (double)r.iterations * o->samples;
+  if (perf != NULL)
+    bench_perf_stop(perf, r.counters);
+  for (int i = 0; i < BENCH_PERF_COUNT; i++)
+    r.counters[i] = perf != NULL ? r.counters[i] / calls : NAN;
+
+  r.ns_per_call = bench_compute_stats(samples, o->samples);
+  return r;
+}
+
+/* ========== Main ========== */
+
+int main(int argc, char **argv) {
+  bench_options opt;
+  if (parse_options(argc, argv, &opt) != 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  /* Before any library thread exists, so that the counters follow the
+   * pool workers too */
+  bench_perf perf;
+  bench_perf *perf_used = NULL;
+  if (opt.perf) {
+    if (bench_perf_open(&perf) > 0)
+      perf_used = &perf;
+    else
+      fprintf(stderr, "performance counters unavailable (%s); "
+                      "continuing without them\n",
+              bench_perf_error(&perf));
+  }
+
+  wcn_simd_init();
+  wcn_simd_set_max_threads(opt.threads);
+
+  size_t cache[4];
+  bench_detect_caches(cache);
+
+  if (opt.max_bytes == 0)
+    opt.max_bytes = bench_dram_bytes(cache);
+  if (opt.max_bytes < opt.min_bytes) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  /* Large enough for the biggest working set plus one element of
+   * misalignment: a alone, or a and c, or all three arrays. c gets the full
+   * size because the f16 -> f32 kernels write twice as many bytes as they
+   * read */
+  const size_t buf_bytes = opt.max_bytes + 64;
+  bench_bufs bufs;
+  unsigned char *base_a = wcn_aligned_alloc(buf_bytes, 64);
+  unsigned char *base_b = wcn_aligned_alloc(buf_bytes / 2, 64);
+  unsigned char *base_c = wcn_aligned_alloc(buf_bytes, 64);
+  double *samples = (double *)malloc(opt.samples * sizeof(double));
+  if (!base_a || !base_b || !base_c || !samples) {
+    fprintf(stderr, "out of memory\n");
+    return 1;
+  }
+
+  wcn_expr_t *e = wcn_expr_create();
+  wcn_expr_node_t y = wcn_expr_fma(
+      e, wcn_expr_const(e, 0.5f), wcn_expr_input(e, 0),
+      wcn_expr_mul(e, wcn_expr_const(e, 2.0f), wcn_expr_input(e, 1)));
+  wcn_expr_plan_t *plan = wcn_expr_compile(e, y);
+  wcn_expr_destroy(e);
+  bufs.plan = plan;
+
+  FILE *out = stdout;
+  if (opt.output != NULL && (out = fopen(opt.output, "w")) == NULL) {
+    perror(opt.output);
+    return 1;
+  }
+
+  bench_json j;
+  bench_json_init(&j, out);
+  bench_json_open(&j, NULL, '{');
+  bench_json_u64(&j, "schema", 1);
+
+  bench_json_open(&j, "library", '{');
+  bench_json_str(&j, "version", wcn_simd_get_version());
+  bench_json_str(&j, "impl", wcn_simd_get_impl());
+  bench_json_str(&j, "kernels", wcn_simd_get_kernel_impl());
+  bench_json_u64(&j, "vector_width", (uint64_t)wcn_simd_get_vector_width());
+  bench_json_close(&j, '}');
+
+  bench_json_open(&j, "host", '{');
+  bench_json_u64(&j, "l1d_bytes", cache[1]);
+  bench_json_u64(&j, "l2_bytes", cache[2]);
+  bench_json_u64(&j, "l3_bytes", cache[3]);
+#if defined(__VERSION__)
+  bench_json_str(&j, "compiler", __VERSION__);
+#elif defined(_MSC_FULL_VER)
+  bench_json_u64(&j, "compiler_msc", _MSC_FULL_VER);
+#endif
+  if (opt.perf) {
+    bench_json_open(&j, "perf_counters", '[');
+    for (int i = 0; i < BENCH_PERF_COUNT; i++)
+      if (perf.fd[i] >= 0)
+        bench_json_str(&j, NULL, bench_perf_names[i]);
+    bench_json_close(&j, ']');
+    bench_json_str(&j, "perf_error", bench_perf_error(&perf));
+  }
+  bench_json_close(&j, '}');
+
+  bench_json_open(&j, "config", '{');
+  bench_json_u64(&j, "samples", opt.samples);
+  bench_json_num(&j, "min_sample_ns", opt.min_sample_ns);
+  bench_json_u64(&j, "threads", wcn_simd_get_max_threads());
+  bench_json_close(&j, '}');
+
+  bench_json_open(&j, "results", '[');
+  for (size_t ki = 0; ki < KERNEL_COUNT; ki++) {
+    const bench_kernel *k = &g_kernels[ki];
+    if (opt.filter != NULL && strstr(k->name, opt.filter) == NULL)
+      continue;
+    if (k->run == run_expr_eval && plan == NULL)
+      continue;
+    bench_fill_array(k->type, base_a, buf_bytes, 0);
+    bench_fill_array(k->type, base_b, buf_bytes / 2, 1);
+    bench_fill_array(k->type, base_c, buf_bytes, 2);
+    for (size_t ws = opt.min_bytes; ws <= opt.max_bytes; ws *= 4) {
+      const size_t n = ws / (k->elem_size * k->arrays);
+      if (n == 0)
+        continue;
+      for (int aligned = 1; aligned >= 0; aligned--) {
+        const size_t skew = aligned ? 0 : k->elem_size;
+        bufs.a = base_a + skew;
+        bufs.b = base_b + skew;
+        bufs.c = base_c + skew;
+        const bench_result r =
+            measure(k, &bufs, n, &opt, perf_used, samples);
+
+        const double median = r.ns_per_call.median;
+        const double bytes = (double)n * k->elem_size * k->traffic;
+        const double ops = (double)n * k->ops;
+        const char *level = bench_resident_level(cache, ws);
+
+        bench_json_open(&j, NULL, '{');
+        bench_json_str(&j, "kernel", k->name);
+        bench_json_str(&j, "type", k->type);
+        bench_json_u64(&j, "elements", n);
+        bench_json_u64(&j, "working_set_bytes", ws);
+        bench_json_str(&j, "resident", level);
+        bench_json_bool(&j, "aligned", aligned);
+        bench_json_u64(&j, "iterations", r.iterations);
+        bench_json_stats(&j, "ns_per_call", &r.ns_per_call);
+        bench_json_num(&j, "ns_per_element", median / (double)n);
+        bench_json_num(&j, "gb_per_s", bytes / median);
+        bench_json_num(&j, "gops_per_s", ops / median);
+        const double *cnt = r.counters;
+        if (perf_used != NULL) {
+          bench_json_open(&j, "counters_per_element", '{');
+          for (int i = 0; i < BENCH_PERF_COUNT; i++)
+            bench_json_num(&j, bench_perf_names[i], cnt[i] / (double)n);
+          bench_json_close(&j, '}');
+          bench_json_num(&j, "ipc", cnt[BENCH_PERF_INSTRUCTIONS] /
+                                        cnt[BENCH_PERF_CYCLES]);
+        }
+        bench_json_close(&j, '}');
+        fflush(out);
+
+        if (!opt.quiet) {
+          char sz[32];
+          fprintf(stderr,
+                  "%-22s %6s %-4s %-9s %8.3f ns/elem %8.2f GB/s "
+                  "%8.2f Gop/s (p10 %.0f, p90 %.0f ns)\n",
+                  k->name, bench_format_size(ws, sz, sizeof(sz)),
+                  level ? level : "", aligned ? "aligned" : "unaligned",
+                  median / (double)n, bytes / median, ops / median,
+                  r.ns_per_call.p10, r.ns_per_call.p90);
+          if (perf_used != NULL && !isnan(cnt[BENCH_PERF_CYCLES]))
+            fprintf(stderr, "    IPC %.2f, %.3f cycles/elem, %.4f L1D miss/elem"
+                            ", %.4f LLC miss/elem\n",
+                    cnt[BENCH_PERF_INSTRUCTIONS] / cnt[BENCH_PERF_CYCLES],
+                    cnt[BENCH_PERF_CYCLES] / (double)n,
+                    cnt[BENCH_PERF_L1D_MISSES] / (double)n,
+                    cnt[BENCH_PERF_LLC_MISSES] / (double)n);
+        }
+      }
+    }
+  }
+  bench_json_close(&j, ']');
+  bench_json_close(&j, '}');
+
+  if (out != stdout)
+    fclose(out);
+  if (perf_used != NULL)
+    bench_perf_close(perf_used);
+  wcn_expr_plan_destroy(plan);
+  free(samples);
+  wcn_aligned_free(base_a);
+  wcn_aligned_free(base_b);
+  wcn_aligned_free(base_c);
+  return g_sink == 12345.678 ? 3 : 0;
+}
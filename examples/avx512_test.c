@@ -0,0 +1,459 @@
+#include "WCN_SIMD.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Correctness checks for the wcn_v512* backend against scalar references.
+ * Built with AVX-512 code generation; skips at run time on hosts without
+ * AVX-512F/BW/DQ/VL so it is safe to run everywhere. */
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("  FAILED: %s (%s:%d)\n", #cond, __FILE__, __LINE__);             \
+      g_failures++;                                                            \
+    }                                                                          \
+  } while (0)
+
+#if defined(WCN_X86_AVX512F) && defined(WCN_X86_AVX512BW) &&                   \
+    defined(WCN_X86_AVX512DQ)
+
+static void fill_f32(float *dst, size_t n, float scale, float bias) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = (float)((int)((i * 37u) % 29u) - 14) * scale + bias;
+  }
+}
+
+static void fill_i32(int32_t *dst, size_t n, int32_t scale) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = ((int32_t)((i * 7919u) % 257u) - 128) * scale;
+  }
+}
+
+/* Test load/store and masked tail access */
+static void test_load_store(void) {
+  printf("Testing load/store and masked access...\n");
+
+  float src[48], dst[48];
+  fill_f32(src, 48, 0.5f, 1.0f);
+
+  /* Unaligned round trip */
+  memset(dst, 0, sizeof(dst));
+  wcn_v512f_store(dst + 3, wcn_v512f_load(src + 3));
+  for (int i = 0; i < 16; i++) {
+    CHECK(dst[3 + i] == src[3 + i]);
+  }
+  CHECK(dst[2] == 0.0f && dst[19] == 0.0f);
+
+  /* Masked tails never touch lanes past count */
+  for (size_t n = 0; n <= 16; n++) {
+    uint16_t m = wcn_v512_mask16_first(n);
+    for (int i = 0; i < 48; i++) {
+      dst[i] = -1.0f;
+    }
+    wcn_v512f_t v = wcn_v512f_maskz_load(m, src);
+    wcn_v512f_mask_store(dst, m, v);
+    for (size_t i = 0; i < 16; i++) {
+      CHECK(dst[i] == (i < n ? src[i] : -1.0f));
+    }
+  }
+  CHECK(wcn_v512_mask16_first(40) == 0xFFFF);
+  CHECK(wcn_v512_mask8_first(3) == 0x07);
+
+  double dsrc[8], ddst[8];
+  for (int i = 0; i < 8; i++) {
+    dsrc[i] = i * 1.25;
+    ddst[i] = -1.0;
+  }
+  wcn_v512d_mask_store(ddst, 0x0F, wcn_v512d_maskz_load(0x0F, dsrc));
+  for (int i = 0; i < 8; i++) {
+    CHECK(ddst[i] == (i < 4 ? dsrc[i] : -1.0));
+  }
+
+  printf("✓ Load/store operations work correctly\n");
+}
+
+/* Test integer and float arithmetic */
+static void test_arithmetic(void) {
+  printf("Testing arithmetic...\n");
+
+  int32_t a[16], b[16], r[16];
+  fill_i32(a, 16, 3);
+  fill_i32(b, 16, -5);
+  wcn_v512i_t va = wcn_v512i_load(a), vb = wcn_v512i_load(b);
+
+  wcn_v512i_store(r, wcn_v512i_add_i32(va, vb));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == a[i] + b[i]);
+  wcn_v512i_store(r, wcn_v512i_sub_i32(va, vb));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == a[i] - b[i]);
+  wcn_v512i_store(r, wcn_v512i_mullo_i32(va, vb));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == a[i] * b[i]);
+  wcn_v512i_store(r, wcn_v512i_abs_i32(vb));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == abs(b[i]));
+
+  int64_t la[8], lb[8], lr[8];
+  for (int i = 0; i < 8; i++) {
+    la[i] = (int64_t)a[i] << 33;
+    lb[i] = (int64_t)b[i] * 1000003;
+  }
+  wcn_v512i_store(lr,
+                  wcn_v512i_add_i64(wcn_v512i_load(la), wcn_v512i_load(lb)));
+  for (int i = 0; i < 8; i++) CHECK(lr[i] == la[i] + lb[i]);
+  wcn_v512i_store(lr,
+                  wcn_v512i_mullo_i64(wcn_v512i_load(la), wcn_v512i_load(lb)));
+  for (int i = 0; i < 8; i++) {
+    CHECK(lr[i] == (int64_t)((uint64_t)la[i] * (uint64_t)lb[i]));
+  }
+  wcn_v512i_store(lr, wcn_v512i_mul_u32(va, vb));
+  for (int i = 0; i < 8; i++) {
+    CHECK((uint64_t)lr[i] == (uint64_t)(uint32_t)a[2 * i] * (uint32_t)b[2 * i]);
+  }
+
+  int8_t ba[64], bb[64], br[64];
+  for (int i = 0; i < 64; i++) {
+    ba[i] = (int8_t)(i * 5 - 100);
+    bb[i] = (int8_t)(90 - i * 3);
+  }
+  wcn_v512i_t vba = wcn_v512i_load(ba), vbb = wcn_v512i_load(bb);
+  wcn_v512i_store(br, wcn_v512i_adds_i8(vba, vbb));
+  for (int i = 0; i < 64; i++) {
+    int s = ba[i] + bb[i];
+    CHECK(br[i] == (s > 127 ? 127 : s < -128 ? -128 : s));
+  }
+  wcn_v512i_store(br, wcn_v512i_add_i8(vba, vbb));
+  for (int i = 0; i < 64; i++) CHECK(br[i] == (int8_t)(ba[i] + bb[i]));
+
+  int16_t ha[32], hb[32];
+  int32_t hr[16];
+  for (int i = 0; i < 32; i++) {
+    ha[i] = (int16_t)(i * 301 - 4000);
+    hb[i] = (int16_t)(77 - i * 13);
+  }
+  wcn_v512i_store(hr,
+                  wcn_v512i_madd_i16(wcn_v512i_load(ha), wcn_v512i_load(hb)));
+  for (int i = 0; i < 16; i++) {
+    CHECK(hr[i] == ha[2 * i] * hb[2 * i] + ha[2 * i + 1] * hb[2 * i + 1]);
+  }
+
+  float fa[16], fb[16], fc[16], fr[16];
+  fill_f32(fa, 16, 0.25f, 0.5f);
+  fill_f32(fb, 16, -0.75f, 2.0f);
+  fill_f32(fc, 16, 1.5f, -3.0f);
+  wcn_v512f_t vfa = wcn_v512f_load(fa), vfb = wcn_v512f_load(fb);
+  wcn_v512f_t vfc = wcn_v512f_load(fc);
+
+  wcn_v512f_store(fr, wcn_v512f_add(vfa, vfb));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fa[i] + fb[i]);
+  wcn_v512f_store(fr, wcn_v512f_mul(vfa, vfb));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fa[i] * fb[i]);
+  wcn_v512f_store(fr, wcn_v512f_fmadd(vfa, vfb, vfc));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fmaf(fa[i], fb[i], fc[i]));
+  wcn_v512f_store(fr, wcn_v512f_fmsub(vfa, vfb, vfc));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fmaf(fa[i], fb[i], -fc[i]));
+  wcn_v512f_store(fr, wcn_v512f_fnmadd(vfa, vfb, vfc));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fmaf(-fa[i], fb[i], fc[i]));
+  wcn_v512f_store(fr, wcn_v512f_neg(vfb));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == -fb[i]);
+  wcn_v512f_store(fr, wcn_v512f_abs(vfb));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == fabsf(fb[i]));
+
+  double da[8], db[8], dr[8];
+  for (int i = 0; i < 8; i++) {
+    da[i] = i * 0.3 - 1.0;
+    db[i] = 2.5 - i * 0.7;
+  }
+  wcn_v512d_store(dr, wcn_v512d_fmadd(wcn_v512d_load(da), wcn_v512d_load(db),
+                                      wcn_v512d_set1(1.0)));
+  for (int i = 0; i < 8; i++) CHECK(dr[i] == fma(da[i], db[i], 1.0));
+  wcn_v512d_store(dr, wcn_v512d_div(wcn_v512d_load(da), wcn_v512d_load(db)));
+  for (int i = 0; i < 8; i++) CHECK(dr[i] == da[i] / db[i]);
+
+  printf("✓ Arithmetic operations work correctly\n");
+}
+
+/* Test shifts */
+static void test_shifts(void) {
+  printf("Testing shifts...\n");
+
+  int32_t a[16], cnt[16], r[16];
+  fill_i32(a, 16, 1 << 20);
+  for (int i = 0; i < 16; i++) cnt[i] = i * 2;
+  wcn_v512i_t va = wcn_v512i_load(a);
+
+  for (unsigned s = 0; s < 32; s += 7) {
+    wcn_v512i_store(r, wcn_v512i_slli_i32(va, s));
+    for (int i = 0; i < 16; i++) CHECK(r[i] == (int32_t)((uint32_t)a[i] << s));
+    wcn_v512i_store(r, wcn_v512i_srli_i32(va, s));
+    for (int i = 0; i < 16; i++) CHECK(r[i] == (int32_t)((uint32_t)a[i] >> s));
+    wcn_v512i_store(r, wcn_v512i_srai_i32(va, s));
+    for (int i = 0; i < 16; i++) CHECK(r[i] == (a[i] >> s));
+    wcn_v512i_store(r, wcn_v512i_sll_i32(va, wcn_v128i_set1_i64((int64_t)s)));
+    for (int i = 0; i < 16; i++) CHECK(r[i] == (int32_t)((uint32_t)a[i] << s));
+  }
+
+  wcn_v512i_t vc = wcn_v512i_load(cnt);
+  wcn_v512i_store(r, wcn_v512i_sllv_i32(va, vc));
+  for (int i = 0; i < 16; i++)
+    CHECK(r[i] == (int32_t)((uint32_t)a[i] << cnt[i]));
+  wcn_v512i_store(r, wcn_v512i_srav_i32(va, vc));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == (a[i] >> cnt[i]));
+
+  int64_t l[8], lr[8];
+  for (int i = 0; i < 8; i++) l[i] = ((int64_t)a[i] << 24) - 12345;
+  wcn_v512i_store(lr, wcn_v512i_srai_i64(wcn_v512i_load(l), 13));
+  for (int i = 0; i < 8; i++) CHECK(lr[i] == (l[i] >> 13));
+
+  int16_t h[32], hr[32];
+  for (int i = 0; i < 32; i++) h[i] = (int16_t)(i * 1031 - 16000);
+  wcn_v512i_store(hr, wcn_v512i_srai_i16(wcn_v512i_load(h), 3));
+  for (int i = 0; i < 32; i++) CHECK(hr[i] == (h[i] >> 3));
+
+  printf("✓ Shift operations work correctly\n");
+}
+
+/* Test comparisons, min/max and blends */
+static void test_compare_minmax(void) {
+  printf("Testing comparisons and min/max...\n");
+
+  int32_t a[16], b[16], r[16];
+  fill_i32(a, 16, 1);
+  fill_i32(b, 16, -1);
+  b[3] = a[3];
+  wcn_v512i_t va = wcn_v512i_load(a), vb = wcn_v512i_load(b);
+
+  uint16_t eq = 0, gt = 0, ltu = 0;
+  for (int i = 0; i < 16; i++) {
+    eq |= (uint16_t)((a[i] == b[i]) << i);
+    gt |= (uint16_t)((a[i] > b[i]) << i);
+    ltu |= (uint16_t)(((uint32_t)a[i] < (uint32_t)b[i]) << i);
+  }
+  const uint16_t ne = (uint16_t)~eq;
+  CHECK(wcn_v512i_cmpeq_i32_mask(va, vb) == eq);
+  CHECK(wcn_v512i_cmpneq_i32_mask(va, vb) == ne);
+  CHECK(wcn_v512i_cmpgt_i32_mask(va, vb) == gt);
+  CHECK(wcn_v512i_cmplt_i32_mask(vb, va) == gt);
+  CHECK(wcn_v512i_cmplt_u32_mask(va, vb) == ltu);
+
+  wcn_v512i_store(r, wcn_v512i_max_i32(va, vb));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == (a[i] > b[i] ? a[i] : b[i]));
+  wcn_v512i_store(r, wcn_v512i_min_u32(va, vb));
+  for (int i = 0; i < 16; i++) {
+    CHECK((uint32_t)r[i] ==
+          ((uint32_t)a[i] < (uint32_t)b[i] ? (uint32_t)a[i] : (uint32_t)b[i]));
+  }
+  wcn_v512i_store(r, wcn_v512i_mask_blend(gt, vb, va));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == (a[i] > b[i] ? a[i] : b[i]));
+
+  uint8_t u8a[64], u8b[64], u8r[64];
+  for (int i = 0; i < 64; i++) {
+    u8a[i] = (uint8_t)(i * 7);
+    u8b[i] = (uint8_t)(255 - i * 3);
+  }
+  wcn_v512i_store(u8r,
+                  wcn_v512i_max_u8(wcn_v512i_load(u8a), wcn_v512i_load(u8b)));
+  for (int i = 0; i < 64; i++)
+    CHECK(u8r[i] == (u8a[i] > u8b[i] ? u8a[i] : u8b[i]));
+
+  float f[16], g[16];
+  fill_f32(f, 16, 0.5f, 0.0f);
+  fill_f32(g, 16, -0.5f, 0.25f);
+  g[5] = f[5];
+  g[9] = NAN;
+  wcn_v512f_t vf = wcn_v512f_load(f), vg = wcn_v512f_load(g);
+  uint16_t flt = 0, fle = 0, fneg = 0;
+  for (int i = 0; i < 16; i++) {
+    flt |= (uint16_t)((f[i] < g[i]) << i);
+    fle |= (uint16_t)((f[i] <= g[i]) << i);
+    fneg |= (uint16_t)((signbit(f[i]) != 0) << i);
+  }
+  CHECK(wcn_v512f_cmplt_mask(vf, vg) == flt);
+  CHECK(wcn_v512f_cmple_mask(vf, vg) == fle);
+  CHECK(wcn_v512f_cmpunord_mask(vf, vg) == (1u << 9));
+  CHECK(wcn_v512f_movemask(vf) == fneg);
+
+  printf("✓ Comparison and min/max operations work correctly\n");
+}
+
+/* Test pack/unpack, permutes and conversions */
+static void test_permute_convert(void) {
+  printf("Testing pack/unpack, permutes and conversions...\n");
+
+  int32_t a[16], b[16], idx[16], r[16];
+  for (int i = 0; i < 16; i++) {
+    a[i] = i * 10000 - 70000;
+    b[i] = 100 + i;
+    idx[i] = (i * 5 + 3) & 15;
+  }
+  wcn_v512i_t va = wcn_v512i_load(a), vb = wcn_v512i_load(b);
+
+  wcn_v512i_store(r, wcn_v512i_permutexvar(wcn_v512i_load(idx), va));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == a[idx[i]]);
+
+  for (int i = 0; i < 16; i++) idx[i] = (i * 7) & 31;
+  wcn_v512i_store(r, wcn_v512i_permutex2var(va, wcn_v512i_load(idx), vb));
+  for (int i = 0; i < 16; i++)
+    CHECK(r[i] == (idx[i] < 16 ? a[idx[i]] : b[idx[i] - 16]));
+
+  /* Unpack/pack operate per 128-bit lane */
+  wcn_v512i_store(r, wcn_v512i_unpacklo_i32(va, vb));
+  for (int lane = 0; lane < 4; lane++) {
+    for (int k = 0; k < 2; k++) {
+      CHECK(r[lane * 4 + 2 * k] == a[lane * 4 + k]);
+      CHECK(r[lane * 4 + 2 * k + 1] == b[lane * 4 + k]);
+    }
+  }
+
+  int16_t p[32];
+  wcn_v512i_store(p, wcn_v512i_packs_i32(va, vb));
+  for (int lane = 0; lane < 4; lane++) {
+    for (int k = 0; k < 4; k++) {
+      int32_t x = a[lane * 4 + k];
+      CHECK(p[lane * 8 + k] == (x > 32767 ? 32767 : x < -32768 ? -32768 : x));
+      CHECK(p[lane * 8 + 4 + k] == b[lane * 4 + k]);
+    }
+  }
+
+  int8_t n8[16];
+  wcn_v128i_store(n8, wcn_v512i_cvts_i32_i8(va));
+  for (int i = 0; i < 16; i++)
+    CHECK(n8[i] == (a[i] > 127 ? 127 : a[i] < -128 ? -128 : a[i]));
+  wcn_v512i_store(r, wcn_v512i_cvt_i8_i32(wcn_v128i_load(n8)));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == n8[i]);
+
+  float f[16], fr[16];
+  fill_f32(f, 16, 1.3f, 0.5f);
+  f[0] = 2.5f;
+  f[1] = -2.5f;
+  wcn_v512f_t vf = wcn_v512f_load(f);
+  wcn_v512i_store(r, wcn_v512f_to_v512i(vf));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == (int32_t)nearbyintf(f[i]));
+  wcn_v512i_store(r, wcn_v512f_to_v512i_trunc(vf));
+  for (int i = 0; i < 16; i++) CHECK(r[i] == (int32_t)f[i]);
+  wcn_v512f_store(fr, wcn_v512f_floor(vf));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == floorf(f[i]));
+  wcn_v512f_store(fr, wcn_v512f_ceil(vf));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == ceilf(f[i]));
+  wcn_v512f_store(fr, wcn_v512f_round_nearest(vf));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == nearbyintf(f[i]));
+
+  double d[8];
+  wcn_v512d_store(d, wcn_v512f_to_v512d_hi(vf));
+  for (int i = 0; i < 8; i++) CHECK(d[i] == (double)f[8 + i]);
+  wcn_v256f_store(fr, wcn_v512d_to_v256f(wcn_v512f_to_v512d_lo(vf)));
+  for (int i = 0; i < 8; i++) CHECK(fr[i] == f[i]);
+
+  printf("✓ Permute and conversion operations work correctly\n");
+}
+
+/* Test reductions, masked arithmetic, compress/expand and gather */
+static void test_reduce_mask(void) {
+  printf("Testing reductions and masked operations...\n");
+
+  float f[16], g[16], fr[16];
+  fill_f32(f, 16, 0.5f, 0.125f);
+  fill_f32(g, 16, 2.0f, -1.0f);
+  wcn_v512f_t vf = wcn_v512f_load(f), vg = wcn_v512f_load(g);
+
+  float sum = 0.0f, mx = f[0], mn = f[0], msum = 0.0f;
+  const uint16_t m = 0x5A3C;
+  for (int i = 0; i < 16; i++) {
+    sum += f[i];
+    mx = f[i] > mx ? f[i] : mx;
+    mn = f[i] < mn ? f[i] : mn;
+    if (m & (1u << i)) msum += f[i];
+  }
+  CHECK(fabsf(wcn_v512f_reduce_add(vf) - sum) < 1e-4f);
+  CHECK(wcn_v512f_reduce_max(vf) == mx);
+  CHECK(wcn_v512f_reduce_min(vf) == mn);
+  CHECK(fabsf(wcn_v512f_mask_reduce_add(m, vf) - msum) < 1e-4f);
+
+  double d[8];
+  double dsum = 0.0;
+  for (int i = 0; i < 8; i++) {
+    d[i] = i * 1.5 - 2.0;
+    dsum += d[i];
+  }
+  CHECK(wcn_v512d_reduce_add(wcn_v512d_load(d)) == dsum);
+  CHECK(wcn_v512d_reduce_max(wcn_v512d_load(d)) == d[7]);
+
+  int32_t a[16];
+  int32_t isum = 0;
+  fill_i32(a, 16, 11);
+  for (int i = 0; i < 16; i++) isum += a[i];
+  CHECK(wcn_v512i_reduce_add_i32(wcn_v512i_load(a)) == isum);
+
+  wcn_v512f_store(fr, wcn_v512f_mask_add(vg, m, vf, vg));
+  for (int i = 0; i < 16; i++)
+    CHECK(fr[i] == ((m >> i) & 1 ? f[i] + g[i] : g[i]));
+  wcn_v512f_store(fr, wcn_v512f_maskz_mul(m, vf, vg));
+  for (int i = 0; i < 16; i++)
+    CHECK(fr[i] == ((m >> i) & 1 ? f[i] * g[i] : 0.0f));
+  wcn_v512f_store(fr, wcn_v512f_mask_fmadd(vf, m, vg, vg));
+  for (int i = 0; i < 16; i++) {
+    CHECK(fr[i] == ((m >> i) & 1 ? fmaf(f[i], g[i], g[i]) : f[i]));
+  }
+
+  float packed[16];
+  for (int i = 0; i < 16; i++) packed[i] = -99.0f;
+  wcn_v512f_mask_compressstore(packed, m, vf);
+  int k = 0;
+  for (int i = 0; i < 16; i++) {
+    if (m & (1u << i)) CHECK(packed[k++] == f[i]);
+  }
+  CHECK(packed[k] == -99.0f);
+  wcn_v512f_store(fr, wcn_v512f_maskz_expand(m, wcn_v512f_load(packed)));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == ((m >> i) & 1 ? f[i] : 0.0f));
+
+  float table[64];
+  int32_t gidx[16];
+  for (int i = 0; i < 64; i++) table[i] = i * 0.5f;
+  for (int i = 0; i < 16; i++) gidx[i] = (i * 13) & 63;
+  wcn_v512f_store(fr, wcn_v512f_gather(table, wcn_v512i_load(gidx), 4));
+  for (int i = 0; i < 16; i++) CHECK(fr[i] == table[gidx[i]]);
+
+  printf("✓ Reduction and masked operations work correctly\n");
+}
+
+int main(void) {
+  printf("=== WCN_SIMD AVX-512 Backend Test ===\n");
+  printf("WCN_SIMD Version: %s\n", wcn_simd_get_version());
+  printf("Implementation: %s\n", wcn_simd_get_impl());
+  printf("Vector Width: %d bits\n\n", wcn_simd_get_vector_width());
+
+  wcn_simd_init();
+  const wcn_simd_features_t *features = wcn_simd_get_features();
+  if (!features->has_avx512f || !features->has_avx512bw ||
+      !features->has_avx512dq || !features->has_avx512vl) {
+    printf("AVX-512F/BW/DQ/VL not available on this CPU, skipping\n");
+    return 0;
+  }
+
+  test_load_store();
+  test_arithmetic();
+  test_shifts();
+  test_compare_minmax();
+  test_permute_convert();
+  test_reduce_mask();
+
+  if (g_failures != 0) {
+    printf("\n=== %d AVX-512 check(s) FAILED ===\n", g_failures);
+    return 1;
+  }
+  printf("\n=== All AVX-512 Tests Passed! ===\n");
+  return 0;
+}
+
+#else
+
+int main(void) {
+  printf("=== WCN_SIMD AVX-512 Backend Test ===\n");
+  printf("Built without AVX-512F/BW/DQ code generation, skipping\n");
+  (void)g_failures;
+  return 0;
+}
+
+#endif
@@ -1,6 +1,8 @@
+#define _POSIX_C_SOURCE 200112L
 #include <WCN_SIMD.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #ifdef _WIN32
@@ -41,6 +43,7 @@ void print_features(void) {
   printf("=== WCN_SIMD Library Information ===\n");
   printf("Version: %s\n", wcn_simd_get_version());
   printf("Implementation: %s\n", wcn_simd_get_impl());
+  printf("Array kernels: %s\n", wcn_simd_get_kernel_impl());
   printf("Vector Width: %d bits\n\n", wcn_simd_get_vector_width());
 
   printf("=== Detected SIMD Features ===\n");
@@ -54,7 +57,12 @@ void print_features(void) {
   printf("  AVX:        %s\n", features->has_avx ? "Yes" : "No");
   printf("  AVX2:       %s\n", features->has_avx2 ? "Yes" : "No");
   printf("  AVX-512F:   %s\n", features->has_avx512f ? "Yes" : "No");
-  printf("  FMA:        %s\n\n", features->has_fma ? "Yes" : "No");
+  printf("  FMA:        %s\n", features->has_fma ? "Yes" : "No");
+  printf("  F16C:       %s\n", features->has_f16c ? "Yes" : "No");
+  printf("  VNNI:       %s\n\n",
+         features->has_avx512vnni ? "AVX-512"
+         : features->has_avxvnni  ? "AVX"
+                                  : "No");
 
   printf("ARM SIMD:\n");
   printf("  NEON:       %s\n", features->has_neon ? "Yes" : "No");
@@ -75,6 +83,23 @@ void print_features(void) {
   printf("Other:\n");
   printf("  MIPS MSA:   %s\n", features->has_msa ? "Yes" : "No");
   printf("  WASM SIMD:  %s\n\n", features->has_wasm_simd128 ? "Yes" : "No");
+
+  wcn_simd_tuning_t tuning;
+  wcn_simd_get_tuning(&tuning);
+  printf("=== Cache Topology ===\n");
+  printf("  L1d:        %zu KiB\n", features->l1d_cache_size >> 10);
+  printf("  L2:         %zu KiB (%d CPUs)\n", features->l2_cache_size >> 10,
+         features->l2_shared_cpus);
+  printf("  L3:         %zu KiB (%d CPUs)\n", features->l3_cache_size >> 10,
+         features->l3_shared_cpus);
+  printf("  Line:       %d bytes\n", features->cache_line_size);
+  printf("  Cores:      %d (%d threads)\n", features->cpu_cores,
+         features->cpu_threads);
+  printf("  Streaming stores from %zu KiB, prefetch %zu bytes ahead\n",
+         tuning.stream_threshold >> 10, tuning.prefetch_distance);
+  printf("  SGEMM packing budgets %zu / %zu / %zu KiB\n\n",
+         tuning.gemm_l1_bytes >> 10, tuning.gemm_l2_bytes >> 10,
+         tuning.gemm_l3_bytes >> 10);
 }
 
 void benchmark_dot_product(void) {
@@ -218,6 +243,291 @@ void benchmark_vector_add(void) {
   aligned_free(c);
 }
 
+/* GB/s of wcn_simd_memcpy_aligned / memset_aligned against the C library
+ * for sizes from L1-resident to well past the last-level cache. The wcn
+ * calls run twice, with the stream threshold at SIZE_MAX (cached stores
+ * only) and at 0 (non-temporal stores at every size), so the crossover is
+ * visible whatever threshold this host derived. The destination is offset
+ * by one byte so that neither side gets an aligned buffer for free. */
+void benchmark_memory(void) {
+  static const size_t sizes[] = {16,        100,       1024,    16 << 10,
+                                 256 << 10, 2u << 20,  8u << 20, 64u << 20};
+  const size_t max_bytes = 64u << 20;
+  unsigned char *src = (unsigned char *)malloc(max_bytes + 64);
+  unsigned char *dst = (unsigned char *)malloc(max_bytes + 64);
+  if (!src || !dst) {
+    free(src);
+    free(dst);
+    return;
+  }
+  memset(src, 0x5A, max_bytes + 64);
+  memset(dst, 0, max_bytes + 64);
+
+  /* Called through volatile pointers so the compiler cannot inline, merge
+   * or drop the repeated library calls */
+  void *(*volatile libc_memcpy)(void *, const void *, size_t) = memcpy;
+  void *(*volatile libc_memset)(void *, int, size_t) = memset;
+
+  wcn_simd_tuning_t saved;
+  wcn_simd_get_tuning(&saved);
+
+  printf("=== Memory Copy/Fill Benchmark (GB/s) ===\n");
+  printf("%10s %9s %9s %9s %9s %9s %9s\n", "bytes", "wcn cpy", "wcn nt",
+         "libc cpy", "wcn set", "wcn nt", "libc set");
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const size_t n = sizes[s];
+    /* ~256 MiB of traffic per measurement */
+    const size_t reps = ((size_t)256 << 20) / n;
+    double gbs[6];
+    for (int k = 0; k < 6; k++) {
+      /* Columns 1 and 4 force the non-temporal path */
+      wcn_simd_set_stream_threshold(k == 1 || k == 4 ? 0 : SIZE_MAX);
+      double start = 0.0;
+      /* repetition 0 is a warm-up */
+      for (size_t r = 0; r <= reps; r++) {
+        if (r == 1) {
+          start = now_seconds();
+        }
+        switch (k) {
+        case 0:
+        case 1:
+          wcn_simd_memcpy_aligned(dst + 1, src, n);
+          break;
+        case 2:
+          libc_memcpy(dst + 1, src, n);
+          break;
+        case 3:
+        case 4:
+          wcn_simd_memset_aligned(dst + 1, (int)r, n);
+          break;
+        default:
+          libc_memset(dst + 1, (int)r, n);
+          break;
+        }
+      }
+      const double t = now_seconds() - start;
+      gbs[k] = t > 0.0 ? (double)n * (double)reps / t * 1e-9 : 0.0;
+    }
+    printf("%10zu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", n, gbs[0], gbs[1],
+           gbs[2], gbs[3], gbs[4], gbs[5]);
+  }
+  printf("(stream threshold on this host: %zu KiB)\n\n",
+         saved.stream_threshold >> 10);
+  wcn_simd_set_tuning(&saved);
+  free(src);
+  free(dst);
+}
+
+/* Largest count of the size sweep: three vectors of bytes on AVX-512 */
+#define SWEEP_MAX 192
+#define SWEEP_GUARD (-99)
+
+static int8_t sat_i8(int v) {
+  return (int8_t)(v < -128 ? -128 : v > 127 ? 127 : v);
+}
+
+static uint8_t sat_u8(int v) {
+  return (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+static int16_t sat_i16(int v) {
+  return (int16_t)(v < -32768 ? -32768 : v > 32767 ? 32767 : v);
+}
+
+/* Every count from 0 to SWEEP_MAX, with inputs starting 0-3 elements and
+ * outputs 3-0 elements past an aligned address (and some calls in place),
+ * on the active kernel table against scalar loops. The values are small
+ * integers, so every summation order gives the exact result. Returns the
+ * mismatches, counting writes past the end. */
+static unsigned sweep_sizes(void) {
+  static WCN_ALIGN(64) float fa[SWEEP_MAX + 4], fb[SWEEP_MAX + 4],
+      fc[SWEEP_MAX + 4];
+  static WCN_ALIGN(64) double da[SWEEP_MAX + 4], db[SWEEP_MAX + 4],
+      dc[SWEEP_MAX + 4];
+  static WCN_ALIGN(64) int8_t ia[SWEEP_MAX + 4], ib[SWEEP_MAX + 4],
+      ic[SWEEP_MAX + 4];
+  static WCN_ALIGN(64) uint8_t ua[SWEEP_MAX + 4], ub[SWEEP_MAX + 4],
+      uc[SWEEP_MAX + 4];
+  static WCN_ALIGN(64) int16_t sa[SWEEP_MAX + 4], sb[SWEEP_MAX + 4],
+      sc[SWEEP_MAX + 4];
+  static WCN_ALIGN(64) int32_t wa[SWEEP_MAX + 4];
+  for (int i = 0; i < SWEEP_MAX + 4; i++) {
+    fa[i] = (float)(i % 13 - 6);
+    fb[i] = (float)(i % 7 - 3);
+    da[i] = fa[i];
+    db[i] = fb[i];
+    ia[i] = (int8_t)(i * 37 % 256 - 128);
+    ib[i] = (int8_t)(i * 91 % 256 - 128);
+    ua[i] = (uint8_t)(i * 37 % 256);
+    ub[i] = (uint8_t)(i * 91 % 256);
+    sa[i] = (int16_t)(i * 9973 % 65536 - 32768);
+    sb[i] = (int16_t)(i * 7919 % 65536 - 32768);
+    wa[i] = i * 7919 % 2001 - 1000;
+  }
+
+  unsigned bad = 0;
+  for (size_t n = 0; n <= SWEEP_MAX; n++) {
+    for (size_t off = 0; off < 4; off++) {
+      const float *x = fa + off, *y = fb + off;
+      float *z = fc + 3 - off;
+      const double *dx = da + off, *dy = db + off;
+      double *dz = dc + 3 - off;
+      size_t i;
+
+      /* Element-wise: each result, then the guard element after them */
+      z[n] = SWEEP_GUARD;
+      wcn_simd_add_array_f32(x, y, z, n);
+      for (i = 0; i < n; i++) {
+        bad += z[i] != x[i] + y[i];
+      }
+      wcn_simd_mul_array_f32(x, y, z, n);
+      for (i = 0; i < n; i++) {
+        bad += z[i] != x[i] * y[i];
+      }
+      for (i = 0; i < n; i++) {
+        z[i] = (float)(i % 5);
+      }
+      wcn_simd_fmadd_array_f32(x, y, z, n);
+      for (i = 0; i < n; i++) {
+        bad += z[i] != x[i] * y[i] + (float)(i % 5);
+      }
+      bad += z[n] != SWEEP_GUARD;
+
+      dz[n] = SWEEP_GUARD;
+      wcn_simd_add_array_f64(dx, dy, dz, n);
+      for (i = 0; i < n; i++) {
+        bad += dz[i] != dx[i] + dy[i];
+      }
+      wcn_simd_mul_array_f64(dx, dy, dz, n);
+      for (i = 0; i < n; i++) {
+        bad += dz[i] != dx[i] * dy[i];
+      }
+      for (i = 0; i < n; i++) {
+        dz[i] = (double)(i % 5);
+      }
+      wcn_simd_fmadd_array_f64(dx, dy, dz, n);
+      for (i = 0; i < n; i++) {
+        bad += dz[i] != dx[i] * dy[i] + (double)(i % 5);
+      }
+      bad += dz[n] != SWEEP_GUARD;
+
+      ic[3 - off + n] = SWEEP_GUARD;
+      uc[3 - off + n] = 0xA5;
+      sc[3 - off + n] = SWEEP_GUARD;
+      wcn_simd_adds_array_i8(ia + off, ib + off, ic + 3 - off, n);
+      for (i = 0; i < n; i++) {
+        bad += ic[3 - off + i] != sat_i8(ia[off + i] + ib[off + i]);
+      }
+      wcn_simd_subs_array_u8(ua + off, ub + off, uc + 3 - off, n);
+      for (i = 0; i < n; i++) {
+        bad += uc[3 - off + i] != sat_u8(ua[off + i] - ub[off + i]);
+      }
+      wcn_simd_adds_array_i16(sa + off, sb + off, sc + 3 - off, n);
+      for (i = 0; i < n; i++) {
+        bad += sc[3 - off + i] != sat_i16(sa[off + i] + sb[off + i]);
+      }
+      bad += ic[3 - off + n] != SWEEP_GUARD;
+      bad += uc[3 - off + n] != 0xA5;
+      bad += sc[3 - off + n] != SWEEP_GUARD;
+
+      /* In place (c == a): the output overwrites the first input */
+      for (i = 0; i < n; i++) {
+        ic[3 - off + i] = ia[off + i];
+        z[i] = x[i];
+      }
+      wcn_simd_adds_array_i8(ic + 3 - off, ib + off, ic + 3 - off, n);
+      wcn_simd_add_array_f32(z, y, z, n);
+      for (i = 0; i < n; i++) {
+        bad += ic[3 - off + i] != sat_i8(ia[off + i] + ib[off + i]);
+        bad += z[i] != x[i] + y[i];
+      }
+      bad += ic[3 - off + n] != SWEEP_GUARD;
+      bad += z[n] != SWEEP_GUARD;
+
+      /* Reductions (float min/max are unspecified for n == 0) */
+      double sum = 0.0, dot = 0.0;
+      double mx = n > 0 ? x[0] : 0.0, mn = mx;
+      long long isum = 0;
+      int imx = n > 0 ? sa[off] : 0, imn = imx;
+      for (i = 0; i < n; i++) {
+        sum += x[i];
+        dot += x[i] * y[i];
+        mx = x[i] > mx ? x[i] : mx;
+        mn = x[i] < mn ? x[i] : mn;
+        isum += wa[off + i];
+        imx = sa[off + i] > imx ? sa[off + i] : imx;
+        imn = sa[off + i] < imn ? sa[off + i] : imn;
+      }
+      bad += wcn_simd_reduce_sum_f32(x, n) != (float)sum;
+      bad += wcn_simd_dot_product_f32(x, y, n) != (float)dot;
+      bad += wcn_simd_reduce_sum_f64(dx, n) != sum;
+      bad += wcn_simd_dot_product_f64(dx, dy, n) != dot;
+      if (n > 0) {
+        bad += wcn_simd_reduce_max_f32(x, n) != (float)mx;
+        bad += wcn_simd_reduce_min_f32(x, n) != (float)mn;
+        bad += wcn_simd_reduce_max_f64(dx, n) != mx;
+        bad += wcn_simd_reduce_min_f64(dx, n) != mn;
+      }
+      bad += wcn_simd_reduce_sum_i32(wa + off, n) != isum;
+      bad += wcn_simd_reduce_max_i16(sa + off, n) != imx;
+      bad += wcn_simd_reduce_min_i16(sa + off, n) != imn;
+    }
+  }
+  return bad;
+}
+
+/* memcpy/memset sizes: every count up to MEM_SWEEP_SMALL (past two
+ * AVX-512 vectors), then the 64 bytes either side of MEM_SWEEP_THRESHOLD,
+ * which the sweep sets as the stream threshold */
+#define MEM_SWEEP_SMALL 320
+#define MEM_SWEEP_THRESHOLD 4096
+#define MEM_SWEEP_MAX (MEM_SWEEP_THRESHOLD + 64)
+
+/* wcn_simd_memcpy_aligned / memset_aligned against the C library at the
+ * sizes above, with source and destination 0, 1, 3 or 63 bytes past an
+ * aligned address, with streaming off, on for every size and switched on
+ * at MEM_SWEEP_THRESHOLD. The whole destination buffer is compared, so
+ * writes before or after the block count too. Returns the mismatches. */
+static unsigned sweep_memory(void) {
+  static WCN_ALIGN(64) unsigned char src[MEM_SWEEP_MAX + 128],
+      dst[MEM_SWEEP_MAX + 128], ref[MEM_SWEEP_MAX + 128];
+  static const size_t offsets[] = {0, 1, 3, 63};
+  const size_t thresholds[] = {SIZE_MAX, 1, MEM_SWEEP_THRESHOLD};
+  const size_t n_offsets = sizeof(offsets) / sizeof(offsets[0]);
+  unsigned bad = 0;
+
+  wcn_simd_tuning_t saved;
+  wcn_simd_get_tuning(&saved);
+  for (size_t i = 0; i < sizeof(src); i++) {
+    src[i] = (unsigned char)(i * 7 + 1);
+  }
+  for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); t++) {
+    wcn_simd_set_stream_threshold(thresholds[t]);
+    for (size_t n = 0; n <= MEM_SWEEP_MAX; n++) {
+      if (n > MEM_SWEEP_SMALL && n < MEM_SWEEP_THRESHOLD - 64) {
+        n = MEM_SWEEP_THRESHOLD - 64;
+      }
+      for (size_t so = 0; so < n_offsets; so++) {
+        for (size_t d = 0; d < n_offsets; d++) {
+          unsigned char *out = dst + offsets[d];
+          memset(dst, 0xEE, sizeof(dst));
+          memset(ref, 0xEE, sizeof(ref));
+          wcn_simd_memcpy_aligned(out, src + offsets[so], n);
+          memcpy(ref + offsets[d], src + offsets[so], n);
+          bad += memcmp(dst, ref, sizeof(dst)) != 0;
+
+          /* The fill value carries high bits that must be dropped */
+          wcn_simd_memset_aligned(out, (int)(n + 0x300), n);
+          memset(ref + offsets[d], (int)(n + 0x300), n);
+          bad += memcmp(dst, ref, sizeof(dst)) != 0;
+        }
+      }
+    }
+  }
+  wcn_simd_set_tuning(&saved);
+  return bad;
+}
+
 void test_basic_operations(void) {
   printf("=== Basic Operations Test ===\n");
 
@@ -257,7 +567,140 @@ void test_basic_operations(void) {
   float max = wcn_simd_reduce_max_f32(a, 8);
   float min = wcn_simd_reduce_min_f32(a, 8);
   float sum = wcn_simd_reduce_sum_f32(a, 8);
-  printf("Max: %.1f, Min: %.1f, Sum: %.1f\n\n", max, min, sum);
+  printf("Max: %.1f, Min: %.1f, Sum: %.1f\n", max, min, sum);
+
+  /* Test double-precision variants */
+  double da[8], db[8];
+  for (int i = 0; i < 8; i++) {
+    da[i] = a[i];
+    db[i] = b[i];
+  }
+  printf("Dot product (f64): %.2f, Sum (f64): %.1f\n",
+         wcn_simd_dot_product_f64(da, db, 8), wcn_simd_reduce_sum_f64(da, 8));
+
+  /* Test 16-bit storage: small integers are exact in f16 and bf16 */
+  wcn_f16_t ha[8], hb[8];
+  wcn_bf16_t ba[8];
+  wcn_simd_f32_to_f16(a, ha, 8);
+  wcn_simd_f32_to_f16(b, hb, 8);
+  wcn_simd_f32_to_bf16(a, ba, 8);
+  printf("Dot product (f16): %.2f, Sum (bf16): %.1f (expected: 120.00, "
+         "36.0)\n",
+         wcn_simd_dot_product_f16(ha, hb, 8), wcn_simd_reduce_sum_bf16(ba, 8));
+
+  /* A signaling NaN with a payload converts to the same quiet f16 NaN on
+   * every kernel table and in the scalar conversion */
+  const float snan = wcn_f32_from_bits(0x7F9A2000u);
+  wcn_f16_t hnan;
+  wcn_simd_f32_to_f16(&snan, &hnan, 1);
+  printf("f16 NaN payload: 0x%04X, scalar 0x%04X (expected: 0x7ED1)\n",
+         (unsigned)hnan, (unsigned)wcn_float_to_f16(snan));
+
+  /* Test quantized u8 x i8: 255 * -128 pairs would saturate a plain
+   * pmaddubsw; row 1 of w repeats -1..-8 */
+  uint8_t qa[40];
+  int8_t qw[2 * 40];
+  int32_t qy[2];
+  for (int i = 0; i < 40; i++) {
+    qa[i] = 255;
+    qw[i] = -128;
+    qw[40 + i] = (int8_t)-(i % 8 + 1);
+  }
+  wcn_simd_gemv_u8i8_i32(qw, qa, qy, 2, 40);
+  printf("Dot product (u8 x i8): %lld, GEMV: [%d, %d] (expected: -1305600, "
+         "-1305600, -45900)\n",
+         (long long)wcn_simd_dot_u8i8_i32(qa, qw, 40), (int)qy[0], (int)qy[1]);
+
+  /* Test SGEMM: a 2x3 matrix times a 3x2 one given transposed */
+  const float ga[6] = {1, 2, 3, 4, 5, 6};
+  const float gbt[6] = {7, 9, 11, 8, 10, 12};
+  float gc[4];
+  wcn_simd_sgemm(WCN_GEMM_NO_TRANS, WCN_GEMM_TRANS, 2, 2, 3, 1.0f, ga, 3, gbt,
+                 3, 0.0f, gc, 2);
+  printf("SGEMM: [%.0f, %.0f; %.0f, %.0f] (expected: [58, 64; 139, 154])\n",
+         gc[0], gc[1], gc[2], gc[3]);
+
+  /* Test transpose: the 2x3 matrix ga to 3x2 */
+  float gt[6];
+  wcn_simd_transpose_f32(ga, gt, 2, 3);
+  printf("Transpose: [%.0f, %.0f; %.0f, %.0f; %.0f, %.0f] (expected: [1, 4; "
+         "2, 5; 3, 6])\n",
+         gt[0], gt[1], gt[2], gt[3], gt[4], gt[5]);
+
+  /* Test FIR: a 3-tap moving sum of a, the second half through a filter
+   * that carries the first half's samples over */
+  const float box[3] = {1, 1, 1};
+  wcn_fir_f32_t *fir = wcn_fir_f32_create(box, 3);
+  if (fir != NULL) {
+    wcn_fir_f32_process(fir, a, c, 3);
+    wcn_fir_f32_process(fir, a + 3, c + 3, 5);
+    wcn_fir_f32_destroy(fir);
+    printf("FIR: [");
+    for (int i = 0; i < 8; i++) {
+      printf("%.0f%s", c[i], i < 7 ? ", " : "");
+    }
+    printf("] (expected: 1, 3, 6, 9, 12, 15, 18, 21)\n");
+  }
+
+  /* Test FFT: the real transform of a, and back (unscaled, so / 8) */
+  const wcn_fft_plan_t *fft = wcn_simd_fft_plan_r2c(8);
+  float spec[10];
+  if (wcn_simd_fft_r2c(fft, a, spec) == 0) {
+    printf("FFT: X0 = %.0f, X2 = %.0f%+.0fi, X4 = %.0f (expected: 36, -4+4i, "
+           "-4)\n",
+           spec[0], spec[4], spec[5], spec[8]);
+    wcn_simd_fft_c2r(fft, spec, c);
+    printf("FFT round trip: [");
+    for (int i = 0; i < 8; i++) {
+      printf("%.0f%s", c[i] / 8, i < 7 ? ", " : "");
+    }
+    printf("] (expected: 1 .. 8)\n");
+  }
+
+  /* Test edge handling: tails, prologues and masks at every small count */
+  printf("Size sweep (0..%d elements, misaligned, f32/f64/int): %u "
+         "mismatches (expected: 0)\n",
+         SWEEP_MAX, sweep_sizes());
+  printf("Memory sweep (memcpy/memset, 0..%d and %d+-64 bytes, misaligned, "
+         "cached and streaming): %u mismatches (expected: 0)\n",
+         MEM_SWEEP_SMALL, MEM_SWEEP_THRESHOLD, sweep_memory());
+
+  /* Test vector math: exp(log(a)) round-trips, in place */
+  wcn_simd_log_array_f32(a, c, 8, WCN_MATH_ACCURATE);
+  wcn_simd_exp_array_f32(c, c, 8, WCN_MATH_ACCURATE);
+  printf("exp(log(a)): [");
+  for (int i = 0; i < 8; i++) {
+    printf("%.4f%s", c[i], i < 7 ? ", " : "");
+  }
+  printf("] (expected: 1..8)\n");
+
+  /* Test softmax: the probabilities sum to 1 */
+  wcn_simd_softmax_f32(a, c, 8);
+  printf("Softmax: [");
+  for (int i = 0; i < 8; i++) {
+    printf("%.4f%s", c[i], i < 7 ? ", " : "");
+  }
+  printf("] sum %.4f, log-sum-exp %.4f (expected: 1.0000, 8.4583)\n",
+         wcn_simd_reduce_sum_f32(c, 8), wcn_simd_logsumexp_f32(a, 8));
+
+  /* Test fused expression: c = clamp(0.5 * (a + b) - a, -2, 2) */
+  wcn_expr_t *e = wcn_expr_create();
+  wcn_expr_node_t x = wcn_expr_input(e, 0);
+  wcn_expr_node_t y = wcn_expr_input(e, 1);
+  wcn_expr_node_t half_sum =
+      wcn_expr_mul(e, wcn_expr_const(e, 0.5F), wcn_expr_add(e, x, y));
+  wcn_expr_plan_t *plan =
+      wcn_expr_compile(e, wcn_expr_clamp(e, wcn_expr_sub(e, half_sum, x),
+                                         -2.0F, 2.0F));
+  wcn_expr_destroy(e);
+  const float *inputs[] = {a, b};
+  wcn_expr_eval(plan, inputs, c, 8);
+  wcn_expr_plan_destroy(plan);
+  printf("Fused expression: [");
+  for (int i = 0; i < 8; i++) {
+    printf("%.1f%s", c[i], i < 7 ? ", " : "");
+  }
+  printf("] (expected: 2.0, 2.0, 1.5, 0.5, -0.5, -1.5, -2.0, -2.0)\n\n");
 }
 
 int main(void) {
@@ -275,6 +718,7 @@ int main(void) {
   /* Run benchmarks */
   benchmark_dot_product();
   benchmark_vector_add();
+  benchmark_memory();
 
   printf("=== All tests completed successfully! ===\n");
 
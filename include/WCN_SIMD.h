@@ -62,12 +62,14 @@ extern "C" {
 #include "wcn_simd/platform/x86/wcn_x86_avx.h"
 #endif
 
-/* Temporarily disabled until AVX512F is tested */
-/*
 #if defined(WCN_X86_AVX512F)
-    #include "wcn_simd/platform/x86/wcn_x86_avx512f.h"
+#include "wcn_simd/platform/x86/wcn_x86_avx512f.h"
+#endif
+
+/* Hardware FMA: replaces the mul+add emulation of wcn_v128f/d_fmadd */
+#if defined(WCN_X86_FMA)
+#include "wcn_simd/platform/x86/wcn_x86_fma.h"
 #endif
-*/
 
 #if defined(WCN_ARM_NEON)
 #include "wcn_simd/platform/arm/wcn_arm_neon.h"
@@ -133,6 +135,36 @@ extern "C" {
 #include "wcn_simd/platform/wasm/wcn_wasm_simd128_atomic.h"
 #endif
 
+/* Fused element-wise expressions (wcn_expr_*) */
+#include "wcn_simd/wcn_expr.h"
+
+/* Work-stealing thread pool (wcn_pool_*) */
+#include "wcn_simd/wcn_pool.h"
+
+/* Aligned allocation, arenas and block pools (wcn_alloc_*, wcn_arena_*) */
+#include "wcn_simd/wcn_alloc.h"
+
+/* Per-kernel call and code path counters (wcn_simd_get_stats) */
+#include "wcn_simd/wcn_stats.h"
+
+/* exp/log/trig/tanh/erf/pow on vectors and arrays (wcn_math.h) */
+#include "wcn_simd/wcn_math.h"
+
+/* f16 / bf16 storage, conversion and mixed-precision kernels (wcn_f16.h) */
+#include "wcn_simd/wcn_f16.h"
+
+/* Cache-blocked single-precision matrix multiplication (wcn_gemm.h) */
+#include "wcn_simd/wcn_gemm.h"
+
+/* Register and whole-matrix transposes (wcn_transpose.h) */
+#include "wcn_simd/wcn_transpose.h"
+
+/* FIR filters, one-shot and streaming (wcn_fir.h) */
+#include "wcn_simd/wcn_fir.h"
+
+/* Complex and real FFTs with cached plans (wcn_fft.h) */
+#include "wcn_simd/wcn_fft.h"
+
 /* ========== Library Information ========== */
 
 #define WCN_SIMD_VERSION_MAJOR 1
@@ -164,6 +196,9 @@ typedef struct {
   int has_avx512dq;
   int has_avx512vl;
   int has_fma;
+  int has_f16c;
+  int has_avx512vnni;
+  int has_avxvnni;
 
   /* ARM features */
   int has_neon;
@@ -191,14 +226,78 @@ typedef struct {
   int has_atomic_operations;
   int has_gcc_atomic;
   int has_msvc_atomic;
+
+  /* Cache topology, from CPUID leaf 4 / 0x8000001D on x86 and from the OS
+   * (sysfs, GetLogicalProcessorInformation, sysctl); 0 where unknown.
+   * Sizes are in bytes and cover the whole cache, which l2/l3_shared_cpus
+   * logical CPUs share. */
+  size_t l1d_cache_size;
+  size_t l2_cache_size;
+  size_t l3_cache_size;
+  int l2_shared_cpus;
+  int l3_shared_cpus;
+  int cache_line_size;
+  int cpu_cores;   /* physical cores */
+  int cpu_threads; /* logical CPUs online */
 } wcn_simd_features_t;
 
+/* Cache-dependent parameters of the array kernels. wcn_simd_init() derives
+ * them from the cache topology above; wcn_simd_calibrate() measures them
+ * instead. */
+typedef struct {
+  /* Output size in bytes from which add_array_f32/f64, memcpy and memset
+   * write with non-temporal stores (x86): about one core's share of the
+   * last-level cache, and at least its L2. 1 streams every call and
+   * SIZE_MAX none (0, which wcn_simd_set_stream_threshold() takes for
+   * "always", reads back as 1) */
+  size_t stream_threshold;
+  /* How far ahead of the loads the f32 loops prefetch, in bytes */
+  size_t prefetch_distance;
+  /* Packed-operand budgets of wcn_simd_sgemm, in bytes: one micro-panel
+   * of B (sets the panel depth), a block of A and a panel of B. About half
+   * of one core's L1d, L2 and last-level cache share */
+  size_t gemm_l1_bytes;
+  size_t gemm_l2_bytes;
+  size_t gemm_l3_bytes;
+} wcn_simd_tuning_t;
+
 /* Initialize feature detection (call once at startup) */
 WCN_API_EXPORT void wcn_simd_init(void);
 
 /* Get detected SIMD features */
 WCN_API_EXPORT const wcn_simd_features_t *wcn_simd_get_features(void);
 
+/* Current kernel tuning */
+WCN_API_EXPORT void wcn_simd_get_tuning(wcn_simd_tuning_t *tuning);
+
+/* Replace the kernel tuning, e.g. with values saved from an earlier
+ * calibration; zero fields keep their current value, so streaming every
+ * call takes a stream_threshold of 1 here */
+WCN_API_EXPORT void wcn_simd_set_tuning(const wcn_simd_tuning_t *tuning);
+
+/* Time the kernels on this machine (a few hundred ms, up to ~200 MiB of
+ * scratch memory) and adopt the prefetch distance and streaming threshold
+ * that measured fastest. Returns 0, or -1 if the scratch memory could not
+ * be allocated. Do not call while array calls are running. */
+WCN_API_EXPORT int wcn_simd_calibrate(void);
+
+/* Get the name of the kernel set selected for the array algorithms below
+ * (e.g. "x86_avx512f" on an AVX-512 host, even in a portable build) */
+WCN_API_EXPORT const char *wcn_simd_get_kernel_impl(void);
+
+/* Threads used by large array calls, including the caller: 1 (the default)
+ * keeps everything on the calling thread, 0 means one per hardware thread.
+ * Reductions and softmax rows from the parallel threshold up are always cut
+ * into the same fixed chunks, on the calling thread when it is the only
+ * one, so their results do not depend on the thread count. This also
+ * sizes wcn_pool_default(). Do not change while array calls are running. */
+WCN_API_EXPORT void wcn_simd_set_max_threads(unsigned threads);
+WCN_API_EXPORT unsigned wcn_simd_get_max_threads(void);
+
+/* Element count from which array calls are split across threads (and
+ * reductions chunked, see above) */
+WCN_API_EXPORT void wcn_simd_set_parallel_threshold(size_t count);
+
 /* ========== Unified Platform-Agnostic SIMD Operations ========== */
 
 /* These macros provide a unified interface that automatically maps to the best
@@ -717,6 +816,16 @@ WCN_API_EXPORT float wcn_simd_dot_product_f32(const float *a, const float *b,
 WCN_API_EXPORT float
 wcn_simd_dot_product_kahan_f32(const float *a, const float *b, size_t count);
 
+/* Pairwise dot product and sum: the plain kernels run over fixed blocks
+ * whose sums are added in a balanced tree, so the rounding error grows
+ * with log2(count) instead of count. Within ~10% of the plain kernels'
+ * speed, where the Kahan dot product costs 2-4x. */
+WCN_API_EXPORT float wcn_simd_dot_product_pairwise_f32(const float *a,
+                                                       const float *b,
+                                                       size_t count);
+WCN_API_EXPORT float wcn_simd_reduce_sum_pairwise_f32(const float *data,
+                                                      size_t count);
+
 /* Vector addition: c[i] = a[i] + b[i] */
 WCN_API_EXPORT void wcn_simd_add_array_f32(const float *a, const float *b,
                                            float *c, size_t count);
@@ -742,12 +851,96 @@ WCN_API_EXPORT float wcn_simd_reduce_min_f32(const float *data, size_t count);
 /* Sum all elements in array */
 WCN_API_EXPORT float wcn_simd_reduce_sum_f32(const float *data, size_t count);
 
-/* Memory operations */
+/* Double-precision variants of the array algorithms above */
+WCN_API_EXPORT double wcn_simd_dot_product_f64(const double *a,
+                                               const double *b, size_t count);
+WCN_API_EXPORT void wcn_simd_add_array_f64(const double *a, const double *b,
+                                           double *c, size_t count);
+WCN_API_EXPORT void wcn_simd_mul_array_f64(const double *a, const double *b,
+                                           double *c, size_t count);
+WCN_API_EXPORT void wcn_simd_scale_array_f64(const double *a, double scalar,
+                                             double *b, size_t count);
+WCN_API_EXPORT void wcn_simd_fmadd_array_f64(const double *a, const double *b,
+                                             double *c, size_t count);
+WCN_API_EXPORT double wcn_simd_reduce_max_f64(const double *data,
+                                              size_t count);
+WCN_API_EXPORT double wcn_simd_reduce_min_f64(const double *data,
+                                              size_t count);
+WCN_API_EXPORT double wcn_simd_reduce_sum_f64(const double *data,
+                                              size_t count);
+
+/* Integer sums, widened so they cannot overflow */
+WCN_API_EXPORT int64_t wcn_simd_reduce_sum_i32(const int32_t *data,
+                                               size_t count);
+WCN_API_EXPORT int64_t wcn_simd_reduce_sum_i16(const int16_t *data,
+                                               size_t count);
+WCN_API_EXPORT uint64_t wcn_simd_reduce_sum_u8(const uint8_t *data,
+                                               size_t count);
+
+/* Integer min/max (0 for an empty array) */
+WCN_API_EXPORT int8_t wcn_simd_reduce_min_i8(const int8_t *data, size_t count);
+WCN_API_EXPORT int8_t wcn_simd_reduce_max_i8(const int8_t *data, size_t count);
+WCN_API_EXPORT uint8_t wcn_simd_reduce_min_u8(const uint8_t *data,
+                                              size_t count);
+WCN_API_EXPORT uint8_t wcn_simd_reduce_max_u8(const uint8_t *data,
+                                              size_t count);
+WCN_API_EXPORT int16_t wcn_simd_reduce_min_i16(const int16_t *data,
+                                               size_t count);
+WCN_API_EXPORT int16_t wcn_simd_reduce_max_i16(const int16_t *data,
+                                               size_t count);
+WCN_API_EXPORT int32_t wcn_simd_reduce_min_i32(const int32_t *data,
+                                               size_t count);
+WCN_API_EXPORT int32_t wcn_simd_reduce_max_i32(const int32_t *data,
+                                               size_t count);
+
+/* Saturating element-wise add/sub: c[i] = sat(a[i] +/- b[i]) */
+WCN_API_EXPORT void wcn_simd_adds_array_i8(const int8_t *a, const int8_t *b,
+                                           int8_t *c, size_t count);
+WCN_API_EXPORT void wcn_simd_subs_array_i8(const int8_t *a, const int8_t *b,
+                                           int8_t *c, size_t count);
+WCN_API_EXPORT void wcn_simd_adds_array_u8(const uint8_t *a, const uint8_t *b,
+                                           uint8_t *c, size_t count);
+WCN_API_EXPORT void wcn_simd_subs_array_u8(const uint8_t *a, const uint8_t *b,
+                                           uint8_t *c, size_t count);
+WCN_API_EXPORT void wcn_simd_adds_array_i16(const int16_t *a, const int16_t *b,
+                                            int16_t *c, size_t count);
+WCN_API_EXPORT void wcn_simd_subs_array_i16(const int16_t *a, const int16_t *b,
+                                            int16_t *c, size_t count);
+WCN_API_EXPORT void
+wcn_simd_adds_array_u16(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                        size_t count);
+WCN_API_EXPORT void
+wcn_simd_subs_array_u16(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                        size_t count);
+
+/* Quantized (u8 x i8) dot product, exact for any count: products are summed
+ * four to an i32 lane (pmaddubsw, VNNI vpdpbusd, ARM sdot/usdot, WASM dot)
+ * and the lanes are folded into 64 bits before they can overflow */
+WCN_API_EXPORT int64_t wcn_simd_dot_u8i8_i32(const uint8_t *a,
+                                             const int8_t *b, size_t count);
+
+/* Quantized GEMV: y[r] = sum_c w[r * cols + c] * x[c] for the row-major
+ * rows x cols matrix w, saturated to int32 (only reachable with more than
+ * 65793 columns) */
+WCN_API_EXPORT void wcn_simd_gemv_u8i8_i32(const int8_t *w, const uint8_t *x,
+                                           int32_t *y, size_t rows,
+                                           size_t cols);
+
+/* Memory operations. Any alignment works; the destination is aligned
+ * internally. Blocks of at least the stream threshold (see
+ * wcn_simd_tuning_t) are written with non-temporal stores where the ISA
+ * has them, which keeps them from evicting the rest of the last-level
+ * cache. The buffers must not overlap. */
 WCN_API_EXPORT void wcn_simd_memcpy_aligned(void *dest, const void *src,
                                             size_t bytes);
 WCN_API_EXPORT void wcn_simd_memset_aligned(void *dest, int value,
                                             size_t bytes);
 
+/* Size from which the two calls above and add_array_f32/f64 bypass the
+ * cache (0: always, SIZE_MAX: never); sets
+ * wcn_simd_tuning_t.stream_threshold */
+WCN_API_EXPORT void wcn_simd_set_stream_threshold(size_t bytes);
+
 #ifdef __cplusplus
 }
 #endif
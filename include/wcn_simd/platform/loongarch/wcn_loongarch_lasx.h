@@ -275,6 +275,22 @@ WCN_INLINE wcn_v256d_t wcn_v256d_sqrt(wcn_v256d_t vec) {
     return result;
 }
 
+/* ========== Absolute Value / Negation ========== */
+
+WCN_INLINE wcn_v256f_t wcn_v256f_abs(wcn_v256f_t vec) {
+    wcn_v256f_t result;
+    /* Clear sign bit of each 32-bit lane */
+    result.raw = (__m256)__lasx_xvbitclri_w((__m256i)vec.raw, 31);
+    return result;
+}
+
+WCN_INLINE wcn_v256f_t wcn_v256f_neg(wcn_v256f_t vec) {
+    wcn_v256f_t result;
+    /* Flip sign bit of each 32-bit lane */
+    result.raw = (__m256)__lasx_xvbitrevi_w((__m256i)vec.raw, 31);
+    return result;
+}
+
 /* ========== Conversions ========== */
 
 WCN_INLINE wcn_v256f_t wcn_v256i_to_v256f(wcn_v256i_t vec) {
@@ -567,22 +567,32 @@ WCN_INLINE void wcn_v256_zeroall(void) {
 
 /* ========== Conversions ========== */
 
+/* Without AVX2, wcn_v256i_t is a pair of 128-bit halves; AVX converts
+ * between 8 floats and 8 int32 in one instruction, so join/split around it */
+WCN_INLINE __m256i __wcn_v256i_join(wcn_v256i_t vec) {
+    return _mm256_insertf128_si256(_mm256_castsi128_si256(vec.low.raw),
+                                   vec.high.raw, 1);
+}
+
+WCN_INLINE wcn_v256i_t __wcn_v256i_split(__m256i raw) {
+    wcn_v256i_t result;
+    result.low.raw = _mm256_castsi256_si128(raw);
+    result.high.raw = _mm256_extractf128_si256(raw, 1);
+    return result;
+}
+
 WCN_INLINE wcn_v256f_t wcn_v256i_to_v256f(wcn_v256i_t vec) {
     wcn_v256f_t result;
-    result.raw = _mm256_cvtepi32_ps(vec.raw);
+    result.raw = _mm256_cvtepi32_ps(__wcn_v256i_join(vec));
     return result;
 }
 
 WCN_INLINE wcn_v256i_t wcn_v256f_to_v256i(wcn_v256f_t vec) {
-    wcn_v256i_t result;
-    result.raw = _mm256_cvtps_epi32(vec.raw);
-    return result;
+    return __wcn_v256i_split(_mm256_cvtps_epi32(vec.raw));
 }
 
 WCN_INLINE wcn_v256i_t wcn_v256f_to_v256i_trunc(wcn_v256f_t vec) {
-    wcn_v256i_t result;
-    result.raw = _mm256_cvttps_epi32(vec.raw);
-    return result;
+    return __wcn_v256i_split(_mm256_cvttps_epi32(vec.raw));
 }
 
 #endif /* WCN_X86_AVX */
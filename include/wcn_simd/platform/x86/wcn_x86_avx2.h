@@ -55,6 +55,24 @@ WCN_INLINE wcn_v256i_t wcn_v256i_set1_i32(int32_t value) {
     return result;
 }
 
+WCN_INLINE wcn_v256i_t wcn_v256i_set1_i8(int8_t value) {
+    wcn_v256i_t result;
+    result.raw = _mm256_set1_epi8(value);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_set1_i16(int16_t value) {
+    wcn_v256i_t result;
+    result.raw = _mm256_set1_epi16(value);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_set1_i64(int64_t value) {
+    wcn_v256i_t result;
+    result.raw = _mm256_set1_epi64x(value);
+    return result;
+}
+
 WCN_INLINE wcn_v256i_t wcn_v256i_setzero(void) {
     wcn_v256i_t result;
     result.raw = _mm256_setzero_si256();
@@ -99,6 +117,106 @@ WCN_INLINE wcn_v256i_t wcn_v256i_sub_i32(wcn_v256i_t a, wcn_v256i_t b) {
     return result;
 }
 
+WCN_INLINE wcn_v256i_t wcn_v256i_add_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_add_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_sub_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_sub_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_add_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_add_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_sub_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_sub_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_add_i64(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_add_epi64(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_sub_i64(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_sub_epi64(a.raw, b.raw);
+    return result;
+}
+
+/* Saturating 8/16-bit arithmetic */
+WCN_INLINE wcn_v256i_t wcn_v256i_adds_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_adds_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_adds_u8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_adds_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_adds_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_adds_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_adds_u16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_adds_epu16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_subs_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_subs_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_subs_u8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_subs_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_subs_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_subs_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_subs_u16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_subs_epu16(a.raw, b.raw);
+    return result;
+}
+
+/* Multiply 16-bit integers and horizontally add adjacent pairs to 32-bit */
+WCN_INLINE wcn_v256i_t wcn_v256i_madd_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_madd_epi16(a.raw, b.raw);
+    return result;
+}
+
+/* Sum of absolute differences of unsigned bytes; unlike the 128-bit
+ * wcn_v128i_sad_u8 the four 64-bit partial sums stay in the vector */
+WCN_INLINE wcn_v256i_t wcn_v256i_sad_u8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_sad_epu8(a.raw, b.raw);
+    return result;
+}
+
 WCN_INLINE wcn_v256i_t wcn_v256i_mullo_i32(wcn_v256i_t a, wcn_v256i_t b) {
     wcn_v256i_t result;
     result.raw = _mm256_mullo_epi32(a.raw, b.raw);
@@ -258,6 +376,66 @@ WCN_INLINE wcn_v256i_t wcn_v256i_min_i32(wcn_v256i_t a, wcn_v256i_t b) {
     return result;
 }
 
+WCN_INLINE wcn_v256i_t wcn_v256i_max_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_max_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_min_i8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_min_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_max_u8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_max_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_min_u8(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_min_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_max_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_max_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_min_i16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_min_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_max_u16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_max_epu16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_min_u16(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_min_epu16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_max_u32(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_max_epu32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v256i_min_u32(wcn_v256i_t a, wcn_v256i_t b) {
+    wcn_v256i_t result;
+    result.raw = _mm256_min_epu32(a.raw, b.raw);
+    return result;
+}
+
 WCN_INLINE wcn_v256f_t wcn_v256f_max(wcn_v256f_t a, wcn_v256f_t b) {
     wcn_v256f_t result;
     result.raw = _mm256_max_ps(a.raw, b.raw);
@@ -296,6 +474,22 @@ WCN_INLINE wcn_v256d_t wcn_v256d_sqrt(wcn_v256d_t vec) {
     return result;
 }
 
+/* ========== Absolute Value / Negation ========== */
+
+WCN_INLINE wcn_v256f_t wcn_v256f_abs(wcn_v256f_t vec) {
+    wcn_v256f_t result;
+    /* Clear the sign bit */
+    result.raw = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256f_t wcn_v256f_neg(wcn_v256f_t vec) {
+    wcn_v256f_t result;
+    /* Flip the sign bit */
+    result.raw = _mm256_xor_ps(vec.raw, _mm256_set1_ps(-0.0f));
+    return result;
+}
+
 /* ========== Gather Operations ========== */
 
 /* Note: Gather scale must be compile-time constant (1, 2, 4, or 8) */
@@ -33,22 +33,49 @@ WCN_INLINE wcn_v512f_t wcn_v512f_load(const float* ptr) {
     return result;
 }
 
+WCN_INLINE wcn_v512f_t wcn_v512f_load_aligned(const float* ptr) {
+    wcn_v512f_t result;
+    result.raw = _mm512_load_ps(ptr);
+    return result;
+}
+
 WCN_INLINE void wcn_v512f_store(float* ptr, wcn_v512f_t vec) {
     _mm512_storeu_ps(ptr, vec.raw);
 }
 
+WCN_INLINE void wcn_v512f_store_aligned(float* ptr, wcn_v512f_t vec) {
+    _mm512_store_ps(ptr, vec.raw);
+}
+
+/* Non-temporal store (ptr must be 64-byte aligned) */
+WCN_INLINE void wcn_v512f_stream(float* ptr, wcn_v512f_t vec) {
+    _mm512_stream_ps(ptr, vec.raw);
+}
+
 WCN_INLINE wcn_v512d_t wcn_v512d_load(const double* ptr) {
     wcn_v512d_t result;
     result.raw = _mm512_loadu_pd(ptr);
     return result;
 }
 
+WCN_INLINE wcn_v512d_t wcn_v512d_load_aligned(const double* ptr) {
+    wcn_v512d_t result;
+    result.raw = _mm512_load_pd(ptr);
+    return result;
+}
+
 WCN_INLINE void wcn_v512d_store(double* ptr, wcn_v512d_t vec) {
     _mm512_storeu_pd(ptr, vec.raw);
 }
 
+WCN_INLINE void wcn_v512d_store_aligned(double* ptr, wcn_v512d_t vec) {
+    _mm512_store_pd(ptr, vec.raw);
+}
+
 /* ========== Masked Load/Store Operations ========== */
 
+/* Masked-off lanes are not accessed, so these are safe on array tails */
+
 WCN_INLINE wcn_v512i_t wcn_v512i_maskz_load(uint16_t mask, const void* ptr) {
     wcn_v512i_t result;
     result.raw = _mm512_maskz_loadu_epi32(mask, ptr);
@@ -59,331 +86,1433 @@ WCN_INLINE void wcn_v512i_mask_store(void* ptr, uint16_t mask, wcn_v512i_t vec)
     _mm512_mask_storeu_epi32(ptr, mask, vec.raw);
 }
 
+WCN_INLINE wcn_v512i_t wcn_v512i_maskz_load_i64(uint8_t mask, const void* ptr) {
+    wcn_v512i_t result;
+    result.raw = _mm512_maskz_loadu_epi64(mask, ptr);
+    return result;
+}
+
+WCN_INLINE void wcn_v512i_mask_store_i64(void* ptr, uint8_t mask, wcn_v512i_t vec) {
+    _mm512_mask_storeu_epi64(ptr, mask, vec.raw);
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_load(uint16_t mask, const float* ptr) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_loadu_ps(mask, ptr);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_load(wcn_v512f_t src, uint16_t mask, const float* ptr) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_loadu_ps(src.raw, mask, ptr);
+    return result;
+}
+
+WCN_INLINE void wcn_v512f_mask_store(float* ptr, uint16_t mask, wcn_v512f_t vec) {
+    _mm512_mask_storeu_ps(ptr, mask, vec.raw);
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_maskz_load(uint8_t mask, const double* ptr) {
+    wcn_v512d_t result;
+    result.raw = _mm512_maskz_loadu_pd(mask, ptr);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_load(wcn_v512d_t src, uint8_t mask, const double* ptr) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mask_loadu_pd(src.raw, mask, ptr);
+    return result;
+}
+
+WCN_INLINE void wcn_v512d_mask_store(double* ptr, uint8_t mask, wcn_v512d_t vec) {
+    _mm512_mask_storeu_pd(ptr, mask, vec.raw);
+}
+
+/* Mask with the low min(count, 16) bits set */
+WCN_INLINE uint16_t wcn_v512_mask16_first(size_t count) {
+    return count >= 16 ? (uint16_t)0xFFFF : (uint16_t)((1u << count) - 1u);
+}
+
+/* Mask with the low min(count, 8) bits set */
+WCN_INLINE uint8_t wcn_v512_mask8_first(size_t count) {
+    return count >= 8 ? (uint8_t)0xFF : (uint8_t)((1u << count) - 1u);
+}
+
 /* ========== Initialization ========== */
 
-WCN_INLINE wcn_v512i_t wcn_v512i_set1_i32(int32_t value) {
-    wcn_v512i_t result;
-    result.raw = _mm512_set1_epi32(value);
-    return result;
+WCN_INLINE wcn_v512i_t wcn_v512i_set1_i8(int8_t value) {
+    wcn_v512i_t result;
+    result.raw = _mm512_set1_epi8(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_set1_i16(int16_t value) {
+    wcn_v512i_t result;
+    result.raw = _mm512_set1_epi16(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_set1_i32(int32_t value) {
+    wcn_v512i_t result;
+    result.raw = _mm512_set1_epi32(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_set1_i64(int64_t value) {
+    wcn_v512i_t result;
+    result.raw = _mm512_set1_epi64(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_setzero(void) {
+    wcn_v512i_t result;
+    result.raw = _mm512_setzero_si512();
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_set1(float value) {
+    wcn_v512f_t result;
+    result.raw = _mm512_set1_ps(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_setzero(void) {
+    wcn_v512f_t result;
+    result.raw = _mm512_setzero_ps();
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_set1(double value) {
+    wcn_v512d_t result;
+    result.raw = _mm512_set1_pd(value);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_setzero(void) {
+    wcn_v512d_t result;
+    result.raw = _mm512_setzero_pd();
+    return result;
+}
+
+/* Broadcast a 128-bit vector to all four lanes */
+WCN_INLINE wcn_v512f_t wcn_v512f_broadcast_v128f(wcn_v128f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_broadcast_f32x4(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_broadcast_v128i(wcn_v128i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_broadcast_i32x4(vec.raw);
+    return result;
+}
+
+/* ========== Cast Operations (no instruction) ========== */
+
+WCN_INLINE wcn_v512i_t wcn_v512f_cast_v512i(wcn_v512f_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_castps_si512(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512i_cast_v512f(wcn_v512i_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512d_cast_v512i(wcn_v512d_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_castpd_si512(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512i_cast_v512d(wcn_v512i_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_castsi512_pd(vec.raw);
+    return result;
+}
+
+/* ========== Arithmetic Operations ========== */
+
+WCN_INLINE wcn_v512i_t wcn_v512i_add_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_add_epi32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sub_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sub_epi32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_add_i64(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_add_epi64(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sub_i64(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sub_epi64(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_mullo_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_mullo_epi32(a.raw, b.raw);
+    return result;
+}
+
+/* 32-bit signed multiplication of even lanes to 64-bit */
+WCN_INLINE wcn_v512i_t wcn_v512i_mul_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_mul_epi32(a.raw, b.raw);
+    return result;
+}
+
+/* 32-bit unsigned multiplication of even lanes to 64-bit */
+WCN_INLINE wcn_v512i_t wcn_v512i_mul_u32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_mul_epu32(a.raw, b.raw);
+    return result;
+}
+
+#ifdef WCN_X86_AVX512BW
+/* 8/16-bit integer arithmetic (requires AVX-512BW) */
+WCN_INLINE wcn_v512i_t wcn_v512i_add_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_add_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sub_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sub_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_add_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_add_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sub_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sub_epi16(a.raw, b.raw);
+    return result;
+}
+
+/* Saturating arithmetic */
+WCN_INLINE wcn_v512i_t wcn_v512i_adds_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_adds_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_adds_u8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_adds_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_subs_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_subs_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_subs_u8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_subs_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_adds_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_adds_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_subs_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_subs_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_adds_u16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_adds_epu16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_subs_u16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_subs_epu16(a.raw, b.raw);
+    return result;
+}
+
+/* Sum of absolute differences of unsigned bytes (eight 64-bit partial sums) */
+WCN_INLINE wcn_v512i_t wcn_v512i_sad_u8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sad_epu8(a.raw, b.raw);
+    return result;
+}
+
+/* Multiply 16-bit integers and horizontally add adjacent pairs to 32-bit */
+WCN_INLINE wcn_v512i_t wcn_v512i_madd_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_madd_epi16(a.raw, b.raw);
+    return result;
+}
+
+/* Multiply unsigned 8-bit by signed 8-bit, add adjacent pairs to 16-bit (saturating) */
+WCN_INLINE wcn_v512i_t wcn_v512i_maddubs_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_maddubs_epi16(a.raw, b.raw);
+    return result;
+}
+#endif
+
+WCN_INLINE wcn_v512f_t wcn_v512f_add(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_add_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_sub(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_sub_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mul(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mul_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_div(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_div_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_add(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_add_pd(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_sub(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_sub_pd(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mul(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mul_pd(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_div(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_div_pd(a.raw, b.raw);
+    return result;
+}
+
+/* Negation (flips the sign bit) */
+WCN_INLINE wcn_v512f_t wcn_v512f_neg(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(_mm512_xor_si512(
+        _mm512_castps_si512(vec.raw), _mm512_set1_epi32((int32_t)0x80000000u)));
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_neg(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_castsi512_pd(_mm512_xor_si512(
+        _mm512_castpd_si512(vec.raw),
+        _mm512_set1_epi64((int64_t)0x8000000000000000ull)));
+    return result;
+}
+
+/* ========== Masked Arithmetic Operations ========== */
+
+/* mask_*: lanes with a clear mask bit are taken from src
+ * maskz_*: lanes with a clear mask bit are zeroed */
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_add(wcn_v512f_t src, uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_add_ps(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_add(uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_add_ps(mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_sub(wcn_v512f_t src, uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_sub_ps(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_mul(wcn_v512f_t src, uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_mul_ps(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_mul(uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_mul_ps(mask, a.raw, b.raw);
+    return result;
+}
+
+/* Lanes with a clear mask bit keep a */
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_fmadd(wcn_v512f_t a, uint16_t mask, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_fmadd_ps(a.raw, mask, b.raw, c.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_mov(wcn_v512f_t src, uint16_t mask, wcn_v512f_t a) {
+    wcn_v512f_t result;
+    result.raw = _mm512_mask_mov_ps(src.raw, mask, a.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_mov(uint16_t mask, wcn_v512f_t a) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_mov_ps(mask, a.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_add(wcn_v512d_t src, uint8_t mask, wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mask_add_pd(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_maskz_add(uint8_t mask, wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_maskz_add_pd(mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_mul(wcn_v512d_t src, uint8_t mask, wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mask_mul_pd(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_fmadd(wcn_v512d_t a, uint8_t mask, wcn_v512d_t b, wcn_v512d_t c) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mask_fmadd_pd(a.raw, mask, b.raw, c.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_mov(wcn_v512d_t src, uint8_t mask, wcn_v512d_t a) {
+    wcn_v512d_t result;
+    result.raw = _mm512_mask_mov_pd(src.raw, mask, a.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_mask_add_i32(wcn_v512i_t src, uint16_t mask, wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_mask_add_epi32(src.raw, mask, a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_maskz_mov_i32(uint16_t mask, wcn_v512i_t a) {
+    wcn_v512i_t result;
+    result.raw = _mm512_maskz_mov_epi32(mask, a.raw);
+    return result;
+}
+
+/* ========== Compress/Expand Operations ========== */
+
+/* Pack the lanes selected by mask contiguously into the low lanes (rest zeroed) */
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_compress(uint16_t mask, wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_compress_ps(mask, vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_maskz_compress_i32(uint16_t mask, wcn_v512i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_maskz_compress_epi32(mask, vec.raw);
+    return result;
+}
+
+/* Store the lanes selected by mask contiguously to ptr (writes popcount(mask) elements) */
+WCN_INLINE void wcn_v512f_mask_compressstore(float* ptr, uint16_t mask, wcn_v512f_t vec) {
+    _mm512_mask_compressstoreu_ps(ptr, mask, vec.raw);
+}
+
+WCN_INLINE void wcn_v512i_mask_compressstore_i32(void* ptr, uint16_t mask, wcn_v512i_t vec) {
+    _mm512_mask_compressstoreu_epi32(ptr, mask, vec.raw);
+}
+
+/* Distribute the low lanes of vec to the lanes selected by mask (rest zeroed) */
+WCN_INLINE wcn_v512f_t wcn_v512f_maskz_expand(uint16_t mask, wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_maskz_expand_ps(mask, vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_maskz_expand_i32(uint16_t mask, wcn_v512i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_maskz_expand_epi32(mask, vec.raw);
+    return result;
+}
+
+/* ========== FMA (Fused Multiply-Add) ========== */
+
+WCN_INLINE wcn_v512f_t wcn_v512f_fmadd(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_fmadd_ps(a.raw, b.raw, c.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_fmadd(wcn_v512d_t a, wcn_v512d_t b, wcn_v512d_t c) {
+    wcn_v512d_t result;
+    result.raw = _mm512_fmadd_pd(a.raw, b.raw, c.raw);
+    return result;
+}
+
+/* a * b - c */
+WCN_INLINE wcn_v512f_t wcn_v512f_fmsub(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_fmsub_ps(a.raw, b.raw, c.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_fmsub(wcn_v512d_t a, wcn_v512d_t b, wcn_v512d_t c) {
+    wcn_v512d_t result;
+    result.raw = _mm512_fmsub_pd(a.raw, b.raw, c.raw);
+    return result;
+}
+
+/* -(a * b) + c */
+WCN_INLINE wcn_v512f_t wcn_v512f_fnmadd(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_fnmadd_ps(a.raw, b.raw, c.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_fnmadd(wcn_v512d_t a, wcn_v512d_t b, wcn_v512d_t c) {
+    wcn_v512d_t result;
+    result.raw = _mm512_fnmadd_pd(a.raw, b.raw, c.raw);
+    return result;
+}
+
+/* Alternate subtract/add: a * b - c in even lanes, a * b + c in odd lanes */
+WCN_INLINE wcn_v512f_t wcn_v512f_fmaddsub(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_fmaddsub_ps(a.raw, b.raw, c.raw);
+    return result;
+}
+
+/* Alternate add/subtract: a * b + c in even lanes, a * b - c in odd lanes */
+WCN_INLINE wcn_v512f_t wcn_v512f_fmsubadd(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+    wcn_v512f_t result;
+    result.raw = _mm512_fmsubadd_ps(a.raw, b.raw, c.raw);
+    return result;
+}
+
+/* ========== Logical Operations ========== */
+
+WCN_INLINE wcn_v512i_t wcn_v512i_and(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_and_si512(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_or(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_or_si512(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_xor(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_xor_si512(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_andnot(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_andnot_si512(a.raw, b.raw);
+    return result;
+}
+
+/* Float bitwise ops go through the integer domain: the _ps forms need AVX-512DQ */
+WCN_INLINE wcn_v512f_t wcn_v512f_and(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(
+        _mm512_and_si512(_mm512_castps_si512(a.raw), _mm512_castps_si512(b.raw)));
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_or(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(
+        _mm512_or_si512(_mm512_castps_si512(a.raw), _mm512_castps_si512(b.raw)));
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_xor(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(
+        _mm512_xor_si512(_mm512_castps_si512(a.raw), _mm512_castps_si512(b.raw)));
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_andnot(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_castsi512_ps(
+        _mm512_andnot_si512(_mm512_castps_si512(a.raw), _mm512_castps_si512(b.raw)));
+    return result;
+}
+
+/* ========== Shift Operations ========== */
+
+/* Immediate-form shifts: GCC, Clang and MSVC all accept a run-time count here
+ * and fall back to the register form, so these are plain inline functions.
+ * Counts >= the lane width give 0 (or the sign fill for srai). */
+
+WCN_INLINE wcn_v512i_t wcn_v512i_slli_i32(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_slli_epi32(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srli_i32(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srli_epi32(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srai_i32(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srai_epi32(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_slli_i64(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_slli_epi64(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srli_i64(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srli_epi64(a.raw, imm);
+    return result;
+}
+
+/* 64-bit arithmetic shift (no SSE/AVX2 equivalent) */
+WCN_INLINE wcn_v512i_t wcn_v512i_srai_i64(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srai_epi64(a.raw, imm);
+    return result;
+}
+
+/* Shift by the count in the low 64 bits of count */
+WCN_INLINE wcn_v512i_t wcn_v512i_sll_i32(wcn_v512i_t a, wcn_v128i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sll_epi32(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srl_i32(wcn_v512i_t a, wcn_v128i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srl_epi32(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sra_i32(wcn_v512i_t a, wcn_v128i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sra_epi32(a.raw, count.raw);
+    return result;
+}
+
+/* Per-lane variable shifts */
+WCN_INLINE wcn_v512i_t wcn_v512i_sllv_i32(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sllv_epi32(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srlv_i32(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srlv_epi32(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srav_i32(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srav_epi32(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sllv_i64(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sllv_epi64(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srlv_i64(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srlv_epi64(a.raw, count.raw);
+    return result;
+}
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE wcn_v512i_t wcn_v512i_slli_i16(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_slli_epi16(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srli_i16(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srli_epi16(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srai_i16(wcn_v512i_t a, unsigned int imm) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srai_epi16(a.raw, imm);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_sllv_i16(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_sllv_epi16(a.raw, count.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_srlv_i16(wcn_v512i_t a, wcn_v512i_t count) {
+    wcn_v512i_t result;
+    result.raw = _mm512_srlv_epi16(a.raw, count.raw);
+    return result;
+}
+#endif
+
+/* ========== Comparison Operations (return mask) ========== */
+
+WCN_INLINE uint16_t wcn_v512i_cmpeq_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpeq_epi32_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint16_t wcn_v512i_cmpgt_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpgt_epi32_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint16_t wcn_v512i_cmplt_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmplt_epi32_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint16_t wcn_v512i_cmpneq_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpneq_epi32_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint16_t wcn_v512i_cmplt_u32_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmplt_epu32_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint8_t wcn_v512i_cmpeq_i64_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpeq_epi64_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint8_t wcn_v512i_cmpgt_i64_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpgt_epi64_mask(a.raw, b.raw);
+}
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE uint64_t wcn_v512i_cmpeq_i8_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpeq_epi8_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint64_t wcn_v512i_cmpgt_i8_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpgt_epi8_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint32_t wcn_v512i_cmpeq_i16_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpeq_epi16_mask(a.raw, b.raw);
+}
+
+WCN_INLINE uint32_t wcn_v512i_cmpgt_i16_mask(wcn_v512i_t a, wcn_v512i_t b) {
+    return _mm512_cmpgt_epi16_mask(a.raw, b.raw);
+}
+#endif
+
+WCN_INLINE uint16_t wcn_v512f_cmpeq_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_EQ_OQ);
+}
+
+WCN_INLINE uint16_t wcn_v512f_cmpneq_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_NEQ_UQ);
+}
+
+WCN_INLINE uint16_t wcn_v512f_cmplt_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_LT_OQ);
+}
+
+WCN_INLINE uint16_t wcn_v512f_cmple_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_LE_OQ);
+}
+
+WCN_INLINE uint16_t wcn_v512f_cmpgt_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_GT_OQ);
+}
+
+WCN_INLINE uint16_t wcn_v512f_cmpge_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_GE_OQ);
+}
+
+/* Set for lanes where either input is NaN */
+WCN_INLINE uint16_t wcn_v512f_cmpunord_mask(wcn_v512f_t a, wcn_v512f_t b) {
+    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_UNORD_Q);
+}
+
+WCN_INLINE uint8_t wcn_v512d_cmpeq_mask(wcn_v512d_t a, wcn_v512d_t b) {
+    return _mm512_cmp_pd_mask(a.raw, b.raw, _CMP_EQ_OQ);
+}
+
+WCN_INLINE uint8_t wcn_v512d_cmplt_mask(wcn_v512d_t a, wcn_v512d_t b) {
+    return _mm512_cmp_pd_mask(a.raw, b.raw, _CMP_LT_OQ);
+}
+
+WCN_INLINE uint8_t wcn_v512d_cmple_mask(wcn_v512d_t a, wcn_v512d_t b) {
+    return _mm512_cmp_pd_mask(a.raw, b.raw, _CMP_LE_OQ);
+}
+
+WCN_INLINE uint8_t wcn_v512d_cmpgt_mask(wcn_v512d_t a, wcn_v512d_t b) {
+    return _mm512_cmp_pd_mask(a.raw, b.raw, _CMP_GT_OQ);
+}
+
+/* ========== Movemask Operations ========== */
+
+/* Sign bit of each lane, like the SSE/AVX movemask family */
+WCN_INLINE uint16_t wcn_v512f_movemask(wcn_v512f_t vec) {
+    return _mm512_cmplt_epi32_mask(_mm512_castps_si512(vec.raw), _mm512_setzero_si512());
+}
+
+WCN_INLINE uint8_t wcn_v512d_movemask(wcn_v512d_t vec) {
+    return _mm512_cmplt_epi64_mask(_mm512_castpd_si512(vec.raw), _mm512_setzero_si512());
+}
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE uint64_t wcn_v512i_movemask_i8(wcn_v512i_t vec) {
+    return _mm512_movepi8_mask(vec.raw);
+}
+#endif
+
+/* ========== Min/Max Operations ========== */
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epi32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epi32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_u32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epu32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_u32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epu32(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_i64(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epi64(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_i64(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epi64(a.raw, b.raw);
+    return result;
+}
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE wcn_v512i_t wcn_v512i_max_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epi8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_u8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_u8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epu8(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epi16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_max_u16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_max_epu16(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_min_u16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_min_epu16(a.raw, b.raw);
+    return result;
+}
+#endif
+
+WCN_INLINE wcn_v512f_t wcn_v512f_max(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_max_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_min(wcn_v512f_t a, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_min_ps(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_max(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_max_pd(a.raw, b.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_min(wcn_v512d_t a, wcn_v512d_t b) {
+    wcn_v512d_t result;
+    result.raw = _mm512_min_pd(a.raw, b.raw);
+    return result;
+}
+
+/* ========== Square Root / Reciprocal ========== */
+
+WCN_INLINE wcn_v512f_t wcn_v512f_sqrt(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_sqrt_ps(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_sqrt(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_sqrt_pd(vec.raw);
+    return result;
+}
+
+/* Approximate reciprocal (relative error < 2^-14) */
+WCN_INLINE wcn_v512f_t wcn_v512f_rcp(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_rcp14_ps(vec.raw);
+    return result;
+}
+
+/* Approximate reciprocal square root (relative error < 2^-14) */
+WCN_INLINE wcn_v512f_t wcn_v512f_rsqrt(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_rsqrt14_ps(vec.raw);
+    return result;
+}
+
+/* ========== Rounding Operations ========== */
+
+WCN_INLINE wcn_v512f_t wcn_v512f_floor(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_roundscale_ps(vec.raw, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_ceil(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_roundscale_ps(vec.raw, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512f_t wcn_v512f_trunc(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_roundscale_ps(vec.raw, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+/* Round half to even */
+WCN_INLINE wcn_v512f_t wcn_v512f_round_nearest(wcn_v512f_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_roundscale_ps(vec.raw, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_floor(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_roundscale_pd(vec.raw, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_ceil(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_roundscale_pd(vec.raw, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_trunc(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_roundscale_pd(vec.raw, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+WCN_INLINE wcn_v512d_t wcn_v512d_round_nearest(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_roundscale_pd(vec.raw, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    return result;
+}
+
+/* ========== Reduction Operations ========== */
+
+WCN_INLINE float wcn_v512f_reduce_add(wcn_v512f_t vec) {
+    return _mm512_reduce_add_ps(vec.raw);
+}
+
+WCN_INLINE float wcn_v512f_reduce_mul(wcn_v512f_t vec) {
+    return _mm512_reduce_mul_ps(vec.raw);
+}
+
+WCN_INLINE float wcn_v512f_reduce_max(wcn_v512f_t vec) {
+    return _mm512_reduce_max_ps(vec.raw);
+}
+
+WCN_INLINE float wcn_v512f_reduce_min(wcn_v512f_t vec) {
+    return _mm512_reduce_min_ps(vec.raw);
+}
+
+/* Masked reductions: lanes with a clear mask bit are ignored */
+WCN_INLINE float wcn_v512f_mask_reduce_add(uint16_t mask, wcn_v512f_t vec) {
+    return _mm512_mask_reduce_add_ps(mask, vec.raw);
+}
+
+WCN_INLINE float wcn_v512f_mask_reduce_max(uint16_t mask, wcn_v512f_t vec) {
+    return _mm512_mask_reduce_max_ps(mask, vec.raw);
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_setzero(void) {
-    wcn_v512i_t result;
-    result.raw = _mm512_setzero_si512();
-    return result;
+WCN_INLINE float wcn_v512f_mask_reduce_min(uint16_t mask, wcn_v512f_t vec) {
+    return _mm512_mask_reduce_min_ps(mask, vec.raw);
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_set1(float value) {
-    wcn_v512f_t result;
-    result.raw = _mm512_set1_ps(value);
-    return result;
+WCN_INLINE double wcn_v512d_reduce_add(wcn_v512d_t vec) {
+    return _mm512_reduce_add_pd(vec.raw);
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_setzero(void) {
-    wcn_v512f_t result;
-    result.raw = _mm512_setzero_ps();
-    return result;
+WCN_INLINE double wcn_v512d_reduce_max(wcn_v512d_t vec) {
+    return _mm512_reduce_max_pd(vec.raw);
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_set1(double value) {
-    wcn_v512d_t result;
-    result.raw = _mm512_set1_pd(value);
-    return result;
+WCN_INLINE double wcn_v512d_reduce_min(wcn_v512d_t vec) {
+    return _mm512_reduce_min_pd(vec.raw);
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_setzero(void) {
-    wcn_v512d_t result;
-    result.raw = _mm512_setzero_pd();
-    return result;
+WCN_INLINE int32_t wcn_v512i_reduce_add_i32(wcn_v512i_t vec) {
+    return _mm512_reduce_add_epi32(vec.raw);
 }
 
-/* ========== Arithmetic Operations ========== */
+WCN_INLINE int32_t wcn_v512i_reduce_max_i32(wcn_v512i_t vec) {
+    return _mm512_reduce_max_epi32(vec.raw);
+}
 
-WCN_INLINE wcn_v512i_t wcn_v512i_add_i32(wcn_v512i_t a, wcn_v512i_t b) {
-    wcn_v512i_t result;
-    result.raw = _mm512_add_epi32(a.raw, b.raw);
-    return result;
+WCN_INLINE int32_t wcn_v512i_reduce_min_i32(wcn_v512i_t vec) {
+    return _mm512_reduce_min_epi32(vec.raw);
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_sub_i32(wcn_v512i_t a, wcn_v512i_t b) {
-    wcn_v512i_t result;
-    result.raw = _mm512_sub_epi32(a.raw, b.raw);
-    return result;
+WCN_INLINE int32_t wcn_v512i_reduce_and_i32(wcn_v512i_t vec) {
+    return _mm512_reduce_and_epi32(vec.raw);
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_mullo_i32(wcn_v512i_t a, wcn_v512i_t b) {
-    wcn_v512i_t result;
-    result.raw = _mm512_mullo_epi32(a.raw, b.raw);
-    return result;
+WCN_INLINE int32_t wcn_v512i_reduce_or_i32(wcn_v512i_t vec) {
+    return _mm512_reduce_or_epi32(vec.raw);
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_add(wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_add_ps(a.raw, b.raw);
-    return result;
+WCN_INLINE int64_t wcn_v512i_reduce_add_i64(wcn_v512i_t vec) {
+    return _mm512_reduce_add_epi64(vec.raw);
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_sub(wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_sub_ps(a.raw, b.raw);
+/* ========== Permute/Shuffle Operations ========== */
+
+/* result[i] = a[idx[i]] across the full 512-bit register */
+WCN_INLINE wcn_v512i_t wcn_v512i_permutexvar(wcn_v512i_t idx, wcn_v512i_t a) {
+    wcn_v512i_t result;
+    result.raw = _mm512_permutexvar_epi32(idx.raw, a.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_mul(wcn_v512f_t a, wcn_v512f_t b) {
+WCN_INLINE wcn_v512f_t wcn_v512f_permutexvar(wcn_v512i_t idx, wcn_v512f_t a) {
     wcn_v512f_t result;
-    result.raw = _mm512_mul_ps(a.raw, b.raw);
+    result.raw = _mm512_permutexvar_ps(idx.raw, a.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_div(wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_div_ps(a.raw, b.raw);
+WCN_INLINE wcn_v512i_t wcn_v512i_permutexvar_i64(wcn_v512i_t idx, wcn_v512i_t a) {
+    wcn_v512i_t result;
+    result.raw = _mm512_permutexvar_epi64(idx.raw, a.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_add(wcn_v512d_t a, wcn_v512d_t b) {
+WCN_INLINE wcn_v512d_t wcn_v512d_permutexvar(wcn_v512i_t idx, wcn_v512d_t a) {
     wcn_v512d_t result;
-    result.raw = _mm512_add_pd(a.raw, b.raw);
+    result.raw = _mm512_permutexvar_pd(idx.raw, a.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_sub(wcn_v512d_t a, wcn_v512d_t b) {
-    wcn_v512d_t result;
-    result.raw = _mm512_sub_pd(a.raw, b.raw);
+/* Two-source permute: index bit 4 (bit 3 for 64-bit lanes) selects b */
+WCN_INLINE wcn_v512i_t wcn_v512i_permutex2var(wcn_v512i_t a, wcn_v512i_t idx, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_permutex2var_epi32(a.raw, idx.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_mul(wcn_v512d_t a, wcn_v512d_t b) {
-    wcn_v512d_t result;
-    result.raw = _mm512_mul_pd(a.raw, b.raw);
+WCN_INLINE wcn_v512f_t wcn_v512f_permutex2var(wcn_v512f_t a, wcn_v512i_t idx, wcn_v512f_t b) {
+    wcn_v512f_t result;
+    result.raw = _mm512_permutex2var_ps(a.raw, idx.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_div(wcn_v512d_t a, wcn_v512d_t b) {
+WCN_INLINE wcn_v512d_t wcn_v512d_permutex2var(wcn_v512d_t a, wcn_v512i_t idx, wcn_v512d_t b) {
     wcn_v512d_t result;
-    result.raw = _mm512_div_pd(a.raw, b.raw);
+    result.raw = _mm512_permutex2var_pd(a.raw, idx.raw, b.raw);
     return result;
 }
 
-/* ========== Masked Arithmetic Operations ========== */
+/* Note: 128-bit lane shuffle and alignr require a compile-time constant */
+#ifndef _MSC_VER
+#define wcn_v512f_shuffle_f32x4(a, b, imm8) \
+    ({ \
+        wcn_v512f_t _result; \
+        _result.raw = _mm512_shuffle_f32x4((a).raw, (b).raw, (imm8)); \
+        _result; \
+    })
+
+#define wcn_v512i_shuffle_i32x4(a, b, imm8) \
+    ({ \
+        wcn_v512i_t _result; \
+        _result.raw = _mm512_shuffle_i32x4((a).raw, (b).raw, (imm8)); \
+        _result; \
+    })
+
+#define wcn_v512i_alignr_i32(a, b, imm8) \
+    ({ \
+        wcn_v512i_t _result; \
+        _result.raw = _mm512_alignr_epi32((a).raw, (b).raw, (imm8)); \
+        _result; \
+    })
+#else
+#define WCN_SHUFFLE_F32X4_512(a, b, imm) _mm512_shuffle_f32x4((a).raw, (b).raw, (imm))
+#define WCN_SHUFFLE_I32X4_512(a, b, imm) _mm512_shuffle_i32x4((a).raw, (b).raw, (imm))
+#define WCN_ALIGNR_EPI32_512(a, b, imm) _mm512_alignr_epi32((a).raw, (b).raw, (imm))
+#endif
 
-WCN_INLINE wcn_v512f_t wcn_v512f_mask_add(wcn_v512f_t src, uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_mask_add_ps(src.raw, mask, a.raw, b.raw);
+#ifdef WCN_X86_AVX512BW
+/* Shuffle bytes within each 128-bit lane (SSSE3-style) */
+WCN_INLINE wcn_v512i_t wcn_v512i_shuffle_i8(wcn_v512i_t vec, wcn_v512i_t control) {
+    wcn_v512i_t result;
+    result.raw = _mm512_shuffle_epi8(vec.raw, control.raw);
     return result;
 }
+#endif
 
-WCN_INLINE wcn_v512f_t wcn_v512f_maskz_add(uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_maskz_add_ps(mask, a.raw, b.raw);
-    return result;
-}
+/* ========== Gather/Scatter Operations ========== */
 
-/* ========== FMA (Fused Multiply-Add) ========== */
+/* Note: Gather/scatter scale must be compile-time constant (1, 2, 4, or 8) */
+#ifndef _MSC_VER
+#define wcn_v512i_gather_i32(base, vindex, scale) \
+    ({ \
+        wcn_v512i_t _result; \
+        _result.raw = _mm512_i32gather_epi32((vindex).raw, (base), (scale)); \
+        _result; \
+    })
+
+#define wcn_v512f_gather(base, vindex, scale) \
+    ({ \
+        wcn_v512f_t _result; \
+        _result.raw = _mm512_i32gather_ps((vindex).raw, (base), (scale)); \
+        _result; \
+    })
+
+#define wcn_v512i_scatter_i32(base, vindex, vec, scale) \
+    _mm512_i32scatter_epi32((base), (vindex).raw, (vec).raw, (scale))
+
+#define wcn_v512f_scatter(base, vindex, vec, scale) \
+    _mm512_i32scatter_ps((base), (vindex).raw, (vec).raw, (scale))
+#else
+#define WCN_I32GATHER_EPI32_512(base, vindex, scale) _mm512_i32gather_epi32((vindex).raw, (base), (scale))
+#define WCN_I32GATHER_PS_512(base, vindex, scale) _mm512_i32gather_ps((vindex).raw, (base), (scale))
+#define WCN_I32SCATTER_EPI32_512(base, vindex, vec, scale) _mm512_i32scatter_epi32((base), (vindex).raw, (vec).raw, (scale))
+#define WCN_I32SCATTER_PS_512(base, vindex, vec, scale) _mm512_i32scatter_ps((base), (vindex).raw, (vec).raw, (scale))
+#endif
 
-WCN_INLINE wcn_v512f_t wcn_v512f_fmadd(wcn_v512f_t a, wcn_v512f_t b, wcn_v512f_t c) {
+/* ========== Mask Operations ========== */
+
+/* Lanes with a set mask bit come from b, the rest from a */
+WCN_INLINE wcn_v512f_t wcn_v512f_mask_blend(uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
     wcn_v512f_t result;
-    result.raw = _mm512_fmadd_ps(a.raw, b.raw, c.raw);
+    result.raw = _mm512_mask_blend_ps(mask, a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_fmadd(wcn_v512d_t a, wcn_v512d_t b, wcn_v512d_t c) {
+WCN_INLINE wcn_v512d_t wcn_v512d_mask_blend(uint8_t mask, wcn_v512d_t a, wcn_v512d_t b) {
     wcn_v512d_t result;
-    result.raw = _mm512_fmadd_pd(a.raw, b.raw, c.raw);
+    result.raw = _mm512_mask_blend_pd(mask, a.raw, b.raw);
     return result;
 }
 
-/* ========== Logical Operations ========== */
-
-WCN_INLINE wcn_v512i_t wcn_v512i_and(wcn_v512i_t a, wcn_v512i_t b) {
+WCN_INLINE wcn_v512i_t wcn_v512i_mask_blend(uint16_t mask, wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_and_si512(a.raw, b.raw);
+    result.raw = _mm512_mask_blend_epi32(mask, a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_or(wcn_v512i_t a, wcn_v512i_t b) {
+/* ========== Pack/Unpack Operations ========== */
+
+/* Note: like AVX2, pack/unpack operate within each 128-bit lane */
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE wcn_v512i_t wcn_v512i_packs_i32(wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_or_si512(a.raw, b.raw);
+    result.raw = _mm512_packs_epi32(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_xor(wcn_v512i_t a, wcn_v512i_t b) {
+WCN_INLINE wcn_v512i_t wcn_v512i_packs_i16(wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_xor_si512(a.raw, b.raw);
+    result.raw = _mm512_packs_epi16(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_andnot(wcn_v512i_t a, wcn_v512i_t b) {
+WCN_INLINE wcn_v512i_t wcn_v512i_packus_i16(wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_andnot_si512(a.raw, b.raw);
+    result.raw = _mm512_packus_epi16(a.raw, b.raw);
     return result;
 }
 
-/* ========== Comparison Operations (return mask) ========== */
-
-WCN_INLINE uint16_t wcn_v512i_cmpeq_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
-    return _mm512_cmpeq_epi32_mask(a.raw, b.raw);
+WCN_INLINE wcn_v512i_t wcn_v512i_packus_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_packus_epi32(a.raw, b.raw);
+    return result;
 }
 
-WCN_INLINE uint16_t wcn_v512i_cmpgt_i32_mask(wcn_v512i_t a, wcn_v512i_t b) {
-    return _mm512_cmpgt_epi32_mask(a.raw, b.raw);
+WCN_INLINE wcn_v512i_t wcn_v512i_unpacklo_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpacklo_epi8(a.raw, b.raw);
+    return result;
 }
 
-WCN_INLINE uint16_t wcn_v512f_cmpeq_mask(wcn_v512f_t a, wcn_v512f_t b) {
-    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_EQ_OQ);
+WCN_INLINE wcn_v512i_t wcn_v512i_unpackhi_i8(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpackhi_epi8(a.raw, b.raw);
+    return result;
 }
 
-WCN_INLINE uint16_t wcn_v512f_cmplt_mask(wcn_v512f_t a, wcn_v512f_t b) {
-    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_LT_OQ);
+WCN_INLINE wcn_v512i_t wcn_v512i_unpacklo_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpacklo_epi16(a.raw, b.raw);
+    return result;
 }
 
-WCN_INLINE uint16_t wcn_v512f_cmple_mask(wcn_v512f_t a, wcn_v512f_t b) {
-    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_LE_OQ);
+WCN_INLINE wcn_v512i_t wcn_v512i_unpackhi_i16(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpackhi_epi16(a.raw, b.raw);
+    return result;
 }
+#endif
 
-WCN_INLINE uint16_t wcn_v512f_cmpgt_mask(wcn_v512f_t a, wcn_v512f_t b) {
-    return _mm512_cmp_ps_mask(a.raw, b.raw, _CMP_GT_OQ);
+WCN_INLINE wcn_v512i_t wcn_v512i_unpacklo_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpacklo_epi32(a.raw, b.raw);
+    return result;
 }
 
-/* ========== Min/Max Operations ========== */
+WCN_INLINE wcn_v512i_t wcn_v512i_unpackhi_i32(wcn_v512i_t a, wcn_v512i_t b) {
+    wcn_v512i_t result;
+    result.raw = _mm512_unpackhi_epi32(a.raw, b.raw);
+    return result;
+}
 
-WCN_INLINE wcn_v512i_t wcn_v512i_max_i32(wcn_v512i_t a, wcn_v512i_t b) {
+WCN_INLINE wcn_v512i_t wcn_v512i_unpacklo_i64(wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_max_epi32(a.raw, b.raw);
+    result.raw = _mm512_unpacklo_epi64(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_min_i32(wcn_v512i_t a, wcn_v512i_t b) {
+WCN_INLINE wcn_v512i_t wcn_v512i_unpackhi_i64(wcn_v512i_t a, wcn_v512i_t b) {
     wcn_v512i_t result;
-    result.raw = _mm512_min_epi32(a.raw, b.raw);
+    result.raw = _mm512_unpackhi_epi64(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_max(wcn_v512f_t a, wcn_v512f_t b) {
+WCN_INLINE wcn_v512f_t wcn_v512f_unpacklo(wcn_v512f_t a, wcn_v512f_t b) {
     wcn_v512f_t result;
-    result.raw = _mm512_max_ps(a.raw, b.raw);
+    result.raw = _mm512_unpacklo_ps(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_min(wcn_v512f_t a, wcn_v512f_t b) {
+WCN_INLINE wcn_v512f_t wcn_v512f_unpackhi(wcn_v512f_t a, wcn_v512f_t b) {
     wcn_v512f_t result;
-    result.raw = _mm512_min_ps(a.raw, b.raw);
+    result.raw = _mm512_unpackhi_ps(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_max(wcn_v512d_t a, wcn_v512d_t b) {
+WCN_INLINE wcn_v512d_t wcn_v512d_unpacklo(wcn_v512d_t a, wcn_v512d_t b) {
     wcn_v512d_t result;
-    result.raw = _mm512_max_pd(a.raw, b.raw);
+    result.raw = _mm512_unpacklo_pd(a.raw, b.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_min(wcn_v512d_t a, wcn_v512d_t b) {
+WCN_INLINE wcn_v512d_t wcn_v512d_unpackhi(wcn_v512d_t a, wcn_v512d_t b) {
     wcn_v512d_t result;
-    result.raw = _mm512_min_pd(a.raw, b.raw);
+    result.raw = _mm512_unpackhi_pd(a.raw, b.raw);
     return result;
 }
 
-/* ========== Square Root ========== */
+/* ========== Conversions ========== */
 
-WCN_INLINE wcn_v512f_t wcn_v512f_sqrt(wcn_v512f_t vec) {
+WCN_INLINE wcn_v512f_t wcn_v512i_to_v512f(wcn_v512i_t vec) {
     wcn_v512f_t result;
-    result.raw = _mm512_sqrt_ps(vec.raw);
+    result.raw = _mm512_cvtepi32_ps(vec.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512d_t wcn_v512d_sqrt(wcn_v512d_t vec) {
-    wcn_v512d_t result;
-    result.raw = _mm512_sqrt_pd(vec.raw);
+/* Uses the current rounding mode (round to nearest even by default) */
+WCN_INLINE wcn_v512i_t wcn_v512f_to_v512i(wcn_v512f_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_cvtps_epi32(vec.raw);
     return result;
 }
 
-/* ========== Reduction Operations ========== */
-
-WCN_INLINE float wcn_v512f_reduce_add(wcn_v512f_t vec) {
-    return _mm512_reduce_add_ps(vec.raw);
+/* Truncates toward zero, like a C cast */
+WCN_INLINE wcn_v512i_t wcn_v512f_to_v512i_trunc(wcn_v512f_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_cvttps_epi32(vec.raw);
+    return result;
 }
 
-WCN_INLINE float wcn_v512f_reduce_max(wcn_v512f_t vec) {
-    return _mm512_reduce_max_ps(vec.raw);
+WCN_INLINE wcn_v512f_t wcn_v512i_u32_to_v512f(wcn_v512i_t vec) {
+    wcn_v512f_t result;
+    result.raw = _mm512_cvtepu32_ps(vec.raw);
+    return result;
 }
 
-WCN_INLINE float wcn_v512f_reduce_min(wcn_v512f_t vec) {
-    return _mm512_reduce_min_ps(vec.raw);
+/* Widen the low / high eight floats to doubles */
+WCN_INLINE wcn_v512d_t wcn_v512f_to_v512d_lo(wcn_v512f_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_cvtps_pd(_mm512_castps512_ps256(vec.raw));
+    return result;
 }
 
-WCN_INLINE int32_t wcn_v512i_reduce_add_i32(wcn_v512i_t vec) {
-    return _mm512_reduce_add_epi32(vec.raw);
+WCN_INLINE wcn_v512d_t wcn_v512f_to_v512d_hi(wcn_v512f_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_cvtps_pd(_mm256_castpd_ps(
+        _mm512_extractf64x4_pd(_mm512_castps_pd(vec.raw), 1)));
+    return result;
 }
 
-WCN_INLINE int32_t wcn_v512i_reduce_max_i32(wcn_v512i_t vec) {
-    return _mm512_reduce_max_epi32(vec.raw);
+/* Narrow eight doubles to floats */
+WCN_INLINE wcn_v256f_t wcn_v512d_to_v256f(wcn_v512d_t vec) {
+    wcn_v256f_t result;
+    result.raw = _mm512_cvtpd_ps(vec.raw);
+    return result;
 }
 
-WCN_INLINE int32_t wcn_v512i_reduce_min_i32(wcn_v512i_t vec) {
-    return _mm512_reduce_min_epi32(vec.raw);
+WCN_INLINE wcn_v512d_t wcn_v256i_to_v512d(wcn_v256i_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_cvtepi32_pd(vec.raw);
+    return result;
 }
 
-/* ========== Permute/Shuffle Operations ========== */
-
-WCN_INLINE wcn_v512i_t wcn_v512i_permutexvar(wcn_v512i_t idx, wcn_v512i_t a) {
+/* Integer widening (sign/zero extension) */
+WCN_INLINE wcn_v512i_t wcn_v512i_cvt_i8_i32(wcn_v128i_t vec) {
     wcn_v512i_t result;
-    result.raw = _mm512_permutexvar_epi32(idx.raw, a.raw);
+    result.raw = _mm512_cvtepi8_epi32(vec.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_permutexvar(wcn_v512i_t idx, wcn_v512f_t a) {
-    wcn_v512f_t result;
-    result.raw = _mm512_permutexvar_ps(idx.raw, a.raw);
+WCN_INLINE wcn_v512i_t wcn_v512i_cvt_u8_i32(wcn_v128i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_cvtepu8_epi32(vec.raw);
     return result;
 }
 
-/* ========== Gather/Scatter Operations ========== */
-
-WCN_INLINE wcn_v512i_t wcn_v512i_gather_i32(const void* base, wcn_v512i_t vindex, int scale) {
+WCN_INLINE wcn_v512i_t wcn_v512i_cvt_i16_i32(wcn_v256i_t vec) {
     wcn_v512i_t result;
-    result.raw = _mm512_i32gather_epi32(vindex.raw, base, scale);
+    result.raw = _mm512_cvtepi16_epi32(vec.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512f_t wcn_v512f_gather(const float* base, wcn_v512i_t vindex, int scale) {
-    wcn_v512f_t result;
-    result.raw = _mm512_i32gather_ps(vindex.raw, base, scale);
+WCN_INLINE wcn_v512i_t wcn_v512i_cvt_i32_i64(wcn_v256i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_cvtepi32_epi64(vec.raw);
     return result;
 }
 
-WCN_INLINE void wcn_v512i_scatter_i32(void* base, wcn_v512i_t vindex, wcn_v512i_t vec, int scale) {
-    _mm512_i32scatter_epi32(base, vindex.raw, vec.raw, scale);
-}
-
-WCN_INLINE void wcn_v512f_scatter(float* base, wcn_v512i_t vindex, wcn_v512f_t vec, int scale) {
-    _mm512_i32scatter_ps(base, vindex.raw, vec.raw, scale);
-}
-
-/* ========== Mask Operations ========== */
-
-WCN_INLINE wcn_v512f_t wcn_v512f_mask_blend(uint16_t mask, wcn_v512f_t a, wcn_v512f_t b) {
-    wcn_v512f_t result;
-    result.raw = _mm512_mask_blend_ps(mask, a.raw, b.raw);
+/* Integer narrowing: truncating and signed-saturating */
+WCN_INLINE wcn_v128i_t wcn_v512i_cvt_i32_i8(wcn_v512i_t vec) {
+    wcn_v128i_t result;
+    result.raw = _mm512_cvtepi32_epi8(vec.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512i_mask_blend(uint16_t mask, wcn_v512i_t a, wcn_v512i_t b) {
-    wcn_v512i_t result;
-    result.raw = _mm512_mask_blend_epi32(mask, a.raw, b.raw);
+WCN_INLINE wcn_v128i_t wcn_v512i_cvts_i32_i8(wcn_v512i_t vec) {
+    wcn_v128i_t result;
+    result.raw = _mm512_cvtsepi32_epi8(vec.raw);
     return result;
 }
 
-/* ========== Conversions ========== */
-
-WCN_INLINE wcn_v512f_t wcn_v512i_to_v512f(wcn_v512i_t vec) {
-    wcn_v512f_t result;
-    result.raw = _mm512_cvtepi32_ps(vec.raw);
+WCN_INLINE wcn_v256i_t wcn_v512i_cvt_i32_i16(wcn_v512i_t vec) {
+    wcn_v256i_t result;
+    result.raw = _mm512_cvtepi32_epi16(vec.raw);
     return result;
 }
 
-WCN_INLINE wcn_v512i_t wcn_v512f_to_v512i(wcn_v512f_t vec) {
-    wcn_v512i_t result;
-    result.raw = _mm512_cvtps_epi32(vec.raw);
+WCN_INLINE wcn_v256i_t wcn_v512i_cvts_i32_i16(wcn_v512i_t vec) {
+    wcn_v256i_t result;
+    result.raw = _mm512_cvtsepi32_epi16(vec.raw);
     return result;
 }
 
@@ -419,14 +1548,55 @@ WCN_INLINE wcn_v512i_t wcn_v512i_mullo_i64(wcn_v512i_t a, wcn_v512i_t b) {
 }
 #endif
 
-/* ========== Extract 256-bit and 128-bit lanes ========== */
+/* ========== Extract/Insert 256-bit and 128-bit lanes ========== */
 
+/* Note: these return the raw __m256/__m128 value; index must be a constant */
 #define wcn_v512i_extract_v256i(vec, index) _mm512_extracti64x4_epi64((vec).raw, (index))
-#define wcn_v512f_extract_v256f(vec, index) _mm512_extractf32x8_ps((vec).raw, (index))
+#define wcn_v512f_extract_v256f(vec, index) \
+    _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd((vec).raw), (index)))
+#define wcn_v512d_extract_v256d(vec, index) _mm512_extractf64x4_pd((vec).raw, (index))
 
 #define wcn_v512i_extract_v128i(vec, index) _mm512_extracti32x4_epi32((vec).raw, (index))
 #define wcn_v512f_extract_v128f(vec, index) _mm512_extractf32x4_ps((vec).raw, (index))
 
+/* Low half without an instruction */
+WCN_INLINE wcn_v256f_t wcn_v512f_get_low(wcn_v512f_t vec) {
+    wcn_v256f_t result;
+    result.raw = _mm512_castps512_ps256(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256d_t wcn_v512d_get_low(wcn_v512d_t vec) {
+    wcn_v256d_t result;
+    result.raw = _mm512_castpd512_pd256(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v256i_t wcn_v512i_get_low(wcn_v512i_t vec) {
+    wcn_v256i_t result;
+    result.raw = _mm512_castsi512_si256(vec.raw);
+    return result;
+}
+
+#ifndef _MSC_VER
+#define wcn_v512i_insert_v256i(vec, val, index) \
+    ({ \
+        wcn_v512i_t _result; \
+        _result.raw = _mm512_inserti64x4((vec).raw, (val), (index)); \
+        _result; \
+    })
+
+#define wcn_v512d_insert_v256d(vec, val, index) \
+    ({ \
+        wcn_v512d_t _result; \
+        _result.raw = _mm512_insertf64x4((vec).raw, (val), (index)); \
+        _result; \
+    })
+#else
+#define WCN_INSERTI64X4_512(vec, val, index) _mm512_inserti64x4((vec).raw, (val), (index))
+#define WCN_INSERTF64X4_512(vec, val, index) _mm512_insertf64x4((vec).raw, (val), (index))
+#endif
+
 /* ========== Conflict Detection (AVX512CD) ========== */
 
 #ifdef WCN_X86_AVX512CD
@@ -445,11 +1615,15 @@ WCN_INLINE wcn_v512i_t wcn_v512i_lzcnt_i32(wcn_v512i_t vec) {
 
 /* ========== Ternlog (3-input logic) ========== */
 
+#ifndef _MSC_VER
 #define wcn_v512i_ternlog(a, b, c, imm) ({ \
     wcn_v512i_t _result; \
     _result.raw = _mm512_ternarylogic_epi32((a).raw, (b).raw, (c).raw, (imm)); \
     _result; \
 })
+#else
+#define WCN_TERNLOG_EPI32_512(a, b, c, imm) _mm512_ternarylogic_epi32((a).raw, (b).raw, (c).raw, (imm))
+#endif
 
 /* ========== Abs (absolute value) ========== */
 
@@ -459,12 +1633,38 @@ WCN_INLINE wcn_v512i_t wcn_v512i_abs_i32(wcn_v512i_t vec) {
     return result;
 }
 
+WCN_INLINE wcn_v512i_t wcn_v512i_abs_i64(wcn_v512i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_abs_epi64(vec.raw);
+    return result;
+}
+
+#ifdef WCN_X86_AVX512BW
+WCN_INLINE wcn_v512i_t wcn_v512i_abs_i8(wcn_v512i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_abs_epi8(vec.raw);
+    return result;
+}
+
+WCN_INLINE wcn_v512i_t wcn_v512i_abs_i16(wcn_v512i_t vec) {
+    wcn_v512i_t result;
+    result.raw = _mm512_abs_epi16(vec.raw);
+    return result;
+}
+#endif
+
 WCN_INLINE wcn_v512f_t wcn_v512f_abs(wcn_v512f_t vec) {
     wcn_v512f_t result;
     result.raw = _mm512_abs_ps(vec.raw);
     return result;
 }
 
+WCN_INLINE wcn_v512d_t wcn_v512d_abs(wcn_v512d_t vec) {
+    wcn_v512d_t result;
+    result.raw = _mm512_abs_pd(vec.raw);
+    return result;
+}
+
 #endif /* WCN_X86_AVX512F */
 
 #endif /* WCN_X86_AVX512F_H */
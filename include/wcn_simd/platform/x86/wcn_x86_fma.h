@@ -22,7 +22,7 @@
 /* Note: Redefine wcn_v128f_fmadd to use hardware FMA instead of SSE2 emulation */
 
 /* a * b + c - Hardware FMA version */
-static inline wcn_v128f_t __wcn_v128f_fmadd_fma(wcn_v128f_t a, wcn_v128f_t b, wcn_v128f_t c) {
+WCN_INLINE wcn_v128f_t __wcn_v128f_fmadd_fma(wcn_v128f_t a, wcn_v128f_t b, wcn_v128f_t c) {
     wcn_v128f_t result;
     result.raw = _mm_fmadd_ps(a.raw, b.raw, c.raw);
     return result;
@@ -50,14 +50,14 @@ WCN_INLINE wcn_v128f_t wcn_v128f_fnmsub(wcn_v128f_t a, wcn_v128f_t b, wcn_v128f_
     return result;
 }
 
-/* Alternate add/subtract: a * b + c[0], a * b - c[1], ... */
+/* Alternate subtract/add: a * b - c in even lanes, a * b + c in odd lanes */
 WCN_INLINE wcn_v128f_t wcn_v128f_fmaddsub(wcn_v128f_t a, wcn_v128f_t b, wcn_v128f_t c) {
     wcn_v128f_t result;
     result.raw = _mm_fmaddsub_ps(a.raw, b.raw, c.raw);
     return result;
 }
 
-/* Alternate subtract/add: a * b - c[0], a * b + c[1], ... */
+/* Alternate add/subtract: a * b + c in even lanes, a * b - c in odd lanes */
 WCN_INLINE wcn_v128f_t wcn_v128f_fmsubadd(wcn_v128f_t a, wcn_v128f_t b, wcn_v128f_t c) {
     wcn_v128f_t result;
     result.raw = _mm_fmsubadd_ps(a.raw, b.raw, c.raw);
@@ -67,7 +67,7 @@ WCN_INLINE wcn_v128f_t wcn_v128f_fmsubadd(wcn_v128f_t a, wcn_v128f_t b, wcn_v128
 /* ========== Double Precision FMA (128-bit) ========== */
 
 /* a * b + c - Hardware FMA version */
-static inline wcn_v128d_t __wcn_v128d_fmadd_fma(wcn_v128d_t a, wcn_v128d_t b, wcn_v128d_t c) {
+WCN_INLINE wcn_v128d_t __wcn_v128d_fmadd_fma(wcn_v128d_t a, wcn_v128d_t b, wcn_v128d_t c) {
     wcn_v128d_t result;
     result.raw = _mm_fmadd_pd(a.raw, b.raw, c.raw);
     return result;
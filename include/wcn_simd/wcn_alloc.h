@@ -0,0 +1,102 @@
+#ifndef WCN_SIMD_ALLOC_H
+#define WCN_SIMD_ALLOC_H
+
+/*
+ * WCN_SIMD Memory Allocation
+ *
+ * Aligned heap allocation plus two allocators for short-lived SIMD
+ * buffers:
+ *
+ *   - an arena hands out scratch memory by bumping a pointer and releases
+ *     all of it at once with an O(1) reset, which replaces the
+ *     malloc/free pair per temporary in a request loop;
+ *   - a block pool recycles fixed-size blocks (vectors, small tiles)
+ *     through a free list.
+ *
+ * Every address returned is aligned to at least WCN_ALLOC_ALIGN, enough
+ * for aligned and streaming AVX-512 loads/stores. Allocations from
+ * wcn_alloc_set_huge_page_threshold() bytes up are backed by 2 MiB pages
+ * where the OS provides them (explicit huge pages or transparent huge
+ * pages on Linux, large pages on Windows when the process may use them).
+ *
+ * Arenas and block pools are not thread-safe; give each thread its own.
+ *
+ *     wcn_arena_t *scratch = wcn_arena_create(0);
+ *     for (;;) {
+ *         float *tmp = wcn_arena_alloc(scratch, n * sizeof(float), 0);
+ *         ...
+ *         wcn_arena_reset(scratch);
+ *     }
+ *     wcn_arena_destroy(scratch);
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Default and minimum alignment: one cache line / one 512-bit vector */
+#define WCN_ALLOC_ALIGN 64
+
+/* Size of a huge page */
+#define WCN_ALLOC_HUGE_PAGE ((size_t)2 << 20)
+
+/* ========== Aligned Heap Allocation ========== */
+
+/* Allocate bytes aligned to align (a power of two; 0 means WCN_ALLOC_ALIGN).
+ * Returns NULL on failure. Release with wcn_aligned_free(). */
+WCN_API_EXPORT void *wcn_aligned_alloc(size_t bytes, size_t align);
+WCN_API_EXPORT void wcn_aligned_free(void *ptr);
+
+/* Resize a block from wcn_aligned_alloc()/wcn_alloc(), keeping its
+ * alignment and contents; NULL ptr allocates */
+WCN_API_EXPORT void *wcn_realloc(void *ptr, size_t bytes);
+
+/* wcn_aligned_alloc(bytes, WCN_ALLOC_ALIGN) / wcn_aligned_free() */
+WCN_API_EXPORT void *wcn_alloc(size_t bytes);
+WCN_API_EXPORT void wcn_free(void *ptr);
+
+/* Allocations of at least this many bytes (including arena and block pool
+ * backing memory) try huge pages first. SIZE_MAX, the default, disables
+ * huge pages. */
+WCN_API_EXPORT void wcn_alloc_set_huge_page_threshold(size_t bytes);
+
+/* ========== Arena ========== */
+
+typedef struct wcn_arena wcn_arena_t;
+
+/* block_bytes is the size of each backing block (0 means 1 MiB); bigger
+ * requests get a block of their own */
+WCN_API_EXPORT wcn_arena_t *wcn_arena_create(size_t block_bytes);
+WCN_API_EXPORT void wcn_arena_destroy(wcn_arena_t *arena);
+
+/* align as for wcn_aligned_alloc(); returns NULL when out of memory */
+WCN_API_EXPORT void *wcn_arena_alloc(wcn_arena_t *arena, size_t bytes,
+                                     size_t align);
+
+/* Release everything allocated so far; the backing blocks are kept */
+WCN_API_EXPORT void wcn_arena_reset(wcn_arena_t *arena);
+
+/* Bytes handed out since the last reset (including alignment padding) */
+WCN_API_EXPORT size_t wcn_arena_used(const wcn_arena_t *arena);
+
+/* ========== Block Pool ========== */
+
+typedef struct wcn_block_pool wcn_block_pool_t;
+
+/* Blocks of block_size bytes (rounded up to a multiple of WCN_ALLOC_ALIGN
+ * and aligned to it), carved blocks_per_chunk at a time (0 means as many
+ * as fit in 64 KiB) */
+WCN_API_EXPORT wcn_block_pool_t *
+wcn_block_pool_create(size_t block_size, size_t blocks_per_chunk);
+WCN_API_EXPORT void wcn_block_pool_destroy(wcn_block_pool_t *pool);
+
+WCN_API_EXPORT void *wcn_block_pool_alloc(wcn_block_pool_t *pool);
+WCN_API_EXPORT void wcn_block_pool_free(wcn_block_pool_t *pool, void *block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_ALLOC_H */
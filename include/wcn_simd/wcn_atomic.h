@@ -114,6 +114,129 @@ WCN_INLINE wcn_v128d_t wcn_v128d_atomic_exchange(wcn_v128d_t* ptr, wcn_v128d_t v
 WCN_INLINE void wcn_atomic_thread_fence(wcn_memory_order_t order);
 WCN_INLINE void wcn_atomic_signal_fence(wcn_memory_order_t order);
 
+/* ========== Scalar Atomic Operations ========== */
+
+/*
+ * Word-sized atomics for counters, flags and indices (e.g. the thread pool's
+ * deques), using the same memory-order vocabulary as the vector operations.
+ * They map directly onto the compiler builtins, so an order known at compile
+ * time costs nothing extra. compare_exchange returns 1 on success and stores
+ * the observed value to *expected on failure.
+ */
+
+#if defined(WCN_HAS_GCC_ATOMIC)
+
+#define WCN_ATOMIC_HAS_SCALAR 1
+
+WCN_INLINE int wcn_atomic_builtin_order(wcn_memory_order_t order) {
+    switch (order) {
+        case WCN_MEMORY_ORDER_RELAXED: return __ATOMIC_RELAXED;
+        case WCN_MEMORY_ORDER_CONSUME: return __ATOMIC_CONSUME;
+        case WCN_MEMORY_ORDER_ACQUIRE: return __ATOMIC_ACQUIRE;
+        case WCN_MEMORY_ORDER_RELEASE: return __ATOMIC_RELEASE;
+        case WCN_MEMORY_ORDER_ACQ_REL: return __ATOMIC_ACQ_REL;
+        default:                       return __ATOMIC_SEQ_CST;
+    }
+}
+
+/* Failure orders may not contain a release */
+WCN_INLINE int wcn_atomic_builtin_failure_order(wcn_memory_order_t order) {
+    switch (order) {
+        case WCN_MEMORY_ORDER_RELEASE: return __ATOMIC_RELAXED;
+        case WCN_MEMORY_ORDER_ACQ_REL: return __ATOMIC_ACQUIRE;
+        default:                       return wcn_atomic_builtin_order(order);
+    }
+}
+
+#define WCN_ATOMIC_SCALAR_OPS(suffix, type)                                          \
+    WCN_INLINE type wcn_atomic_load_##suffix(const volatile type* ptr,               \
+                                             wcn_memory_order_t order) {             \
+        return __atomic_load_n(ptr, wcn_atomic_builtin_order(order));                \
+    }                                                                                \
+    WCN_INLINE void wcn_atomic_store_##suffix(volatile type* ptr, type value,        \
+                                              wcn_memory_order_t order) {            \
+        __atomic_store_n(ptr, value, wcn_atomic_builtin_order(order));               \
+    }                                                                                \
+    WCN_INLINE type wcn_atomic_exchange_##suffix(volatile type* ptr, type value,     \
+                                                 wcn_memory_order_t order) {         \
+        return __atomic_exchange_n(ptr, value, wcn_atomic_builtin_order(order));     \
+    }                                                                                \
+    WCN_INLINE type wcn_atomic_fetch_add_##suffix(volatile type* ptr, type value,    \
+                                                  wcn_memory_order_t order) {        \
+        return __atomic_fetch_add(ptr, value, wcn_atomic_builtin_order(order));      \
+    }                                                                                \
+    WCN_INLINE int wcn_atomic_compare_exchange_##suffix(                             \
+        volatile type* ptr, type* expected, type desired,                            \
+        wcn_memory_order_t success_order, wcn_memory_order_t failure_order) {        \
+        return __atomic_compare_exchange_n(                                          \
+            ptr, expected, desired, 0, wcn_atomic_builtin_order(success_order),      \
+            wcn_atomic_builtin_failure_order(failure_order));                        \
+    }
+
+WCN_ATOMIC_SCALAR_OPS(i32, int32_t)
+WCN_ATOMIC_SCALAR_OPS(i64, int64_t)
+
+#undef WCN_ATOMIC_SCALAR_OPS
+
+#elif defined(WCN_HAS_MSVC_ATOMIC)
+
+#include <intrin.h>
+
+#define WCN_ATOMIC_HAS_SCALAR 1
+
+/* Interlocked operations are full barriers; plain volatile accesses have
+ * acquire/release semantics under /volatile:ms, and seq_cst loads and
+ * stores go through an interlocked operation. */
+#define WCN_ATOMIC_SCALAR_OPS(suffix, type, itype, isuffix)                          \
+    WCN_INLINE type wcn_atomic_load_##suffix(const volatile type* ptr,               \
+                                             wcn_memory_order_t order) {             \
+        if (order == WCN_MEMORY_ORDER_SEQ_CST) {                                     \
+            return (type)_InterlockedCompareExchange##isuffix(                       \
+                (volatile itype*)ptr, 0, 0);                                         \
+        }                                                                            \
+        return *ptr;                                                                 \
+    }                                                                                \
+    WCN_INLINE void wcn_atomic_store_##suffix(volatile type* ptr, type value,        \
+                                              wcn_memory_order_t order) {            \
+        if (order == WCN_MEMORY_ORDER_SEQ_CST) {                                     \
+            _InterlockedExchange##isuffix((volatile itype*)ptr, (itype)value);       \
+        } else {                                                                     \
+            *ptr = value;                                                            \
+        }                                                                            \
+    }                                                                                \
+    WCN_INLINE type wcn_atomic_exchange_##suffix(volatile type* ptr, type value,     \
+                                                 wcn_memory_order_t order) {         \
+        (void)order;                                                                 \
+        return (type)_InterlockedExchange##isuffix((volatile itype*)ptr,             \
+                                                   (itype)value);                    \
+    }                                                                                \
+    WCN_INLINE type wcn_atomic_fetch_add_##suffix(volatile type* ptr, type value,    \
+                                                  wcn_memory_order_t order) {        \
+        (void)order;                                                                 \
+        return (type)_InterlockedExchangeAdd##isuffix((volatile itype*)ptr,          \
+                                                      (itype)value);                 \
+    }                                                                                \
+    WCN_INLINE int wcn_atomic_compare_exchange_##suffix(                             \
+        volatile type* ptr, type* expected, type desired,                            \
+        wcn_memory_order_t success_order, wcn_memory_order_t failure_order) {        \
+        (void)success_order;                                                         \
+        (void)failure_order;                                                         \
+        const type old = (type)_InterlockedCompareExchange##isuffix(                 \
+            (volatile itype*)ptr, (itype)desired, (itype)*expected);                 \
+        if (old == *expected) {                                                      \
+            return 1;                                                                \
+        }                                                                            \
+        *expected = old;                                                             \
+        return 0;                                                                    \
+    }
+
+WCN_ATOMIC_SCALAR_OPS(i32, int32_t, long, )
+WCN_ATOMIC_SCALAR_OPS(i64, int64_t, __int64, 64)
+
+#undef WCN_ATOMIC_SCALAR_OPS
+
+#endif /* WCN_HAS_GCC_ATOMIC / WCN_HAS_MSVC_ATOMIC */
+
 /* ========== Platform-Specific Atomic Features ========== */
 
 typedef struct {
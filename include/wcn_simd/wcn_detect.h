@@ -20,6 +20,9 @@
     #if defined(__AVX512VL__)
         #define WCN_X86_AVX512VL 1
     #endif
+    #if defined(__AVX512CD__)
+        #define WCN_X86_AVX512CD 1
+    #endif
     
     /* AVX2 */
     #if defined(__AVX2__)
@@ -31,6 +34,11 @@
         #define WCN_X86_FMA 1
     #endif
     
+    /* F16C (MSVC allows its intrinsics from /arch:AVX2 on) */
+    #if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define WCN_X86_F16C 1
+    #endif
+    
     /* AVX */
     #if defined(__AVX__)
         #define WCN_X86_AVX 1
@@ -0,0 +1,107 @@
+#ifndef WCN_SIMD_EXPR_H
+#define WCN_SIMD_EXPR_H
+
+/*
+ * WCN_SIMD Fused Element-wise Expressions
+ *
+ * Every wcn_simd_*_array_f32 call streams whole arrays through memory, so a
+ * chain such as y = a*x + b*z costs one pass per step. An expression is
+ * instead described once as a small op graph over input arrays and
+ * constants, compiled into a reusable plan, and evaluated in a single
+ * blocked pass: intermediates stay in L1-sized block buffers and every
+ * input and output element is touched exactly once.
+ *
+ *     wcn_expr_t *e = wcn_expr_create();
+ *     wcn_expr_node_t x = wcn_expr_input(e, 0);
+ *     wcn_expr_node_t z = wcn_expr_input(e, 1);
+ *     wcn_expr_node_t y = wcn_expr_fma(e, wcn_expr_const(e, a), x,
+ *                             wcn_expr_mul(e, wcn_expr_const(e, b), z));
+ *     wcn_expr_plan_t *plan = wcn_expr_compile(e, y);
+ *     wcn_expr_destroy(e);
+ *
+ *     const float *in[] = {x_data, z_data};
+ *     wcn_expr_eval(plan, in, out, count);     (as often as needed)
+ *     wcn_expr_plan_destroy(plan);
+ *
+ * Builder calls never fail loudly: an invalid argument or a full graph
+ * yields WCN_EXPR_INVALID, which propagates through later calls and makes
+ * wcn_expr_compile() return NULL. Identical sub-expressions are shared and
+ * all-constant ones are folded while the graph is built.
+ *
+ * A compiled plan is immutable; it can be evaluated from several threads
+ * at once. The output may alias an input array (exactly, not partially).
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of distinct input arrays an expression can read */
+#define WCN_EXPR_MAX_INPUTS 8
+
+/* Maximum number of nodes (inputs, constants and operations) per graph */
+#define WCN_EXPR_MAX_NODES 64
+
+/* Returned by the builder functions on error */
+#define WCN_EXPR_INVALID (-1)
+
+typedef struct wcn_expr wcn_expr_t;
+typedef struct wcn_expr_plan wcn_expr_plan_t;
+typedef int wcn_expr_node_t;
+
+/* ========== Graph Construction ========== */
+
+WCN_API_EXPORT wcn_expr_t *wcn_expr_create(void);
+WCN_API_EXPORT void wcn_expr_destroy(wcn_expr_t *e);
+
+/* Leaves: the index-th input array, or a constant broadcast to all lanes */
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_input(wcn_expr_t *e, unsigned index);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_const(wcn_expr_t *e, float value);
+
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_add(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_sub(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_mul(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_div(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_min(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_max(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b);
+
+/* a * b + c */
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_fma(wcn_expr_t *e, wcn_expr_node_t a,
+                                            wcn_expr_node_t b,
+                                            wcn_expr_node_t c);
+
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_abs(wcn_expr_t *e, wcn_expr_node_t a);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_neg(wcn_expr_t *e, wcn_expr_node_t a);
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_sqrt(wcn_expr_t *e, wcn_expr_node_t a);
+
+/* min(max(x, lo), hi) */
+WCN_API_EXPORT wcn_expr_node_t wcn_expr_clamp(wcn_expr_t *e, wcn_expr_node_t x,
+                                              float lo, float hi);
+
+/* ========== Plans ========== */
+
+/* Compile the sub-graph rooted at root; NULL if the graph is invalid or
+ * needs more live intermediates than the evaluator has block buffers. The
+ * builder can be destroyed or extended afterwards. */
+WCN_API_EXPORT wcn_expr_plan_t *wcn_expr_compile(const wcn_expr_t *e,
+                                                 wcn_expr_node_t root);
+WCN_API_EXPORT void wcn_expr_plan_destroy(wcn_expr_plan_t *plan);
+
+/* out[i] = expr(inputs[0][i], inputs[1][i], ...) for i < count */
+WCN_API_EXPORT void wcn_expr_eval(const wcn_expr_plan_t *plan,
+                                  const float *const *inputs, float *out,
+                                  size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_EXPR_H */
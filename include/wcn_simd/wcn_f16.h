@@ -0,0 +1,149 @@
+#ifndef WCN_SIMD_F16_H
+#define WCN_SIMD_F16_H
+
+/*
+ * WCN_SIMD 16-bit Floating-Point Storage
+ *
+ * wcn_f16_t holds an IEEE 754 binary16 value (1 sign, 5 exponent, 10
+ * mantissa bits) and wcn_bf16_t a bfloat16 (the upper half of a float: 1
+ * sign, 8 exponent, 7 mantissa bits). Both are storage formats: arrays of
+ * them are converted to and from float in bulk, or read directly by the
+ * mixed-precision kernels below, which widen to float and accumulate in
+ * float. Halving the bytes per element roughly doubles the speed of
+ * memory-bound scans such as similarity search over stored embeddings:
+ *
+ *     float score = wcn_simd_dot_product_f16(query_f16, row_f16, dim);
+ *
+ * Conversions to float are exact. Conversions from float round to nearest
+ * even; values beyond the format's range become infinities, and NaN stays
+ * NaN (quiet, keeping the upper payload bits that fit, as the hardware
+ * conversions do). The array functions use F16C or AVX-512F on x86 and NEON on
+ * AArch64 for binary16, and integer bit manipulation everywhere else
+ * (including bfloat16, which is a shift and a rounding add).
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint16_t wcn_f16_t;
+typedef uint16_t wcn_bf16_t;
+
+/* ========== Scalar Conversions ========== */
+
+/* Bit casts between float and its encoding */
+WCN_INLINE float wcn_f32_from_bits(uint32_t bits) {
+    union {
+        uint32_t u;
+        float f;
+    } v;
+    v.u = bits;
+    return v.f;
+}
+
+WCN_INLINE uint32_t wcn_f32_to_bits(float f) {
+    union {
+        uint32_t u;
+        float f;
+    } v;
+    v.f = f;
+    return v.u;
+}
+
+/* Exact; subnormals go through an integer conversion, so the result does
+ * not depend on denormals-are-zero modes */
+WCN_INLINE float wcn_f16_to_float(wcn_f16_t h) {
+    const uint32_t e = h & 0x7FFFu;
+    const uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t bits;
+    if (e < 0x400u) {
+        /* zero or subnormal: e * 2^-24 */
+        bits = wcn_f32_to_bits((float)e * 5.9604644775390625e-08f);
+    } else if (e == 0x7C00u) {
+        bits = 0x7F800000u; /* infinity */
+    } else if (e > 0x7C00u) {
+        bits = (e << 13) | 0x7FC00000u; /* NaN, quieted, payload kept */
+    } else {
+        bits = (e << 13) + (112u << 23); /* rebias 15 -> 127 */
+    }
+    return wcn_f32_from_bits(bits | sign);
+}
+
+/* Round to nearest even */
+WCN_INLINE wcn_f16_t wcn_float_to_f16(float f) {
+    uint32_t u = wcn_f32_to_bits(f);
+    const uint32_t sign = u & 0x80000000u;
+    uint32_t h;
+    u ^= sign;
+    if (u >= (143u << 23)) {
+        /* 2^16 and up overflow (65520 and up already round to infinity
+         * below); NaN becomes a quiet NaN with the top of its payload, as
+         * vcvtps2ph does */
+        h = u > 0x7F800000u ? 0x7E00u | ((u >> 13) & 0x3FFu) : 0x7C00u;
+    } else if (u < (113u << 23)) {
+        /* Below 2^-14: adding 0.5 leaves the subnormal mantissa, rounded,
+         * in the low bits */
+        h = wcn_f32_to_bits(wcn_f32_from_bits(u) + 0.5f) -
+            wcn_f32_to_bits(0.5f);
+    } else {
+        const uint32_t odd = (u >> 13) & 1u;
+        h = (u + ((uint32_t)(15 - 127) << 23) + 0xFFFu + odd) >> 13;
+    }
+    return (wcn_f16_t)(h | (sign >> 16));
+}
+
+/* Exact */
+WCN_INLINE float wcn_bf16_to_float(wcn_bf16_t b) {
+    return wcn_f32_from_bits((uint32_t)b << 16);
+}
+
+/* Round to nearest even */
+WCN_INLINE wcn_bf16_t wcn_float_to_bf16(float f) {
+    const uint32_t u = wcn_f32_to_bits(f);
+    if ((u & 0x7FFFFFFFu) > 0x7F800000u) {
+        return (wcn_bf16_t)((u >> 16) | 0x40u); /* quiet NaN */
+    }
+    return (wcn_bf16_t)((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+}
+
+/* ========== Array Conversions ========== */
+
+WCN_API_EXPORT void wcn_simd_f16_to_f32(const wcn_f16_t *src, float *dst,
+                                        size_t count);
+WCN_API_EXPORT void wcn_simd_f32_to_f16(const float *src, wcn_f16_t *dst,
+                                        size_t count);
+WCN_API_EXPORT void wcn_simd_bf16_to_f32(const wcn_bf16_t *src, float *dst,
+                                         size_t count);
+WCN_API_EXPORT void wcn_simd_f32_to_bf16(const float *src, wcn_bf16_t *dst,
+                                         size_t count);
+
+/* ========== Mixed-Precision Kernels ========== */
+
+/* 16-bit inputs, float products and float accumulation */
+WCN_API_EXPORT float wcn_simd_dot_product_f16(const wcn_f16_t *a,
+                                              const wcn_f16_t *b,
+                                              size_t count);
+WCN_API_EXPORT float wcn_simd_dot_product_bf16(const wcn_bf16_t *a,
+                                               const wcn_bf16_t *b,
+                                               size_t count);
+
+/* c[i] += a[i] * b[i], with float c */
+WCN_API_EXPORT void wcn_simd_fmadd_array_f16(const wcn_f16_t *a,
+                                             const wcn_f16_t *b, float *c,
+                                             size_t count);
+WCN_API_EXPORT void wcn_simd_fmadd_array_bf16(const wcn_bf16_t *a,
+                                              const wcn_bf16_t *b, float *c,
+                                              size_t count);
+
+WCN_API_EXPORT float wcn_simd_reduce_sum_f16(const wcn_f16_t *data,
+                                             size_t count);
+WCN_API_EXPORT float wcn_simd_reduce_sum_bf16(const wcn_bf16_t *data,
+                                              size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_F16_H */
@@ -0,0 +1,95 @@
+#ifndef WCN_SIMD_FFT_H
+#define WCN_SIMD_FFT_H
+
+/*
+ * WCN_SIMD Fast Fourier Transforms
+ *
+ * Single-precision complex-to-complex transforms of n points and
+ * real-to-complex / complex-to-real transforms of n real samples, for any n
+ * whose only prime factors are 2, 3 and 5. Complex data is interleaved
+ * (re, im) float pairs:
+ *
+ *     X[k] = sum over j < n of x[j] * e^(-2 pi i j k / n)      (forward)
+ *     x[j] = sum over k < n of X[k] * e^(+2 pi i j k / n)      (inverse)
+ *
+ * Neither direction is scaled, so an inverse of a forward transform gives
+ * n times the input. A real transform of n samples produces the n / 2 + 1
+ * non-redundant bins X[0] .. X[n / 2] (the rest are their conjugates), and
+ * its inverse reads the same n / 2 + 1 bins and ignores the imaginary parts
+ * of X[0] and X[n / 2]:
+ *
+ *     const wcn_fft_plan_t *p = wcn_simd_fft_plan_r2c(1024);
+ *     float spectrum[2 * 513];
+ *     wcn_simd_fft_r2c(p, frame, spectrum);
+ *
+ * Plans are cached per size and kind: asking twice for the same plan
+ * returns the same pointer, and a plan stays valid until
+ * wcn_simd_fft_plan_cache_clear(). Executing one does not modify it, so a
+ * plan may be used by any number of threads at once.
+ *
+ * The transforms are self-sorting (Stockham) sequences of radix-8, 4, 2, 5
+ * and 3 passes that vectorize over whole vectors of complex points: the
+ * first pass over groups of butterflies, with a register transpose on the
+ * way out, the others over the points within a butterfly leg. Twiddles are
+ * applied with fmaddsub (fmsubadd for the inverse), from one table for both
+ * directions. Real transforms run a complex transform of n / 2 points on
+ * the samples taken in pairs and split its output, or merge it back before
+ * the inverse. Sizes with a power-of-two factor of 64 or more are fully
+ * vectorized on every ISA; passes that cannot fill a vector fall back to
+ * scalar code.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wcn_fft_plan wcn_fft_plan_t;
+
+typedef enum {
+    WCN_FFT_FORWARD = 0, /* e^(-2 pi i j k / n) */
+    WCN_FFT_INVERSE = 1  /* e^(+2 pi i j k / n), unscaled */
+} wcn_fft_dir_t;
+
+/* ========== Plans ========== */
+
+/* Plan for complex transforms of n points; NULL if n is 0 or has a prime
+ * factor other than 2, 3 and 5, or memory runs out */
+WCN_API_EXPORT const wcn_fft_plan_t *wcn_simd_fft_plan_c2c(size_t n);
+
+/* Plan for real transforms of n samples (wcn_simd_fft_r2c() and
+ * wcn_simd_fft_c2r()); n must be even, with n / 2 as for complex plans */
+WCN_API_EXPORT const wcn_fft_plan_t *wcn_simd_fft_plan_r2c(size_t n);
+
+/* Free every cached plan. No plan may be in use, and none of the pointers
+ * handed out before may be used again. */
+WCN_API_EXPORT void wcn_simd_fft_plan_cache_clear(void);
+
+/* ========== Transforms ========== */
+
+/* out (n complex) = the transform of in (n complex) with a complex plan.
+ * in == out transforms in place; partially overlapping arrays are not
+ * allowed. Returns 0, or -1 if the plan is NULL or of the wrong kind, or
+ * the scratch buffer of large transforms could not be allocated (out is
+ * then unchanged). */
+WCN_API_EXPORT int wcn_simd_fft_c2c(const wcn_fft_plan_t *plan,
+                                    const float *in, float *out,
+                                    wcn_fft_dir_t dir);
+
+/* out (n / 2 + 1 complex) = the forward transform of in (n floats) with a
+ * real plan. in == out works in place, with the array sized for out. */
+WCN_API_EXPORT int wcn_simd_fft_r2c(const wcn_fft_plan_t *plan,
+                                    const float *in, float *out);
+
+/* out (n floats) = the inverse transform of in (n / 2 + 1 complex) with a
+ * real plan; in == out works in place. in is left unchanged when the
+ * transform is out of place. */
+WCN_API_EXPORT int wcn_simd_fft_c2r(const wcn_fft_plan_t *plan,
+                                    const float *in, float *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_FFT_H */
@@ -0,0 +1,93 @@
+#ifndef WCN_SIMD_FIR_H
+#define WCN_SIMD_FIR_H
+
+/*
+ * WCN_SIMD FIR Filters
+ *
+ * Causal FIR filtering (1D convolution) of float and Q-format int16
+ * signals:
+ *
+ *     y[n] = sum over k < ntaps of taps[k] * x[n - k]
+ *
+ * either over one buffer, with the samples before x[0] taken as zero, or
+ * through a filter object that keeps the last ntaps - 1 samples between
+ * calls, so that a signal delivered in buffers of any size filters exactly
+ * as if it were one array:
+ *
+ *     wcn_fir_f32_t *lp = wcn_fir_f32_create(taps, 63);
+ *     while (read_block(in, 4096)) {
+ *         wcn_fir_f32_process(lp, in, out, 4096);
+ *         ...
+ *     }
+ *     wcn_fir_f32_destroy(lp);
+ *
+ * Only the first ntaps - 1 outputs of a call read the saved history, from
+ * a tap-sized scratch window; the rest read the caller's buffer in place.
+ *
+ * Filters of up to one vector of taps (16 on AVX-512, 8 on AVX2, 4 on
+ * 128-bit ISAs) keep every tap in a register and build the shifted input
+ * windows from pairs of vectors (valignd on AVX-512). Longer ones block
+ * the outputs: a tile of output vectors stays in registers while groups of
+ * taps one vector apart sweep over it, so each input load feeds several
+ * multiply-adds. The int16 filters multiply tap pairs with pmaddwd on x86
+ * and widening multiply-accumulates on AArch64.
+ *
+ * A filter object is not thread-safe; large calls are split across the
+ * thread pool internally. y must not overlap x.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wcn_fir_f32 wcn_fir_f32_t;
+typedef struct wcn_fir_i16 wcn_fir_i16_t;
+
+/* ========== One-Shot ========== */
+
+/* y[n] for n < count, from x[0..count) and zeros before it. Returns 0, or
+ * -1 if ntaps is 0 or the tap scratch could not be allocated (y is then
+ * unchanged). */
+WCN_API_EXPORT int wcn_simd_fir_f32(const float *x, float *y, size_t count,
+                                    const float *taps, size_t ntaps);
+
+/* int16 samples and taps; each output is the 32-bit sum of products,
+ * rounded to nearest and shifted right by shift (15 for Q15 taps), then
+ * saturated to int16. The sum wraps if it overflows 32 bits, which Q15
+ * taps whose absolute values add up to less than 2.0 rule out. shift must
+ * be below 32. */
+WCN_API_EXPORT int wcn_simd_fir_i16(const int16_t *x, int16_t *y,
+                                    size_t count, const int16_t *taps,
+                                    size_t ntaps, unsigned shift);
+
+/* ========== Streaming ========== */
+
+/* A filter with zeroed history; NULL if ntaps is 0 (or, for int16, shift
+ * is 32 or more) or memory runs out. The taps are copied. */
+WCN_API_EXPORT wcn_fir_f32_t *wcn_fir_f32_create(const float *taps,
+                                                 size_t ntaps);
+WCN_API_EXPORT wcn_fir_i16_t *wcn_fir_i16_create(const int16_t *taps,
+                                                 size_t ntaps,
+                                                 unsigned shift);
+
+/* Filter the next count samples of the signal */
+WCN_API_EXPORT void wcn_fir_f32_process(wcn_fir_f32_t *fir, const float *x,
+                                        float *y, size_t count);
+WCN_API_EXPORT void wcn_fir_i16_process(wcn_fir_i16_t *fir,
+                                        const int16_t *x, int16_t *y,
+                                        size_t count);
+
+/* Forget the history, as if the filter had just been created */
+WCN_API_EXPORT void wcn_fir_f32_reset(wcn_fir_f32_t *fir);
+WCN_API_EXPORT void wcn_fir_i16_reset(wcn_fir_i16_t *fir);
+
+WCN_API_EXPORT void wcn_fir_f32_destroy(wcn_fir_f32_t *fir);
+WCN_API_EXPORT void wcn_fir_i16_destroy(wcn_fir_i16_t *fir);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_FIR_H */
@@ -0,0 +1,53 @@
+#ifndef WCN_SIMD_GEMM_H
+#define WCN_SIMD_GEMM_H
+
+/*
+ * WCN_SIMD Matrix Multiplication
+ *
+ * wcn_simd_sgemm() computes C = alpha * op(A) * op(B) + beta * C on
+ * row-major f32 matrices, where op(X) is X or its transpose:
+ *
+ *     // 64 x 256 activations times a 256 x 1024 weight matrix
+ *     wcn_simd_sgemm(WCN_GEMM_NO_TRANS, WCN_GEMM_NO_TRANS, 64, 1024, 256,
+ *                    1.0f, act, 256, w, 1024, 0.0f, out, 1024);
+ *
+ * The implementation follows the usual GotoBLAS structure: panels of op(B)
+ * sized for the last-level cache and blocks of op(A) sized for L2 are
+ * packed into contiguous buffers, and a register-blocked micro-kernel
+ * (12 x 32 on AVX-512, 6 x 16 on AVX2, 8 x 8 on AArch64 NEON, 6 x 16 on
+ * RVV, 6 x 8 on other 128-bit ISAs) runs over them with the whole output
+ * tile held in registers. The block sizes come from wcn_simd_tuning_t.
+ * Large products are split across the thread pool by rows or columns of
+ * C; wcn_simd_set_max_threads(1) keeps them on the calling thread. The
+ * order in which each element is summed does not depend on the split.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WCN_GEMM_NO_TRANS = 0, /* op(X) = X */
+    WCN_GEMM_TRANS = 1     /* op(X) = X^T */
+} wcn_gemm_trans_t;
+
+/* C = alpha * op(A) * op(B) + beta * C with op(A) m x k, op(B) k x n and
+ * C m x n. lda, ldb and ldc are the row strides, in elements, of the
+ * matrices as stored (so A is k x m with stride lda when transposed). With
+ * beta == 0 C is only written, and may hold NaN or garbage on entry. C must
+ * not overlap A or B. Returns 0, or -1 if the packing buffers could not be
+ * allocated (C is then unchanged). */
+WCN_API_EXPORT int wcn_simd_sgemm(wcn_gemm_trans_t trans_a,
+                                  wcn_gemm_trans_t trans_b, size_t m,
+                                  size_t n, size_t k, float alpha,
+                                  const float *a, size_t lda, const float *b,
+                                  size_t ldb, float beta, float *c,
+                                  size_t ldc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_GEMM_H */
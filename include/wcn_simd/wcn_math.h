@@ -0,0 +1,446 @@
+#ifndef WCN_SIMD_MATH_H
+#define WCN_SIMD_MATH_H
+
+/*
+ * WCN_SIMD Vector Math
+ *
+ * exp, exp2, log, log2, log1p, sin, cos, tan, atan2, tanh, erf and pow on
+ * float vectors, as inline functions of the vector types the target has
+ * (wcn_v128f_exp(), wcn_v256f_exp(), wcn_v512f_exp(), ...) and as array
+ * functions dispatched like the other array algorithms:
+ *
+ *     wcn_simd_exp_array_f32(x, y, count, WCN_MATH_ACCURATE);
+ *     wcn_v256f_t s = wcn_v256f_sin_fast(wcn_v256f_load(p));
+ *
+ * Softmax and log-sum-exp over arrays and matrix rows are built on exp.
+ *
+ * The plain functions cover the whole float domain: subnormals, signed
+ * zeros, infinities and NaN give the C99 results, and the error against
+ * the correctly rounded result stays about 1 ulp. Maximum errors measured
+ * over all floats, with and without a fused multiply-add:
+ *
+ *     exp, exp2, log, log2, log1p     0.84 ulp
+ *     sin, cos                        0.78 ulp
+ *     tan                             0.95 ulp   (1.06 without FMA)
+ *     atan2                           0.92 ulp   (1.07 without FMA)
+ *     tanh                            0.81 ulp
+ *     erf                             0.96 ulp   (1.16 without FMA)
+ *     pow                             0.77 ulp
+ *
+ * sin, cos and tan reduce arguments up to 2^18 (2^13 without FMA) in
+ * vector code and hand larger ones to the C library, one lane at a time.
+ *
+ * The _fast variants trade accuracy for speed: shorter polynomials and no
+ * special-value handling. They are within 3.5 ulp, except pow_fast, whose
+ * relative error is about 2^-22 * |y * log2(x)|, for arguments in their
+ * domain; anything else, including NaN and infinities, gives unspecified
+ * results:
+ *
+ *     sin_fast, cos_fast, tan_fast    |x| <= 8192
+ *     log*_fast                       x > 0 and normal (log1p_fast: 1 + x)
+ *     atan2_fast                      finite, not both zero
+ *     pow_fast                        x > 0, finite y
+ *
+ * The vector functions exist for wcn_v128f_t on SSE2 and AArch64 NEON,
+ * wcn_v256f_t on AVX2 and wcn_v512f_t on AVX-512F. The array functions
+ * work everywhere; targets without those use the same code on scalars.
+ *
+ * The kernels depend on IEEE arithmetic for their error terms, and this
+ * header compiles them with fast-math optimizations off. GCC, however,
+ * applies the caller's -ffast-math after inlining, so code that calls the
+ * plain vector functions must not be built with it there. The array
+ * functions are unaffected by how the calling code is built.
+ */
+
+#include "wcn_types.h"
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    WCN_MATH_ACCURATE = 0, /* plain functions, about 1 ulp */
+    WCN_MATH_FAST = 1      /* _fast functions, within their domains */
+} wcn_math_mode_t;
+
+/* ========== Array Functions ========== */
+
+/* y[i] = f(x[i]); y may be x */
+WCN_API_EXPORT void wcn_simd_exp_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_exp2_array_f32(const float *x, float *y,
+                                            size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_log_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_log2_array_f32(const float *x, float *y,
+                                            size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_log1p_array_f32(const float *x, float *y,
+                                             size_t count,
+                                             wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_sin_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_cos_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_tan_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_tanh_array_f32(const float *x, float *y,
+                                            size_t count, wcn_math_mode_t mode);
+WCN_API_EXPORT void wcn_simd_erf_array_f32(const float *x, float *y,
+                                           size_t count, wcn_math_mode_t mode);
+
+/* s[i] = sin(x[i]), c[i] = cos(x[i]) in one pass */
+WCN_API_EXPORT void wcn_simd_sincos_array_f32(const float *x, float *s,
+                                              float *c, size_t count,
+                                              wcn_math_mode_t mode);
+
+/* z[i] = atan2(y[i], x[i]) */
+WCN_API_EXPORT void wcn_simd_atan2_array_f32(const float *y, const float *x,
+                                             float *z, size_t count,
+                                             wcn_math_mode_t mode);
+
+/* z[i] = pow(x[i], y[i]) */
+WCN_API_EXPORT void wcn_simd_pow_array_f32(const float *x, const float *y,
+                                           float *z, size_t count,
+                                           wcn_math_mode_t mode);
+
+/* ========== Softmax ========== */
+
+/*
+ * Numerically stable softmax and log-sum-exp: one pass finds the maximum
+ * and the sum of exp(x[i] - max) together, block by block, and softmax
+ * adds a normalizing pass, y[i] = exp(x[i] - max) / sum. -inf entries
+ * (masked logits) contribute nothing; a row of only -inf has log-sum-exp
+ * -inf and a NaN softmax, and +inf or NaN entries give NaN. The results
+ * are within a few ulp.
+ */
+
+/* log(sum(exp(x[i]))); -inf for count == 0 */
+WCN_API_EXPORT float wcn_simd_logsumexp_f32(const float *x, size_t count);
+
+/* y[i] = exp(x[i]) / sum(exp(x[j])); y may be x */
+WCN_API_EXPORT void wcn_simd_softmax_f32(const float *x, float *y,
+                                         size_t count);
+
+/* The same over each cols-long row of the row-major rows x cols matrix x:
+ * out[r] is row r's log-sum-exp, and y (which may be x) holds the
+ * row-wise softmax */
+WCN_API_EXPORT void wcn_simd_logsumexp_rows_f32(const float *x, float *out,
+                                                size_t rows, size_t cols);
+WCN_API_EXPORT void wcn_simd_softmax_rows_f32(const float *x, float *y,
+                                              size_t rows, size_t cols);
+
+/* ========== Vector Functions ========== */
+
+/*
+ * Each vector width instantiates wcn_math_impl.h on its raw intrinsic
+ * type, through these adapter macros:
+ *
+ *   WCN_M_F, WCN_M_I, WCN_M_K   float, int32 and compare mask vector types
+ *   WCN_M_FN(name)              name of an instantiated kernel
+ *   WCN_M_LANES, WCN_M_FUSED    lane count; 1 if WCN_M_FMA rounds once
+ *   WCN_M_SET1/ADD/SUB/MUL/DIV/FMA/MIN/MAX, WCN_M_LOAD/STORE
+ *                               float arithmetic (MIN/MAX may return either
+ *                               operand for NaN) and unaligned access
+ *   WCN_M_ISET1/IADD/ISUB/IAND/IXOR, WCN_M_ISLL/ISRA(a, imm)
+ *                               int32 arithmetic and shifts
+ *   WCN_M_ASI/ASF, WCN_M_CVTI/CVTF
+ *                               bit casts; int to float and integral float
+ *                               to int conversions
+ *   WCN_M_LT/LE/EQ, WCN_M_UNORD ordered compares; either operand NaN
+ *   WCN_M_ITEST(i, bit)         lanes of i with the single bit set
+ *   WCN_M_KAND/KOR/KANDNOT(a, b), WCN_M_SEL(k, a, b), WCN_M_ANY(k)
+ *                               mask logic (KANDNOT: a and not b),
+ *                               k ? a : b, and whether any lane is set
+ */
+
+#define WCN_MATH_UNARY(W, name)                                                \
+    WCN_INLINE wcn_##W##_t wcn_##W##_##name(wcn_##W##_t x) {                   \
+        wcn_##W##_t r;                                                         \
+        r.raw = wcn_math_##W##_##name(x.raw);                                  \
+        return r;                                                              \
+    }
+
+#define WCN_MATH_BINARY(W, name)                                               \
+    WCN_INLINE wcn_##W##_t wcn_##W##_##name(wcn_##W##_t a, wcn_##W##_t b) {    \
+        wcn_##W##_t r;                                                         \
+        r.raw = wcn_math_##W##_##name(a.raw, b.raw);                           \
+        return r;                                                              \
+    }
+
+#define WCN_MATH_SINCOS(W, name)                                               \
+    WCN_INLINE void wcn_##W##_##name(wcn_##W##_t x, wcn_##W##_t *s,            \
+                                     wcn_##W##_t *c) {                         \
+        wcn_math_##W##_##name(x.raw, &s->raw, &c->raw);                        \
+    }
+
+/* exp(x), ..., sincos(x, &s, &c), atan2(y, x), pow(x, y) */
+#define WCN_MATH_PUBLIC(W)                                                     \
+    WCN_MATH_UNARY(W, exp)                                                     \
+    WCN_MATH_UNARY(W, exp_fast)                                                \
+    WCN_MATH_UNARY(W, exp2)                                                    \
+    WCN_MATH_UNARY(W, exp2_fast)                                               \
+    WCN_MATH_UNARY(W, log)                                                     \
+    WCN_MATH_UNARY(W, log_fast)                                                \
+    WCN_MATH_UNARY(W, log2)                                                    \
+    WCN_MATH_UNARY(W, log2_fast)                                               \
+    WCN_MATH_UNARY(W, log1p)                                                   \
+    WCN_MATH_UNARY(W, log1p_fast)                                              \
+    WCN_MATH_UNARY(W, sin)                                                     \
+    WCN_MATH_UNARY(W, sin_fast)                                                \
+    WCN_MATH_UNARY(W, cos)                                                     \
+    WCN_MATH_UNARY(W, cos_fast)                                                \
+    WCN_MATH_SINCOS(W, sincos)                                                 \
+    WCN_MATH_SINCOS(W, sincos_fast)                                            \
+    WCN_MATH_UNARY(W, tan)                                                     \
+    WCN_MATH_UNARY(W, tan_fast)                                                \
+    WCN_MATH_UNARY(W, tanh)                                                    \
+    WCN_MATH_UNARY(W, tanh_fast)                                               \
+    WCN_MATH_UNARY(W, erf)                                                     \
+    WCN_MATH_UNARY(W, erf_fast)                                                \
+    WCN_MATH_BINARY(W, atan2)                                                  \
+    WCN_MATH_BINARY(W, atan2_fast)                                             \
+    WCN_MATH_BINARY(W, pow)                                                    \
+    WCN_MATH_BINARY(W, pow_fast)
+
+/* IEEE semantics, without contraction into FMAs, for the code between the
+ * two whatever the floating-point flags of the including file (the
+ * library's array kernels use them as well) */
+#if defined(__clang__)
+#define WCN_MATH_PRECISE_BEGIN                                                 \
+    _Pragma("float_control(precise, on, push)")                                \
+    _Pragma("clang fp contract(off)")
+#define WCN_MATH_PRECISE_END _Pragma("float_control(pop)")
+#elif defined(_MSC_VER)
+#define WCN_MATH_PRECISE_BEGIN __pragma(float_control(precise, on, push))
+#define WCN_MATH_PRECISE_END __pragma(float_control(pop))
+#elif defined(__GNUC__)
+#define WCN_MATH_PRECISE_BEGIN                                                 \
+    _Pragma("GCC push_options")                                                \
+    _Pragma("GCC optimize(\"no-fast-math\", \"fp-contract=off\")")
+#define WCN_MATH_PRECISE_END _Pragma("GCC pop_options")
+#else
+#define WCN_MATH_PRECISE_BEGIN
+#define WCN_MATH_PRECISE_END
+#endif
+
+WCN_MATH_PRECISE_BEGIN
+
+/* ---------- 128-bit: SSE2 ---------- */
+
+#if defined(WCN_X86_SSE2)
+
+#define WCN_M_F __m128
+#define WCN_M_I __m128i
+#define WCN_M_K __m128
+#define WCN_M_FN(name) wcn_math_v128f_##name
+#define WCN_M_LANES 4
+#define WCN_M_SET1(c) _mm_set1_ps(c)
+#define WCN_M_ADD(a, b) _mm_add_ps(a, b)
+#define WCN_M_SUB(a, b) _mm_sub_ps(a, b)
+#define WCN_M_MUL(a, b) _mm_mul_ps(a, b)
+#define WCN_M_DIV(a, b) _mm_div_ps(a, b)
+#if defined(WCN_X86_FMA)
+#define WCN_M_FUSED 1
+#define WCN_M_FMA(a, b, c) _mm_fmadd_ps(a, b, c)
+#else
+#define WCN_M_FUSED 0
+#define WCN_M_FMA(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#endif
+#define WCN_M_MIN(a, b) _mm_min_ps(a, b)
+#define WCN_M_MAX(a, b) _mm_max_ps(a, b)
+#define WCN_M_LOAD(p) _mm_loadu_ps(p)
+#define WCN_M_STORE(p, v) _mm_storeu_ps(p, v)
+#define WCN_M_ISET1(c) _mm_set1_epi32(c)
+#define WCN_M_IADD(a, b) _mm_add_epi32(a, b)
+#define WCN_M_ISUB(a, b) _mm_sub_epi32(a, b)
+#define WCN_M_IAND(a, b) _mm_and_si128(a, b)
+#define WCN_M_IXOR(a, b) _mm_xor_si128(a, b)
+#define WCN_M_ISLL(a, n) _mm_slli_epi32(a, n)
+#define WCN_M_ISRA(a, n) _mm_srai_epi32(a, n)
+#define WCN_M_ASI(f) _mm_castps_si128(f)
+#define WCN_M_ASF(i) _mm_castsi128_ps(i)
+#define WCN_M_CVTI(i) _mm_cvtepi32_ps(i)
+#define WCN_M_CVTF(f) _mm_cvtps_epi32(f)
+#define WCN_M_LT(a, b) _mm_cmplt_ps(a, b)
+#define WCN_M_LE(a, b) _mm_cmple_ps(a, b)
+#define WCN_M_EQ(a, b) _mm_cmpeq_ps(a, b)
+#define WCN_M_UNORD(a, b) _mm_cmpunord_ps(a, b)
+#define WCN_M_ITEST(i, m)                                                      \
+    _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(i, _mm_set1_epi32(m)),      \
+                                     _mm_set1_epi32(m)))
+#define WCN_M_KAND(a, b) _mm_and_ps(a, b)
+#define WCN_M_KOR(a, b) _mm_or_ps(a, b)
+#define WCN_M_KANDNOT(a, b) _mm_andnot_ps(b, a)
+#if defined(WCN_X86_SSE4_1)
+#define WCN_M_SEL(k, a, b) _mm_blendv_ps(b, a, k)
+#else
+#define WCN_M_SEL(k, a, b)                                                     \
+    _mm_or_ps(_mm_and_ps(k, a), _mm_andnot_ps(k, b))
+#endif
+#define WCN_M_ANY(k) (_mm_movemask_ps(k) != 0)
+#include "wcn_math_impl.h"
+
+WCN_MATH_PUBLIC(v128f)
+
+/* ---------- 128-bit: AArch64 NEON ---------- */
+
+#elif defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64)
+
+#define WCN_M_F float32x4_t
+#define WCN_M_I int32x4_t
+#define WCN_M_K uint32x4_t
+#define WCN_M_FN(name) wcn_math_v128f_##name
+#define WCN_M_LANES 4
+#define WCN_M_FUSED 1
+#define WCN_M_SET1(c) vdupq_n_f32(c)
+#define WCN_M_ADD(a, b) vaddq_f32(a, b)
+#define WCN_M_SUB(a, b) vsubq_f32(a, b)
+#define WCN_M_MUL(a, b) vmulq_f32(a, b)
+#define WCN_M_DIV(a, b) vdivq_f32(a, b)
+#define WCN_M_FMA(a, b, c) vfmaq_f32(c, a, b)
+#define WCN_M_MIN(a, b) vminq_f32(a, b)
+#define WCN_M_MAX(a, b) vmaxq_f32(a, b)
+#define WCN_M_LOAD(p) vld1q_f32(p)
+#define WCN_M_STORE(p, v) vst1q_f32(p, v)
+#define WCN_M_ISET1(c) vdupq_n_s32(c)
+#define WCN_M_IADD(a, b) vaddq_s32(a, b)
+#define WCN_M_ISUB(a, b) vsubq_s32(a, b)
+#define WCN_M_IAND(a, b) vandq_s32(a, b)
+#define WCN_M_IXOR(a, b) veorq_s32(a, b)
+#define WCN_M_ISLL(a, n) vshlq_n_s32(a, n)
+#define WCN_M_ISRA(a, n) vshrq_n_s32(a, n)
+#define WCN_M_ASI(f) vreinterpretq_s32_f32(f)
+#define WCN_M_ASF(i) vreinterpretq_f32_s32(i)
+#define WCN_M_CVTI(i) vcvtq_f32_s32(i)
+#define WCN_M_CVTF(f) vcvtnq_s32_f32(f)
+#define WCN_M_LT(a, b) vcltq_f32(a, b)
+#define WCN_M_LE(a, b) vcleq_f32(a, b)
+#define WCN_M_EQ(a, b) vceqq_f32(a, b)
+#define WCN_M_UNORD(a, b)                                                      \
+    vmvnq_u32(vandq_u32(vceqq_f32(a, a), vceqq_f32(b, b)))
+#define WCN_M_ITEST(i, m) vtstq_s32(i, vdupq_n_s32(m))
+#define WCN_M_KAND(a, b) vandq_u32(a, b)
+#define WCN_M_KOR(a, b) vorrq_u32(a, b)
+#define WCN_M_KANDNOT(a, b) vbicq_u32(a, b)
+#define WCN_M_SEL(k, a, b) vbslq_f32(k, a, b)
+#define WCN_M_ANY(k) (vmaxvq_u32(k) != 0)
+#include "wcn_math_impl.h"
+
+WCN_MATH_PUBLIC(v128f)
+
+#endif
+
+/* ---------- 256-bit: AVX2 ---------- */
+
+#if defined(WCN_X86_AVX2)
+
+#define WCN_M_F __m256
+#define WCN_M_I __m256i
+#define WCN_M_K __m256
+#define WCN_M_FN(name) wcn_math_v256f_##name
+#define WCN_M_LANES 8
+#define WCN_M_SET1(c) _mm256_set1_ps(c)
+#define WCN_M_ADD(a, b) _mm256_add_ps(a, b)
+#define WCN_M_SUB(a, b) _mm256_sub_ps(a, b)
+#define WCN_M_MUL(a, b) _mm256_mul_ps(a, b)
+#define WCN_M_DIV(a, b) _mm256_div_ps(a, b)
+#if defined(WCN_X86_FMA)
+#define WCN_M_FUSED 1
+#define WCN_M_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define WCN_M_FUSED 0
+#define WCN_M_FMA(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#endif
+#define WCN_M_MIN(a, b) _mm256_min_ps(a, b)
+#define WCN_M_MAX(a, b) _mm256_max_ps(a, b)
+#define WCN_M_LOAD(p) _mm256_loadu_ps(p)
+#define WCN_M_STORE(p, v) _mm256_storeu_ps(p, v)
+#define WCN_M_ISET1(c) _mm256_set1_epi32(c)
+#define WCN_M_IADD(a, b) _mm256_add_epi32(a, b)
+#define WCN_M_ISUB(a, b) _mm256_sub_epi32(a, b)
+#define WCN_M_IAND(a, b) _mm256_and_si256(a, b)
+#define WCN_M_IXOR(a, b) _mm256_xor_si256(a, b)
+#define WCN_M_ISLL(a, n) _mm256_slli_epi32(a, n)
+#define WCN_M_ISRA(a, n) _mm256_srai_epi32(a, n)
+#define WCN_M_ASI(f) _mm256_castps_si256(f)
+#define WCN_M_ASF(i) _mm256_castsi256_ps(i)
+#define WCN_M_CVTI(i) _mm256_cvtepi32_ps(i)
+#define WCN_M_CVTF(f) _mm256_cvtps_epi32(f)
+#define WCN_M_LT(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define WCN_M_LE(a, b) _mm256_cmp_ps(a, b, _CMP_LE_OQ)
+#define WCN_M_EQ(a, b) _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define WCN_M_UNORD(a, b) _mm256_cmp_ps(a, b, _CMP_UNORD_Q)
+#define WCN_M_ITEST(i, m)                                                      \
+    _mm256_castsi256_ps(_mm256_cmpeq_epi32(                                    \
+        _mm256_and_si256(i, _mm256_set1_epi32(m)), _mm256_set1_epi32(m)))
+#define WCN_M_KAND(a, b) _mm256_and_ps(a, b)
+#define WCN_M_KOR(a, b) _mm256_or_ps(a, b)
+#define WCN_M_KANDNOT(a, b) _mm256_andnot_ps(b, a)
+#define WCN_M_SEL(k, a, b) _mm256_blendv_ps(b, a, k)
+#define WCN_M_ANY(k) (_mm256_movemask_ps(k) != 0)
+#include "wcn_math_impl.h"
+
+WCN_MATH_PUBLIC(v256f)
+
+#endif
+
+/* ---------- 512-bit: AVX-512F ---------- */
+
+#if defined(WCN_X86_AVX512F)
+
+#define WCN_M_F __m512
+#define WCN_M_I __m512i
+#define WCN_M_K __mmask16
+#define WCN_M_FN(name) wcn_math_v512f_##name
+#define WCN_M_LANES 16
+#define WCN_M_FUSED 1
+#define WCN_M_SET1(c) _mm512_set1_ps(c)
+#define WCN_M_ADD(a, b) _mm512_add_ps(a, b)
+#define WCN_M_SUB(a, b) _mm512_sub_ps(a, b)
+#define WCN_M_MUL(a, b) _mm512_mul_ps(a, b)
+#define WCN_M_DIV(a, b) _mm512_div_ps(a, b)
+#define WCN_M_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define WCN_M_MIN(a, b) _mm512_min_ps(a, b)
+#define WCN_M_MAX(a, b) _mm512_max_ps(a, b)
+#define WCN_M_LOAD(p) _mm512_loadu_ps(p)
+#define WCN_M_STORE(p, v) _mm512_storeu_ps(p, v)
+#define WCN_M_ISET1(c) _mm512_set1_epi32(c)
+#define WCN_M_IADD(a, b) _mm512_add_epi32(a, b)
+#define WCN_M_ISUB(a, b) _mm512_sub_epi32(a, b)
+#define WCN_M_IAND(a, b) _mm512_and_si512(a, b)
+#define WCN_M_IXOR(a, b) _mm512_xor_si512(a, b)
+#define WCN_M_ISLL(a, n) _mm512_slli_epi32(a, n)
+#define WCN_M_ISRA(a, n) _mm512_srai_epi32(a, n)
+#define WCN_M_ASI(f) _mm512_castps_si512(f)
+#define WCN_M_ASF(i) _mm512_castsi512_ps(i)
+#define WCN_M_CVTI(i) _mm512_cvtepi32_ps(i)
+#define WCN_M_CVTF(f) _mm512_cvtps_epi32(f)
+#define WCN_M_LT(a, b) _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ)
+#define WCN_M_LE(a, b) _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ)
+#define WCN_M_EQ(a, b) _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)
+#define WCN_M_UNORD(a, b) _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q)
+#define WCN_M_ITEST(i, m) _mm512_test_epi32_mask(i, _mm512_set1_epi32(m))
+#define WCN_M_KAND(a, b) ((__mmask16)((a) & (b)))
+#define WCN_M_KOR(a, b) ((__mmask16)((a) | (b)))
+#define WCN_M_KANDNOT(a, b) ((__mmask16)((a) & ~(b)))
+#define WCN_M_SEL(k, a, b) _mm512_mask_blend_ps(k, b, a)
+#define WCN_M_ANY(k) ((k) != 0)
+#include "wcn_math_impl.h"
+
+WCN_MATH_PUBLIC(v512f)
+
+#endif
+
+WCN_MATH_PRECISE_END
+
+#undef WCN_MATH_UNARY
+#undef WCN_MATH_BINARY
+#undef WCN_MATH_SINCOS
+#undef WCN_MATH_PUBLIC
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_MATH_H */
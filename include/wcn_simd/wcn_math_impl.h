@@ -0,0 +1,976 @@
+/*
+ * WCN_SIMD vector math kernels.
+ *
+ * This file is intentionally not include-guarded: wcn_math.h includes it
+ * once per vector width the target has, and the library once more for
+ * plain floats. Each inclusion describes the width with the WCN_M_*
+ * adapter macros listed in wcn_math.h, which are undefined again at the
+ * end, and names the instantiated kernels with WCN_M_FN(name). The kernels
+ * only use those operations: arithmetic and fused multiply-add, rounding
+ * by the 1.5 * 2^23 addition, int32 shifts and bit casts to take floats
+ * apart and build powers of two, and compare-and-select for branches.
+ *
+ * Every function comes in two flavours. The plain one handles the whole
+ * float range, including subnormals, infinities and NaN, with the bounds
+ * listed in wcn_math.h; it carries error terms in a second float where a
+ * single one is not precise enough. The _fast one uses shorter
+ * polynomials, skips the special-value fixups and assumes the input
+ * domain documented for it.
+ */
+
+/* ========== Helpers ========== */
+
+#define WCN_M_K1(c) WCN_M_SET1(c)
+#define WCN_M_SIGNBIT WCN_M_ISET1(-2147483647 - 1)
+#define WCN_M_INF WCN_M_ASF(WCN_M_ISET1(0x7f800000))
+#define WCN_M_NAN WCN_M_ASF(WCN_M_ISET1(0x7fc00000))
+
+/* Unaligned load and store and a few lane-wise operations, for callers
+ * working on the raw vectors */
+WCN_INLINE WCN_M_F WCN_M_FN(load)(const float *p) { return WCN_M_LOAD(p); }
+
+WCN_INLINE void WCN_M_FN(store)(float *p, WCN_M_F v) { WCN_M_STORE(p, v); }
+
+WCN_INLINE WCN_M_F WCN_M_FN(set1)(float c) { return WCN_M_SET1(c); }
+
+WCN_INLINE WCN_M_F WCN_M_FN(add)(WCN_M_F a, WCN_M_F b) {
+    return WCN_M_ADD(a, b);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(sub)(WCN_M_F a, WCN_M_F b) {
+    return WCN_M_SUB(a, b);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(mul)(WCN_M_F a, WCN_M_F b) {
+    return WCN_M_MUL(a, b);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(max)(WCN_M_F a, WCN_M_F b) {
+    return WCN_M_MAX(a, b);
+}
+
+/* Nearest integer, ties to even, for |x| < 2^22 */
+WCN_INLINE WCN_M_F WCN_M_FN(rint)(WCN_M_F x) {
+    const WCN_M_F magic = WCN_M_K1(12582912.0f);
+    return WCN_M_SUB(WCN_M_ADD(x, magic), magic);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(fabs)(WCN_M_F x) {
+    return WCN_M_ASF(WCN_M_IAND(WCN_M_ASI(x), WCN_M_ISET1(0x7fffffff)));
+}
+
+WCN_INLINE WCN_M_I WCN_M_FN(signbit)(WCN_M_F x) {
+    return WCN_M_IAND(WCN_M_ASI(x), WCN_M_SIGNBIT);
+}
+
+/* Flip the sign of the lanes whose bit 31 of s is set */
+WCN_INLINE WCN_M_F WCN_M_FN(xorsign)(WCN_M_F x, WCN_M_I s) {
+    return WCN_M_ASF(WCN_M_IXOR(WCN_M_ASI(x), s));
+}
+
+/* 2^n for n in [-126, 127] */
+WCN_INLINE WCN_M_F WCN_M_FN(pow2i)(WCN_M_I n) {
+    return WCN_M_ASF(WCN_M_ISLL(WCN_M_IADD(n, WCN_M_ISET1(127)), 23));
+}
+
+/* x * 2^n for n in [-252, 254], in two steps so that a subnormal result
+ * is rounded only once */
+WCN_INLINE WCN_M_F WCN_M_FN(ldexp)(WCN_M_F x, WCN_M_I n) {
+    const WCN_M_I n1 = WCN_M_ISRA(n, 1);
+    return WCN_M_MUL(WCN_M_MUL(x, WCN_M_FN(pow2i)(n1)),
+                     WCN_M_FN(pow2i)(WCN_M_ISUB(n, n1)));
+}
+
+/* a * b = *hi + *lo exactly (Dekker's product without a fused FMA) */
+WCN_INLINE void WCN_M_FN(two_prod)(WCN_M_F a, WCN_M_F b, WCN_M_F *hi,
+                                   WCN_M_F *lo) {
+    const WCN_M_F p = WCN_M_MUL(a, b);
+#if WCN_M_FUSED
+    *lo = WCN_M_FMA(a, b, WCN_M_SUB(WCN_M_K1(0.0f), p));
+#else
+    const WCN_M_F split = WCN_M_K1(4097.0f);
+    const WCN_M_F ca = WCN_M_MUL(a, split);
+    const WCN_M_F cb = WCN_M_MUL(b, split);
+    const WCN_M_F ah = WCN_M_SUB(ca, WCN_M_SUB(ca, a));
+    const WCN_M_F bh = WCN_M_SUB(cb, WCN_M_SUB(cb, b));
+    const WCN_M_F al = WCN_M_SUB(a, ah);
+    const WCN_M_F bl = WCN_M_SUB(b, bh);
+    WCN_M_F e = WCN_M_SUB(WCN_M_MUL(ah, bh), p);
+    e = WCN_M_ADD(e, WCN_M_MUL(ah, bl));
+    e = WCN_M_ADD(e, WCN_M_MUL(al, bh));
+    *lo = WCN_M_ADD(e, WCN_M_MUL(al, bl));
+#endif
+    *hi = p;
+}
+
+/* ========== exp, exp2 ========== */
+
+/* e^r - 1 - r on |r| <= ln2/2 as r^2 P(r); the minimax relative error
+ * of e^r is 2^-28.3 */
+WCN_INLINE WCN_M_F WCN_M_FN(exp_poly_tail)(WCN_M_F r) {
+    WCN_M_F p = WCN_M_K1(1.381459879e-03f);
+    p = WCN_M_FMA(p, r, WCN_M_K1(8.368716575e-03f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(4.166838899e-02f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(1.666652113e-01f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(4.999999404e-01f));
+    return WCN_M_MUL(WCN_M_MUL(r, r), p);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(exp_poly_m1)(WCN_M_F r) {
+    return WCN_M_ADD(r, WCN_M_FN(exp_poly_tail)(r));
+}
+
+/* e^r = (1 + r) + tail with 1 + r split exactly, so that the sum is
+ * rounded once */
+WCN_INLINE WCN_M_F WCN_M_FN(exp_poly)(WCN_M_F r) {
+    const WCN_M_F s = WCN_M_ADD(WCN_M_K1(1.0f), r);
+    const WCN_M_F e = WCN_M_ADD(WCN_M_SUB(WCN_M_K1(1.0f), s), r);
+    return WCN_M_ADD(s, WCN_M_ADD(e, WCN_M_FN(exp_poly_tail)(r)));
+}
+
+/* e^r with relative error 2^-23.2 */
+WCN_INLINE WCN_M_F WCN_M_FN(exp_poly_fast)(WCN_M_F r) {
+    WCN_M_F p = WCN_M_K1(8.312520571e-03f);
+    p = WCN_M_FMA(p, r, WCN_M_K1(4.189015552e-02f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(1.666711420e-01f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(4.999923110e-01f));
+    return WCN_M_ADD(WCN_M_K1(1.0f), WCN_M_FMA(WCN_M_MUL(r, r), p, r));
+}
+
+/* 2^(r + r_lo) on |r| <= 1/2 as 1 + r ln2 + r^2 P(r) + r_lo ln2 2^r,
+ * with 1 + r ln2 in two floats and a single rounding at the end;
+ * P's relative error is 2^-28.3 */
+WCN_INLINE WCN_M_F WCN_M_FN(exp2_poly)(WCN_M_F r, WCN_M_F r_lo) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ln2 = WCN_M_K1(6.93147182e-01f);
+    WCN_M_F p = WCN_M_K1(1.532112219e-04f);
+    p = WCN_M_FMA(p, r, WCN_M_K1(1.339018461e-03f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(9.618526325e-03f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(5.550362170e-02f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(2.402264774e-01f));
+    WCN_M_F t, t_lo;
+    WCN_M_FN(two_prod)(r, ln2, &t, &t_lo);
+    t_lo = WCN_M_FMA(r, WCN_M_K1(-1.90465421e-09f), t_lo);
+    const WCN_M_F s = WCN_M_ADD(one, t);
+    const WCN_M_F tail = WCN_M_MUL(WCN_M_MUL(r, r), p);
+    WCN_M_F e = WCN_M_ADD(WCN_M_ADD(WCN_M_SUB(one, s), t), t_lo);
+    e = WCN_M_FMA(WCN_M_MUL(r_lo, ln2), WCN_M_ADD(s, tail),
+                  WCN_M_ADD(e, tail));
+    return WCN_M_ADD(s, e);
+}
+
+/* 2^r with relative error 2^-23.2 */
+WCN_INLINE WCN_M_F WCN_M_FN(exp2_poly_fast)(WCN_M_F r) {
+    WCN_M_F p = WCN_M_K1(1.330024912e-03f);
+    p = WCN_M_FMA(p, r, WCN_M_K1(9.669728577e-03f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(5.550559983e-02f));
+    p = WCN_M_FMA(p, r, WCN_M_K1(2.402228117e-01f));
+    return WCN_M_ADD(WCN_M_K1(1.0f),
+                     WCN_M_FMA(WCN_M_MUL(r, r), p,
+                               WCN_M_MUL(r, WCN_M_K1(6.93147182e-01f))));
+}
+
+/* x = n ln2 + r with |r| <= ln2/2; the 9-bit high part of ln2 keeps
+ * n * ln2_hi exact with or without a fused multiply-add. x must be
+ * clamped to [-104, 89]. */
+WCN_INLINE WCN_M_F WCN_M_FN(exp_reduce)(WCN_M_F x, WCN_M_F *n) {
+    *n = WCN_M_FN(rint)(WCN_M_MUL(x, WCN_M_K1(1.44269502e+00f)));
+    const WCN_M_F r = WCN_M_FMA(*n, WCN_M_K1(-6.93359375e-01f), x);
+    return WCN_M_FMA(*n, WCN_M_K1(2.12194440e-04f), r);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(exp)(WCN_M_F x) {
+    const WCN_M_F xc =
+        WCN_M_MAX(WCN_M_MIN(x, WCN_M_K1(89.0f)), WCN_M_K1(-104.0f));
+    WCN_M_F n;
+    const WCN_M_F r = WCN_M_FN(exp_reduce)(xc, &n);
+    const WCN_M_F y = WCN_M_FN(ldexp)(WCN_M_FN(exp_poly)(r), WCN_M_CVTF(n));
+    return WCN_M_SEL(WCN_M_UNORD(x, x), WCN_M_ADD(x, x), y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(exp_fast)(WCN_M_F x) {
+    const WCN_M_F xc =
+        WCN_M_MAX(WCN_M_MIN(x, WCN_M_K1(89.0f)), WCN_M_K1(-104.0f));
+    WCN_M_F n;
+    const WCN_M_F r = WCN_M_FN(exp_reduce)(xc, &n);
+    return WCN_M_FN(ldexp)(WCN_M_FN(exp_poly_fast)(r), WCN_M_CVTF(n));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(exp2)(WCN_M_F x) {
+    const WCN_M_F xc =
+        WCN_M_MAX(WCN_M_MIN(x, WCN_M_K1(129.0f)), WCN_M_K1(-151.0f));
+    const WCN_M_F n = WCN_M_FN(rint)(xc);
+    const WCN_M_F p =
+        WCN_M_FN(exp2_poly)(WCN_M_SUB(xc, n), WCN_M_K1(0.0f));
+    const WCN_M_F y = WCN_M_FN(ldexp)(p, WCN_M_CVTF(n));
+    return WCN_M_SEL(WCN_M_UNORD(x, x), WCN_M_ADD(x, x), y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(exp2_fast)(WCN_M_F x) {
+    const WCN_M_F xc =
+        WCN_M_MAX(WCN_M_MIN(x, WCN_M_K1(129.0f)), WCN_M_K1(-151.0f));
+    const WCN_M_F n = WCN_M_FN(rint)(xc);
+    return WCN_M_FN(ldexp)(WCN_M_FN(exp2_poly_fast)(WCN_M_SUB(xc, n)),
+                           WCN_M_CVTF(n));
+}
+
+/* ========== log, log2, log1p ========== */
+
+/* Split x > 0 into 2^k * (1 + f) with 1 + f in [sqrt(1/2), sqrt(2));
+ * subnormals are scaled up first. Returns f, exact. */
+WCN_INLINE WCN_M_F WCN_M_FN(log_split)(WCN_M_F x, WCN_M_F *k) {
+    const WCN_M_K sub = WCN_M_LT(x, WCN_M_K1(1.17549435e-38f));
+    const WCN_M_F xs = WCN_M_SEL(sub, WCN_M_MUL(x, WCN_M_K1(8388608.0f)), x);
+    WCN_M_I ix = WCN_M_IADD(WCN_M_ASI(xs), WCN_M_ISET1(0x004afb0d));
+    const WCN_M_F e = WCN_M_CVTI(
+        WCN_M_ISUB(WCN_M_ISRA(ix, 23), WCN_M_ISET1(0x7f)));
+    *k = WCN_M_SEL(sub, WCN_M_SUB(e, WCN_M_K1(23.0f)), e);
+    ix = WCN_M_IADD(WCN_M_IAND(ix, WCN_M_ISET1(0x007fffff)),
+                    WCN_M_ISET1(0x3f3504f3));
+    return WCN_M_SUB(WCN_M_ASF(ix), WCN_M_K1(1.0f));
+}
+
+/* log(1 + f) = f - f^2/2 + s * (f^2/2 + R(s^2)), s = f / (2 + f): the
+ * classic argument of Cody and Waite, as in the fdlibm logf. Returns
+ * s * (hfsq + R) and sets *hfsq. */
+WCN_INLINE WCN_M_F WCN_M_FN(log_tail)(WCN_M_F f, WCN_M_F *hfsq) {
+    const WCN_M_F s = WCN_M_DIV(f, WCN_M_ADD(WCN_M_K1(2.0f), f));
+    const WCN_M_F z = WCN_M_MUL(s, s);
+    const WCN_M_F w = WCN_M_MUL(z, z);
+    const WCN_M_F t1 = WCN_M_MUL(
+        w, WCN_M_FMA(w, WCN_M_K1(2.42790788e-01f), WCN_M_K1(4.00009722e-01f)));
+    const WCN_M_F t2 = WCN_M_MUL(
+        z, WCN_M_FMA(w, WCN_M_K1(2.84987867e-01f), WCN_M_K1(6.66666627e-01f)));
+    *hfsq = WCN_M_MUL(WCN_M_MUL(WCN_M_K1(0.5f), f), f);
+    return WCN_M_MUL(s, WCN_M_ADD(*hfsq, WCN_M_ADD(t2, t1)));
+}
+
+/* log(1 + f) - f + f^2/2 on [sqrt(1/2) - 1, sqrt(2) - 1] as f^3 * P(f),
+ * relative error 2^-24.9 */
+WCN_INLINE WCN_M_F WCN_M_FN(log_fast_core)(WCN_M_F f) {
+    const WCN_M_F z = WCN_M_MUL(f, f);
+    WCN_M_F p = WCN_M_K1(8.700437844e-02f);
+    p = WCN_M_FMA(p, f, WCN_M_K1(-1.426748782e-01f));
+    p = WCN_M_FMA(p, f, WCN_M_K1(1.491476744e-01f));
+    p = WCN_M_FMA(p, f, WCN_M_K1(-1.657758504e-01f));
+    p = WCN_M_FMA(p, f, WCN_M_K1(1.996306330e-01f));
+    p = WCN_M_FMA(p, f, WCN_M_K1(-2.500133812e-01f));
+    p = WCN_M_FMA(p, f, WCN_M_K1(3.333390951e-01f));
+    const WCN_M_F y =
+        WCN_M_FMA(WCN_M_MUL(p, f), z, WCN_M_MUL(WCN_M_K1(-0.5f), z));
+    return WCN_M_ADD(f, y);
+}
+
+/* Results for x outside (0, inf): -inf at zero, NaN below it and for NaN,
+ * x itself at +inf */
+WCN_INLINE WCN_M_F WCN_M_FN(log_special)(WCN_M_F x, WCN_M_F y) {
+    y = WCN_M_SEL(WCN_M_EQ(x, WCN_M_INF), x, y);
+    y = WCN_M_SEL(WCN_M_LT(x, WCN_M_K1(0.0f)), WCN_M_NAN, y);
+    y = WCN_M_SEL(WCN_M_EQ(x, WCN_M_K1(0.0f)),
+                  WCN_M_SUB(WCN_M_K1(0.0f), WCN_M_INF), y);
+    return WCN_M_SEL(WCN_M_UNORD(x, x), WCN_M_ADD(x, x), y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log)(WCN_M_F x) {
+    WCN_M_F k, hfsq;
+    const WCN_M_F f = WCN_M_FN(log_split)(x, &k);
+    const WCN_M_F t = WCN_M_FN(log_tail)(f, &hfsq);
+    WCN_M_F y = WCN_M_FMA(k, WCN_M_K1(9.05800061e-06f), t);
+    y = WCN_M_ADD(WCN_M_SUB(y, hfsq), f);
+    y = WCN_M_FMA(k, WCN_M_K1(6.93138123e-01f), y);
+    return WCN_M_FN(log_special)(x, y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log_fast)(WCN_M_F x) {
+    WCN_M_I ix = WCN_M_IADD(WCN_M_ASI(x), WCN_M_ISET1(0x004afb0d));
+    const WCN_M_F k = WCN_M_CVTI(
+        WCN_M_ISUB(WCN_M_ISRA(ix, 23), WCN_M_ISET1(0x7f)));
+    ix = WCN_M_IADD(WCN_M_IAND(ix, WCN_M_ISET1(0x007fffff)),
+                    WCN_M_ISET1(0x3f3504f3));
+    const WCN_M_F f = WCN_M_SUB(WCN_M_ASF(ix), WCN_M_K1(1.0f));
+    return WCN_M_FMA(k, WCN_M_K1(6.93147182e-01f),
+                     WCN_M_FN(log_fast_core)(f));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log2)(WCN_M_F x) {
+    WCN_M_F k, hfsq;
+    const WCN_M_F f = WCN_M_FN(log_split)(x, &k);
+    const WCN_M_F t = WCN_M_FN(log_tail)(f, &hfsq);
+    /* f - hfsq with its low 12 bits moved into lo, so that the products
+     * with the 12-bit high part of 1/ln2 are exact */
+    WCN_M_F hi = WCN_M_SUB(f, hfsq);
+    hi = WCN_M_ASF(WCN_M_IAND(WCN_M_ASI(hi), WCN_M_ISET1(-4096)));
+    const WCN_M_F lo = WCN_M_ADD(WCN_M_SUB(WCN_M_SUB(f, hi), hfsq), t);
+    WCN_M_F y = WCN_M_MUL(WCN_M_ADD(lo, hi), WCN_M_K1(-1.76052854e-04f));
+    y = WCN_M_FMA(lo, WCN_M_K1(1.44287109e+00f), y);
+    y = WCN_M_FMA(hi, WCN_M_K1(1.44287109e+00f), y);
+    return WCN_M_FN(log_special)(x, WCN_M_ADD(y, k));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log2_fast)(WCN_M_F x) {
+    return WCN_M_MUL(WCN_M_FN(log_fast)(x), WCN_M_K1(1.44269502e+00f));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log1p)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F u = WCN_M_ADD(one, x);
+    WCN_M_F k;
+    WCN_M_F f = WCN_M_FN(log_split)(u, &k);
+    /* log(1 + x) - log(u), the rounding error of u; negligible once u
+     * reaches 2^25 */
+    WCN_M_F c = WCN_M_SEL(WCN_M_LE(WCN_M_K1(2.0f), k),
+                          WCN_M_SUB(one, WCN_M_SUB(u, x)),
+                          WCN_M_SUB(x, WCN_M_SUB(u, one)));
+    c = WCN_M_SEL(WCN_M_LT(k, WCN_M_K1(25.0f)), WCN_M_DIV(c, u),
+                  WCN_M_K1(0.0f));
+    /* Where 1 + x is already in range, take f = x exactly */
+    const WCN_M_K near = WCN_M_KAND(WCN_M_LE(WCN_M_K1(-2.92893201e-01f), x),
+                                    WCN_M_LT(x, WCN_M_K1(4.14213538e-01f)));
+    f = WCN_M_SEL(near, x, f);
+    k = WCN_M_SEL(near, WCN_M_K1(0.0f), k);
+    c = WCN_M_SEL(near, WCN_M_K1(0.0f), c);
+
+    WCN_M_F hfsq;
+    const WCN_M_F t = WCN_M_FN(log_tail)(f, &hfsq);
+    WCN_M_F y = WCN_M_ADD(t, WCN_M_FMA(k, WCN_M_K1(9.05800061e-06f), c));
+    y = WCN_M_ADD(WCN_M_SUB(y, hfsq), f);
+    y = WCN_M_FMA(k, WCN_M_K1(6.93138123e-01f), y);
+    return WCN_M_FN(log_special)(u, y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(log1p_fast)(WCN_M_F x) {
+    const WCN_M_K near = WCN_M_KAND(WCN_M_LE(WCN_M_K1(-2.92893201e-01f), x),
+                                    WCN_M_LT(x, WCN_M_K1(4.14213538e-01f)));
+    return WCN_M_SEL(near, WCN_M_FN(log_fast_core)(x),
+                     WCN_M_FN(log_fast)(WCN_M_ADD(WCN_M_K1(1.0f), x)));
+}
+
+/* ========== sin, cos, tan ========== */
+
+/* Largest |x| the vector reduction handles within the stated bounds;
+ * beyond it the plain functions reduce lane by lane in double precision
+ * through the C library. */
+#if WCN_M_FUSED
+#define WCN_M_TRIG_MAX 262144.0f
+#else
+#define WCN_M_TRIG_MAX 8192.0f
+#endif
+
+/* |x| = j pi/2 + r + r_lo with |r| <= pi/4, for |x| <= WCN_M_TRIG_MAX.
+ * Returns r and the quadrant j. */
+WCN_INLINE WCN_M_F WCN_M_FN(trig_reduce)(WCN_M_F ax, WCN_M_F *r_lo,
+                                         WCN_M_I *q) {
+    const WCN_M_F j =
+        WCN_M_FN(rint)(WCN_M_MUL(ax, WCN_M_K1(6.36619747e-01f)));
+    /* Subtract the leading parts of pi/2 exactly: a full float, whose
+     * product with j the FMA keeps exact, or two short ones */
+#if WCN_M_FUSED
+    const WCN_M_F a = WCN_M_FMA(j, WCN_M_K1(-1.57079637e+00f), ax);
+    const WCN_M_F c3 = WCN_M_K1(-4.37113883e-08f);
+#else
+    WCN_M_F a = WCN_M_FMA(j, WCN_M_K1(-1.5703125f), ax);
+    a = WCN_M_FMA(j, WCN_M_K1(-4.83751297e-04f), a);
+    const WCN_M_F c3 = WCN_M_K1(7.54979013e-08f);
+#endif
+    /* and the rest in two floats */
+    WCN_M_F ph, pl;
+    WCN_M_FN(two_prod)(j, c3, &ph, &pl);
+    const WCN_M_F r = WCN_M_SUB(a, ph);
+    *r_lo = WCN_M_SUB(WCN_M_SUB(WCN_M_SUB(a, r), ph), pl);
+    *r_lo = WCN_M_FMA(j, WCN_M_K1(1.71512451e-15f), *r_lo);
+    /* j is below 2^22, out-of-range lanes are replaced by the caller */
+    *q = WCN_M_CVTF(WCN_M_MIN(j, WCN_M_K1(4194304.0f)));
+    return r;
+}
+
+/* sin(r + r_lo) on |r| <= pi/4 as r + r^3 S(r^2) + r_lo cos r; the
+ * polynomial has relative error 2^-37.5 */
+WCN_INLINE WCN_M_F WCN_M_FN(sin_poly)(WCN_M_F r, WCN_M_F r_lo, WCN_M_F z) {
+    WCN_M_F p = WCN_M_K1(2.718121550e-06f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.983931288e-04f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(8.333329111e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.666666716e-01f));
+    const WCN_M_F c = WCN_M_FMA(z, WCN_M_K1(-0.5f), WCN_M_K1(1.0f));
+    return WCN_M_ADD(r, WCN_M_FMA(WCN_M_MUL(r, z), p, WCN_M_MUL(r_lo, c)));
+}
+
+/* Relative error 2^-28.0 */
+WCN_INLINE WCN_M_F WCN_M_FN(sin_poly_fast)(WCN_M_F r, WCN_M_F z) {
+    WCN_M_F p = WCN_M_K1(-1.951528247e-04f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(8.332160302e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.666665524e-01f));
+    return WCN_M_FMA(WCN_M_MUL(r, z), p, r);
+}
+
+/* cos(r + r_lo) on |r| <= pi/4 as 1 - z/2 + z^2 C(z) - r r_lo, with
+ * 1 - z/2 carried in two floats; C has relative error 2^-33.0 */
+WCN_INLINE WCN_M_F WCN_M_FN(cos_poly)(WCN_M_F r, WCN_M_F r_lo, WCN_M_F z) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    WCN_M_F p = WCN_M_K1(2.443315680e-05f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.388731645e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(4.166664556e-02f));
+    const WCN_M_F hz = WCN_M_MUL(WCN_M_K1(0.5f), z);
+    const WCN_M_F w = WCN_M_SUB(one, hz);
+    WCN_M_F e = WCN_M_SUB(WCN_M_SUB(one, w), hz);
+    e = WCN_M_SUB(WCN_M_FMA(WCN_M_MUL(z, z), p, e), WCN_M_MUL(r, r_lo));
+    return WCN_M_ADD(w, e);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(cos_poly_fast)(WCN_M_F z) {
+    WCN_M_F p = WCN_M_K1(2.443315680e-05f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.388731645e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(4.166664556e-02f));
+    return WCN_M_FMA(WCN_M_MUL(z, z), p,
+                     WCN_M_FMA(z, WCN_M_K1(-0.5f), WCN_M_K1(1.0f)));
+}
+
+/* Redo the lanes with |x| > WCN_M_TRIG_MAX (and infinities) in double */
+WCN_INLINE WCN_M_F WCN_M_FN(trig_wide)(WCN_M_F x, WCN_M_F y,
+                                       double (*fn)(double)) {
+    if (!WCN_M_ANY(WCN_M_LT(WCN_M_K1(WCN_M_TRIG_MAX), WCN_M_FN(fabs)(x)))) {
+        return y;
+    }
+    float xs[WCN_M_LANES], ys[WCN_M_LANES];
+    WCN_M_STORE(xs, x);
+    WCN_M_STORE(ys, y);
+    for (int i = 0; i < WCN_M_LANES; i++) {
+        if (WCN_M_TRIG_MAX < fabsf(xs[i])) {
+            ys[i] = (float)fn((double)xs[i]);
+        }
+    }
+    return WCN_M_LOAD(ys);
+}
+
+/* sin(|x|) and cos(|x|) from the quadrant: swap on odd j, negate sin on
+ * j = 2, 3 and cos on j = 1, 2 */
+WCN_INLINE void WCN_M_FN(sincos_quadrant)(WCN_M_F sp, WCN_M_F cp, WCN_M_I q,
+                                          WCN_M_F *s, WCN_M_F *c) {
+    const WCN_M_K odd = WCN_M_ITEST(q, 1);
+    *s = WCN_M_FN(xorsign)(WCN_M_SEL(odd, cp, sp),
+                           WCN_M_IAND(WCN_M_ISLL(q, 30), WCN_M_SIGNBIT));
+    *c = WCN_M_FN(xorsign)(
+        WCN_M_SEL(odd, sp, cp),
+        WCN_M_IAND(WCN_M_ISLL(WCN_M_IADD(q, WCN_M_ISET1(1)), 30),
+                   WCN_M_SIGNBIT));
+}
+
+WCN_INLINE void WCN_M_FN(sincos_core)(WCN_M_F x, WCN_M_F *s, WCN_M_F *c) {
+    WCN_M_I q;
+    WCN_M_F r_lo;
+    const WCN_M_F r = WCN_M_FN(trig_reduce)(WCN_M_FN(fabs)(x), &r_lo, &q);
+    const WCN_M_F z = WCN_M_MUL(r, r);
+    WCN_M_FN(sincos_quadrant)(WCN_M_FN(sin_poly)(r, r_lo, z),
+                              WCN_M_FN(cos_poly)(r, r_lo, z), q, s, c);
+    *s = WCN_M_FN(xorsign)(*s, WCN_M_FN(signbit)(x));
+}
+
+WCN_INLINE void WCN_M_FN(sincos_fast)(WCN_M_F x, WCN_M_F *s, WCN_M_F *c) {
+    WCN_M_I q;
+    WCN_M_F r_lo;
+    WCN_M_F r = WCN_M_FN(trig_reduce)(WCN_M_FN(fabs)(x), &r_lo, &q);
+    r = WCN_M_ADD(r, r_lo);
+    const WCN_M_F z = WCN_M_MUL(r, r);
+    WCN_M_FN(sincos_quadrant)(WCN_M_FN(sin_poly_fast)(r, z),
+                              WCN_M_FN(cos_poly_fast)(z), q, s, c);
+    *s = WCN_M_FN(xorsign)(*s, WCN_M_FN(signbit)(x));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(sin)(WCN_M_F x) {
+    WCN_M_F s, c;
+    WCN_M_FN(sincos_core)(x, &s, &c);
+    return WCN_M_FN(trig_wide)(x, s, sin);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(cos)(WCN_M_F x) {
+    WCN_M_F s, c;
+    WCN_M_FN(sincos_core)(x, &s, &c);
+    return WCN_M_FN(trig_wide)(x, c, cos);
+}
+
+WCN_INLINE void WCN_M_FN(sincos)(WCN_M_F x, WCN_M_F *s, WCN_M_F *c) {
+    WCN_M_F sv, cv;
+    WCN_M_FN(sincos_core)(x, &sv, &cv);
+    *s = WCN_M_FN(trig_wide)(x, sv, sin);
+    *c = WCN_M_FN(trig_wide)(x, cv, cos);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(sin_fast)(WCN_M_F x) {
+    WCN_M_F s, c;
+    WCN_M_FN(sincos_fast)(x, &s, &c);
+    return s;
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(cos_fast)(WCN_M_F x) {
+    WCN_M_F s, c;
+    WCN_M_FN(sincos_fast)(x, &s, &c);
+    return c;
+}
+
+/* tan r - r on |r| <= pi/4 as r^3 T(r^2), with r^3 in two floats;
+ * relative error 2^-28.3 */
+WCN_INLINE WCN_M_F WCN_M_FN(tan_poly)(WCN_M_F r) {
+    WCN_M_F z, z_lo, u, u_lo;
+    WCN_M_FN(two_prod)(r, r, &z, &z_lo);
+    WCN_M_FN(two_prod)(r, z, &u, &u_lo);
+    u_lo = WCN_M_FMA(r, z_lo, u_lo);
+    WCN_M_F p = WCN_M_K1(4.376292694e-03f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(8.948920731e-05f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.083585899e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(2.128216624e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(5.405992270e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.333266348e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(3.333334923e-01f));
+    return WCN_M_FMA(u, p, WCN_M_MUL(u_lo, p));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(tan)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    WCN_M_I q;
+    WCN_M_F r_lo;
+    const WCN_M_F r = WCN_M_FN(trig_reduce)(WCN_M_FN(fabs)(x), &r_lo, &q);
+    /* tan(r + r_lo) = t + tl, with r_lo scaled by the derivative */
+    WCN_M_F d = WCN_M_FN(tan_poly)(r);
+    const WCN_M_F t0 = WCN_M_ADD(r, d);
+    d = WCN_M_FMA(r_lo, WCN_M_FMA(t0, t0, one), d);
+    const WCN_M_F t = WCN_M_ADD(r, d);
+    const WCN_M_F tl = WCN_M_ADD(WCN_M_SUB(r, t), d);
+    /* Odd quadrants: -1 / (t + tl), corrected by the residual so that it
+     * is rounded once */
+    const WCN_M_F inv = WCN_M_DIV(WCN_M_K1(-1.0f), t);
+    WCN_M_F ph, pl;
+    WCN_M_FN(two_prod)(inv, t, &ph, &pl);
+    const WCN_M_F e =
+        WCN_M_ADD(WCN_M_ADD(WCN_M_ADD(one, ph), pl), WCN_M_MUL(inv, tl));
+    const WCN_M_F cot = WCN_M_FMA(inv, e, inv);
+    WCN_M_F y = WCN_M_SEL(WCN_M_ITEST(q, 1), cot, WCN_M_ADD(t, tl));
+    y = WCN_M_FN(xorsign)(y, WCN_M_FN(signbit)(x));
+    return WCN_M_FN(trig_wide)(x, y, tan);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(tan_fast)(WCN_M_F x) {
+    WCN_M_I q;
+    WCN_M_F r_lo;
+    WCN_M_F r = WCN_M_FN(trig_reduce)(WCN_M_FN(fabs)(x), &r_lo, &q);
+    r = WCN_M_ADD(r, r_lo);
+    const WCN_M_F z = WCN_M_MUL(r, r);
+    /* relative error 2^-25.8 */
+    WCN_M_F p = WCN_M_K1(9.385642596e-03f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(3.119510598e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(2.443039417e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(5.341120809e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.333879977e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(3.333315551e-01f));
+    const WCN_M_F t = WCN_M_FMA(WCN_M_MUL(r, z), p, r);
+    WCN_M_F y = WCN_M_SEL(WCN_M_ITEST(q, 1),
+                          WCN_M_DIV(WCN_M_K1(-1.0f), t), t);
+    return WCN_M_FN(xorsign)(y, WCN_M_FN(signbit)(x));
+}
+
+/* ========== atan2 ========== */
+
+/* atan t - t on [0, 1] as t^3 A(t^2), with t^3 in two floats; relative
+ * error 2^-28.5 */
+WCN_INLINE WCN_M_F WCN_M_FN(atan_poly)(WCN_M_F t, WCN_M_F *zp) {
+    WCN_M_F z, z_lo, u, u_lo;
+    WCN_M_FN(two_prod)(t, t, &z, &z_lo);
+    WCN_M_FN(two_prod)(t, z, &u, &u_lo);
+    u_lo = WCN_M_FMA(t, z_lo, u_lo);
+    WCN_M_F p = WCN_M_K1(-1.793622971e-03f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.091461163e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.117785603e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(5.795760453e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-8.403450996e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.095218584e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.426424235e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.999854892e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.333329856e-01f));
+    *zp = z;
+    return WCN_M_FMA(u, p, WCN_M_MUL(u_lo, p));
+}
+
+/* Relative error 2^-23.1 */
+WCN_INLINE WCN_M_F WCN_M_FN(atan_poly_fast)(WCN_M_F t, WCN_M_F z) {
+    WCN_M_F p = WCN_M_K1(-4.822534975e-03f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(2.473406494e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-6.020313129e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(9.968473017e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-1.404132843e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.997421384e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.333239257e-01f));
+    return WCN_M_MUL(WCN_M_MUL(t, z), p);
+}
+
+/* c - (hi + lo) in two floats, for |c| >= |hi| */
+WCN_INLINE void WCN_M_FN(reflect)(WCN_M_F c_hi, WCN_M_F c_lo, WCN_M_F *hi,
+                                  WCN_M_F *lo) {
+    const WCN_M_F s = WCN_M_SUB(c_hi, *hi);
+    *lo = WCN_M_SUB(WCN_M_ADD(WCN_M_SUB(WCN_M_SUB(c_hi, s), *hi), c_lo), *lo);
+    *hi = s;
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(atan2)(WCN_M_F y, WCN_M_F x) {
+    const WCN_M_F zero = WCN_M_K1(0.0f);
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    const WCN_M_F ay = WCN_M_FN(fabs)(y);
+    const WCN_M_K swap = WCN_M_LT(ax, ay);
+    WCN_M_F num = WCN_M_MIN(ax, ay);
+    WCN_M_F den = WCN_M_MAX(ax, ay);
+    /* Both infinite: the angle of the diagonal */
+    const WCN_M_K inf2 = WCN_M_EQ(num, WCN_M_INF);
+    num = WCN_M_SEL(inf2, one, num);
+    den = WCN_M_SEL(inf2, one, den);
+    /* Keep the residual products below out of the subnormal range and
+     * away from overflow */
+    WCN_M_F sc = WCN_M_SEL(WCN_M_LT(num, WCN_M_K1(7.88860905e-31f)),
+                           WCN_M_K1(1.84467441e+19f), one);
+    sc = WCN_M_SEL(WCN_M_LT(WCN_M_K1(1.26765060e+30f), den),
+                   WCN_M_K1(5.42101086e-20f), sc);
+    num = WCN_M_MUL(num, sc);
+    den = WCN_M_MUL(den, sc);
+
+    /* t + t_lo = num / den; both zero gives t = 0 */
+    WCN_M_F t = WCN_M_DIV(num, den);
+    WCN_M_F ph, pl;
+    WCN_M_FN(two_prod)(t, den, &ph, &pl);
+    WCN_M_F t_lo = WCN_M_DIV(WCN_M_SUB(WCN_M_SUB(num, ph), pl), den);
+    const WCN_M_K none = WCN_M_EQ(den, zero);
+    t = WCN_M_SEL(none, zero, t);
+    t_lo = WCN_M_SEL(WCN_M_KOR(none, WCN_M_UNORD(t_lo, t_lo)), zero, t_lo);
+
+    /* atan(t + t_lo) ~ t + A + t_lo / (1 + t^2), A = t^3 A(t^2) */
+    WCN_M_F z;
+    const WCN_M_F a = WCN_M_FN(atan_poly)(t, &z);
+    WCN_M_F hi = WCN_M_ADD(t, a);
+    WCN_M_F lo = WCN_M_ADD(WCN_M_ADD(WCN_M_SUB(t, hi), a),
+                           WCN_M_MUL(t_lo, WCN_M_FMA(z, WCN_M_K1(-0.5f), one)));
+
+    /* Octant and quadrant fixups on the two-float angle */
+    WCN_M_F rh = hi, rl = lo;
+    WCN_M_FN(reflect)(WCN_M_K1(1.57079637e+00f), WCN_M_K1(-4.37113883e-08f),
+                      &rh, &rl);
+    hi = WCN_M_SEL(swap, rh, hi);
+    lo = WCN_M_SEL(swap, rl, lo);
+    rh = hi;
+    rl = lo;
+    WCN_M_FN(reflect)(WCN_M_K1(3.14159274e+00f), WCN_M_K1(-8.74227766e-08f),
+                      &rh, &rl);
+    const WCN_M_K xneg = WCN_M_ITEST(WCN_M_ASI(x), -2147483647 - 1);
+    hi = WCN_M_SEL(xneg, rh, hi);
+    lo = WCN_M_SEL(xneg, rl, lo);
+
+    const WCN_M_F r =
+        WCN_M_FN(xorsign)(WCN_M_ADD(hi, lo), WCN_M_FN(signbit)(y));
+    return WCN_M_SEL(WCN_M_UNORD(x, y), WCN_M_ADD(x, y), r);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(atan2_fast)(WCN_M_F y, WCN_M_F x) {
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    const WCN_M_F ay = WCN_M_FN(fabs)(y);
+    const WCN_M_F t = WCN_M_DIV(WCN_M_MIN(ax, ay), WCN_M_MAX(ax, ay));
+    WCN_M_F r =
+        WCN_M_ADD(t, WCN_M_FN(atan_poly_fast)(t, WCN_M_MUL(t, t)));
+    r = WCN_M_SEL(WCN_M_LT(ax, ay),
+                  WCN_M_SUB(WCN_M_K1(1.57079637e+00f), r), r);
+    r = WCN_M_SEL(WCN_M_ITEST(WCN_M_ASI(x), -2147483647 - 1),
+                  WCN_M_SUB(WCN_M_K1(3.14159274e+00f), r), r);
+    return WCN_M_FN(xorsign)(r, WCN_M_FN(signbit)(y));
+}
+
+/* ========== tanh, erf ========== */
+
+/* tanh x - x on |x| < 0.55 as x^3 H(x^2), relative error 2^-30.7 */
+WCN_INLINE WCN_M_F WCN_M_FN(tanh_poly)(WCN_M_F x, WCN_M_F z) {
+    WCN_M_F p = WCN_M_K1(2.395822434e-03f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-8.413957432e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(2.178282663e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-5.395964906e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.333329380e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.333333135e-01f));
+    return WCN_M_MUL(WCN_M_MUL(x, z), p);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(tanh)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    const WCN_M_F small =
+        WCN_M_ADD(x, WCN_M_FN(tanh_poly)(x, WCN_M_MUL(x, x)));
+
+    /* 1 - 2 / (e^2a + 1) with e^2a = 2^n (1 + q) kept in two floats; past
+     * a = 9.1 the result rounds to 1 */
+    WCN_M_F n;
+    const WCN_M_F a2 = WCN_M_MUL(WCN_M_MIN(ax, WCN_M_K1(9.1f)), WCN_M_K1(2.0f));
+    const WCN_M_F q = WCN_M_FN(exp_poly_m1)(WCN_M_FN(exp_reduce)(a2, &n));
+    const WCN_M_I ni = WCN_M_CVTF(n);
+    const WCN_M_F d_hi = WCN_M_ADD(WCN_M_FN(pow2i)(ni), one);
+    const WCN_M_F d_lo = WCN_M_FN(ldexp)(q, ni);
+    const WCN_M_F d = WCN_M_ADD(d_hi, d_lo);
+    const WCN_M_F dl = WCN_M_ADD(WCN_M_SUB(d_hi, d), d_lo);
+    const WCN_M_F g = WCN_M_DIV(WCN_M_K1(2.0f), d);
+    WCN_M_F ph, pl;
+    WCN_M_FN(two_prod)(g, d, &ph, &pl);
+    const WCN_M_F g_lo = WCN_M_DIV(
+        WCN_M_SUB(WCN_M_SUB(WCN_M_SUB(WCN_M_K1(2.0f), ph), pl),
+                  WCN_M_MUL(g, dl)),
+        d);
+    const WCN_M_F s = WCN_M_SUB(one, g);
+    const WCN_M_F large = WCN_M_FN(xorsign)(
+        WCN_M_ADD(s, WCN_M_SUB(WCN_M_SUB(WCN_M_SUB(one, s), g), g_lo)),
+        WCN_M_FN(signbit)(x));
+
+    const WCN_M_F y = WCN_M_SEL(WCN_M_LT(ax, WCN_M_K1(0.55f)), small, large);
+    return WCN_M_SEL(WCN_M_UNORD(x, x), WCN_M_ADD(x, x), y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(tanh_fast)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    const WCN_M_F z = WCN_M_MUL(x, x);
+    /* relative error 2^-24.6 */
+    WCN_M_F p = WCN_M_K1(1.643758081e-02f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-5.267181247e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.332072467e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.333294690e-01f));
+    const WCN_M_F small = WCN_M_FMA(WCN_M_MUL(x, z), p, x);
+    const WCN_M_F e = WCN_M_FN(exp_fast)(
+        WCN_M_MUL(WCN_M_MIN(ax, WCN_M_K1(9.1f)), WCN_M_K1(2.0f)));
+    const WCN_M_F large = WCN_M_FN(xorsign)(
+        WCN_M_SUB(one, WCN_M_DIV(WCN_M_K1(2.0f), WCN_M_ADD(e, one))),
+        WCN_M_FN(signbit)(x));
+    return WCN_M_SEL(WCN_M_LT(ax, WCN_M_K1(0.55f)), small, large);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(erf)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+
+    /* |x| < 0.921875: x + x P(x^2), relative error 2^-31.2; the rounding
+     * error of x^2 is fed through P's linear term */
+    WCN_M_F z, z_lo;
+    WCN_M_FN(two_prod)(x, x, &z, &z_lo);
+    WCN_M_F p = WCN_M_K1(8.370100113e-05f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(-8.142704028e-04f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(5.201032385e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-2.685939893e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.128369570e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.761263490e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.283791661e-01f));
+    p = WCN_M_FMA(z_lo, WCN_M_K1(-3.761263490e-01f), p);
+    const WCN_M_F small = WCN_M_FMA(x, p, x);
+
+    /* Otherwise 1 - e^Q(a) with Q ~ log erfc a = -a + a P(a); e^Q is taken
+     * as 2^n (1 + q) and subtracted in two parts. erf(4) rounds to 1. */
+    const WCN_M_F a = WCN_M_MIN(ax, WCN_M_K1(4.0f));
+    WCN_M_F c = WCN_M_K1(-1.130361397e-05f);
+    c = WCN_M_FMA(c, a, WCN_M_K1(3.235273180e-04f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-3.645399353e-03f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(2.376827784e-02f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-1.062440872e-01f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-6.351469755e-01f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-1.286495626e-01f));
+    const WCN_M_F qa = WCN_M_FMA(a, c, WCN_M_SUB(WCN_M_K1(0.0f), a));
+    WCN_M_F n;
+    const WCN_M_F q = WCN_M_FN(exp_poly_m1)(WCN_M_FN(exp_reduce)(qa, &n));
+    const WCN_M_I ni = WCN_M_CVTF(n);
+    const WCN_M_F e_hi = WCN_M_FN(pow2i)(ni);
+    const WCN_M_F large = WCN_M_FN(xorsign)(
+        WCN_M_SUB(WCN_M_SUB(one, e_hi), WCN_M_MUL(e_hi, q)),
+        WCN_M_FN(signbit)(x));
+
+    const WCN_M_F y =
+        WCN_M_SEL(WCN_M_LT(ax, WCN_M_K1(0.921875f)), small, large);
+    return WCN_M_SEL(WCN_M_UNORD(x, x), WCN_M_ADD(x, x), y);
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(erf_fast)(WCN_M_F x) {
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    /* relative errors 2^-25.9 and 2^-23.5 */
+    const WCN_M_F z = WCN_M_MUL(x, x);
+    WCN_M_F p = WCN_M_K1(-5.990853533e-04f);
+    p = WCN_M_FMA(p, z, WCN_M_K1(4.993180279e-03f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-2.676661685e-02f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.128181592e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(-3.761249483e-01f));
+    p = WCN_M_FMA(p, z, WCN_M_K1(1.283791512e-01f));
+    const WCN_M_F small = WCN_M_FMA(x, p, x);
+    const WCN_M_F a = WCN_M_MIN(ax, WCN_M_K1(4.0f));
+    WCN_M_F c = WCN_M_K1(2.139229618e-04f);
+    c = WCN_M_FMA(c, a, WCN_M_K1(-3.214443801e-03f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(2.288831957e-02f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-1.052592695e-01f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-6.357202530e-01f));
+    c = WCN_M_FMA(c, a, WCN_M_K1(-1.285137832e-01f));
+    const WCN_M_F e =
+        WCN_M_FN(exp_fast)(WCN_M_FMA(a, c, WCN_M_SUB(WCN_M_K1(0.0f), a)));
+    const WCN_M_F large =
+        WCN_M_FN(xorsign)(WCN_M_SUB(one, e), WCN_M_FN(signbit)(x));
+    return WCN_M_SEL(WCN_M_LT(ax, WCN_M_K1(0.921875f)), small, large);
+}
+
+/* ========== pow ========== */
+
+/* log2 x = k + hi + lo for finite x > 0, with an absolute error of about
+ * 2^-36 in hi + lo */
+WCN_INLINE WCN_M_F WCN_M_FN(log2_ext)(WCN_M_F x, WCN_M_F *hi, WCN_M_F *lo) {
+    WCN_M_F k;
+    const WCN_M_F f = WCN_M_FN(log_split)(x, &k);
+    /* s = f / (2 + f) in two floats */
+    const WCN_M_F d_hi = WCN_M_ADD(WCN_M_K1(2.0f), f);
+    const WCN_M_F d_lo = WCN_M_ADD(WCN_M_SUB(WCN_M_K1(2.0f), d_hi), f);
+    const WCN_M_F s = WCN_M_DIV(f, d_hi);
+    WCN_M_F ph, pl;
+    WCN_M_FN(two_prod)(s, d_hi, &ph, &pl);
+    const WCN_M_F s_lo = WCN_M_DIV(
+        WCN_M_SUB(WCN_M_SUB(WCN_M_SUB(f, ph), pl), WCN_M_MUL(s, d_lo)), d_hi);
+    /* log(1 + f) = 2 atanh s = 2s + 2s^3/3 + s^5 Q(s^2); the s^3 term
+     * and the correction for s_lo are kept in two floats, Q's absolute
+     * error is 2^-38.8 */
+    WCN_M_F z, z_lo, u, u_lo, c, c_lo;
+    WCN_M_FN(two_prod)(s, s, &z, &z_lo);
+    WCN_M_FN(two_prod)(s, z, &u, &u_lo);
+    u_lo = WCN_M_FMA(s, z_lo, u_lo);
+    WCN_M_FN(two_prod)(u, WCN_M_K1(6.66666687e-01f), &c, &c_lo);
+    c_lo = WCN_M_FMA(u, WCN_M_K1(-1.98682149e-08f), c_lo);
+    c_lo = WCN_M_FMA(u_lo, WCN_M_K1(6.66666687e-01f), c_lo);
+    WCN_M_F q = WCN_M_K1(2.346547395e-01f);
+    q = WCN_M_FMA(q, z, WCN_M_K1(2.854490280e-01f));
+    q = WCN_M_FMA(q, z, WCN_M_K1(4.000017643e-01f));
+    /* d(2 atanh s)/ds = 2 / (1 - s^2) */
+    const WCN_M_F ds = WCN_M_MUL(
+        WCN_M_MUL(WCN_M_K1(2.0f), s_lo),
+        WCN_M_FMA(z, WCN_M_ADD(WCN_M_K1(1.0f), z), WCN_M_K1(1.0f)));
+    const WCN_M_F l_mid =
+        WCN_M_ADD(WCN_M_FMA(WCN_M_MUL(u, z), q, ds), c_lo);
+    const WCN_M_F l_hi = WCN_M_MUL(WCN_M_K1(2.0f), s);
+    const WCN_M_F h0 = WCN_M_ADD(l_hi, c);
+    const WCN_M_F l = WCN_M_ADD(WCN_M_ADD(WCN_M_SUB(l_hi, h0), c), l_mid);
+    const WCN_M_F h = WCN_M_ADD(h0, l);
+    const WCN_M_F l2 = WCN_M_ADD(WCN_M_SUB(h0, h), l);
+    /* times 1/ln2 in two floats */
+    WCN_M_FN(two_prod)(h, WCN_M_K1(1.44269502e+00f), hi, lo);
+    *lo = WCN_M_FMA(h, WCN_M_K1(1.92596303e-08f), *lo);
+    *lo = WCN_M_FMA(l2, WCN_M_K1(1.44269502e+00f), *lo);
+    return k;
+}
+
+/* 2^(e1 + e2 + e_lo), with e1 and e2 clamped to |e| <= 2^20 */
+WCN_INLINE WCN_M_F WCN_M_FN(exp2_ext)(WCN_M_F e1, WCN_M_F e2, WCN_M_F e_lo) {
+    const WCN_M_F n1 = WCN_M_FN(rint)(e1);
+    const WCN_M_F n2 = WCN_M_FN(rint)(e2);
+    const WCN_M_F r1 = WCN_M_SUB(e1, n1);
+    const WCN_M_F r2 = WCN_M_SUB(e2, n2);
+    /* r1 + r2 in two floats, then back into [-1/2, 1/2] */
+    WCN_M_F r = WCN_M_ADD(r1, r2);
+    const WCN_M_F b = WCN_M_SUB(r, r1);
+    const WCN_M_F r_lo = WCN_M_ADD(
+        WCN_M_ADD(WCN_M_SUB(r1, WCN_M_SUB(r, b)), WCN_M_SUB(r2, b)), e_lo);
+    const WCN_M_F n3 = WCN_M_FN(rint)(r);
+    r = WCN_M_SUB(r, n3);
+    const WCN_M_F n = WCN_M_ADD(WCN_M_ADD(n1, n2), n3);
+    return WCN_M_FN(ldexp)(WCN_M_FN(exp2_poly)(r, r_lo), WCN_M_CVTF(n));
+}
+
+WCN_INLINE WCN_M_F WCN_M_FN(pow)(WCN_M_F x, WCN_M_F y) {
+    const WCN_M_F zero = WCN_M_K1(0.0f);
+    const WCN_M_F one = WCN_M_K1(1.0f);
+    const WCN_M_F big = WCN_M_K1(1048576.0f);
+    const WCN_M_F ax = WCN_M_FN(fabs)(x);
+    const WCN_M_F ay = WCN_M_FN(fabs)(y);
+
+    /* y log2|x| = a1 + a2 + a_lo */
+    WCN_M_F l_hi, l_lo;
+    const WCN_M_F k = WCN_M_FN(log2_ext)(ax, &l_hi, &l_lo);
+    WCN_M_F a1, a1_lo, a2, a2_lo;
+    WCN_M_FN(two_prod)(y, k, &a1, &a1_lo);
+    WCN_M_FN(two_prod)(y, l_hi, &a2, &a2_lo);
+    const WCN_M_F a_lo = WCN_M_FMA(y, l_lo, WCN_M_ADD(a1_lo, a2_lo));
+    /* Out of range results saturate through ldexp: |a1 + a2| >= 190
+     * overflows or underflows. Larger a1, a2 are clamped for the rounding
+     * in exp2_ext and saturated here. */
+    const WCN_M_F e = WCN_M_ADD(a1, a2);
+    const WCN_M_K sat = WCN_M_LT(WCN_M_K1(190.0f), WCN_M_FN(fabs)(e));
+    a1 = WCN_M_MAX(WCN_M_MIN(a1, big), WCN_M_SUB(zero, big));
+    a2 = WCN_M_MAX(WCN_M_MIN(a2, big), WCN_M_SUB(zero, big));
+    WCN_M_F r = WCN_M_FN(exp2_ext)(a1, a2, a_lo);
+    r = WCN_M_SEL(sat, WCN_M_SEL(WCN_M_LT(zero, e), WCN_M_INF, zero), r);
+
+    /* Integer y: |y| >= 2^23, or equal to itself rounded by the 2^23
+     * addition; odd if half of it is not an integer */
+    const WCN_M_F m23 = WCN_M_K1(8388608.0f);
+    const WCN_M_K small_y = WCN_M_LT(ay, m23);
+    const WCN_M_F ry = WCN_M_SUB(WCN_M_ADD(ay, m23), m23);
+    const WCN_M_K frac = WCN_M_KANDNOT(small_y, WCN_M_EQ(ry, ay));
+    const WCN_M_F hy = WCN_M_MUL(ay, WCN_M_K1(0.5f));
+    const WCN_M_K odd = WCN_M_KANDNOT(
+        WCN_M_KANDNOT(WCN_M_LT(ay, WCN_M_K1(16777216.0f)), frac),
+        WCN_M_EQ(WCN_M_SUB(WCN_M_ADD(hy, m23), m23), hy));
+
+    /* x = 0 or infinite, or y infinite: 0 or inf, or 1 for |x| = 1 */
+    const WCN_M_K yinf = WCN_M_EQ(ay, WCN_M_INF);
+    const WCN_M_K edge = WCN_M_KOR(WCN_M_KOR(WCN_M_EQ(ax, zero),
+                                             WCN_M_EQ(ax, WCN_M_INF)),
+                                   yinf);
+    WCN_M_F ev = WCN_M_SEL(WCN_M_LT(zero, WCN_M_MUL(WCN_M_SUB(ax, one), y)),
+                           WCN_M_INF, zero);
+    ev = WCN_M_SEL(WCN_M_KAND(yinf, WCN_M_EQ(ax, one)), one, ev);
+    r = WCN_M_SEL(edge, ev, r);
+    /* Negative x: NaN for non-integer y, the sign of x for odd y */
+    const WCN_M_K xneg = WCN_M_ITEST(WCN_M_ASI(x), -2147483647 - 1);
+    r = WCN_M_SEL(WCN_M_KAND(xneg, odd), WCN_M_FN(xorsign)(r, WCN_M_SIGNBIT),
+                  r);
+    r = WCN_M_SEL(WCN_M_KANDNOT(WCN_M_KAND(xneg, frac), edge), WCN_M_NAN, r);
+
+    r = WCN_M_SEL(WCN_M_UNORD(x, y), WCN_M_ADD(x, y), r);
+    return WCN_M_SEL(WCN_M_KOR(WCN_M_EQ(y, zero), WCN_M_EQ(x, one)), one, r);
+}
+
+/* For x > 0; exp2_fast(y * log2_fast(x)) */
+WCN_INLINE WCN_M_F WCN_M_FN(pow_fast)(WCN_M_F x, WCN_M_F y) {
+    return WCN_M_FN(exp2_fast)(WCN_M_MUL(y, WCN_M_FN(log2_fast)(x)));
+}
+
+#undef WCN_M_K1
+#undef WCN_M_SIGNBIT
+#undef WCN_M_INF
+#undef WCN_M_NAN
+#undef WCN_M_TRIG_MAX
+
+/* The adapter is consumed: the next inclusion defines its own */
+#undef WCN_M_F
+#undef WCN_M_I
+#undef WCN_M_K
+#undef WCN_M_FN
+#undef WCN_M_LANES
+#undef WCN_M_FUSED
+#undef WCN_M_SET1
+#undef WCN_M_ADD
+#undef WCN_M_SUB
+#undef WCN_M_MUL
+#undef WCN_M_DIV
+#undef WCN_M_FMA
+#undef WCN_M_MIN
+#undef WCN_M_MAX
+#undef WCN_M_LOAD
+#undef WCN_M_STORE
+#undef WCN_M_ISET1
+#undef WCN_M_IADD
+#undef WCN_M_ISUB
+#undef WCN_M_IAND
+#undef WCN_M_IXOR
+#undef WCN_M_ISLL
+#undef WCN_M_ISRA
+#undef WCN_M_ASI
+#undef WCN_M_ASF
+#undef WCN_M_CVTI
+#undef WCN_M_CVTF
+#undef WCN_M_LT
+#undef WCN_M_LE
+#undef WCN_M_EQ
+#undef WCN_M_UNORD
+#undef WCN_M_ITEST
+#undef WCN_M_KAND
+#undef WCN_M_KOR
+#undef WCN_M_KANDNOT
+#undef WCN_M_SEL
+#undef WCN_M_ANY
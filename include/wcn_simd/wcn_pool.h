@@ -0,0 +1,92 @@
+#ifndef WCN_SIMD_POOL_H
+#define WCN_SIMD_POOL_H
+
+/*
+ * WCN_SIMD Work-Stealing Thread Pool
+ *
+ * A persistent set of worker threads for splitting short SIMD jobs (tens of
+ * microseconds) over several cores. Workers are created once and wait for
+ * work by spinning briefly before parking, so a job that follows shortly
+ * after the previous one starts without a system call.
+ *
+ *     static void scale(void *ctx, size_t begin, size_t end) {
+ *         struct job *j = ctx;
+ *         wcn_simd_scale_array_f32(j->x + begin, j->s, j->y + begin,
+ *                                  end - begin);
+ *     }
+ *
+ *     wcn_pool_parallel_for(NULL, 0, n, 16384, scale, &job);
+ *
+ * A range [begin, end) is always cut into the same grain-sized chunks
+ * [begin + k*grain, min(begin + (k+1)*grain, end)); only the thread that
+ * runs each chunk varies. The calling thread takes part in the work, and
+ * the call returns once every chunk has run.
+ *
+ * One job runs on a pool at a time. A call made while the pool is busy --
+ * from another thread, or from inside a chunk function -- runs its chunks
+ * on the calling thread instead, so nesting never deadlocks.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wcn_pool wcn_pool_t;
+
+/* wcn_pool_create() flags */
+#define WCN_POOL_PIN_THREADS 0x1u /* bind worker i to logical CPU i */
+
+/* Runs one chunk [begin, end) */
+typedef void (*wcn_pool_range_fn)(void *ctx, size_t begin, size_t end);
+
+/* Reduces one chunk [begin, end) into *partial, which it must fully set */
+typedef void (*wcn_pool_reduce_fn)(void *ctx, size_t begin, size_t end,
+                                   void *partial);
+
+/* Folds a chunk's partial into the accumulator */
+typedef void (*wcn_pool_combine_fn)(void *ctx, void *acc, const void *partial);
+
+/* ========== Pool Management ========== */
+
+/* Create a pool of `threads` participants including the caller (0 means one
+ * per hardware thread). Returns NULL on failure. Builds without thread
+ * support return a pool that runs everything on the caller. */
+WCN_API_EXPORT wcn_pool_t *wcn_pool_create(unsigned threads, unsigned flags);
+
+/* Stop and join the workers; no job may be running */
+WCN_API_EXPORT void wcn_pool_destroy(wcn_pool_t *pool);
+
+/* Number of participants, including the calling thread */
+WCN_API_EXPORT unsigned wcn_pool_size(const wcn_pool_t *pool);
+
+/* The library's own pool, also used by the large array calls. It is sized
+ * by wcn_simd_set_max_threads(); NULL while that is 1. */
+WCN_API_EXPORT wcn_pool_t *wcn_pool_default(void);
+
+/* ========== Parallel Loops ========== */
+
+/* Call fn on every grain-sized chunk of [begin, end). A NULL pool means
+ * wcn_pool_default(). */
+WCN_API_EXPORT void wcn_pool_parallel_for(wcn_pool_t *pool, size_t begin,
+                                          size_t end, size_t grain,
+                                          wcn_pool_range_fn fn, void *ctx);
+
+/* Reduce [begin, end) chunk by chunk: map fills one partial of
+ * partial_size bytes per chunk, then combine folds the partials into
+ * *result (which holds the initial value) in chunk order on the calling
+ * thread. The result therefore does not depend on the pool size. Returns 0,
+ * or -1 if no memory could be found for a partial. */
+WCN_API_EXPORT int wcn_pool_parallel_reduce(wcn_pool_t *pool, size_t begin,
+                                            size_t end, size_t grain,
+                                            size_t partial_size,
+                                            wcn_pool_reduce_fn map,
+                                            wcn_pool_combine_fn combine,
+                                            void *ctx, void *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_POOL_H */
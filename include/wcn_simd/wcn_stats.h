@@ -0,0 +1,160 @@
+#ifndef WCN_SIMD_STATS_H
+#define WCN_SIMD_STATS_H
+
+/*
+ * WCN_SIMD Kernel Statistics
+ *
+ * Libraries built with WCN_SIMD_ENABLE_STATS (which defines
+ * WCN_SIMD_STATS) count, per array algorithm, the calls made, the data
+ * they covered and the code paths they took: misaligned arguments, partial
+ * vectors at the end, multi-threaded splits, alignment prologues and
+ * non-temporal stores. The counters are per thread and summed by
+ * wcn_simd_get_stats(); incrementing one is a plain add to thread-local
+ * memory. In default builds the counting code is not compiled at all and
+ * wcn_simd_get_stats() reports enabled == 0.
+ *
+ *     wcn_simd_stats_t s;
+ *     wcn_simd_reset_stats();
+ *     run_workload();
+ *     wcn_simd_get_stats(&s);
+ *     const wcn_simd_kernel_stats_t *add = &s.kernel[WCN_STATS_ADD_ARRAY_F32];
+ *     printf("%.0f%% misaligned\n",
+ *            100.0 * add->misaligned_calls / add->calls);
+ *
+ * Totals read while other threads are inside array calls may lag behind
+ * by the calls in flight.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The counted algorithms: the wcn_simd_* array functions, memcpy/memset,
+ * wcn_expr_eval() and the math array functions (both modes together) */
+typedef enum {
+    WCN_STATS_DOT_PRODUCT_F32,
+    WCN_STATS_DOT_PRODUCT_KAHAN_F32,
+    WCN_STATS_DOT_PRODUCT_PAIRWISE_F32,
+    WCN_STATS_ADD_ARRAY_F32,
+    WCN_STATS_MUL_ARRAY_F32,
+    WCN_STATS_SCALE_ARRAY_F32,
+    WCN_STATS_FMADD_ARRAY_F32,
+    WCN_STATS_REDUCE_MAX_F32,
+    WCN_STATS_REDUCE_MIN_F32,
+    WCN_STATS_REDUCE_SUM_F32,
+    WCN_STATS_REDUCE_SUM_PAIRWISE_F32,
+    WCN_STATS_DOT_PRODUCT_F64,
+    WCN_STATS_ADD_ARRAY_F64,
+    WCN_STATS_MUL_ARRAY_F64,
+    WCN_STATS_SCALE_ARRAY_F64,
+    WCN_STATS_FMADD_ARRAY_F64,
+    WCN_STATS_REDUCE_MAX_F64,
+    WCN_STATS_REDUCE_MIN_F64,
+    WCN_STATS_REDUCE_SUM_F64,
+    WCN_STATS_REDUCE_SUM_I32,
+    WCN_STATS_REDUCE_SUM_I16,
+    WCN_STATS_REDUCE_SUM_U8,
+    WCN_STATS_REDUCE_MIN_I8,
+    WCN_STATS_REDUCE_MAX_I8,
+    WCN_STATS_REDUCE_MIN_U8,
+    WCN_STATS_REDUCE_MAX_U8,
+    WCN_STATS_REDUCE_MIN_I16,
+    WCN_STATS_REDUCE_MAX_I16,
+    WCN_STATS_REDUCE_MIN_I32,
+    WCN_STATS_REDUCE_MAX_I32,
+    WCN_STATS_ADDS_ARRAY_I8,
+    WCN_STATS_SUBS_ARRAY_I8,
+    WCN_STATS_ADDS_ARRAY_U8,
+    WCN_STATS_SUBS_ARRAY_U8,
+    WCN_STATS_ADDS_ARRAY_I16,
+    WCN_STATS_SUBS_ARRAY_I16,
+    WCN_STATS_ADDS_ARRAY_U16,
+    WCN_STATS_SUBS_ARRAY_U16,
+    WCN_STATS_MEMCPY,
+    WCN_STATS_MEMSET,
+    WCN_STATS_EXPR_EVAL,
+    WCN_STATS_EXP_ARRAY_F32,
+    WCN_STATS_EXP2_ARRAY_F32,
+    WCN_STATS_LOG_ARRAY_F32,
+    WCN_STATS_LOG2_ARRAY_F32,
+    WCN_STATS_LOG1P_ARRAY_F32,
+    WCN_STATS_SIN_ARRAY_F32,
+    WCN_STATS_COS_ARRAY_F32,
+    WCN_STATS_SINCOS_ARRAY_F32,
+    WCN_STATS_TAN_ARRAY_F32,
+    WCN_STATS_TANH_ARRAY_F32,
+    WCN_STATS_ERF_ARRAY_F32,
+    WCN_STATS_ATAN2_ARRAY_F32,
+    WCN_STATS_POW_ARRAY_F32,
+    WCN_STATS_LOGSUMEXP_F32,
+    WCN_STATS_SOFTMAX_F32,
+    WCN_STATS_LOGSUMEXP_ROWS_F32,
+    WCN_STATS_SOFTMAX_ROWS_F32,
+    WCN_STATS_F16_TO_F32,
+    WCN_STATS_F32_TO_F16,
+    WCN_STATS_BF16_TO_F32,
+    WCN_STATS_F32_TO_BF16,
+    WCN_STATS_DOT_PRODUCT_F16,
+    WCN_STATS_DOT_PRODUCT_BF16,
+    WCN_STATS_FMADD_ARRAY_F16,
+    WCN_STATS_FMADD_ARRAY_BF16,
+    WCN_STATS_REDUCE_SUM_F16,
+    WCN_STATS_REDUCE_SUM_BF16,
+    WCN_STATS_DOT_U8I8_I32,
+    WCN_STATS_GEMV_U8I8_I32,
+    WCN_STATS_SGEMM,
+    WCN_STATS_TRANSPOSE_F32,
+    WCN_STATS_TRANSPOSE_U16,
+    WCN_STATS_TRANSPOSE_U8,
+    WCN_STATS_FIR_F32,
+    WCN_STATS_FIR_I16,
+    WCN_STATS_FFT_C2C,
+    WCN_STATS_FFT_R2C,
+    WCN_STATS_FFT_C2R,
+    WCN_STATS_KERNEL_COUNT
+} wcn_stats_kernel_t;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t elements;          /* bytes for memcpy/memset */
+    uint64_t bytes;             /* bytes read plus bytes written */
+
+    /* Calls with an array argument not aligned to the vector width of the
+     * selected kernel set (wcn_simd_get_kernel_impl()) */
+    uint64_t misaligned_calls;
+    /* Calls whose element count leaves a partial vector at the end */
+    uint64_t tail_calls;
+    /* Calls split into chunks on the thread pool (large reductions are
+     * chunked even when they run on one thread) */
+    uint64_t parallel_calls;
+
+    /* Kernel runs (one per call, or per chunk of a split call) that
+     * peeled an alignment prologue off a misaligned destination, and that
+     * wrote with non-temporal stores. Only algorithms with such paths
+     * count them: add_array_f32/f64, memcpy and memset. */
+    uint64_t prologue_runs;
+    uint64_t stream_runs;
+} wcn_simd_kernel_stats_t;
+
+typedef struct {
+    int enabled; /* 0 if the library was built without WCN_SIMD_STATS */
+    wcn_simd_kernel_stats_t kernel[WCN_STATS_KERNEL_COUNT];
+} wcn_simd_stats_t;
+
+/* Sum of the counters of every thread since the last reset */
+WCN_API_EXPORT void wcn_simd_get_stats(wcn_simd_stats_t *stats);
+
+/* Zero all counters; call while no other thread is inside an array call */
+WCN_API_EXPORT void wcn_simd_reset_stats(void);
+
+/* "add_array_f32", ...; NULL for an out-of-range kernel */
+WCN_API_EXPORT const char *
+wcn_simd_stats_kernel_name(wcn_stats_kernel_t kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_STATS_H */
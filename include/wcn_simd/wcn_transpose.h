@@ -0,0 +1,235 @@
+#ifndef WCN_SIMD_TRANSPOSE_H
+#define WCN_SIMD_TRANSPOSE_H
+
+/*
+ * WCN_SIMD Matrix Transpose
+ *
+ * Register transposes of square blocks of vectors, as inline functions of
+ * the vector types the target has, and whole-matrix transposes dispatched
+ * like the other array algorithms:
+ *
+ *     wcn_v128f_t r[4] = { ... four rows ... };
+ *     wcn_v128f_transpose4x4(r);              // r now holds the columns
+ *
+ *     // 480 x 640 image to 640 x 480
+ *     wcn_simd_transpose_u8(img, out, 480, 640);
+ *
+ * The register transposes are unpack networks: log2(n) rounds of
+ * unpacklo/unpackhi, widening the interleaved element each round, plus a
+ * final exchange of 128-bit lanes for the 256- and 512-bit ones. They
+ * exist for wcn_v128f_t / wcn_v128i_t on every 128-bit target (SSE2, NEON,
+ * LSX, AltiVec, MSA, WebAssembly), for wcn_v256f_t on AVX, wcn_v256i_t on
+ * AVX2 and wcn_v512f_t / wcn_v512i_t on AVX-512F.
+ *
+ * The array functions split the matrix recursively along its longer side
+ * until a block fits in the L1 cache, whatever the dimensions, and
+ * transpose each block with the widest register tile available (16 x 16
+ * floats on AVX-512, 8 x 8 on AVX, 4 x 4 on 128-bit targets; 8 x 8 and
+ * 16 x 16 for u16 and u8). Outputs above
+ * wcn_simd_tuning_t.stream_threshold bytes are written with non-temporal
+ * stores on x86 when the destination rows are vector aligned, and large
+ * matrices are split across the thread pool.
+ */
+
+#include "wcn_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* dst = src^T: src is rows x cols and dst cols x rows, both row-major and
+ * contiguous. src and dst must not overlap (no in-place transpose). */
+WCN_API_EXPORT void wcn_simd_transpose_f32(const float *src, float *dst,
+                                           size_t rows, size_t cols);
+WCN_API_EXPORT void wcn_simd_transpose_u16(const uint16_t *src,
+                                           uint16_t *dst, size_t rows,
+                                           size_t cols);
+WCN_API_EXPORT void wcn_simd_transpose_u8(const uint8_t *src, uint8_t *dst,
+                                          size_t rows, size_t cols);
+
+/* ---------- 128-bit ---------- */
+
+#if defined(WCN_X86_SSE2) || defined(WCN_ARM_NEON) ||                         \
+    defined(WCN_LOONGARCH_LSX) || defined(WCN_POWERPC_ALTIVEC) ||              \
+    defined(WCN_MIPS_MSA) || defined(WCN_WASM_SIMD128)
+
+/* r[i] = row i in, column i out */
+WCN_INLINE void wcn_v128f_transpose4x4(wcn_v128f_t r[4]) {
+    const wcn_v128f_t t0 = wcn_v128f_unpacklo(r[0], r[2]);
+    const wcn_v128f_t t1 = wcn_v128f_unpackhi(r[0], r[2]);
+    const wcn_v128f_t t2 = wcn_v128f_unpacklo(r[1], r[3]);
+    const wcn_v128f_t t3 = wcn_v128f_unpackhi(r[1], r[3]);
+    r[0] = wcn_v128f_unpacklo(t0, t2);
+    r[1] = wcn_v128f_unpackhi(t0, t2);
+    r[2] = wcn_v128f_unpacklo(t1, t3);
+    r[3] = wcn_v128f_unpackhi(t1, t3);
+}
+
+WCN_INLINE void wcn_v128i_transpose4x4_i32(wcn_v128i_t r[4]) {
+    const wcn_v128i_t t0 = wcn_v128i_unpacklo_i32(r[0], r[1]);
+    const wcn_v128i_t t1 = wcn_v128i_unpackhi_i32(r[0], r[1]);
+    const wcn_v128i_t t2 = wcn_v128i_unpacklo_i32(r[2], r[3]);
+    const wcn_v128i_t t3 = wcn_v128i_unpackhi_i32(r[2], r[3]);
+    r[0] = wcn_v128i_unpacklo_i64(t0, t2);
+    r[1] = wcn_v128i_unpackhi_i64(t0, t2);
+    r[2] = wcn_v128i_unpacklo_i64(t1, t3);
+    r[3] = wcn_v128i_unpackhi_i64(t1, t3);
+}
+
+/* Each round interleaves neighbouring rows at twice the previous width,
+ * low halves to the first half of the array and high halves to the
+ * second; after the last round column j sits at the bit-reversed index. */
+WCN_INLINE void wcn_v128i_transpose8x8_i16(wcn_v128i_t r[8]) {
+    wcn_v128i_t a[8], b[8];
+    for (int i = 0; i < 4; ++i) {
+        a[i] = wcn_v128i_unpacklo_i16(r[2 * i], r[2 * i + 1]);
+        a[i + 4] = wcn_v128i_unpackhi_i16(r[2 * i], r[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        b[i] = wcn_v128i_unpacklo_i32(a[2 * i], a[2 * i + 1]);
+        b[i + 4] = wcn_v128i_unpackhi_i32(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        a[i] = wcn_v128i_unpacklo_i64(b[2 * i], b[2 * i + 1]);
+        a[i + 4] = wcn_v128i_unpackhi_i64(b[2 * i], b[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        r[i] = a[((i & 1) << 2) | (i & 2) | ((i & 4) >> 2)];
+    }
+}
+
+WCN_INLINE void wcn_v128i_transpose16x16_i8(wcn_v128i_t r[16]) {
+    wcn_v128i_t a[16], b[16];
+    for (int i = 0; i < 8; ++i) {
+        a[i] = wcn_v128i_unpacklo_i8(r[2 * i], r[2 * i + 1]);
+        a[i + 8] = wcn_v128i_unpackhi_i8(r[2 * i], r[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        b[i] = wcn_v128i_unpacklo_i16(a[2 * i], a[2 * i + 1]);
+        b[i + 8] = wcn_v128i_unpackhi_i16(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        a[i] = wcn_v128i_unpacklo_i32(b[2 * i], b[2 * i + 1]);
+        a[i + 8] = wcn_v128i_unpackhi_i32(b[2 * i], b[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        b[i] = wcn_v128i_unpacklo_i64(a[2 * i], a[2 * i + 1]);
+        b[i + 8] = wcn_v128i_unpackhi_i64(a[2 * i], a[2 * i + 1]);
+    }
+    for (int i = 0; i < 16; ++i) {
+        r[i] = b[((i & 1) << 3) | ((i & 2) << 1) | ((i & 4) >> 1) |
+                 ((i & 8) >> 3)];
+    }
+}
+
+#endif
+
+/* ---------- 256-bit: AVX / AVX2 ---------- */
+
+/* 4 x 4 transposes inside each 128-bit lane, then the lanes of rows i and
+ * i + 4 are exchanged */
+#if defined(WCN_X86_AVX)
+
+WCN_INLINE void wcn_v256f_transpose8x8(wcn_v256f_t r[8]) {
+    wcn_v256f_t w[8];
+    for (int h = 0; h < 8; h += 4) {
+        const wcn_v256f_t t0 = wcn_v256f_unpacklo(r[h], r[h + 2]);
+        const wcn_v256f_t t1 = wcn_v256f_unpackhi(r[h], r[h + 2]);
+        const wcn_v256f_t t2 = wcn_v256f_unpacklo(r[h + 1], r[h + 3]);
+        const wcn_v256f_t t3 = wcn_v256f_unpackhi(r[h + 1], r[h + 3]);
+        w[h] = wcn_v256f_unpacklo(t0, t2);
+        w[h + 1] = wcn_v256f_unpackhi(t0, t2);
+        w[h + 2] = wcn_v256f_unpacklo(t1, t3);
+        w[h + 3] = wcn_v256f_unpackhi(t1, t3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        r[i].raw = _mm256_permute2f128_ps(w[i].raw, w[i + 4].raw, 0x20);
+        r[i + 4].raw = _mm256_permute2f128_ps(w[i].raw, w[i + 4].raw, 0x31);
+    }
+}
+
+#endif
+
+#if defined(WCN_X86_AVX2)
+
+WCN_INLINE void wcn_v256i_transpose8x8_i32(wcn_v256i_t r[8]) {
+    wcn_v256i_t w[8];
+    for (int h = 0; h < 8; h += 4) {
+        const wcn_v256i_t t0 = wcn_v256i_unpacklo_i32(r[h], r[h + 1]);
+        const wcn_v256i_t t1 = wcn_v256i_unpackhi_i32(r[h], r[h + 1]);
+        const wcn_v256i_t t2 = wcn_v256i_unpacklo_i32(r[h + 2], r[h + 3]);
+        const wcn_v256i_t t3 = wcn_v256i_unpackhi_i32(r[h + 2], r[h + 3]);
+        w[h] = wcn_v256i_unpacklo_i64(t0, t2);
+        w[h + 1] = wcn_v256i_unpackhi_i64(t0, t2);
+        w[h + 2] = wcn_v256i_unpacklo_i64(t1, t3);
+        w[h + 3] = wcn_v256i_unpackhi_i64(t1, t3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        r[i].raw = _mm256_permute2x128_si256(w[i].raw, w[i + 4].raw, 0x20);
+        r[i + 4].raw = _mm256_permute2x128_si256(w[i].raw, w[i + 4].raw, 0x31);
+    }
+}
+
+#endif
+
+/* ---------- 512-bit: AVX-512F ---------- */
+
+/* 4 x 4 transposes inside each 128-bit lane, then two rounds of 128-bit
+ * lane shuffles across rows i, i + 4, i + 8 and i + 12 */
+#if defined(WCN_X86_AVX512F)
+
+WCN_INLINE void wcn_v512f_transpose16x16(wcn_v512f_t r[16]) {
+    __m512 w[16];
+    for (int h = 0; h < 16; h += 4) {
+        const __m512 t0 = _mm512_unpacklo_ps(r[h].raw, r[h + 2].raw);
+        const __m512 t1 = _mm512_unpackhi_ps(r[h].raw, r[h + 2].raw);
+        const __m512 t2 = _mm512_unpacklo_ps(r[h + 1].raw, r[h + 3].raw);
+        const __m512 t3 = _mm512_unpackhi_ps(r[h + 1].raw, r[h + 3].raw);
+        w[h] = _mm512_unpacklo_ps(t0, t2);
+        w[h + 1] = _mm512_unpackhi_ps(t0, t2);
+        w[h + 2] = _mm512_unpacklo_ps(t1, t3);
+        w[h + 3] = _mm512_unpackhi_ps(t1, t3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        const __m512 v0 = _mm512_shuffle_f32x4(w[i], w[i + 4], 0x44);
+        const __m512 v1 = _mm512_shuffle_f32x4(w[i], w[i + 4], 0xEE);
+        const __m512 v2 = _mm512_shuffle_f32x4(w[i + 8], w[i + 12], 0x44);
+        const __m512 v3 = _mm512_shuffle_f32x4(w[i + 8], w[i + 12], 0xEE);
+        r[i].raw = _mm512_shuffle_f32x4(v0, v2, 0x88);
+        r[i + 4].raw = _mm512_shuffle_f32x4(v0, v2, 0xDD);
+        r[i + 8].raw = _mm512_shuffle_f32x4(v1, v3, 0x88);
+        r[i + 12].raw = _mm512_shuffle_f32x4(v1, v3, 0xDD);
+    }
+}
+
+WCN_INLINE void wcn_v512i_transpose16x16_i32(wcn_v512i_t r[16]) {
+    __m512i w[16];
+    for (int h = 0; h < 16; h += 4) {
+        const __m512i t0 = _mm512_unpacklo_epi32(r[h].raw, r[h + 1].raw);
+        const __m512i t1 = _mm512_unpackhi_epi32(r[h].raw, r[h + 1].raw);
+        const __m512i t2 = _mm512_unpacklo_epi32(r[h + 2].raw, r[h + 3].raw);
+        const __m512i t3 = _mm512_unpackhi_epi32(r[h + 2].raw, r[h + 3].raw);
+        w[h] = _mm512_unpacklo_epi64(t0, t2);
+        w[h + 1] = _mm512_unpackhi_epi64(t0, t2);
+        w[h + 2] = _mm512_unpacklo_epi64(t1, t3);
+        w[h + 3] = _mm512_unpackhi_epi64(t1, t3);
+    }
+    for (int i = 0; i < 4; ++i) {
+        const __m512i v0 = _mm512_shuffle_i32x4(w[i], w[i + 4], 0x44);
+        const __m512i v1 = _mm512_shuffle_i32x4(w[i], w[i + 4], 0xEE);
+        const __m512i v2 = _mm512_shuffle_i32x4(w[i + 8], w[i + 12], 0x44);
+        const __m512i v3 = _mm512_shuffle_i32x4(w[i + 8], w[i + 12], 0xEE);
+        r[i].raw = _mm512_shuffle_i32x4(v0, v2, 0x88);
+        r[i + 4].raw = _mm512_shuffle_i32x4(v0, v2, 0xDD);
+        r[i + 8].raw = _mm512_shuffle_i32x4(v1, v3, 0x88);
+        r[i + 12].raw = _mm512_shuffle_i32x4(v1, v3, 0xDD);
+    }
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_SIMD_TRANSPOSE_H */
@@ -0,0 +1,398 @@
+/*
+ * WCN_SIMD memory allocation (see wcn_alloc.h).
+ *
+ * Every block from wcn_aligned_alloc() is preceded by an alloc_header that
+ * records where the underlying allocation starts and how it was obtained,
+ * so one free function serves both malloc and mapped huge page memory and
+ * wcn_realloc() knows the size and alignment to preserve.
+ *
+ * Huge pages: Linux first asks for explicit (hugetlbfs) pages, which only
+ * exist when the administrator reserved some, and otherwise maps a 2 MiB
+ * aligned region and marks it for transparent huge pages. Windows uses
+ * large pages, which need SeLockMemoryPrivilege. When neither works the
+ * allocation quietly falls back to malloc.
+ *
+ * The arena and the block pool take their backing memory from
+ * wcn_aligned_alloc(), so large arena blocks get huge pages as well.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "WCN_SIMD.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define ALLOC_HAS_HUGE 1
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#define ALLOC_HAS_HUGE 1
+#endif
+
+#define IS_POW2(x) ((x) != 0 && ((x) & ((x)-1)) == 0)
+#define ROUND_UP(x, a) (((x) + (a)-1) & ~((size_t)(a)-1))
+
+/* 1 MiB arena blocks and 64 KiB block pool chunks by default */
+#define ARENA_BLOCK_DEFAULT ((size_t)1 << 20)
+#define BLOCK_POOL_CHUNK_DEFAULT ((size_t)64 << 10)
+
+typedef struct alloc_header {
+  void *base;    /* start of the malloc block or mapping */
+  size_t bytes;  /* size requested by the caller */
+  size_t align;  /* alignment of the returned address */
+  size_t mapped; /* length of the mapping; 0 for malloc */
+} alloc_header;
+
+static size_t g_huge_threshold = SIZE_MAX;
+
+/* ========== Huge Pages ========== */
+
+#if defined(ALLOC_HAS_HUGE)
+
+/* Map at least bytes of huge page backed memory, aligned to
+ * WCN_ALLOC_HUGE_PAGE; stores the mapping length in *mapped */
+static void *huge_map(size_t bytes, size_t *mapped) {
+#if defined(_WIN32)
+  const size_t page = GetLargePageMinimum();
+  if (page == 0 || page > WCN_ALLOC_HUGE_PAGE)
+    return NULL;
+  const size_t len = ROUND_UP(bytes, WCN_ALLOC_HUGE_PAGE);
+  void *p = VirtualAlloc(NULL, len, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                         PAGE_READWRITE);
+  if (p == NULL)
+    return NULL;
+  *mapped = len;
+  return p;
+#else
+  const size_t len = ROUND_UP(bytes, WCN_ALLOC_HUGE_PAGE);
+  void *p;
+#if defined(MAP_HUGETLB)
+  p = mmap(NULL, len, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED) {
+    *mapped = len;
+    return p;
+  }
+#endif
+  /* Over-map by one huge page and trim both ends so the region starts on
+   * a huge page boundary; THP can only back aligned 2 MiB ranges */
+  if (len > SIZE_MAX - WCN_ALLOC_HUGE_PAGE)
+    return NULL;
+  p = mmap(NULL, len + WCN_ALLOC_HUGE_PAGE, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    return NULL;
+  const uintptr_t raw = (uintptr_t)p;
+  const uintptr_t start = ROUND_UP(raw, WCN_ALLOC_HUGE_PAGE);
+  if (start > raw)
+    munmap(p, start - raw);
+  if (raw + WCN_ALLOC_HUGE_PAGE > start)
+    munmap((void *)(start + len), raw + WCN_ALLOC_HUGE_PAGE - start);
+#if defined(MADV_HUGEPAGE)
+  madvise((void *)start, len, MADV_HUGEPAGE);
+#endif
+  *mapped = len;
+  return (void *)start;
+#endif
+}
+
+static void huge_unmap(void *p, size_t len) {
+#if defined(_WIN32)
+  (void)len;
+  VirtualFree(p, 0, MEM_RELEASE);
+#else
+  munmap(p, len);
+#endif
+}
+
+#endif /* ALLOC_HAS_HUGE */
+
+/* ========== Aligned Heap Allocation ========== */
+
+WCN_API_EXPORT
+void *wcn_aligned_alloc(size_t bytes, size_t align) {
+  if (align == 0)
+    align = WCN_ALLOC_ALIGN;
+  if (!IS_POW2(align))
+    return NULL;
+  if (align < WCN_ALLOC_ALIGN)
+    align = WCN_ALLOC_ALIGN;
+  /* align >= sizeof(alloc_header), so the header always fits in front */
+  if (bytes > SIZE_MAX - align - sizeof(alloc_header))
+    return NULL;
+
+  unsigned char *base = NULL;
+  unsigned char *user;
+  size_t mapped = 0;
+#if defined(ALLOC_HAS_HUGE)
+  if (bytes >= g_huge_threshold && align <= WCN_ALLOC_HUGE_PAGE)
+    base = (unsigned char *)huge_map(bytes + align, &mapped);
+#endif
+  if (base != NULL) {
+    user = base + align;
+  } else {
+    base = (unsigned char *)malloc(bytes + align + sizeof(alloc_header));
+    if (base == NULL)
+      return NULL;
+    user = (unsigned char *)ROUND_UP((uintptr_t)base + sizeof(alloc_header),
+                                     align);
+  }
+
+  alloc_header *h = (alloc_header *)user - 1;
+  h->base = base;
+  h->bytes = bytes;
+  h->align = align;
+  h->mapped = mapped;
+  return user;
+}
+
+WCN_API_EXPORT
+void wcn_aligned_free(void *ptr) {
+  if (ptr == NULL)
+    return;
+  const alloc_header *h = (const alloc_header *)ptr - 1;
+#if defined(ALLOC_HAS_HUGE)
+  if (h->mapped != 0) {
+    huge_unmap(h->base, h->mapped);
+    return;
+  }
+#endif
+  free(h->base);
+}
+
+WCN_API_EXPORT
+void *wcn_realloc(void *ptr, size_t bytes) {
+  if (ptr == NULL)
+    return wcn_alloc(bytes);
+  const alloc_header *h = (const alloc_header *)ptr - 1;
+  void *p = wcn_aligned_alloc(bytes, h->align);
+  if (p == NULL)
+    return NULL;
+  memcpy(p, ptr, bytes < h->bytes ? bytes : h->bytes);
+  wcn_aligned_free(ptr);
+  return p;
+}
+
+WCN_API_EXPORT
+void *wcn_alloc(size_t bytes) {
+  return wcn_aligned_alloc(bytes, WCN_ALLOC_ALIGN);
+}
+
+WCN_API_EXPORT
+void wcn_free(void *ptr) { wcn_aligned_free(ptr); }
+
+WCN_API_EXPORT
+void wcn_alloc_set_huge_page_threshold(size_t bytes) {
+  g_huge_threshold = bytes;
+}
+
+/* ========== Arena ========== */
+
+/* Arena blocks form a singly linked list in allocation order. Allocation
+ * bumps a pointer through the current block and moves on to the next one
+ * when it is full; reset only rewinds to the first block. */
+typedef struct arena_block {
+  struct arena_block *next;
+  size_t size; /* usable bytes after ARENA_BLOCK_HEADER */
+} arena_block;
+
+#define ARENA_BLOCK_HEADER ROUND_UP(sizeof(arena_block), WCN_ALLOC_ALIGN)
+
+struct wcn_arena {
+  arena_block *first;
+  arena_block *cur;
+  uintptr_t ptr;
+  uintptr_t end;
+  size_t block_bytes;
+  size_t used;
+};
+
+static void arena_enter(wcn_arena_t *arena, arena_block *b) {
+  arena->cur = b;
+  arena->ptr = (uintptr_t)b + ARENA_BLOCK_HEADER;
+  arena->end = arena->ptr + b->size;
+}
+
+WCN_API_EXPORT
+wcn_arena_t *wcn_arena_create(size_t block_bytes) {
+  wcn_arena_t *arena = (wcn_arena_t *)calloc(1, sizeof(*arena));
+  if (arena == NULL)
+    return NULL;
+  arena->block_bytes =
+      block_bytes != 0 ? ROUND_UP(block_bytes, WCN_ALLOC_ALIGN)
+                       : ARENA_BLOCK_DEFAULT;
+  return arena;
+}
+
+WCN_API_EXPORT
+void wcn_arena_destroy(wcn_arena_t *arena) {
+  if (arena == NULL)
+    return;
+  arena_block *b = arena->first;
+  while (b != NULL) {
+    arena_block *next = b->next;
+    wcn_aligned_free(b);
+    b = next;
+  }
+  free(arena);
+}
+
+WCN_API_EXPORT
+void *wcn_arena_alloc(wcn_arena_t *arena, size_t bytes, size_t align) {
+  if (align == 0)
+    align = WCN_ALLOC_ALIGN;
+  if (arena == NULL || !IS_POW2(align))
+    return NULL;
+  if (align < WCN_ALLOC_ALIGN)
+    align = WCN_ALLOC_ALIGN;
+  if (bytes > SIZE_MAX - align - ARENA_BLOCK_HEADER)
+    return NULL;
+  /* Block data starts WCN_ALLOC_ALIGN-aligned, so this much room in an
+   * empty block always suffices */
+  const size_t need = bytes + (align - WCN_ALLOC_ALIGN);
+
+  for (;;) {
+    if (arena->cur != NULL) {
+      const uintptr_t p = ROUND_UP(arena->ptr, align);
+      if (p <= arena->end && arena->end - p >= bytes) {
+        arena->used += p + bytes - arena->ptr;
+        arena->ptr = p + bytes;
+        return (void *)p;
+      }
+      /* Reuse a block kept from before the last reset if it is big
+       * enough */
+      arena_block *next = arena->cur->next;
+      if (next != NULL && next->size >= need) {
+        arena_enter(arena, next);
+        continue;
+      }
+    }
+
+    /* Add a block after the current one; smaller blocks further down the
+     * list stay in line for later requests */
+    const size_t size = need > arena->block_bytes ? need : arena->block_bytes;
+    arena_block *b =
+        (arena_block *)wcn_aligned_alloc(ARENA_BLOCK_HEADER + size,
+                                         WCN_ALLOC_ALIGN);
+    if (b == NULL)
+      return NULL;
+    b->size = size;
+    if (arena->cur != NULL) {
+      b->next = arena->cur->next;
+      arena->cur->next = b;
+    } else {
+      b->next = arena->first;
+      arena->first = b;
+    }
+    arena_enter(arena, b);
+  }
+}
+
+WCN_API_EXPORT
+void wcn_arena_reset(wcn_arena_t *arena) {
+  if (arena == NULL || arena->first == NULL)
+    return;
+  arena_enter(arena, arena->first);
+  arena->used = 0;
+}
+
+WCN_API_EXPORT
+size_t wcn_arena_used(const wcn_arena_t *arena) {
+  return arena != NULL ? arena->used : 0;
+}
+
+/* ========== Block Pool ========== */
+
+/* Chunks of blocks are carved on demand and only returned on destroy. Free
+ * blocks are chained through their first word. */
+typedef struct pool_chunk {
+  struct pool_chunk *next;
+} pool_chunk;
+
+#define POOL_CHUNK_HEADER ROUND_UP(sizeof(pool_chunk), WCN_ALLOC_ALIGN)
+
+struct wcn_block_pool {
+  void *free_list;
+  pool_chunk *chunks;
+  size_t block_size;
+  size_t blocks_per_chunk;
+};
+
+WCN_API_EXPORT
+wcn_block_pool_t *wcn_block_pool_create(size_t block_size,
+                                        size_t blocks_per_chunk) {
+  if (block_size > SIZE_MAX / 2)
+    return NULL;
+  block_size = block_size != 0 ? ROUND_UP(block_size, WCN_ALLOC_ALIGN)
+                               : WCN_ALLOC_ALIGN;
+  if (blocks_per_chunk == 0) {
+    blocks_per_chunk = BLOCK_POOL_CHUNK_DEFAULT / block_size;
+    if (blocks_per_chunk == 0)
+      blocks_per_chunk = 1;
+  }
+  if (blocks_per_chunk > (SIZE_MAX - POOL_CHUNK_HEADER) / block_size)
+    return NULL;
+
+  wcn_block_pool_t *pool = (wcn_block_pool_t *)calloc(1, sizeof(*pool));
+  if (pool == NULL)
+    return NULL;
+  pool->block_size = block_size;
+  pool->blocks_per_chunk = blocks_per_chunk;
+  return pool;
+}
+
+WCN_API_EXPORT
+void wcn_block_pool_destroy(wcn_block_pool_t *pool) {
+  if (pool == NULL)
+    return;
+  pool_chunk *c = pool->chunks;
+  while (c != NULL) {
+    pool_chunk *next = c->next;
+    wcn_aligned_free(c);
+    c = next;
+  }
+  free(pool);
+}
+
+WCN_API_EXPORT
+void *wcn_block_pool_alloc(wcn_block_pool_t *pool) {
+  if (pool == NULL)
+    return NULL;
+  if (pool->free_list == NULL) {
+    pool_chunk *c = (pool_chunk *)wcn_aligned_alloc(
+        POOL_CHUNK_HEADER + pool->blocks_per_chunk * pool->block_size,
+        WCN_ALLOC_ALIGN);
+    if (c == NULL)
+      return NULL;
+    c->next = pool->chunks;
+    pool->chunks = c;
+
+    /* Thread the new blocks in address order */
+    unsigned char *block = (unsigned char *)c + POOL_CHUNK_HEADER;
+    void *head = NULL;
+    for (size_t i = pool->blocks_per_chunk; i-- > 0;) {
+      void *b = block + i * pool->block_size;
+      *(void **)b = head;
+      head = b;
+    }
+    pool->free_list = head;
+  }
+  void *b = pool->free_list;
+  pool->free_list = *(void **)b;
+  return b;
+}
+
+WCN_API_EXPORT
+void wcn_block_pool_free(wcn_block_pool_t *pool, void *block) {
+  if (pool == NULL || block == NULL)
+    return;
+  *(void **)block = pool->free_list;
+  pool->free_list = block;
+}
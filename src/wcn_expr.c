@@ -0,0 +1,373 @@
+/*
+ * WCN_SIMD fused element-wise expressions: graph builder and compiler.
+ *
+ * Nodes are appended in creation order, and an operation can only refer to
+ * nodes that already exist, so the node array is always topologically
+ * sorted. Compilation keeps the nodes reachable from the root, assigns each
+ * intermediate a block slot that is released after its last use, and emits
+ * one instruction per operation; the evaluation itself is an ISA kernel
+ * (wcn_kernels_expr_impl.h).
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Leaf node kinds; they never appear in a compiled plan */
+#define EXPR_NODE_INPUT 0xF0
+#define EXPR_NODE_CONST 0xF1
+
+typedef struct {
+  float value;      /* EXPR_NODE_CONST */
+  int16_t arg[3];   /* operands, -1 if unused */
+  uint8_t op;       /* wcn_expr_op_t or EXPR_NODE_* */
+  uint8_t input;    /* EXPR_NODE_INPUT */
+} expr_node_t;
+
+struct wcn_expr {
+  int count;
+  expr_node_t nodes[WCN_EXPR_MAX_NODES];
+};
+
+static int expr_arity(uint8_t op) {
+  switch (op) {
+  case WCN_EXPR_OP_FMA:
+    return 3;
+  case WCN_EXPR_OP_ABS:
+  case WCN_EXPR_OP_NEG:
+  case WCN_EXPR_OP_SQRT:
+    return 1;
+  case EXPR_NODE_INPUT:
+  case EXPR_NODE_CONST:
+    return 0;
+  default:
+    return 2;
+  }
+}
+
+/* Scalar semantics, used to fold all-constant operations */
+static float expr_fold(uint8_t op, float a, float b, float c) {
+  switch (op) {
+  case WCN_EXPR_OP_ADD:
+    return a + b;
+  case WCN_EXPR_OP_SUB:
+    return a - b;
+  case WCN_EXPR_OP_MUL:
+    return a * b;
+  case WCN_EXPR_OP_DIV:
+    return a / b;
+  case WCN_EXPR_OP_MIN:
+    return fminf(a, b);
+  case WCN_EXPR_OP_MAX:
+    return fmaxf(a, b);
+  case WCN_EXPR_OP_FMA:
+    return fmaf(a, b, c);
+  case WCN_EXPR_OP_ABS:
+    return fabsf(a);
+  case WCN_EXPR_OP_NEG:
+    return -a;
+  case WCN_EXPR_OP_SQRT:
+    return sqrtf(a);
+  default:
+    return a;
+  }
+}
+
+/* Append a node, or return the existing node it duplicates */
+static wcn_expr_node_t expr_push(wcn_expr_t *e, const expr_node_t *node) {
+  for (int i = 0; i < e->count; ++i) {
+    if (memcmp(&e->nodes[i], node, sizeof(*node)) == 0) {
+      return i;
+    }
+  }
+  if (e->count == WCN_EXPR_MAX_NODES) {
+    return WCN_EXPR_INVALID;
+  }
+  e->nodes[e->count] = *node;
+  return e->count++;
+}
+
+static wcn_expr_node_t expr_op(wcn_expr_t *e, uint8_t op, wcn_expr_node_t a,
+                               wcn_expr_node_t b, wcn_expr_node_t c) {
+  if (!e) {
+    return WCN_EXPR_INVALID;
+  }
+
+  const int arity = expr_arity(op);
+  wcn_expr_node_t args[3] = {a, b, c};
+  int all_const = 1;
+  for (int k = 0; k < 3; ++k) {
+    if (k >= arity) {
+      args[k] = -1;
+    } else if (args[k] < 0 || args[k] >= e->count) {
+      return WCN_EXPR_INVALID;
+    } else if (e->nodes[args[k]].op != EXPR_NODE_CONST) {
+      all_const = 0;
+    }
+  }
+
+  if (all_const) {
+    float v[3] = {0.0f, 0.0f, 0.0f};
+    for (int k = 0; k < arity; ++k) {
+      v[k] = e->nodes[args[k]].value;
+    }
+    return wcn_expr_const(e, expr_fold(op, v[0], v[1], v[2]));
+  }
+
+  /* Canonical operand order lets commutative duplicates be shared */
+  if ((op == WCN_EXPR_OP_ADD || op == WCN_EXPR_OP_MUL ||
+       op == WCN_EXPR_OP_MIN || op == WCN_EXPR_OP_MAX) &&
+      args[0] > args[1]) {
+    wcn_expr_node_t t = args[0];
+    args[0] = args[1];
+    args[1] = t;
+  }
+
+  expr_node_t node;
+  memset(&node, 0, sizeof(node));
+  node.op = op;
+  for (int k = 0; k < 3; ++k) {
+    node.arg[k] = (int16_t)args[k];
+  }
+  return expr_push(e, &node);
+}
+
+/* ========== Graph Construction ========== */
+
+WCN_API_EXPORT
+wcn_expr_t *wcn_expr_create(void) {
+  return (wcn_expr_t *)calloc(1, sizeof(wcn_expr_t));
+}
+
+WCN_API_EXPORT
+void wcn_expr_destroy(wcn_expr_t *e) { free(e); }
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_input(wcn_expr_t *e, unsigned index) {
+  if (!e || index >= WCN_EXPR_MAX_INPUTS) {
+    return WCN_EXPR_INVALID;
+  }
+  expr_node_t node;
+  memset(&node, 0, sizeof(node));
+  node.op = EXPR_NODE_INPUT;
+  node.input = (uint8_t)index;
+  node.arg[0] = node.arg[1] = node.arg[2] = -1;
+  return expr_push(e, &node);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_const(wcn_expr_t *e, float value) {
+  if (!e) {
+    return WCN_EXPR_INVALID;
+  }
+  expr_node_t node;
+  memset(&node, 0, sizeof(node));
+  node.op = EXPR_NODE_CONST;
+  node.value = value;
+  node.arg[0] = node.arg[1] = node.arg[2] = -1;
+  return expr_push(e, &node);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_add(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_ADD, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_sub(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_SUB, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_mul(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_MUL, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_div(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_DIV, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_min(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_MIN, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_max(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b) {
+  return expr_op(e, WCN_EXPR_OP_MAX, a, b, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_fma(wcn_expr_t *e, wcn_expr_node_t a,
+                             wcn_expr_node_t b, wcn_expr_node_t c) {
+  return expr_op(e, WCN_EXPR_OP_FMA, a, b, c);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_abs(wcn_expr_t *e, wcn_expr_node_t a) {
+  return expr_op(e, WCN_EXPR_OP_ABS, a, -1, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_neg(wcn_expr_t *e, wcn_expr_node_t a) {
+  return expr_op(e, WCN_EXPR_OP_NEG, a, -1, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_sqrt(wcn_expr_t *e, wcn_expr_node_t a) {
+  return expr_op(e, WCN_EXPR_OP_SQRT, a, -1, -1);
+}
+
+WCN_API_EXPORT
+wcn_expr_node_t wcn_expr_clamp(wcn_expr_t *e, wcn_expr_node_t x, float lo,
+                               float hi) {
+  wcn_expr_node_t t = wcn_expr_max(e, x, wcn_expr_const(e, lo));
+  return wcn_expr_min(e, t, wcn_expr_const(e, hi));
+}
+
+/* ========== Plans ========== */
+
+WCN_API_EXPORT
+wcn_expr_plan_t *wcn_expr_compile(const wcn_expr_t *e, wcn_expr_node_t root) {
+  if (!e || root < 0 || root >= e->count) {
+    return NULL;
+  }
+
+  /* Reachability and last use; operands always precede their users */
+  uint8_t live[WCN_EXPR_MAX_NODES] = {0};
+  int last_use[WCN_EXPR_MAX_NODES];
+  live[root] = 1;
+  for (int i = root; i >= 0; --i) {
+    if (!live[i]) {
+      continue;
+    }
+    for (int k = 0; k < 3; ++k) {
+      if (e->nodes[i].arg[k] >= 0) {
+        live[e->nodes[i].arg[k]] = 1;
+      }
+    }
+  }
+  for (int i = 0; i <= root; ++i) {
+    last_use[i] = -1;
+    if (!live[i]) {
+      continue;
+    }
+    for (int k = 0; k < 3; ++k) {
+      if (e->nodes[i].arg[k] >= 0) {
+        last_use[e->nodes[i].arg[k]] = i;
+      }
+    }
+  }
+
+  wcn_expr_plan_t *plan = (wcn_expr_plan_t *)calloc(1, sizeof(*plan));
+  if (!plan) {
+    return NULL;
+  }
+
+  uint8_t ref[WCN_EXPR_MAX_NODES];
+  uint8_t slot_busy[WCN_EXPR_MAX_SLOTS] = {0};
+  uint32_t n_consts = 0;
+
+  for (int i = 0; i <= root; ++i) {
+    const expr_node_t *node = &e->nodes[i];
+    if (!live[i]) {
+      continue;
+    }
+
+    if (node->op == EXPR_NODE_INPUT) {
+      plan->input_mask |= 1u << node->input;
+      ref[i] = node->input;
+      continue;
+    }
+    if (node->op == EXPR_NODE_CONST) {
+      for (size_t l = 0; l < WCN_EXPR_SPLAT; ++l) {
+        plan->consts[n_consts][l] = node->value;
+      }
+      ref[i] = (uint8_t)(WCN_EXPR_REF_CONST + n_consts++);
+      continue;
+    }
+
+    wcn_expr_insn_t *insn = &plan->insns[plan->n_insns++];
+    insn->op = node->op;
+    for (int k = 0; k < 3; ++k) {
+      const int arg = node->arg[k] >= 0 ? node->arg[k] : node->arg[0];
+      insn->src[k] = ref[arg];
+    }
+
+    /* Operands that die here free their slot first, so the result may
+     * overwrite one of them in place (the ops are element-wise) */
+    for (int k = 0; k < 3; ++k) {
+      const int arg = node->arg[k];
+      if (arg >= 0 && last_use[arg] == i && ref[arg] >= WCN_EXPR_REF_SLOT &&
+          ref[arg] < WCN_EXPR_REF_CONST) {
+        slot_busy[ref[arg] - WCN_EXPR_REF_SLOT] = 0;
+      }
+    }
+
+    if (i == root) {
+      insn->dst = WCN_EXPR_DST_OUT;
+      break;
+    }
+    int slot = 0;
+    while (slot < WCN_EXPR_MAX_SLOTS && slot_busy[slot]) {
+      ++slot;
+    }
+    if (slot == WCN_EXPR_MAX_SLOTS) {
+      free(plan);
+      return NULL;
+    }
+    slot_busy[slot] = 1;
+    insn->dst = (uint8_t)slot;
+    ref[i] = (uint8_t)(WCN_EXPR_REF_SLOT + slot);
+  }
+
+  /* A bare input or constant still has to be written to the output */
+  if (e->nodes[root].op == EXPR_NODE_INPUT ||
+      e->nodes[root].op == EXPR_NODE_CONST) {
+    wcn_expr_insn_t *insn = &plan->insns[plan->n_insns++];
+    insn->op = WCN_EXPR_OP_COPY;
+    insn->dst = WCN_EXPR_DST_OUT;
+    insn->src[0] = insn->src[1] = insn->src[2] = ref[root];
+  }
+  return plan;
+}
+
+WCN_API_EXPORT
+void wcn_expr_plan_destroy(wcn_expr_plan_t *plan) { free(plan); }
+
+WCN_API_EXPORT
+void wcn_expr_eval(const wcn_expr_plan_t *plan, const float *const *inputs,
+                   float *out, size_t count) {
+  if (!plan || count == 0) {
+    return;
+  }
+#if defined(WCN_SIMD_STATS)
+  {
+    uintptr_t addr = (uintptr_t)out;
+    unsigned arrays = 1;
+    for (int i = 0; i < WCN_EXPR_MAX_INPUTS; i++) {
+      if (plan->input_mask & (1u << i)) {
+        addr |= (uintptr_t)inputs[i];
+        arrays++;
+      }
+    }
+    WCN_STATS_CALL(WCN_STATS_EXPR_EVAL, count, sizeof(float), arrays, addr);
+  }
+#endif
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_EXPR_EVAL, parallel_calls);
+    wcn_parallel_expr(plan, inputs, out, count);
+    return;
+  }
+  wcn_simd_active_kernels()->expr_eval_f32(plan, inputs, out, count);
+}
@@ -0,0 +1,135 @@
+/*
+ * WCN_SIMD 16-bit float storage: array entry points (see wcn_f16.h).
+ *
+ * The kernels live in wcn_kernels_half_impl.h and are split across the
+ * pool like their f32 counterparts. Statistics count elements of the 16-bit
+ * format; a float array is two such units per element.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+
+/* ========== Conversions ========== */
+
+WCN_API_EXPORT
+void wcn_simd_f16_to_f32(const wcn_f16_t *src, float *dst, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_F16_TO_F32, count, sizeof(wcn_f16_t), 3,
+                 (uintptr_t)src | (uintptr_t)dst);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_F16_TO_F32, parallel_calls);
+    wcn_parallel_map(WCN_PAR_F16_TO_F32, src, NULL, dst, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->f16_to_f32(src, dst, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_f32_to_f16(const float *src, wcn_f16_t *dst, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_F32_TO_F16, count, sizeof(wcn_f16_t), 3,
+                 (uintptr_t)src | (uintptr_t)dst);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_F32_TO_F16, parallel_calls);
+    wcn_parallel_map(WCN_PAR_F32_TO_F16, src, NULL, dst, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->f32_to_f16(src, dst, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_bf16_to_f32(const wcn_bf16_t *src, float *dst, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_BF16_TO_F32, count, sizeof(wcn_bf16_t), 3,
+                 (uintptr_t)src | (uintptr_t)dst);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_BF16_TO_F32, parallel_calls);
+    wcn_parallel_map(WCN_PAR_BF16_TO_F32, src, NULL, dst, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->bf16_to_f32(src, dst, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_f32_to_bf16(const float *src, wcn_bf16_t *dst, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_F32_TO_BF16, count, sizeof(wcn_bf16_t), 3,
+                 (uintptr_t)src | (uintptr_t)dst);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_F32_TO_BF16, parallel_calls);
+    wcn_parallel_map(WCN_PAR_F32_TO_BF16, src, NULL, dst, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->f32_to_bf16(src, dst, count);
+}
+
+/* ========== Mixed-Precision Kernels ========== */
+
+WCN_API_EXPORT
+float wcn_simd_dot_product_f16(const wcn_f16_t *a, const wcn_f16_t *b,
+                               size_t count) {
+  WCN_STATS_CALL(WCN_STATS_DOT_PRODUCT_F16, count, sizeof(wcn_f16_t), 2,
+                 (uintptr_t)a | (uintptr_t)b);
+  if (wcn_parallel_should_chunk(count)) {
+    WCN_STATS_ADD(WCN_STATS_DOT_PRODUCT_F16, parallel_calls);
+    return (float)wcn_parallel_reduce(WCN_PAR_DOT_F16, a, b, count);
+  }
+  return wcn_simd_active_kernels()->dot_product_f16(a, b, count);
+}
+
+WCN_API_EXPORT
+float wcn_simd_dot_product_bf16(const wcn_bf16_t *a, const wcn_bf16_t *b,
+                                size_t count) {
+  WCN_STATS_CALL(WCN_STATS_DOT_PRODUCT_BF16, count, sizeof(wcn_bf16_t), 2,
+                 (uintptr_t)a | (uintptr_t)b);
+  if (wcn_parallel_should_chunk(count)) {
+    WCN_STATS_ADD(WCN_STATS_DOT_PRODUCT_BF16, parallel_calls);
+    return (float)wcn_parallel_reduce(WCN_PAR_DOT_BF16, a, b, count);
+  }
+  return wcn_simd_active_kernels()->dot_product_bf16(a, b, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_fmadd_array_f16(const wcn_f16_t *a, const wcn_f16_t *b,
+                              float *c, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_FMADD_ARRAY_F16, count, sizeof(wcn_f16_t), 6,
+                 (uintptr_t)a | (uintptr_t)b | (uintptr_t)c);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_FMADD_ARRAY_F16, parallel_calls);
+    wcn_parallel_map(WCN_PAR_FMADD_F16, a, b, c, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->fmadd_array_f16(a, b, c, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_fmadd_array_bf16(const wcn_bf16_t *a, const wcn_bf16_t *b,
+                               float *c, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_FMADD_ARRAY_BF16, count, sizeof(wcn_bf16_t), 6,
+                 (uintptr_t)a | (uintptr_t)b | (uintptr_t)c);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(WCN_STATS_FMADD_ARRAY_BF16, parallel_calls);
+    wcn_parallel_map(WCN_PAR_FMADD_BF16, a, b, c, 0.0, count);
+    return;
+  }
+  wcn_simd_active_kernels()->fmadd_array_bf16(a, b, c, count);
+}
+
+WCN_API_EXPORT
+float wcn_simd_reduce_sum_f16(const wcn_f16_t *data, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_REDUCE_SUM_F16, count, sizeof(wcn_f16_t), 1,
+                 (uintptr_t)data);
+  if (wcn_parallel_should_chunk(count)) {
+    WCN_STATS_ADD(WCN_STATS_REDUCE_SUM_F16, parallel_calls);
+    return (float)wcn_parallel_reduce(WCN_PAR_SUM_F16, data, NULL, count);
+  }
+  return wcn_simd_active_kernels()->reduce_sum_f16(data, count);
+}
+
+WCN_API_EXPORT
+float wcn_simd_reduce_sum_bf16(const wcn_bf16_t *data, size_t count) {
+  WCN_STATS_CALL(WCN_STATS_REDUCE_SUM_BF16, count, sizeof(wcn_bf16_t), 1,
+                 (uintptr_t)data);
+  if (wcn_parallel_should_chunk(count)) {
+    WCN_STATS_ADD(WCN_STATS_REDUCE_SUM_BF16, parallel_calls);
+    return (float)wcn_parallel_reduce(WCN_PAR_SUM_BF16, data, NULL, count);
+  }
+  return wcn_simd_active_kernels()->reduce_sum_bf16(data, count);
+}
@@ -0,0 +1,270 @@
+/*
+ * WCN_SIMD FFT: plans, the plan cache and entry points (see wcn_fft.h).
+ *
+ * The passes live in wcn_kernels_fft_impl.h. A plan factors n into radix-8
+ * passes first (radix 4 and 2 for the leftover factors of two, preferring
+ * two radix-4 passes to a radix-8 and a radix-2 one), then 5 and 3, and
+ * precomputes every twiddle in double precision. The first pass, the only
+ * one that vectorizes over butterflies, thus gets the widest radix. Plans
+ * are immutable once built and live in a mutex-guarded list until
+ * wcn_simd_fft_plan_cache_clear(). Transforms of up to FFT_STACK_POINTS
+ * points keep their scratch on the stack; larger ones allocate it per
+ * call. Statistics count every point read once and written once.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_thread.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Largest transform, in complex points, whose scratch is a stack array */
+#define FFT_STACK_POINTS 1024
+
+static wcn_fft_plan_t *g_plans;
+
+#if !defined(WCN_SIMD_NO_THREADS)
+static wcn_mutex_t g_lock = WCN_MUTEX_INIT;
+#define FFT_LOCK() wcn_mutex_lock(&g_lock)
+#define FFT_UNLOCK() wcn_mutex_unlock(&g_lock)
+#else
+#define FFT_LOCK() ((void)0)
+#define FFT_UNLOCK() ((void)0)
+#endif
+
+/* ========== Plans ========== */
+
+/* e^(-2 pi i k / n), with k reduced first so that large n stay exact */
+static void fft_twiddle(size_t k, size_t n, float *re, float *im) {
+  const double a = -6.283185307179586476925 * (double)(k % n) / (double)n;
+  *re = (float)cos(a);
+  *im = (float)sin(a);
+}
+
+/* The radices of n into plan; -1 if n has a prime factor above 5 */
+static int fft_factor(size_t n, wcn_fft_plan_t *plan) {
+  unsigned log2 = 0;
+  while (n % 2 == 0) {
+    n /= 2;
+    log2++;
+  }
+  unsigned eights = log2 / 3, fours = 0, twos = 0;
+  if (log2 % 3 == 2) {
+    fours = 1;
+  } else if (log2 % 3 == 1 && eights > 0) {
+    eights--;
+    fours = 2;
+  } else if (log2 % 3 == 1) {
+    twos = 1;
+  }
+  unsigned t = 0;
+  for (; eights > 0; --eights) {
+    plan->radix[t++] = 8;
+  }
+  for (; fours > 0; --fours) {
+    plan->radix[t++] = 4;
+  }
+  for (; twos > 0; --twos) {
+    plan->radix[t++] = 2;
+  }
+  for (; n % 5 == 0; n /= 5) {
+    plan->radix[t++] = 5;
+  }
+  for (; n % 3 == 0; n /= 3) {
+    plan->radix[t++] = 3;
+  }
+  plan->stages = t;
+  return n == 1 ? 0 : -1;
+}
+
+/* A plan for n complex points, or for 2 n real samples with real set */
+static wcn_fft_plan_t *fft_plan_build(size_t n, int real) {
+  wcn_fft_plan_t *plan = (wcn_fft_plan_t *)calloc(1, sizeof(*plan));
+  if (plan == NULL) {
+    return NULL;
+  }
+  plan->n = n;
+  plan->real_n = real ? 2 * n : 0;
+  if (fft_factor(n, plan) != 0) {
+    free(plan);
+    return NULL;
+  }
+
+  /* Every table in one block: the passes, then pass 0 per lane, then the
+   * real split */
+  size_t floats = 0, s = 1;
+  for (unsigned t = 0; t < plan->stages; ++t) {
+    const unsigned r = plan->radix[t];
+    plan->stride[t] = s;
+    floats += 2 * (n / (s * r)) * (r - 1);
+    s *= r;
+  }
+  const size_t lanes_at = floats;
+  if (plan->stages > 0) {
+    floats += 4 * (n / plan->radix[0]) * (plan->radix[0] - 1);
+  }
+  const size_t real_at = floats;
+  if (real) {
+    floats += 4 * (n / 2 + 1);
+  }
+  plan->tables = (float *)wcn_aligned_alloc((floats + 1) * sizeof(float), 64);
+  if (plan->tables == NULL) {
+    free(plan);
+    return NULL;
+  }
+
+  float *tw = plan->tables;
+  for (unsigned t = 0; t < plan->stages; ++t) {
+    const unsigned r = plan->radix[t];
+    const size_t len = n / plan->stride[t];
+    plan->tw[t] = tw;
+    for (size_t p = 0; p < len / r; ++p) {
+      for (unsigned j = 1; j < r; ++j, tw += 2) {
+        fft_twiddle(p * j, len, &tw[0], &tw[1]);
+      }
+    }
+  }
+  if (plan->stages > 0) {
+    const unsigned r = plan->radix[0];
+    const size_t m = n / r;
+    float *lanes = plan->tables + lanes_at;
+    plan->tw_lanes = lanes;
+    for (unsigned j = 1; j < r; ++j, lanes += 4 * m) {
+      for (size_t p = 0; p < m; ++p) {
+        fft_twiddle(p * j, n, &lanes[2 * p], &lanes[2 * m + 2 * p]);
+        lanes[2 * p + 1] = lanes[2 * p];
+        lanes[2 * m + 2 * p + 1] = lanes[2 * m + 2 * p];
+      }
+    }
+  }
+  if (real) {
+    const size_t half = n / 2 + 1;
+    float *rtw = plan->tables + real_at;
+    plan->real_tw = rtw;
+    for (size_t k = 0; k < half; ++k) {
+      fft_twiddle(k, 2 * n, &rtw[2 * k], &rtw[2 * half + 2 * k]);
+      rtw[2 * k + 1] = rtw[2 * k];
+      rtw[2 * half + 2 * k + 1] = rtw[2 * half + 2 * k];
+    }
+  }
+  return plan;
+}
+
+/* The cached plan, building it on first use */
+static const wcn_fft_plan_t *fft_plan_get(size_t n, int real) {
+  const size_t real_n = real ? 2 * n : 0;
+  FFT_LOCK();
+  wcn_fft_plan_t *plan = g_plans;
+  while (plan != NULL && (plan->n != n || plan->real_n != real_n)) {
+    plan = plan->next;
+  }
+  if (plan == NULL) {
+    plan = fft_plan_build(n, real);
+    if (plan != NULL) {
+      plan->next = g_plans;
+      g_plans = plan;
+    }
+  }
+  FFT_UNLOCK();
+  return plan;
+}
+
+WCN_API_EXPORT
+const wcn_fft_plan_t *wcn_simd_fft_plan_c2c(size_t n) {
+  return n > 0 ? fft_plan_get(n, 0) : NULL;
+}
+
+WCN_API_EXPORT
+const wcn_fft_plan_t *wcn_simd_fft_plan_r2c(size_t n) {
+  return n > 0 && n % 2 == 0 ? fft_plan_get(n / 2, 1) : NULL;
+}
+
+WCN_API_EXPORT
+void wcn_simd_fft_plan_cache_clear(void) {
+  FFT_LOCK();
+  wcn_fft_plan_t *plan = g_plans;
+  g_plans = NULL;
+  FFT_UNLOCK();
+  while (plan != NULL) {
+    wcn_fft_plan_t *next = plan->next;
+    wcn_aligned_free(plan->tables);
+    free(plan);
+    plan = next;
+  }
+}
+
+/* ========== Transforms ========== */
+
+/* Scratch for plan: stack (2 * FFT_STACK_POINTS floats) or the heap */
+static float *fft_work(const wcn_fft_plan_t *plan, float *stack) {
+  if (plan->n <= FFT_STACK_POINTS) {
+    return stack;
+  }
+  return (float *)wcn_aligned_alloc(2 * plan->n * sizeof(float), 64);
+}
+
+static void fft_work_free(float *work, float *stack) {
+  if (work != stack) {
+    wcn_aligned_free(work);
+  }
+}
+
+WCN_API_EXPORT
+int wcn_simd_fft_c2c(const wcn_fft_plan_t *plan, const float *in, float *out,
+                     wcn_fft_dir_t dir) {
+  if (plan == NULL || plan->real_n != 0) {
+    return -1;
+  }
+  WCN_STATS_CALL(WCN_STATS_FFT_C2C, plan->n, 2 * sizeof(float), 2,
+                 (uintptr_t)in | (uintptr_t)out);
+  WCN_ALIGN(64) float stack[2 * FFT_STACK_POINTS];
+  float *work = fft_work(plan, stack);
+  if (work == NULL) {
+    return -1;
+  }
+  wcn_simd_active_kernels()->fft_c2c(plan, in, out, work,
+                                     dir == WCN_FFT_INVERSE);
+  fft_work_free(work, stack);
+  return 0;
+}
+
+WCN_API_EXPORT
+int wcn_simd_fft_r2c(const wcn_fft_plan_t *plan, const float *in,
+                     float *out) {
+  if (plan == NULL || plan->real_n == 0) {
+    return -1;
+  }
+  WCN_STATS_CALL(WCN_STATS_FFT_R2C, plan->real_n, sizeof(float), 2,
+                 (uintptr_t)in | (uintptr_t)out);
+  WCN_ALIGN(64) float stack[2 * FFT_STACK_POINTS];
+  float *work = fft_work(plan, stack);
+  if (work == NULL) {
+    return -1;
+  }
+  const wcn_kernel_table_t *kt = wcn_simd_active_kernels();
+  kt->fft_c2c(plan, in, out, work, 0);
+  kt->fft_r2c_split(plan, out);
+  fft_work_free(work, stack);
+  return 0;
+}
+
+WCN_API_EXPORT
+int wcn_simd_fft_c2r(const wcn_fft_plan_t *plan, const float *in,
+                     float *out) {
+  if (plan == NULL || plan->real_n == 0) {
+    return -1;
+  }
+  WCN_STATS_CALL(WCN_STATS_FFT_C2R, plan->real_n, sizeof(float), 2,
+                 (uintptr_t)in | (uintptr_t)out);
+  WCN_ALIGN(64) float stack[2 * FFT_STACK_POINTS];
+  float *work = fft_work(plan, stack);
+  if (work == NULL) {
+    return -1;
+  }
+  const wcn_kernel_table_t *kt = wcn_simd_active_kernels();
+  kt->fft_c2r_merge(plan, in, out);
+  kt->fft_c2c(plan, out, out, work, 1);
+  fft_work_free(work, stack);
+  return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * WCN_SIMD FIR filters: filter objects and entry points (see wcn_fir.h).
+ *
+ * The kernels (wcn_kernels_fir_impl.h) read count + ntaps - 1 input samples
+ * for count outputs. A filter keeps the last ntaps - 1 samples of the
+ * signal at the front of a scratch buffer twice that size; a call appends
+ * the first ntaps - 1 new samples behind them and filters that window for
+ * its first outputs, then filters the caller's buffer directly for the
+ * rest. One-shot calls are a filter used once. Statistics count every
+ * sample read once and written once.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  void *g;            /* taps reversed, zero-padded to WCN_FIR_TAP_ALIGN */
+  unsigned char *buf; /* history, then room for as many new samples */
+  size_t ntaps;
+  size_t elem_size;
+  unsigned shift;
+  wcn_stats_kernel_t stat;
+} fir_state_t;
+
+struct wcn_fir_f32 {
+  fir_state_t s;
+};
+
+struct wcn_fir_i16 {
+  fir_state_t s;
+};
+
+/* Reverse the taps into g (and the buffers after it), zeroing the rest */
+static int fir_init(fir_state_t *f, const void *taps, size_t ntaps,
+                    size_t elem_size, unsigned shift,
+                    wcn_stats_kernel_t stat) {
+  const size_t padded = (ntaps + WCN_FIR_TAP_ALIGN - 1) /
+                        WCN_FIR_TAP_ALIGN * WCN_FIR_TAP_ALIGN;
+  const size_t g_bytes = padded * elem_size;
+  unsigned char *mem = (unsigned char *)wcn_aligned_alloc(
+      g_bytes + 2 * (ntaps - 1) * elem_size, 64);
+  if (mem == NULL) {
+    return -1;
+  }
+  memset(mem, 0, g_bytes + 2 * (ntaps - 1) * elem_size);
+  const unsigned char *t = (const unsigned char *)taps;
+  for (size_t k = 0; k < ntaps; ++k) {
+    memcpy(mem + (ntaps - 1 - k) * elem_size, t + k * elem_size, elem_size);
+  }
+  f->g = mem;
+  f->buf = mem + g_bytes;
+  f->ntaps = ntaps;
+  f->elem_size = elem_size;
+  f->shift = shift;
+  f->stat = stat;
+  return 0;
+}
+
+/* count outputs from count + ntaps - 1 samples at x */
+static void fir_run(const fir_state_t *f, const void *x, void *y,
+                    size_t count) {
+  /* Each output costs about as much as ntaps / 16 array elements */
+  if (wcn_parallel_should_split(count / 16 * f->ntaps)) {
+    WCN_STATS_ADD(f->stat, parallel_calls);
+    wcn_parallel_fir(f->elem_size, x, y, count, f->g, f->ntaps, f->shift);
+    return;
+  }
+  const wcn_kernel_table_t *kt = wcn_simd_active_kernels();
+  if (f->elem_size == sizeof(float)) {
+    kt->fir_f32((const float *)x, (float *)y, count, (const float *)f->g,
+                f->ntaps);
+  } else {
+    kt->fir_i16((const int16_t *)x, (int16_t *)y, count,
+                (const int16_t *)f->g, f->ntaps, f->shift);
+  }
+}
+
+static void fir_process(fir_state_t *f, const void *x, void *y,
+                        size_t count) {
+  WCN_STATS_CALL(f->stat, count, f->elem_size, 2,
+                 (uintptr_t)x | (uintptr_t)y);
+  const size_t es = f->elem_size;
+  const size_t h = f->ntaps - 1;
+  if (h == 0) {
+    fir_run(f, x, y, count);
+    return;
+  }
+  const size_t head = count < h ? count : h;
+  memcpy(f->buf + h * es, x, head * es);
+  fir_run(f, f->buf, y, head);
+  if (count > h) {
+    fir_run(f, x, (unsigned char *)y + h * es, count - h);
+    memcpy(f->buf, (const unsigned char *)x + (count - h) * es, h * es);
+  } else {
+    /* The new samples already follow the history */
+    memmove(f->buf, f->buf + count * es, h * es);
+  }
+}
+
+static void fir_reset(fir_state_t *f) {
+  memset(f->buf, 0, (f->ntaps - 1) * f->elem_size);
+}
+
+/* ========== One-Shot ========== */
+
+WCN_API_EXPORT
+int wcn_simd_fir_f32(const float *x, float *y, size_t count,
+                     const float *taps, size_t ntaps) {
+  fir_state_t f;
+  if (ntaps == 0 ||
+      fir_init(&f, taps, ntaps, sizeof(float), 0, WCN_STATS_FIR_F32) != 0) {
+    return -1;
+  }
+  fir_process(&f, x, y, count);
+  wcn_aligned_free(f.g);
+  return 0;
+}
+
+WCN_API_EXPORT
+int wcn_simd_fir_i16(const int16_t *x, int16_t *y, size_t count,
+                     const int16_t *taps, size_t ntaps, unsigned shift) {
+  fir_state_t f;
+  if (ntaps == 0 || shift >= 32 ||
+      fir_init(&f, taps, ntaps, sizeof(int16_t), shift, WCN_STATS_FIR_I16) !=
+          0) {
+    return -1;
+  }
+  fir_process(&f, x, y, count);
+  wcn_aligned_free(f.g);
+  return 0;
+}
+
+/* ========== Streaming ========== */
+
+WCN_API_EXPORT
+wcn_fir_f32_t *wcn_fir_f32_create(const float *taps, size_t ntaps) {
+  if (ntaps == 0) {
+    return NULL;
+  }
+  wcn_fir_f32_t *fir = (wcn_fir_f32_t *)calloc(1, sizeof(*fir));
+  if (fir == NULL) {
+    return NULL;
+  }
+  if (fir_init(&fir->s, taps, ntaps, sizeof(float), 0, WCN_STATS_FIR_F32) !=
+      0) {
+    free(fir);
+    return NULL;
+  }
+  return fir;
+}
+
+WCN_API_EXPORT
+wcn_fir_i16_t *wcn_fir_i16_create(const int16_t *taps, size_t ntaps,
+                                  unsigned shift) {
+  if (ntaps == 0 || shift >= 32) {
+    return NULL;
+  }
+  wcn_fir_i16_t *fir = (wcn_fir_i16_t *)calloc(1, sizeof(*fir));
+  if (fir == NULL) {
+    return NULL;
+  }
+  if (fir_init(&fir->s, taps, ntaps, sizeof(int16_t), shift,
+               WCN_STATS_FIR_I16) != 0) {
+    free(fir);
+    return NULL;
+  }
+  return fir;
+}
+
+WCN_API_EXPORT
+void wcn_fir_f32_process(wcn_fir_f32_t *fir, const float *x, float *y,
+                         size_t count) {
+  fir_process(&fir->s, x, y, count);
+}
+
+WCN_API_EXPORT
+void wcn_fir_i16_process(wcn_fir_i16_t *fir, const int16_t *x, int16_t *y,
+                         size_t count) {
+  fir_process(&fir->s, x, y, count);
+}
+
+WCN_API_EXPORT
+void wcn_fir_f32_reset(wcn_fir_f32_t *fir) { fir_reset(&fir->s); }
+
+WCN_API_EXPORT
+void wcn_fir_i16_reset(wcn_fir_i16_t *fir) { fir_reset(&fir->s); }
+
+WCN_API_EXPORT
+void wcn_fir_f32_destroy(wcn_fir_f32_t *fir) {
+  if (fir != NULL) {
+    wcn_aligned_free(fir->s.g);
+    free(fir);
+  }
+}
+
+WCN_API_EXPORT
+void wcn_fir_i16_destroy(wcn_fir_i16_t *fir) {
+  if (fir != NULL) {
+    wcn_aligned_free(fir->s.g);
+    free(fir);
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * WCN_SIMD matrix multiplication: entry point (see wcn_gemm.h).
+ *
+ * The packing and micro-kernels live in wcn_kernels_gemm_impl.h. This file
+ * handles the degenerate shapes, owns the packing scratch of single-threaded
+ * calls and hands large products to wcn_parallel_sgemm(). Statistics count
+ * the elements of A, B and C once each.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+
+/* C = beta * C, with beta == 0 overwriting whatever C holds */
+static void scale_c(float *c, size_t ldc, size_t m, size_t n, float beta) {
+  for (size_t i = 0; i < m; ++i) {
+    float *row = c + i * ldc;
+    for (size_t j = 0; j < n; ++j) {
+      row[j] = beta == 0.0f ? 0.0f : beta * row[j];
+    }
+  }
+}
+
+WCN_API_EXPORT
+int wcn_simd_sgemm(wcn_gemm_trans_t trans_a, wcn_gemm_trans_t trans_b,
+                   size_t m, size_t n, size_t k, float alpha, const float *a,
+                   size_t lda, const float *b, size_t ldb, float beta,
+                   float *c, size_t ldc) {
+  WCN_STATS_CALL(WCN_STATS_SGEMM, m * k + k * n + m * n, sizeof(float), 1,
+                 (uintptr_t)a | (uintptr_t)b | (uintptr_t)c);
+  if (m == 0 || n == 0) {
+    return 0;
+  }
+  if (k == 0 || alpha == 0.0f) {
+    if (beta != 1.0f) {
+      scale_c(c, ldc, m, n, beta);
+    }
+    return 0;
+  }
+
+  wcn_sgemm_args_t args;
+  args.m = m;
+  args.n = n;
+  args.k = k;
+  args.a = a;
+  args.b = b;
+  args.c = c;
+  args.lda = lda;
+  args.ldb = ldb;
+  args.ldc = ldc;
+  args.trans_a = trans_a != WCN_GEMM_NO_TRANS;
+  args.trans_b = trans_b != WCN_GEMM_NO_TRANS;
+  args.alpha = alpha;
+  args.beta = beta;
+
+  /* Each element of C costs about as much as k / 64 array elements */
+  if (wcn_parallel_should_split(m * n / 64 * k)) {
+    WCN_STATS_ADD(WCN_STATS_SGEMM, parallel_calls);
+    return wcn_parallel_sgemm(&args);
+  }
+  const wcn_kernel_table_t *kt = wcn_simd_active_kernels();
+  float *pack = (float *)wcn_aligned_alloc(
+      kt->sgemm_pack_floats(m, n, k) * sizeof(float), 64);
+  if (pack == NULL) {
+    return -1;
+  }
+  kt->sgemm_f32(&args, pack);
+  wcn_aligned_free(pack);
+  return 0;
+}
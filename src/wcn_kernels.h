@@ -0,0 +1,362 @@
+#ifndef WCN_KERNELS_H
+#define WCN_KERNELS_H
+
+/*
+ * WCN_SIMD internal kernel dispatch table.
+ *
+ * The array kernels live in wcn_kernels_impl.h (f64 variants in
+ * wcn_kernels_f64_impl.h, integer ones in wcn_kernels_int_impl.h, the
+ * expression evaluator in wcn_kernels_expr_impl.h, memcpy/memset in
+ * wcn_kernels_mem_impl.h, vector math in wcn_kernels_math_impl.h, f16 and
+ * bf16 in wcn_kernels_half_impl.h, SGEMM in wcn_kernels_gemm_impl.h,
+ * transposes in wcn_kernels_transpose_impl.h, FIR filters in
+ * wcn_kernels_fir_impl.h, FFT passes in wcn_kernels_fft_impl.h) and are
+ * compiled once per ISA level.
+ * On x86 with WCN_SIMD_DISPATCH the build produces an SSE2, an
+ * AVX2+FMA+F16C and (if the compiler supports it) an AVX-512 table;
+ * wcn_simd_init() selects the best one the host CPU and OS can run.
+ * Everywhere else a single table built with the target's flags is used.
+ */
+
+#include "WCN_SIMD.h"
+
+#ifndef WCN_RESTRICT
+#ifdef _MSC_VER
+#define WCN_RESTRICT __restrict
+#else
+#define WCN_RESTRICT restrict
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========== Compiled Expression Plans ========== */
+
+/* Built by wcn_expr.c, run by the expr_eval_f32 kernel. The evaluator walks
+ * the array in blocks of WCN_EXPR_BLOCK elements and runs every instruction
+ * over the whole block before moving on, so intermediates live in at most
+ * WCN_EXPR_MAX_SLOTS L1-resident block buffers. */
+#define WCN_EXPR_BLOCK 256
+#define WCN_EXPR_MAX_SLOTS 16
+
+/* Constants are stored pre-broadcast to the widest vector (16 floats) */
+#define WCN_EXPR_SPLAT 16
+
+/* Operand references: input arrays, then block slots, then constants */
+#define WCN_EXPR_REF_SLOT WCN_EXPR_MAX_INPUTS
+#define WCN_EXPR_REF_CONST (WCN_EXPR_REF_SLOT + WCN_EXPR_MAX_SLOTS)
+#define WCN_EXPR_REF_COUNT (WCN_EXPR_REF_CONST + WCN_EXPR_MAX_NODES)
+
+/* Destination of the last instruction: the caller's output array */
+#define WCN_EXPR_DST_OUT 0xFF
+
+typedef enum {
+  WCN_EXPR_OP_COPY,
+  WCN_EXPR_OP_ADD,
+  WCN_EXPR_OP_SUB,
+  WCN_EXPR_OP_MUL,
+  WCN_EXPR_OP_DIV,
+  WCN_EXPR_OP_MIN,
+  WCN_EXPR_OP_MAX,
+  WCN_EXPR_OP_FMA,
+  WCN_EXPR_OP_ABS,
+  WCN_EXPR_OP_NEG,
+  WCN_EXPR_OP_SQRT
+} wcn_expr_op_t;
+
+typedef struct {
+  uint8_t op;     /* wcn_expr_op_t */
+  uint8_t dst;    /* slot index or WCN_EXPR_DST_OUT */
+  uint8_t src[3]; /* operand references; unused ones repeat src[0] */
+} wcn_expr_insn_t;
+
+struct wcn_expr_plan {
+  uint32_t input_mask; /* bit i set if inputs[i] is read */
+  uint32_t n_insns;
+  wcn_expr_insn_t insns[WCN_EXPR_MAX_NODES];
+  float consts[WCN_EXPR_MAX_NODES][WCN_EXPR_SPLAT];
+};
+
+/* ========== Vector Math ========== */
+
+/* Functions of the math_f32 kernel (wcn_math.h) */
+typedef enum {
+  WCN_MATH_FN_EXP,
+  WCN_MATH_FN_EXP2,
+  WCN_MATH_FN_LOG,
+  WCN_MATH_FN_LOG2,
+  WCN_MATH_FN_LOG1P,
+  WCN_MATH_FN_SIN,
+  WCN_MATH_FN_COS,
+  WCN_MATH_FN_SINCOS,
+  WCN_MATH_FN_TAN,
+  WCN_MATH_FN_TANH,
+  WCN_MATH_FN_ERF,
+  WCN_MATH_FN_ATAN2,
+  WCN_MATH_FN_POW
+} wcn_math_fn_t;
+
+/* ========== Matrix Multiplication ========== */
+
+/* One wcn_simd_sgemm() call, or the rows or columns of it a pool task
+ * computes (wcn_gemm.h for the meaning of the fields) */
+typedef struct {
+  size_t m, n, k;
+  const float *a;
+  const float *b;
+  float *c;
+  size_t lda, ldb, ldc;
+  int trans_a, trans_b;
+  float alpha, beta;
+} wcn_sgemm_args_t;
+
+/* ========== FIR Filters ========== */
+
+/* The kernels take the taps reversed and zero-padded to a multiple of this
+ * many (one AVX-512 vector of floats) */
+#define WCN_FIR_TAP_ALIGN 16
+
+/* ========== FFT ========== */
+
+/* Enough passes for any size_t n (every radix is at least 2) */
+#define WCN_FFT_MAX_STAGES 64
+
+/* A complex transform of n points as Stockham passes (see
+ * wcn_kernels_fft_impl.h). Twiddles are forward, e^(-2 pi i ...), as (re, im)
+ * pairs unless noted. Real plans describe the transform of their 2 n
+ * samples taken in pairs. */
+struct wcn_fft_plan {
+  size_t n;
+  size_t real_n; /* 2 n for real plans, 0 for complex ones */
+  unsigned stages;
+  unsigned radix[WCN_FFT_MAX_STAGES];
+  size_t stride[WCN_FFT_MAX_STAGES]; /* s: product of the earlier radices */
+  /* Pass t: w^(p * j) at [p * (r - 1) + j - 1] for p < m, 0 < j < r */
+  const float *tw[WCN_FFT_MAX_STAGES];
+  /* Pass 0 again, for vectors over p: for each j, the real parts for every
+   * p (each twice in a row), then the imaginary parts */
+  const float *tw_lanes;
+  /* Real plans: e^(-2 pi i k / (2 n)) for k <= n / 2, laid out as tw_lanes */
+  const float *real_tw;
+  float *tables;
+  struct wcn_fft_plan *next; /* plan cache chain */
+};
+
+/* ========== Kernel Table ========== */
+
+typedef struct {
+  /* Implementation name of the ISA level the table was compiled for */
+  const char *name;
+  /* Widest vector the kernels use, in bytes */
+  size_t vector_bytes;
+
+  float (*dot_product_f32)(const float *a, const float *b, size_t count);
+  float (*dot_product_kahan_f32)(const float *a, const float *b,
+                                 size_t count);
+  float (*dot_product_pairwise_f32)(const float *a, const float *b,
+                                    size_t count);
+  void (*add_array_f32)(const float *a, const float *b, float *c,
+                        size_t count);
+  void (*mul_array_f32)(const float *a, const float *b, float *c,
+                        size_t count);
+  void (*scale_array_f32)(const float *a, float scalar, float *b,
+                          size_t count);
+  void (*fmadd_array_f32)(const float *a, const float *b, float *c,
+                          size_t count);
+  float (*reduce_max_f32)(const float *data, size_t count);
+  float (*reduce_min_f32)(const float *data, size_t count);
+  float (*reduce_sum_f32)(const float *data, size_t count);
+  float (*reduce_sum_pairwise_f32)(const float *data, size_t count);
+
+  double (*dot_product_f64)(const double *a, const double *b, size_t count);
+  void (*add_array_f64)(const double *a, const double *b, double *c,
+                        size_t count);
+  void (*mul_array_f64)(const double *a, const double *b, double *c,
+                        size_t count);
+  void (*scale_array_f64)(const double *a, double scalar, double *b,
+                          size_t count);
+  void (*fmadd_array_f64)(const double *a, const double *b, double *c,
+                          size_t count);
+  double (*reduce_max_f64)(const double *data, size_t count);
+  double (*reduce_min_f64)(const double *data, size_t count);
+  double (*reduce_sum_f64)(const double *data, size_t count);
+
+  int64_t (*reduce_sum_i32)(const int32_t *data, size_t count);
+  int64_t (*reduce_sum_i16)(const int16_t *data, size_t count);
+  uint64_t (*reduce_sum_u8)(const uint8_t *data, size_t count);
+  int8_t (*reduce_min_i8)(const int8_t *data, size_t count);
+  int8_t (*reduce_max_i8)(const int8_t *data, size_t count);
+  uint8_t (*reduce_min_u8)(const uint8_t *data, size_t count);
+  uint8_t (*reduce_max_u8)(const uint8_t *data, size_t count);
+  int16_t (*reduce_min_i16)(const int16_t *data, size_t count);
+  int16_t (*reduce_max_i16)(const int16_t *data, size_t count);
+  int32_t (*reduce_min_i32)(const int32_t *data, size_t count);
+  int32_t (*reduce_max_i32)(const int32_t *data, size_t count);
+  void (*adds_array_i8)(const int8_t *a, const int8_t *b, int8_t *c,
+                        size_t count);
+  void (*subs_array_i8)(const int8_t *a, const int8_t *b, int8_t *c,
+                        size_t count);
+  void (*adds_array_u8)(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                        size_t count);
+  void (*subs_array_u8)(const uint8_t *a, const uint8_t *b, uint8_t *c,
+                        size_t count);
+  void (*adds_array_i16)(const int16_t *a, const int16_t *b, int16_t *c,
+                         size_t count);
+  void (*subs_array_i16)(const int16_t *a, const int16_t *b, int16_t *c,
+                         size_t count);
+  void (*adds_array_u16)(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                         size_t count);
+  void (*subs_array_u16)(const uint16_t *a, const uint16_t *b, uint16_t *c,
+                         size_t count);
+  /* u8 x i8 dot product, exact in 64 bits; the GEMV writes
+   * y[r] = dot(x, row r of the row-major rows x cols w) saturated to int32 */
+  int64_t (*dot_u8i8_i32)(const uint8_t *a, const int8_t *b, size_t count);
+  void (*gemv_u8i8_i32)(const int8_t *w, const uint8_t *x, int32_t *y,
+                        size_t rows, size_t cols);
+
+  void (*expr_eval_f32)(const wcn_expr_plan_t *plan,
+                        const float *const *inputs, float *out, size_t count);
+
+  /* y[i] = fn(a[i]), or fn(a[i], b[i]) for atan2 and pow; sincos writes
+   * the sines to y and the cosines to c. b and c are NULL when unused. */
+  void (*math_f32)(wcn_math_fn_t fn, wcn_math_mode_t mode, const float *a,
+                   const float *b, float *y, float *c, size_t count);
+
+  /* Softmax of each cols-long row of a into y and/or the row's
+   * log-sum-exp into lse; either may be NULL */
+  void (*softmax_rows_f32)(const float *a, float *y, float *lse, size_t rows,
+                           size_t cols);
+  /* Maximum of a and the sum of exp(a[i] - max), for splitting one row */
+  void (*softmax_stats_f32)(const float *a, size_t count, float *max,
+                            double *sum);
+  /* y[i] = exp(a[i] - shift) * scale */
+  void (*exp_scale_f32)(const float *a, float shift, float scale, float *y,
+                        size_t count);
+
+  /* binary16 (f16) and bfloat16 (bf16) storage: conversion to and from
+   * float, and kernels that widen 16-bit inputs and accumulate in float */
+  void (*f16_to_f32)(const uint16_t *src, float *dst, size_t count);
+  void (*f32_to_f16)(const float *src, uint16_t *dst, size_t count);
+  void (*bf16_to_f32)(const uint16_t *src, float *dst, size_t count);
+  void (*f32_to_bf16)(const float *src, uint16_t *dst, size_t count);
+  float (*dot_product_f16)(const uint16_t *a, const uint16_t *b,
+                           size_t count);
+  float (*dot_product_bf16)(const uint16_t *a, const uint16_t *b,
+                            size_t count);
+  void (*fmadd_array_f16)(const uint16_t *a, const uint16_t *b, float *c,
+                          size_t count);
+  void (*fmadd_array_bf16)(const uint16_t *a, const uint16_t *b, float *c,
+                           size_t count);
+  float (*reduce_sum_f16)(const uint16_t *data, size_t count);
+  float (*reduce_sum_bf16)(const uint16_t *data, size_t count);
+
+  /* sgemm_f32 needs k > 0 and a 64-byte aligned scratch buffer of
+   * sgemm_pack_floats(m, n, k) floats */
+  size_t (*sgemm_pack_floats)(size_t m, size_t n, size_t k);
+  void (*sgemm_f32)(const wcn_sgemm_args_t *args, float *pack);
+
+  /* dst (cols x rows, row stride ldd) = src^T (rows x cols, row stride
+   * lds); stream: non-temporal stores where dst alignment allows */
+  void (*transpose_f32)(const float *src, size_t lds, float *dst, size_t ldd,
+                        size_t rows, size_t cols, int stream);
+  void (*transpose_u16)(const uint16_t *src, size_t lds, uint16_t *dst,
+                        size_t ldd, size_t rows, size_t cols, int stream);
+  void (*transpose_u8)(const uint8_t *src, size_t lds, uint8_t *dst,
+                       size_t ldd, size_t rows, size_t cols, int stream);
+
+  /* y[n] = sum over o < ntaps of g[o] * x[n + o] for n < count: x holds
+   * count + ntaps - 1 samples, g the reversed taps padded with zeros to
+   * WCN_FIR_TAP_ALIGN. fir_i16 rounds, shifts and saturates each sum
+   * (wcn_simd_fir_i16). */
+  void (*fir_f32)(const float *x, float *y, size_t count, const float *g,
+                  size_t ntaps);
+  void (*fir_i16)(const int16_t *x, int16_t *y, size_t count,
+                  const int16_t *g, size_t ntaps, unsigned shift);
+
+  /* out = the transform of in (n complex, in == out allowed) with a scratch
+   * buffer of 2 n floats; inverse: conjugate twiddles. fft_r2c_split turns
+   * the transform of a real plan into its n + 1 bins in place, and
+   * fft_c2r_merge the n + 1 bins at in back into n points at out (in ==
+   * out allowed) for the inverse transform. */
+  void (*fft_c2c)(const wcn_fft_plan_t *plan, const float *in, float *out,
+                  float *work, int inverse);
+  void (*fft_r2c_split)(const wcn_fft_plan_t *plan, float *out);
+  void (*fft_c2r_merge)(const wcn_fft_plan_t *plan, const float *in,
+                        float *out);
+
+  /* stream: use non-temporal stores for the bulk of the destination */
+  void (*memcpy_bytes)(void *dst, const void *src, size_t bytes, int stream);
+  void (*memset_bytes)(void *dst, int value, size_t bytes, int stream);
+} wcn_kernel_table_t;
+
+/* ========== Tuning ========== */
+
+/* Cache-dependent kernel parameters (wcn_tuning.c). Kernels read them once
+ * per call, so a change takes effect with the next call. */
+extern wcn_simd_tuning_t wcn_tuning;
+
+/* Derive wcn_tuning from the detected cache topology */
+void wcn_tuning_init(const wcn_simd_features_t *features);
+
+/* ========== Statistics ========== */
+
+/* Counting hooks of WCN_SIMD_STATS builds (wcn_stats.c); without it they
+ * expand to nothing. WCN_STATS_CALL goes at the API entry of an algorithm,
+ * WCN_STATS_ADD wherever a kernel takes a path worth counting. */
+#if defined(WCN_SIMD_STATS)
+
+#if defined(_MSC_VER)
+#define WCN_THREAD_LOCAL __declspec(thread)
+#else
+#define WCN_THREAD_LOCAL _Thread_local
+#endif
+
+/* Counters of the calling thread; NULL until it first counts something */
+extern WCN_THREAD_LOCAL wcn_simd_kernel_stats_t *wcn_stats_tls;
+
+/* Allocate and register the calling thread's counters */
+wcn_simd_kernel_stats_t *wcn_stats_attach(void);
+
+static inline wcn_simd_kernel_stats_t *wcn_stats_local(wcn_stats_kernel_t k) {
+  wcn_simd_kernel_stats_t *s = wcn_stats_tls;
+  return (s != NULL ? s : wcn_stats_attach()) + k;
+}
+
+/* count elements of elem_size bytes, traffic of them read or written per
+ * element; addr is the bitwise OR of the array addresses */
+void wcn_stats_call(wcn_stats_kernel_t k, size_t count, size_t elem_size,
+                    unsigned traffic, uintptr_t addr);
+
+#define WCN_STATS_CALL(k, count, elem_size, traffic, addr)                     \
+  wcn_stats_call(k, count, elem_size, traffic, addr)
+#define WCN_STATS_ADD(k, field) ((void)wcn_stats_local(k)->field++)
+
+#else
+
+#define WCN_STATS_CALL(k, count, elem_size, traffic, addr) ((void)0)
+#define WCN_STATS_ADD(k, field) ((void)0)
+
+#endif /* WCN_SIMD_STATS */
+
+#if defined(WCN_SIMD_DISPATCH)
+extern const wcn_kernel_table_t wcn_kernels_sse2;
+#if defined(WCN_SIMD_DISPATCH_AVX2)
+extern const wcn_kernel_table_t wcn_kernels_avx2;
+#endif
+#if defined(WCN_SIMD_DISPATCH_AVX512)
+extern const wcn_kernel_table_t wcn_kernels_avx512;
+#endif
+#else
+extern const wcn_kernel_table_t wcn_kernels_native;
+#endif
+
+/* Table selected by wcn_simd_init() (initializes the library on first use) */
+const wcn_kernel_table_t *wcn_simd_active_kernels(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_KERNELS_H */
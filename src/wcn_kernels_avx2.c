@@ -0,0 +1,12 @@
+/*
+ * x86 AVX2 + FMA array kernels (Haswell / Zen and newer). Compiled with
+ * -mavx2 -mfma -mf16c (/arch:AVX2) and only entered after wcn_simd_init()
+ * has confirmed CPU and OS support.
+ */
+
+#define WCN_KERNEL_TABLE wcn_kernels_avx2
+#include "wcn_kernels_impl.h"
+
+#if !defined(WCN_X86_AVX2)
+#error "wcn_kernels_avx2.c must be compiled with AVX2 enabled"
+#endif
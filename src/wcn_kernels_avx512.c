@@ -0,0 +1,12 @@
+/*
+ * x86 AVX-512 (F/BW/DQ/VL) array kernels (Skylake-SP, Ice Lake, Zen 4 and
+ * newer). Only entered after wcn_simd_init() has confirmed CPU and OS
+ * support for the ZMM register state.
+ */
+
+#define WCN_KERNEL_TABLE wcn_kernels_avx512
+#include "wcn_kernels_impl.h"
+
+#if !defined(WCN_X86_AVX512F)
+#error "wcn_kernels_avx512.c must be compiled with AVX-512F enabled"
+#endif
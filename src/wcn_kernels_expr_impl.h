@@ -0,0 +1,172 @@
+/*
+ * WCN_SIMD fused expression evaluator.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * A plan (see wcn_kernels.h) is a straight-line list of instructions over
+ * input arrays, broadcast constants and block slots. It is interpreted one
+ * block at a time: each instruction is a tight vector loop over the block,
+ * so the per-instruction dispatch is amortized over WCN_EXPR_BLOCK elements
+ * while intermediates never leave L1. The loops are written against the
+ * portable float vector API; VF(op) names the widest flavour the TU has
+ * (SVE builds use the NEON one). Targets without one (RVV, scalar) run the
+ * same loops on scalars and leave vectorization to the compiler.
+ */
+
+#include <string.h>
+
+/* ========== Float Vector Selection ========== */
+
+#if defined(WCN_X86_AVX512F)
+#define VF_LANES 16
+#define VF(op) wcn_v512f_##op
+typedef wcn_v512f_t vf_t;
+#elif defined(WCN_X86_AVX2) || defined(WCN_LOONGARCH_LASX)
+#define VF_LANES 8
+#define VF(op) wcn_v256f_##op
+typedef wcn_v256f_t vf_t;
+#elif defined(WCN_X86_SSE2) || defined(WCN_ARM_NEON) ||                       \
+    defined(WCN_LOONGARCH_LSX) || defined(WCN_POWERPC_ALTIVEC) ||             \
+    defined(WCN_WASM_SIMD128) || defined(WCN_MIPS_MSA)
+#define VF_LANES 4
+#define VF(op) wcn_v128f_##op
+typedef wcn_v128f_t vf_t;
+#else
+#define VF_LANES 1
+#define VF(op) expr_scalar_##op
+typedef float vf_t;
+
+static inline float expr_scalar_load(const float *p) { return *p; }
+static inline void expr_scalar_store(float *p, float v) { *p = v; }
+static inline float expr_scalar_add(float a, float b) { return a + b; }
+static inline float expr_scalar_sub(float a, float b) { return a - b; }
+static inline float expr_scalar_mul(float a, float b) { return a * b; }
+static inline float expr_scalar_div(float a, float b) { return a / b; }
+static inline float expr_scalar_min(float a, float b) { return fminf(a, b); }
+static inline float expr_scalar_max(float a, float b) { return fmaxf(a, b); }
+static inline float expr_scalar_fmadd(float a, float b, float c) {
+  return fmaf(a, b, c);
+}
+static inline float expr_scalar_abs(float a) { return fabsf(a); }
+static inline float expr_scalar_neg(float a) { return -a; }
+static inline float expr_scalar_sqrt(float a) { return sqrtf(a); }
+#endif
+
+#if VF_LANES > WCN_EXPR_SPLAT
+#error "expression constants are not broadcast wide enough for this ISA"
+#endif
+
+/* Loop over n elements of the current block; constants (references past
+ * WCN_EXPR_REF_CONST) do not advance. */
+#define EXPR_LOOP(expr)                                                        \
+  for (size_t j = 0; j < n;                                                    \
+       j += VF_LANES, pa += sa, pb += sb, pc += sc, pd += VF_LANES) {          \
+    VF(store)(pd, expr);                                                       \
+  }
+
+#define EXPR_A VF(load)(pa)
+#define EXPR_B VF(load)(pb)
+#define EXPR_C VF(load)(pc)
+
+/* Run every instruction of the plan over n elements (a multiple of
+ * VF_LANES, at most WCN_EXPR_BLOCK) */
+static void expr_run_block(const wcn_expr_plan_t *plan,
+                           const float *const *ref, float *slots, float *out,
+                           size_t n) {
+  for (uint32_t k = 0; k < plan->n_insns; ++k) {
+    const wcn_expr_insn_t *in = &plan->insns[k];
+    const float *pa = ref[in->src[0]];
+    const float *pb = ref[in->src[1]];
+    const float *pc = ref[in->src[2]];
+    const size_t sa = in->src[0] < WCN_EXPR_REF_CONST ? VF_LANES : 0;
+    const size_t sb = in->src[1] < WCN_EXPR_REF_CONST ? VF_LANES : 0;
+    const size_t sc = in->src[2] < WCN_EXPR_REF_CONST ? VF_LANES : 0;
+    float *pd = in->dst == WCN_EXPR_DST_OUT
+                    ? out
+                    : slots + (size_t)in->dst * WCN_EXPR_BLOCK;
+
+    switch ((wcn_expr_op_t)in->op) {
+    case WCN_EXPR_OP_COPY:
+      EXPR_LOOP(EXPR_A)
+      break;
+    case WCN_EXPR_OP_ADD:
+      EXPR_LOOP(VF(add)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_SUB:
+      EXPR_LOOP(VF(sub)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_MUL:
+      EXPR_LOOP(VF(mul)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_DIV:
+      EXPR_LOOP(VF(div)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_MIN:
+      EXPR_LOOP(VF(min)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_MAX:
+      EXPR_LOOP(VF(max)(EXPR_A, EXPR_B))
+      break;
+    case WCN_EXPR_OP_FMA:
+      EXPR_LOOP(VF(fmadd)(EXPR_A, EXPR_B, EXPR_C))
+      break;
+    case WCN_EXPR_OP_ABS:
+      EXPR_LOOP(VF(abs)(EXPR_A))
+      break;
+    case WCN_EXPR_OP_NEG:
+      EXPR_LOOP(VF(neg)(EXPR_A))
+      break;
+    case WCN_EXPR_OP_SQRT:
+      EXPR_LOOP(VF(sqrt)(EXPR_A))
+      break;
+    }
+  }
+}
+
+static void expr_eval_f32(const wcn_expr_plan_t *plan,
+                          const float *const *inputs, float *out,
+                          size_t count) {
+  float slots[WCN_EXPR_MAX_SLOTS * WCN_EXPR_BLOCK];
+  const float *ref[WCN_EXPR_REF_COUNT] = {0};
+
+  for (size_t s = 0; s < WCN_EXPR_MAX_SLOTS; ++s) {
+    ref[WCN_EXPR_REF_SLOT + s] = slots + s * WCN_EXPR_BLOCK;
+  }
+  for (size_t k = 0; k < WCN_EXPR_MAX_NODES; ++k) {
+    ref[WCN_EXPR_REF_CONST + k] = plan->consts[k];
+  }
+
+  const size_t body = count - count % VF_LANES;
+  for (size_t base = 0; base < body; base += WCN_EXPR_BLOCK) {
+    const size_t n =
+        body - base < WCN_EXPR_BLOCK ? body - base : WCN_EXPR_BLOCK;
+    for (size_t i = 0; i < WCN_EXPR_MAX_INPUTS; ++i) {
+      if (plan->input_mask & (1u << i)) {
+        ref[i] = inputs[i] + base;
+      }
+    }
+    expr_run_block(plan, ref, slots, out + base, n);
+  }
+
+  /* Remainder: run one vector over zero-padded copies of the inputs */
+  if (body < count) {
+    const size_t rem = count - body;
+    float pad_in[WCN_EXPR_MAX_INPUTS][VF_LANES];
+    float pad_out[VF_LANES];
+    memset(pad_in, 0, sizeof(pad_in));
+    for (size_t i = 0; i < WCN_EXPR_MAX_INPUTS; ++i) {
+      if (plan->input_mask & (1u << i)) {
+        memcpy(pad_in[i], inputs[i] + body, rem * sizeof(float));
+        ref[i] = pad_in[i];
+      }
+    }
+    expr_run_block(plan, ref, slots, pad_out, VF_LANES);
+    memcpy(out + body, pad_out, rem * sizeof(float));
+  }
+}
+
+#undef EXPR_LOOP
+#undef EXPR_A
+#undef EXPR_B
+#undef EXPR_C
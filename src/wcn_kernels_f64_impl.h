@@ -0,0 +1,794 @@
+/*
+ * WCN_SIMD double-precision array kernel bodies.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * Every backend with a double-precision vector unit maps a small set of
+ * vf64_* helpers onto one native vector register. The kernels themselves
+ * are written once on top of these helpers and keep the strategies of the
+ * f32 kernels: destination alignment prologue and streaming stores for
+ * add_array on x86, 2x/4x unrolling with independent accumulators, and a
+ * single masked step for the remainder where the ISA has predication.
+ * AltiVec (no double vectors) and 32-bit ARM NEON fall back to scalar.
+ */
+
+/* ========== f64 Vector Helpers ========== */
+
+#if defined(WCN_X86_AVX512F)
+
+#define VF64_LANES 8
+#define VF64_ALIGN 64
+#define VF64_HAS_TAIL 1
+#define VF64_HAS_STREAM 1
+typedef __m512d vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return _mm512_loadu_pd(p); }
+static inline void vf64_storeu(double *p, vf64_t v) { _mm512_storeu_pd(p, v); }
+static inline void vf64_store(double *p, vf64_t v) { _mm512_store_pd(p, v); }
+static inline void vf64_stream(double *p, vf64_t v) { _mm512_stream_pd(p, v); }
+static inline vf64_t vf64_set1(double x) { return _mm512_set1_pd(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return _mm512_add_pd(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return _mm512_mul_pd(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return _mm512_max_pd(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return _mm512_min_pd(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return _mm512_fmadd_pd(a, b, c);
+}
+static inline double vf64_hsum(vf64_t v) { return _mm512_reduce_add_pd(v); }
+static inline double vf64_hmax(vf64_t v) { return _mm512_reduce_max_pd(v); }
+static inline double vf64_hmin(vf64_t v) { return _mm512_reduce_min_pd(v); }
+
+/* first n (< 8) lanes from p, the rest from src */
+static inline vf64_t vf64_load_tail(const double *p, size_t n, vf64_t src) {
+  return _mm512_mask_loadu_pd(src, (__mmask8)((1u << n) - 1u), p);
+}
+static inline void vf64_store_tail(double *p, vf64_t v, size_t n) {
+  _mm512_mask_storeu_pd(p, (__mmask8)((1u << n) - 1u), v);
+}
+
+#elif defined(WCN_X86_AVX)
+
+#define VF64_LANES 4
+#define VF64_ALIGN 32
+#define VF64_HAS_TAIL 1
+#define VF64_HAS_STREAM 1
+typedef __m256d vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return _mm256_loadu_pd(p); }
+static inline void vf64_storeu(double *p, vf64_t v) { _mm256_storeu_pd(p, v); }
+static inline void vf64_store(double *p, vf64_t v) { _mm256_store_pd(p, v); }
+static inline void vf64_stream(double *p, vf64_t v) { _mm256_stream_pd(p, v); }
+static inline vf64_t vf64_set1(double x) { return _mm256_set1_pd(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return _mm256_add_pd(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return _mm256_mul_pd(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return _mm256_max_pd(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return _mm256_min_pd(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+#if defined(WCN_X86_FMA)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+static inline double vf64_hsum(vf64_t v) {
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),
+                         _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+static inline double vf64_hmax(vf64_t v) {
+  __m128d m = _mm_max_pd(_mm256_castpd256_pd128(v),
+                         _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_max_sd(m, _mm_unpackhi_pd(m, m)));
+}
+static inline double vf64_hmin(vf64_t v) {
+  __m128d m = _mm_min_pd(_mm256_castpd256_pd128(v),
+                         _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_min_sd(m, _mm_unpackhi_pd(m, m)));
+}
+
+/* vmaskmovpd mask selecting the first n (< 4) lanes; AVX-only, no AVX2 */
+static inline __m256i vf64_tail_mask(size_t n) {
+  return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_setr_pd(0, 1, 2, 3),
+                                           _mm256_set1_pd((double)n),
+                                           _CMP_LT_OQ));
+}
+static inline vf64_t vf64_load_tail(const double *p, size_t n, vf64_t src) {
+  __m256i m = vf64_tail_mask(n);
+  return _mm256_blendv_pd(src, _mm256_maskload_pd(p, m),
+                          _mm256_castsi256_pd(m));
+}
+static inline void vf64_store_tail(double *p, vf64_t v, size_t n) {
+  _mm256_maskstore_pd(p, vf64_tail_mask(n), v);
+}
+
+#elif defined(WCN_X86_SSE2)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+#define VF64_HAS_STREAM 1
+typedef __m128d vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return _mm_loadu_pd(p); }
+static inline void vf64_storeu(double *p, vf64_t v) { _mm_storeu_pd(p, v); }
+static inline void vf64_store(double *p, vf64_t v) { _mm_store_pd(p, v); }
+static inline void vf64_stream(double *p, vf64_t v) { _mm_stream_pd(p, v); }
+static inline vf64_t vf64_set1(double x) { return _mm_set1_pd(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) { return _mm_add_pd(a, b); }
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) { return _mm_mul_pd(a, b); }
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) { return _mm_max_pd(a, b); }
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) { return _mm_min_pd(a, b); }
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return _mm_add_pd(_mm_mul_pd(a, b), c);
+}
+static inline double vf64_hsum(vf64_t v) {
+  return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+static inline double vf64_hmax(vf64_t v) {
+  return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+}
+static inline double vf64_hmin(vf64_t v) {
+  return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+#elif defined(WCN_ARM_SVE)
+
+/* Vector length is a runtime property; VF64_ALIGN 1 disables the
+ * alignment prologue, predicated loads/stores make it unnecessary */
+#define VF64_LANES svcntd()
+#define VF64_ALIGN 1
+#define VF64_HAS_TAIL 1
+typedef svfloat64_t vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) {
+  return svld1_f64(svptrue_b64(), p);
+}
+static inline void vf64_storeu(double *p, vf64_t v) {
+  svst1_f64(svptrue_b64(), p, v);
+}
+static inline void vf64_store(double *p, vf64_t v) { vf64_storeu(p, v); }
+static inline vf64_t vf64_set1(double x) { return svdup_n_f64(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return svadd_f64_x(svptrue_b64(), a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return svmul_f64_x(svptrue_b64(), a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return svmax_f64_x(svptrue_b64(), a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return svmin_f64_x(svptrue_b64(), a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return svmla_f64_x(svptrue_b64(), c, a, b);
+}
+static inline double vf64_hsum(vf64_t v) {
+  return svaddv_f64(svptrue_b64(), v);
+}
+static inline double vf64_hmax(vf64_t v) {
+  return svmaxv_f64(svptrue_b64(), v);
+}
+static inline double vf64_hmin(vf64_t v) {
+  return svminv_f64(svptrue_b64(), v);
+}
+static inline vf64_t vf64_load_tail(const double *p, size_t n, vf64_t src) {
+  svbool_t pg = svwhilelt_b64_u64(0, n);
+  return svsel_f64(pg, svld1_f64(pg, p), src);
+}
+static inline void vf64_store_tail(double *p, vf64_t v, size_t n) {
+  svst1_f64(svwhilelt_b64_u64(0, n), p, v);
+}
+
+#elif defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+typedef float64x2_t vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return vld1q_f64(p); }
+static inline void vf64_storeu(double *p, vf64_t v) { vst1q_f64(p, v); }
+static inline void vf64_store(double *p, vf64_t v) { vst1q_f64(p, v); }
+static inline vf64_t vf64_set1(double x) { return vdupq_n_f64(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) { return vaddq_f64(a, b); }
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) { return vmulq_f64(a, b); }
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) { return vmaxq_f64(a, b); }
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) { return vminq_f64(a, b); }
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return vfmaq_f64(c, a, b);
+}
+static inline double vf64_hsum(vf64_t v) { return vaddvq_f64(v); }
+static inline double vf64_hmax(vf64_t v) { return vmaxvq_f64(v); }
+static inline double vf64_hmin(vf64_t v) { return vminvq_f64(v); }
+
+#elif defined(WCN_WASM_SIMD128)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+typedef v128_t vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return wasm_v128_load(p); }
+static inline void vf64_storeu(double *p, vf64_t v) { wasm_v128_store(p, v); }
+static inline void vf64_store(double *p, vf64_t v) { wasm_v128_store(p, v); }
+static inline vf64_t vf64_set1(double x) { return wasm_f64x2_splat(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return wasm_f64x2_add(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return wasm_f64x2_mul(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return wasm_f64x2_max(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return wasm_f64x2_min(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+#if defined(__wasm_relaxed_simd__)
+  return __builtin_wasm_relaxed_madd_f64x2(a, b, c);
+#else
+  return wasm_f64x2_add(wasm_f64x2_mul(a, b), c);
+#endif
+}
+static inline double vf64_hsum(vf64_t v) {
+  return wasm_f64x2_extract_lane(v, 0) + wasm_f64x2_extract_lane(v, 1);
+}
+static inline double vf64_hmax(vf64_t v) {
+  double x = wasm_f64x2_extract_lane(v, 0), y = wasm_f64x2_extract_lane(v, 1);
+  return x > y ? x : y;
+}
+static inline double vf64_hmin(vf64_t v) {
+  double x = wasm_f64x2_extract_lane(v, 0), y = wasm_f64x2_extract_lane(v, 1);
+  return x < y ? x : y;
+}
+
+#elif defined(WCN_LOONGARCH_LASX)
+
+#define VF64_LANES 4
+#define VF64_ALIGN 32
+typedef __m256d vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) {
+  return (__m256d)__lasx_xvld(p, 0);
+}
+static inline void vf64_storeu(double *p, vf64_t v) {
+  __lasx_xvst((__m256i)v, p, 0);
+}
+static inline void vf64_store(double *p, vf64_t v) { vf64_storeu(p, v); }
+static inline vf64_t vf64_set1(double x) {
+  const double t[4] = {x, x, x, x};
+  return vf64_loadu(t);
+}
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return __lasx_xvfadd_d(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return __lasx_xvfmul_d(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return __lasx_xvfmax_d(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return __lasx_xvfmin_d(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return __lasx_xvfmadd_d(a, b, c);
+}
+static inline double vf64_hsum(vf64_t v) {
+  double t[4];
+  vf64_storeu(t, v);
+  return (t[0] + t[1]) + (t[2] + t[3]);
+}
+static inline double vf64_hmax(vf64_t v) {
+  double t[4];
+  vf64_storeu(t, v);
+  double x = t[0] > t[1] ? t[0] : t[1], y = t[2] > t[3] ? t[2] : t[3];
+  return x > y ? x : y;
+}
+static inline double vf64_hmin(vf64_t v) {
+  double t[4];
+  vf64_storeu(t, v);
+  double x = t[0] < t[1] ? t[0] : t[1], y = t[2] < t[3] ? t[2] : t[3];
+  return x < y ? x : y;
+}
+
+#elif defined(WCN_LOONGARCH_LSX)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+typedef __m128d vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) {
+  return (__m128d)__lsx_vld(p, 0);
+}
+static inline void vf64_storeu(double *p, vf64_t v) {
+  __lsx_vst((__m128i)v, p, 0);
+}
+static inline void vf64_store(double *p, vf64_t v) { vf64_storeu(p, v); }
+static inline vf64_t vf64_set1(double x) {
+  const double t[2] = {x, x};
+  return vf64_loadu(t);
+}
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return __lsx_vfadd_d(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return __lsx_vfmul_d(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return __lsx_vfmax_d(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return __lsx_vfmin_d(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return __lsx_vfmadd_d(a, b, c);
+}
+static inline double vf64_hsum(vf64_t v) {
+  double t[2];
+  vf64_storeu(t, v);
+  return t[0] + t[1];
+}
+static inline double vf64_hmax(vf64_t v) {
+  double t[2];
+  vf64_storeu(t, v);
+  return t[0] > t[1] ? t[0] : t[1];
+}
+static inline double vf64_hmin(vf64_t v) {
+  double t[2];
+  vf64_storeu(t, v);
+  return t[0] < t[1] ? t[0] : t[1];
+}
+
+#elif defined(WCN_POWERPC_VSX)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+typedef __vector double vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) { return vec_xl(0, p); }
+static inline void vf64_storeu(double *p, vf64_t v) { vec_xst(v, 0, p); }
+static inline void vf64_store(double *p, vf64_t v) { vec_xst(v, 0, p); }
+static inline vf64_t vf64_set1(double x) { return vec_splats(x); }
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) { return vec_add(a, b); }
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) { return vec_mul(a, b); }
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) { return vec_max(a, b); }
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) { return vec_min(a, b); }
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return vec_madd(a, b, c);
+}
+static inline double vf64_hsum(vf64_t v) { return v[0] + v[1]; }
+static inline double vf64_hmax(vf64_t v) { return v[0] > v[1] ? v[0] : v[1]; }
+static inline double vf64_hmin(vf64_t v) { return v[0] < v[1] ? v[0] : v[1]; }
+
+#elif defined(WCN_MIPS_MSA)
+
+#define VF64_LANES 2
+#define VF64_ALIGN 16
+typedef v2f64 vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) {
+  return (v2f64)__msa_ld_d((void *)p, 0);
+}
+static inline void vf64_storeu(double *p, vf64_t v) {
+  __msa_st_d((v2i64)v, (void *)p, 0);
+}
+static inline void vf64_store(double *p, vf64_t v) { vf64_storeu(p, v); }
+static inline vf64_t vf64_set1(double x) {
+  const double t[2] = {x, x};
+  return vf64_loadu(t);
+}
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return __msa_fadd_d(a, b);
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return __msa_fmul_d(a, b);
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return __msa_fmax_d(a, b);
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return __msa_fmin_d(a, b);
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return __msa_fmadd_d(c, a, b);
+}
+static inline double vf64_hsum(vf64_t v) { return v[0] + v[1]; }
+static inline double vf64_hmax(vf64_t v) { return v[0] > v[1] ? v[0] : v[1]; }
+static inline double vf64_hmin(vf64_t v) { return v[0] < v[1] ? v[0] : v[1]; }
+
+#elif defined(WCN_RISCV_RVV)
+
+/* Full-register helpers run at VLMAX; the tail helpers shorten vl and
+ * keep the inactive lanes (tail-undisturbed) */
+#define VF64_LANES __riscv_vsetvlmax_e64m1()
+#define VF64_ALIGN 1
+#define VF64_HAS_TAIL 1
+typedef vfloat64m1_t vf64_t;
+
+static inline vf64_t vf64_loadu(const double *p) {
+  return __riscv_vle64_v_f64m1(p, __riscv_vsetvlmax_e64m1());
+}
+static inline void vf64_storeu(double *p, vf64_t v) {
+  __riscv_vse64_v_f64m1(p, v, __riscv_vsetvlmax_e64m1());
+}
+static inline void vf64_store(double *p, vf64_t v) { vf64_storeu(p, v); }
+static inline vf64_t vf64_set1(double x) {
+  return __riscv_vfmv_v_f_f64m1(x, __riscv_vsetvlmax_e64m1());
+}
+static inline vf64_t vf64_add(vf64_t a, vf64_t b) {
+  return __riscv_vfadd_vv_f64m1(a, b, __riscv_vsetvlmax_e64m1());
+}
+static inline vf64_t vf64_mul(vf64_t a, vf64_t b) {
+  return __riscv_vfmul_vv_f64m1(a, b, __riscv_vsetvlmax_e64m1());
+}
+static inline vf64_t vf64_max(vf64_t a, vf64_t b) {
+  return __riscv_vfmax_vv_f64m1(a, b, __riscv_vsetvlmax_e64m1());
+}
+static inline vf64_t vf64_min(vf64_t a, vf64_t b) {
+  return __riscv_vfmin_vv_f64m1(a, b, __riscv_vsetvlmax_e64m1());
+}
+static inline vf64_t vf64_fmadd(vf64_t a, vf64_t b, vf64_t c) {
+  return __riscv_vfmacc_vv_f64m1(c, a, b, __riscv_vsetvlmax_e64m1());
+}
+static inline double vf64_hsum(vf64_t v) {
+  size_t vl = __riscv_vsetvlmax_e64m1();
+  return __riscv_vfmv_f_s_f64m1_f64(__riscv_vfredusum_vs_f64m1_f64m1(
+      v, __riscv_vfmv_s_f_f64m1(0.0, 1), vl));
+}
+static inline double vf64_hmax(vf64_t v) {
+  size_t vl = __riscv_vsetvlmax_e64m1();
+  return __riscv_vfmv_f_s_f64m1_f64(
+      __riscv_vfredmax_vs_f64m1_f64m1(v, v, vl));
+}
+static inline double vf64_hmin(vf64_t v) {
+  size_t vl = __riscv_vsetvlmax_e64m1();
+  return __riscv_vfmv_f_s_f64m1_f64(
+      __riscv_vfredmin_vs_f64m1_f64m1(v, v, vl));
+}
+static inline vf64_t vf64_load_tail(const double *p, size_t n, vf64_t src) {
+  return __riscv_vle64_v_f64m1_tu(src, p, n);
+}
+static inline void vf64_store_tail(double *p, vf64_t v, size_t n) {
+  __riscv_vse64_v_f64m1(p, v, n);
+}
+
+#endif
+
+/* ========== f64 Array Kernels ========== */
+
+static double dot_product_f64(const double *WCN_RESTRICT a,
+                              const double *WCN_RESTRICT b, size_t count) {
+  size_t i = 0;
+  double sum = 0.0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  /* four independent chains hide the FMA latency */
+  vf64_t acc0 = vf64_set1(0.0);
+  vf64_t acc1 = acc0;
+  vf64_t acc2 = acc0;
+  vf64_t acc3 = acc0;
+  for (; i + 4 * w <= count; i += 4 * w) {
+    acc0 = vf64_fmadd(vf64_loadu(a + i), vf64_loadu(b + i), acc0);
+    acc1 = vf64_fmadd(vf64_loadu(a + i + w), vf64_loadu(b + i + w), acc1);
+    acc2 = vf64_fmadd(vf64_loadu(a + i + 2 * w), vf64_loadu(b + i + 2 * w),
+                      acc2);
+    acc3 = vf64_fmadd(vf64_loadu(a + i + 3 * w), vf64_loadu(b + i + 3 * w),
+                      acc3);
+  }
+  for (; i + w <= count; i += w) {
+    acc0 = vf64_fmadd(vf64_loadu(a + i), vf64_loadu(b + i), acc0);
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    vf64_t z = vf64_set1(0.0);
+    acc1 = vf64_fmadd(vf64_load_tail(a + i, count - i, z),
+                      vf64_load_tail(b + i, count - i, z), acc1);
+    i = count;
+  }
+#endif
+  sum = vf64_hsum(vf64_add(vf64_add(acc0, acc1), vf64_add(acc2, acc3)));
+#endif
+
+  for (; i < count; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+static void add_array_f64(const double *WCN_RESTRICT a,
+                          const double *WCN_RESTRICT b, double *WCN_RESTRICT c,
+                          size_t count) {
+  size_t i = 0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+
+  /* --- prologue: advance the destination to a vector boundary so the main
+   * loop can use aligned (and streaming) stores --- */
+  size_t lead = 0;
+  if (((uintptr_t)c & (sizeof(double) - 1)) == 0) {
+    lead = ((VF64_ALIGN - ((uintptr_t)c & (VF64_ALIGN - 1))) &
+            (VF64_ALIGN - 1)) /
+           sizeof(double);
+    if (lead > count)
+      lead = count;
+  }
+#if defined(VF64_HAS_TAIL)
+  if (lead != 0) {
+    vf64_t z = vf64_set1(0.0);
+    vf64_store_tail(c, vf64_add(vf64_load_tail(a, lead, z),
+                                vf64_load_tail(b, lead, z)),
+                    lead);
+  }
+#else
+  for (size_t k = 0; k < lead; ++k) {
+    c[k] = a[k] + b[k];
+  }
+#endif
+  i = lead;
+  if (lead != 0)
+    WCN_STATS_ADD(WCN_STATS_ADD_ARRAY_F64, prologue_runs);
+
+  const int aligned = ((uintptr_t)(c + i) & (VF64_ALIGN - 1)) == 0;
+#if defined(VF64_HAS_STREAM)
+  /* non-temporal stores for large outputs that will not be re-read soon */
+  if (aligned && count * sizeof(double) >= wcn_tuning.stream_threshold) {
+    WCN_STATS_ADD(WCN_STATS_ADD_ARRAY_F64, stream_runs);
+    for (; i + 4 * w <= count; i += 4 * w) {
+      vf64_stream(c + i, vf64_add(vf64_loadu(a + i), vf64_loadu(b + i)));
+      vf64_stream(c + i + w,
+                  vf64_add(vf64_loadu(a + i + w), vf64_loadu(b + i + w)));
+      vf64_stream(c + i + 2 * w, vf64_add(vf64_loadu(a + i + 2 * w),
+                                          vf64_loadu(b + i + 2 * w)));
+      vf64_stream(c + i + 3 * w, vf64_add(vf64_loadu(a + i + 3 * w),
+                                          vf64_loadu(b + i + 3 * w)));
+    }
+    for (; i + w <= count; i += w) {
+      vf64_stream(c + i, vf64_add(vf64_loadu(a + i), vf64_loadu(b + i)));
+    }
+    _mm_sfence();
+  } else
+#endif
+  if (aligned) {
+    for (; i + 2 * w <= count; i += 2 * w) {
+      vf64_store(c + i, vf64_add(vf64_loadu(a + i), vf64_loadu(b + i)));
+      vf64_store(c + i + w,
+                 vf64_add(vf64_loadu(a + i + w), vf64_loadu(b + i + w)));
+    }
+    for (; i + w <= count; i += w) {
+      vf64_store(c + i, vf64_add(vf64_loadu(a + i), vf64_loadu(b + i)));
+    }
+  } else {
+    for (; i + w <= count; i += w) {
+      vf64_storeu(c + i, vf64_add(vf64_loadu(a + i), vf64_loadu(b + i)));
+    }
+  }
+
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    vf64_t z = vf64_set1(0.0);
+    vf64_store_tail(c + i, vf64_add(vf64_load_tail(a + i, count - i, z),
+                                    vf64_load_tail(b + i, count - i, z)),
+                    count - i);
+    i = count;
+  }
+#endif
+#endif
+
+  for (; i < count; ++i) {
+    c[i] = a[i] + b[i];
+  }
+}
+
+static void mul_array_f64(const double *WCN_RESTRICT a,
+                          const double *WCN_RESTRICT b, double *WCN_RESTRICT c,
+                          size_t count) {
+  size_t i = 0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    vf64_storeu(c + i, vf64_mul(vf64_loadu(a + i), vf64_loadu(b + i)));
+    vf64_storeu(c + i + w,
+                vf64_mul(vf64_loadu(a + i + w), vf64_loadu(b + i + w)));
+  }
+  for (; i + w <= count; i += w) {
+    vf64_storeu(c + i, vf64_mul(vf64_loadu(a + i), vf64_loadu(b + i)));
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    vf64_t z = vf64_set1(0.0);
+    vf64_store_tail(c + i, vf64_mul(vf64_load_tail(a + i, count - i, z),
+                                    vf64_load_tail(b + i, count - i, z)),
+                    count - i);
+    i = count;
+  }
+#endif
+#endif
+
+  for (; i < count; ++i) {
+    c[i] = a[i] * b[i];
+  }
+}
+
+static void scale_array_f64(const double *WCN_RESTRICT a, double scalar,
+                            double *WCN_RESTRICT b, size_t count) {
+  size_t i = 0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  const vf64_t vs = vf64_set1(scalar);
+  for (; i + 2 * w <= count; i += 2 * w) {
+    vf64_storeu(b + i, vf64_mul(vf64_loadu(a + i), vs));
+    vf64_storeu(b + i + w, vf64_mul(vf64_loadu(a + i + w), vs));
+  }
+  for (; i + w <= count; i += w) {
+    vf64_storeu(b + i, vf64_mul(vf64_loadu(a + i), vs));
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    vf64_t v = vf64_load_tail(a + i, count - i, vs);
+    vf64_store_tail(b + i, vf64_mul(v, vs), count - i);
+    i = count;
+  }
+#endif
+#endif
+
+  for (; i < count; ++i) {
+    b[i] = a[i] * scalar;
+  }
+}
+
+static void fmadd_array_f64(const double *WCN_RESTRICT a,
+                            const double *WCN_RESTRICT b,
+                            double *WCN_RESTRICT c, size_t count) {
+  size_t i = 0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    vf64_storeu(c + i, vf64_fmadd(vf64_loadu(a + i), vf64_loadu(b + i),
+                                  vf64_loadu(c + i)));
+    vf64_storeu(c + i + w,
+                vf64_fmadd(vf64_loadu(a + i + w), vf64_loadu(b + i + w),
+                           vf64_loadu(c + i + w)));
+  }
+  for (; i + w <= count; i += w) {
+    vf64_storeu(c + i, vf64_fmadd(vf64_loadu(a + i), vf64_loadu(b + i),
+                                  vf64_loadu(c + i)));
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    const size_t n = count - i;
+    vf64_t z = vf64_set1(0.0);
+    vf64_store_tail(c + i,
+                    vf64_fmadd(vf64_load_tail(a + i, n, z),
+                               vf64_load_tail(b + i, n, z),
+                               vf64_load_tail(c + i, n, z)),
+                    n);
+    i = count;
+  }
+#endif
+#endif
+
+  for (; i < count; ++i) {
+    c[i] = a[i] * b[i] + c[i];
+  }
+}
+
+static double reduce_max_f64(const double *data, size_t count) {
+  if (count == 0)
+    return 0.0;
+
+  double max_val = data[0];
+  size_t i = 1;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  vf64_t m0 = vf64_set1(data[0]);
+  vf64_t m1 = m0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    m0 = vf64_max(m0, vf64_loadu(data + i));
+    m1 = vf64_max(m1, vf64_loadu(data + i + w));
+  }
+  for (; i + w <= count; i += w) {
+    m0 = vf64_max(m0, vf64_loadu(data + i));
+  }
+#if defined(VF64_HAS_TAIL)
+  /* inactive lanes repeat the running maximum */
+  if (i < count) {
+    m1 = vf64_max(m1, vf64_load_tail(data + i, count - i, m1));
+    i = count;
+  }
+#endif
+  max_val = vf64_hmax(vf64_max(m0, m1));
+#endif
+
+  for (; i < count; ++i) {
+    if (data[i] > max_val)
+      max_val = data[i];
+  }
+  return max_val;
+}
+
+static double reduce_min_f64(const double *data, size_t count) {
+  if (count == 0)
+    return 0.0;
+
+  double min_val = data[0];
+  size_t i = 1;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  vf64_t m0 = vf64_set1(data[0]);
+  vf64_t m1 = m0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    m0 = vf64_min(m0, vf64_loadu(data + i));
+    m1 = vf64_min(m1, vf64_loadu(data + i + w));
+  }
+  for (; i + w <= count; i += w) {
+    m0 = vf64_min(m0, vf64_loadu(data + i));
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    m1 = vf64_min(m1, vf64_load_tail(data + i, count - i, m1));
+    i = count;
+  }
+#endif
+  min_val = vf64_hmin(vf64_min(m0, m1));
+#endif
+
+  for (; i < count; ++i) {
+    if (data[i] < min_val)
+      min_val = data[i];
+  }
+  return min_val;
+}
+
+static double reduce_sum_f64(const double *data, size_t count) {
+  size_t i = 0;
+  double sum = 0.0;
+
+#if defined(VF64_LANES)
+  const size_t w = VF64_LANES;
+  vf64_t s0 = vf64_set1(0.0);
+  vf64_t s1 = s0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    s0 = vf64_add(s0, vf64_loadu(data + i));
+    s1 = vf64_add(s1, vf64_loadu(data + i + w));
+  }
+  for (; i + w <= count; i += w) {
+    s0 = vf64_add(s0, vf64_loadu(data + i));
+  }
+#if defined(VF64_HAS_TAIL)
+  if (i < count) {
+    s1 = vf64_add(s1, vf64_load_tail(data + i, count - i, vf64_set1(0.0)));
+    i = count;
+  }
+#endif
+  sum = vf64_hsum(vf64_add(s0, s1));
+#endif
+
+  for (; i < count; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
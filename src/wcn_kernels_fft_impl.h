@@ -0,0 +1,632 @@
+/*
+ * WCN_SIMD FFT kernels.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason. Reuses the
+ * VF(op) float selection of wcn_kernels_expr_impl.h.
+ *
+ * A plan (wcn_fft.c) splits the n-point transform into Stockham passes of
+ * radix r. Pass t, with s the product of the radices before it and
+ * m = n / (s * r), computes for p < m and q < s
+ *
+ *     y[q + s * (r * p + j)] = w^(p * j) * sum over k < r of
+ *                              x[q + s * (p + k * m)] * e^(-2 pi i j k / r)
+ *
+ * with w = e^(-2 pi i / (m * r)), ping-ponging between the output and a
+ * scratch array so that the result comes out in natural order. Complex
+ * values are interleaved (re, im) floats and a vector holds FFT_VC of them.
+ * Passes with s a multiple of FFT_VC vectorize over q: every load is a
+ * whole vector of one butterfly leg and the twiddles are broadcasts. The
+ * first pass (s == 1) vectorizes over p instead, FFT_VC butterflies side by
+ * side with per-lane twiddles, and transposes each FFT_VC x FFT_VC block
+ * of its results so that the r outputs of a butterfly are stored together.
+ * Anything else (sizes without enough factors of two, the p left over
+ * after the last whole vector, ISAs below) runs the same butterflies on
+ * scalar complex values.
+ *
+ * Twiddles are stored once, for the forward direction. v * w is
+ * fmaddsub(v, re(w), swap(v) * im(w)) and v * conj(w), for the inverse,
+ * the same with fmsubadd; x86 without FMA and AArch64 emulate both with a
+ * sign-flipped multiply-add.
+ */
+
+#include <string.h>
+
+/* ========== Complex Vectors ========== */
+
+#if defined(WCN_X86_SSE2) ||                                                   \
+    (defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64))
+#define FFT_VC (VF_LANES / 2)
+#else
+#define FFT_VC 1
+#endif
+
+#define FFT_SQRT1_2 0.707106781186547524400844362104849039f
+#define FFT_SIN_PI_3 0.866025403784438646763723170752936183f
+#define FFT_COS_2PI_5 0.309016994374947424102293417182819059f
+#define FFT_COS_4PI_5 -0.809016994374947424102293417182819059f
+#define FFT_SIN_2PI_5 0.951056516295153572116439333379382143f
+#define FFT_SIN_4PI_5 0.587785252292473129168705954639072769f
+
+#if FFT_VC > 1
+
+/* Multipliers that negate the real (even) or imaginary (odd) lanes */
+static const float fft_neg_even[16] = {-1, 1, -1, 1, -1, 1, -1, 1,
+                                       -1, 1, -1, 1, -1, 1, -1, 1};
+static const float fft_neg_odd[16] = {1, -1, 1, -1, 1, -1, 1, -1,
+                                      1, -1, 1, -1, 1, -1, 1, -1};
+
+#if VF_LANES == 16
+
+/* (re, im) -> (im, re) in every complex lane */
+static inline vf_t fc_swap(vf_t v) {
+  v.raw = _mm512_permute_ps(v.raw, 0xB1);
+  return v;
+}
+
+/* Complex lanes in reverse order */
+static inline vf_t fc_reverse(vf_t v) {
+  const __m512i idx = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  v.raw = _mm512_castpd_ps(
+      _mm512_permutexvar_pd(idx, _mm512_castps_pd(v.raw)));
+  return v;
+}
+
+/* The 8 x 8 block of complex values in v[0..8), transposed */
+static inline void fc_transpose(vf_t *v) {
+  __m512d t[8], u[8];
+  for (int i = 0; i < 8; i += 2) {
+    const __m512d a = _mm512_castps_pd(v[i].raw);
+    const __m512d b = _mm512_castps_pd(v[i + 1].raw);
+    t[i] = _mm512_unpacklo_pd(a, b);
+    t[i + 1] = _mm512_unpackhi_pd(a, b);
+  }
+  /* u[4h + 2e + o]: columns of parity o, e selecting 0/4 or 2/6, from the
+   * rows of half h */
+  for (int h = 0; h < 8; h += 4) {
+    u[h] = _mm512_shuffle_f64x2(t[h], t[h + 2], 0x88);
+    u[h + 1] = _mm512_shuffle_f64x2(t[h], t[h + 2], 0xDD);
+    u[h + 2] = _mm512_shuffle_f64x2(t[h + 1], t[h + 3], 0x88);
+    u[h + 3] = _mm512_shuffle_f64x2(t[h + 1], t[h + 3], 0xDD);
+  }
+  v[0].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[0], u[4], 0x88));
+  v[4].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[0], u[4], 0xDD));
+  v[2].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[1], u[5], 0x88));
+  v[6].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[1], u[5], 0xDD));
+  v[1].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[2], u[6], 0x88));
+  v[5].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[2], u[6], 0xDD));
+  v[3].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[3], u[7], 0x88));
+  v[7].raw = _mm512_castpd_ps(_mm512_shuffle_f64x2(u[3], u[7], 0xDD));
+}
+
+#define fc_fmaddsub wcn_v512f_fmaddsub
+#define fc_fmsubadd wcn_v512f_fmsubadd
+
+#elif VF_LANES == 8
+
+static inline vf_t fc_swap(vf_t v) {
+  v.raw = _mm256_permute_ps(v.raw, 0xB1);
+  return v;
+}
+
+static inline vf_t fc_reverse(vf_t v) {
+  v.raw = _mm256_castpd_ps(
+      _mm256_permute4x64_pd(_mm256_castps_pd(v.raw), 0x1B));
+  return v;
+}
+
+static inline void fc_transpose(vf_t *v) {
+  const __m256d t0 = _mm256_unpacklo_pd(_mm256_castps_pd(v[0].raw),
+                                        _mm256_castps_pd(v[1].raw));
+  const __m256d t1 = _mm256_unpackhi_pd(_mm256_castps_pd(v[0].raw),
+                                        _mm256_castps_pd(v[1].raw));
+  const __m256d t2 = _mm256_unpacklo_pd(_mm256_castps_pd(v[2].raw),
+                                        _mm256_castps_pd(v[3].raw));
+  const __m256d t3 = _mm256_unpackhi_pd(_mm256_castps_pd(v[2].raw),
+                                        _mm256_castps_pd(v[3].raw));
+  v[0].raw = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x20));
+  v[1].raw = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x20));
+  v[2].raw = _mm256_castpd_ps(_mm256_permute2f128_pd(t0, t2, 0x31));
+  v[3].raw = _mm256_castpd_ps(_mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+#if defined(WCN_X86_FMA)
+#define fc_fmaddsub wcn_v256f_fmaddsub
+#define fc_fmsubadd wcn_v256f_fmsubadd
+#endif
+
+#elif defined(WCN_X86_SSE2)
+
+static inline vf_t fc_swap(vf_t v) {
+  v.raw = _mm_shuffle_ps(v.raw, v.raw, 0xB1);
+  return v;
+}
+
+static inline vf_t fc_reverse(vf_t v) {
+  v.raw = _mm_shuffle_ps(v.raw, v.raw, 0x4E);
+  return v;
+}
+
+static inline void fc_transpose(vf_t *v) {
+  const __m128 lo = _mm_movelh_ps(v[0].raw, v[1].raw);
+  v[1].raw = _mm_movehl_ps(v[1].raw, v[0].raw);
+  v[0].raw = lo;
+}
+
+#if defined(WCN_X86_FMA)
+#define fc_fmaddsub wcn_v128f_fmaddsub
+#define fc_fmsubadd wcn_v128f_fmsubadd
+#endif
+
+#else /* AArch64 NEON */
+
+static inline vf_t fc_swap(vf_t v) {
+  v.raw = vrev64q_f32(v.raw);
+  return v;
+}
+
+static inline vf_t fc_reverse(vf_t v) {
+  v.raw = vextq_f32(v.raw, v.raw, 2);
+  return v;
+}
+
+static inline void fc_transpose(vf_t *v) {
+  const float32x4_t lo =
+      vcombine_f32(vget_low_f32(v[0].raw), vget_low_f32(v[1].raw));
+  v[1].raw = vcombine_f32(vget_high_f32(v[0].raw), vget_high_f32(v[1].raw));
+  v[0].raw = lo;
+}
+
+#endif
+
+#if !defined(fc_fmaddsub)
+/* a * b - c in the real lanes, a * b + c in the imaginary ones */
+static inline vf_t fc_fmaddsub(vf_t a, vf_t b, vf_t c) {
+  return VF(fmadd)(a, b, VF(mul)(c, VF(load)(fft_neg_even)));
+}
+
+/* a * b + c in the real lanes, a * b - c in the imaginary ones */
+static inline vf_t fc_fmsubadd(vf_t a, vf_t b, vf_t c) {
+  return VF(fmadd)(a, b, VF(mul)(c, VF(load)(fft_neg_odd)));
+}
+#endif
+
+#define fc_add VF(add)
+#define fc_sub VF(sub)
+
+static inline vf_t fc_scale(vf_t v, float k) {
+  return VF(mul)(v, VF(set1)(k));
+}
+
+/* v * -i, or v * i for the inverse */
+static inline vf_t fc_rot(vf_t v, const int inv) {
+  return VF(mul)(fc_swap(v), VF(load)(inv ? fft_neg_even : fft_neg_odd));
+}
+
+/* v * w, or v * conj(w) for the inverse; wr and wi hold the real and the
+ * imaginary part of w in both lanes of each complex value */
+static inline vf_t fc_mul(vf_t v, vf_t wr, vf_t wi, const int inv) {
+  const vf_t t = VF(mul)(fc_swap(v), wi);
+  return inv ? fc_fmsubadd(v, wr, t) : fc_fmaddsub(v, wr, t);
+}
+
+static inline vf_t fc_conj(vf_t v) {
+  return VF(mul)(v, VF(load)(fft_neg_odd));
+}
+
+#endif /* FFT_VC > 1 */
+
+/* ========== Scalar Complex ========== */
+
+typedef struct {
+  float re, im;
+} fs_t;
+
+static inline fs_t fs_load(const float *p) {
+  fs_t v = {p[0], p[1]};
+  return v;
+}
+
+static inline void fs_store(float *p, fs_t v) {
+  p[0] = v.re;
+  p[1] = v.im;
+}
+
+static inline fs_t fs_add(fs_t a, fs_t b) {
+  fs_t v = {a.re + b.re, a.im + b.im};
+  return v;
+}
+
+static inline fs_t fs_sub(fs_t a, fs_t b) {
+  fs_t v = {a.re - b.re, a.im - b.im};
+  return v;
+}
+
+static inline fs_t fs_scale(fs_t a, float k) {
+  fs_t v = {a.re * k, a.im * k};
+  return v;
+}
+
+static inline fs_t fs_rot(fs_t a, const int inv) {
+  fs_t v = {inv ? -a.im : a.im, inv ? a.re : -a.re};
+  return v;
+}
+
+static inline fs_t fs_mul(fs_t a, float wr, float wi, const int inv) {
+  if (inv) {
+    wi = -wi;
+  }
+  fs_t v = {a.re * wr - a.im * wi, a.im * wr + a.re * wi};
+  return v;
+}
+
+static inline fs_t fs_conj(fs_t a) {
+  fs_t v = {a.re, -a.im};
+  return v;
+}
+
+/* ========== Butterflies ========== */
+
+/* P##_dft<r>(a, inv): a[0..r) replaced by its r-point DFT (inverse with
+ * inv), for the complex type T with operations P##_add, _sub, _scale and
+ * _rot */
+#define FFT_BUTTERFLIES(P, T)                                                  \
+  WCN_INLINE void P##_dft2(T *a) {                                             \
+    const T t = a[0];                                                          \
+    a[0] = P##_add(t, a[1]);                                                   \
+    a[1] = P##_sub(t, a[1]);                                                   \
+  }                                                                            \
+                                                                               \
+  WCN_INLINE void P##_dft3(T *a, const int inv) {                              \
+    const T t1 = P##_add(a[1], a[2]);                                          \
+    const T m1 = P##_sub(a[0], P##_scale(t1, 0.5f));                           \
+    const T m2 = P##_scale(P##_rot(P##_sub(a[1], a[2]), inv), FFT_SIN_PI_3);   \
+    a[0] = P##_add(a[0], t1);                                                  \
+    a[1] = P##_add(m1, m2);                                                    \
+    a[2] = P##_sub(m1, m2);                                                    \
+  }                                                                            \
+                                                                               \
+  WCN_INLINE void P##_dft4(T *a, const int inv) {                              \
+    const T t0 = P##_add(a[0], a[2]);                                          \
+    const T t1 = P##_sub(a[0], a[2]);                                          \
+    const T t2 = P##_add(a[1], a[3]);                                          \
+    const T t3 = P##_rot(P##_sub(a[1], a[3]), inv);                            \
+    a[0] = P##_add(t0, t2);                                                    \
+    a[1] = P##_add(t1, t3);                                                    \
+    a[2] = P##_sub(t0, t2);                                                    \
+    a[3] = P##_sub(t1, t3);                                                    \
+  }                                                                            \
+                                                                               \
+  WCN_INLINE void P##_dft5(T *a, const int inv) {                              \
+    const T t1 = P##_add(a[1], a[4]);                                          \
+    const T t2 = P##_add(a[2], a[3]);                                          \
+    const T t3 = P##_sub(a[1], a[4]);                                          \
+    const T t4 = P##_sub(a[2], a[3]);                                          \
+    const T b1 = P##_add(a[0], P##_add(P##_scale(t1, FFT_COS_2PI_5),           \
+                                       P##_scale(t2, FFT_COS_4PI_5)));         \
+    const T b2 = P##_add(a[0], P##_add(P##_scale(t1, FFT_COS_4PI_5),           \
+                                       P##_scale(t2, FFT_COS_2PI_5)));         \
+    const T d1 = P##_rot(P##_add(P##_scale(t3, FFT_SIN_2PI_5),                 \
+                                 P##_scale(t4, FFT_SIN_4PI_5)),                \
+                         inv);                                                 \
+    const T d2 = P##_rot(P##_sub(P##_scale(t3, FFT_SIN_4PI_5),                 \
+                                 P##_scale(t4, FFT_SIN_2PI_5)),                \
+                         inv);                                                 \
+    a[0] = P##_add(a[0], P##_add(t1, t2));                                     \
+    a[1] = P##_add(b1, d1);                                                    \
+    a[2] = P##_add(b2, d2);                                                    \
+    a[3] = P##_sub(b2, d2);                                                    \
+    a[4] = P##_sub(b1, d1);                                                    \
+  }                                                                            \
+                                                                               \
+  /* Radix 2 across a[k], a[k + 4], the odd half turned by e^(-2 pi i k / 8), \
+   * then two 4-point DFTs */                                                  \
+  WCN_INLINE void P##_dft8(T *a, const int inv) {                              \
+    T e[4], o[4];                                                              \
+    for (int k = 0; k < 4; ++k) {                                              \
+      e[k] = P##_add(a[k], a[k + 4]);                                          \
+      o[k] = P##_sub(a[k], a[k + 4]);                                          \
+    }                                                                          \
+    o[1] = P##_scale(P##_add(o[1], P##_rot(o[1], inv)), FFT_SQRT1_2);          \
+    o[2] = P##_rot(o[2], inv);                                                 \
+    o[3] = P##_rot(                                                            \
+        P##_scale(P##_add(o[3], P##_rot(o[3], inv)), FFT_SQRT1_2), inv);       \
+    P##_dft4(e, inv);                                                          \
+    P##_dft4(o, inv);                                                          \
+    for (int j = 0; j < 4; ++j) {                                              \
+      a[2 * j] = e[j];                                                         \
+      a[2 * j + 1] = o[j];                                                     \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  WCN_INLINE void P##_dft(T *a, const unsigned r, const int inv) {             \
+    switch (r) {                                                               \
+    case 2:                                                                    \
+      P##_dft2(a);                                                             \
+      break;                                                                   \
+    case 3:                                                                    \
+      P##_dft3(a, inv);                                                        \
+      break;                                                                   \
+    case 4:                                                                    \
+      P##_dft4(a, inv);                                                        \
+      break;                                                                   \
+    case 5:                                                                    \
+      P##_dft5(a, inv);                                                        \
+      break;                                                                   \
+    default:                                                                   \
+      P##_dft8(a, inv);                                                        \
+      break;                                                                   \
+    }                                                                          \
+  }
+
+FFT_BUTTERFLIES(fs, fs_t)
+#if FFT_VC > 1
+FFT_BUTTERFLIES(fc, vf_t)
+#endif
+
+#undef FFT_BUTTERFLIES
+
+/* ========== Passes ========== */
+
+/* Calls fn(args..., r, inv) with r and inv as constants, so that the
+ * butterflies and the twiddle loops unroll */
+#define FFT_RADIX_SWITCH(fn, r, inv, ...)                                      \
+  switch (r) {                                                                 \
+  case 2:                                                                      \
+    (inv) ? fn(__VA_ARGS__, 2, 1) : fn(__VA_ARGS__, 2, 0);                     \
+    break;                                                                     \
+  case 3:                                                                      \
+    (inv) ? fn(__VA_ARGS__, 3, 1) : fn(__VA_ARGS__, 3, 0);                     \
+    break;                                                                     \
+  case 4:                                                                      \
+    (inv) ? fn(__VA_ARGS__, 4, 1) : fn(__VA_ARGS__, 4, 0);                     \
+    break;                                                                     \
+  case 5:                                                                      \
+    (inv) ? fn(__VA_ARGS__, 5, 1) : fn(__VA_ARGS__, 5, 0);                     \
+    break;                                                                     \
+  default:                                                                     \
+    (inv) ? fn(__VA_ARGS__, 8, 1) : fn(__VA_ARGS__, 8, 0);                     \
+    break;                                                                     \
+  }
+
+/* Butterflies p0 <= p < m of a pass, one complex value at a time */
+WCN_INLINE void fft_pass_scalar_r(const float *x, float *y, size_t s,
+                                  size_t m, const float *tw, size_t p0,
+                                  const unsigned r, const int inv) {
+  for (size_t p = p0; p < m; ++p) {
+    const float *w = tw + 2 * p * (r - 1);
+    for (size_t q = 0; q < s; ++q) {
+      fs_t a[8];
+      for (unsigned k = 0; k < r; ++k) {
+        a[k] = fs_load(x + 2 * (q + s * (p + k * m)));
+      }
+      fs_dft(a, r, inv);
+      float *yp = y + 2 * (q + s * r * p);
+      fs_store(yp, a[0]);
+      for (unsigned j = 1; j < r; ++j) {
+        fs_store(yp + 2 * s * j,
+                 fs_mul(a[j], w[2 * (j - 1)], w[2 * (j - 1) + 1], inv));
+      }
+    }
+  }
+}
+
+static void fft_pass_scalar(const float *x, float *y, size_t s, size_t m,
+                            const float *tw, size_t p0, unsigned r,
+                            int inv) {
+  FFT_RADIX_SWITCH(fft_pass_scalar_r, r, inv, x, y, s, m, tw, p0)
+}
+
+#if FFT_VC > 1
+
+/* The s / FFT_VC vectors of butterfly p; twiddle is 0 for p == 0 */
+WCN_INLINE void fft_legs_q(const float *xp, float *yp, size_t s, size_t m,
+                           const vf_t *wr, const vf_t *wi, const unsigned r,
+                           const int inv, const int twiddle) {
+  for (size_t q = 0; q < s; q += FFT_VC) {
+    vf_t a[8];
+    for (unsigned k = 0; k < r; ++k) {
+      a[k] = VF(load)(xp + 2 * (q + s * k * m));
+    }
+    fc_dft(a, r, inv);
+    VF(store)(yp + 2 * q, a[0]);
+    for (unsigned j = 1; j < r; ++j) {
+      VF(store)(yp + 2 * (q + s * j),
+                twiddle ? fc_mul(a[j], wr[j], wi[j], inv) : a[j]);
+    }
+  }
+}
+
+/* A pass with s a multiple of FFT_VC: vectors over q */
+WCN_INLINE void fft_pass_q_r(const float *x, float *y, size_t s, size_t m,
+                             const float *tw, const unsigned r,
+                             const int inv) {
+  fft_legs_q(x, y, s, m, NULL, NULL, r, inv, 0);
+  for (size_t p = 1; p < m; ++p) {
+    const float *w = tw + 2 * p * (r - 1);
+    vf_t wr[8], wi[8];
+    for (unsigned j = 1; j < r; ++j) {
+      wr[j] = VF(set1)(w[2 * (j - 1)]);
+      wi[j] = VF(set1)(w[2 * (j - 1) + 1]);
+    }
+    fft_legs_q(x + 2 * s * p, y + 2 * s * r * p, s, m, wr, wi, r, inv, 1);
+  }
+}
+
+static void fft_pass_q(const float *x, float *y, size_t s, size_t m,
+                       const float *tw, unsigned r, int inv) {
+  FFT_RADIX_SWITCH(fft_pass_q_r, r, inv, x, y, s, m, tw)
+}
+
+/* The first pass (s == 1), r a multiple of FFT_VC: vectors over p, with
+ * the twiddles of each lane from tw_lanes. Returns the p it stopped at. */
+WCN_INLINE size_t fft_pass_p_r(const float *x, float *y, size_t m,
+                               const float *tw_lanes, const unsigned r,
+                               const int inv) {
+  size_t p = 0;
+  for (; p + FFT_VC <= m; p += FFT_VC) {
+    vf_t a[8];
+    for (unsigned k = 0; k < r; ++k) {
+      a[k] = VF(load)(x + 2 * (p + k * m));
+    }
+    fc_dft(a, r, inv);
+    for (unsigned j = 1; j < r; ++j) {
+      const float *w = tw_lanes + 4 * m * (j - 1) + 2 * p;
+      a[j] = fc_mul(a[j], VF(load)(w), VF(load)(w + 2 * m), inv);
+    }
+    /* Block g of the outputs of lane l goes to y[r * (p + l) + g] */
+    for (unsigned g = 0; g < r; g += FFT_VC) {
+      fc_transpose(a + g);
+      for (unsigned l = 0; l < FFT_VC; ++l) {
+        VF(store)(y + 2 * (r * (p + l) + g), a[g + l]);
+      }
+    }
+  }
+  return p;
+}
+
+static size_t fft_pass_p(const float *x, float *y, size_t m,
+                         const float *tw_lanes, unsigned r, int inv) {
+  switch (r) {
+#if FFT_VC <= 2
+  case 2:
+    return inv ? fft_pass_p_r(x, y, m, tw_lanes, 2, 1)
+               : fft_pass_p_r(x, y, m, tw_lanes, 2, 0);
+#endif
+#if FFT_VC <= 4
+  case 4:
+    return inv ? fft_pass_p_r(x, y, m, tw_lanes, 4, 1)
+               : fft_pass_p_r(x, y, m, tw_lanes, 4, 0);
+#endif
+  case 8:
+    return inv ? fft_pass_p_r(x, y, m, tw_lanes, 8, 1)
+               : fft_pass_p_r(x, y, m, tw_lanes, 8, 0);
+  default:
+    return 0;
+  }
+}
+
+#endif /* FFT_VC > 1 */
+
+#undef FFT_RADIX_SWITCH
+
+static void fft_pass(const wcn_fft_plan_t *plan, unsigned t, const float *x,
+                     float *y, int inv) {
+  const unsigned r = plan->radix[t];
+  const size_t s = plan->stride[t];
+  const size_t m = plan->n / (s * r);
+  size_t p = 0;
+#if FFT_VC > 1
+  if (s % FFT_VC == 0) {
+    fft_pass_q(x, y, s, m, plan->tw[t], r, inv);
+    return;
+  }
+  if (s == 1) {
+    p = fft_pass_p(x, y, m, plan->tw_lanes, r, inv);
+  }
+#endif
+  fft_pass_scalar(x, y, s, m, plan->tw[t], p, r, inv);
+}
+
+/* ========== Transforms ========== */
+
+static void fft_c2c(const wcn_fft_plan_t *plan, const float *in, float *out,
+                    float *work, int inverse) {
+  const unsigned stages = plan->stages;
+  if (stages == 0) {
+    if (in != out) {
+      memcpy(out, in, 2 * plan->n * sizeof(float));
+    }
+    return;
+  }
+  /* Passes alternate between out and work, ending in out; in place, an odd
+   * count starts from a copy in work */
+  const float *src = in;
+  if (in == out && stages % 2 == 1) {
+    memcpy(work, in, 2 * plan->n * sizeof(float));
+    src = work;
+  }
+  for (unsigned t = 0; t < stages; ++t) {
+    float *dst = (stages - 1 - t) % 2 == 0 ? out : work;
+    fft_pass(plan, t, src, dst, inverse);
+    src = dst;
+  }
+}
+
+/* Real plans. With Z the n-point transform of the samples taken in pairs
+ * and W = e^(-2 pi i / (2 n)), bins k and n - k of the real transform are
+ *
+ *     E = (Z[k] + conj(Z[n - k])) / 2,  O = (Z[k] - conj(Z[n - k])) / 2,
+ *     G = -i * W^k * O,  X[k] = E + G,  X[n - k] = conj(E - G)
+ *
+ * and the merge inverts that (unscaled, so the inverse n-point transform
+ * of its output gives 2 n times the samples). */
+
+static void fft_r2c_split(const wcn_fft_plan_t *plan, float *z) {
+  const size_t n = plan->n;
+  const float *twr = plan->real_tw;
+  const float *twi = twr + 2 * (n / 2 + 1);
+  const float r0 = z[0], i0 = z[1];
+  size_t k = 1;
+#if FFT_VC > 1
+  const vf_t half = VF(set1)(0.5f);
+  /* Stops before the mirrored vectors would meet */
+  for (; 2 * (k + FFT_VC - 1) < n; k += FFT_VC) {
+    float *zk = z + 2 * k;
+    float *zm = z + 2 * (n - k - (FFT_VC - 1));
+    const vf_t a = VF(load)(zk);
+    const vf_t b = fc_conj(fc_reverse(VF(load)(zm)));
+    const vf_t e = VF(mul)(VF(add)(a, b), half);
+    const vf_t o = VF(mul)(VF(sub)(a, b), half);
+    const vf_t g =
+        fc_rot(fc_mul(o, VF(load)(twr + 2 * k), VF(load)(twi + 2 * k), 0), 0);
+    VF(store)(zk, VF(add)(e, g));
+    VF(store)(zm, fc_reverse(fc_conj(VF(sub)(e, g))));
+  }
+#endif
+  for (; 2 * k <= n; ++k) {
+    const fs_t a = fs_load(z + 2 * k);
+    const fs_t b = fs_conj(fs_load(z + 2 * (n - k)));
+    const fs_t e = fs_scale(fs_add(a, b), 0.5f);
+    const fs_t o = fs_scale(fs_sub(a, b), 0.5f);
+    const fs_t g = fs_rot(fs_mul(o, twr[2 * k], twi[2 * k], 0), 0);
+    fs_store(z + 2 * k, fs_add(e, g));
+    fs_store(z + 2 * (n - k), fs_conj(fs_sub(e, g)));
+  }
+  z[0] = r0 + i0;
+  z[1] = 0.0f;
+  z[2 * n] = r0 - i0;
+  z[2 * n + 1] = 0.0f;
+}
+
+static void fft_c2r_merge(const wcn_fft_plan_t *plan, const float *x,
+                          float *z) {
+  const size_t n = plan->n;
+  const float *twr = plan->real_tw;
+  const float *twi = twr + 2 * (n / 2 + 1);
+  const float x0 = x[0], xn = x[2 * n];
+  size_t k = 1;
+#if FFT_VC > 1
+  for (; 2 * (k + FFT_VC - 1) < n; k += FFT_VC) {
+    const size_t km = n - k - (FFT_VC - 1);
+    const vf_t a = VF(load)(x + 2 * k);
+    const vf_t b = fc_conj(fc_reverse(VF(load)(x + 2 * km)));
+    const vf_t e = VF(add)(a, b);
+    const vf_t o = fc_rot(fc_mul(VF(sub)(a, b), VF(load)(twr + 2 * k),
+                                 VF(load)(twi + 2 * k), 1),
+                          1);
+    VF(store)(z + 2 * k, VF(add)(e, o));
+    VF(store)(z + 2 * km, fc_reverse(fc_conj(VF(sub)(e, o))));
+  }
+#endif
+  for (; 2 * k <= n; ++k) {
+    const fs_t a = fs_load(x + 2 * k);
+    const fs_t b = fs_conj(fs_load(x + 2 * (n - k)));
+    const fs_t e = fs_add(a, b);
+    const fs_t o = fs_rot(fs_mul(fs_sub(a, b), twr[2 * k], twi[2 * k], 1), 1);
+    fs_store(z + 2 * k, fs_add(e, o));
+    fs_store(z + 2 * (n - k), fs_conj(fs_sub(e, o)));
+  }
+  z[0] = x0 + xn;
+  z[1] = x0 - xn;
+}
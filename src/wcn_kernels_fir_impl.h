@@ -0,0 +1,324 @@
+/*
+ * WCN_SIMD FIR filter kernels.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason. Reuses the
+ * VF(op) float selection of wcn_kernels_expr_impl.h and the VI(op) integer
+ * one of wcn_kernels_int_impl.h.
+ *
+ * The kernels compute y[n] = sum over o < ntaps of g[o] * x[n + o], where g
+ * holds the taps reversed and zero-padded to WCN_FIR_TAP_ALIGN, so that x
+ * supplies count + ntaps - 1 samples and needs no edge handling. Float
+ * filters take one of two shapes:
+ *
+ *   - short (ntaps <= VF_LANES): every tap is broadcast into a register
+ *     once per call; FIR_SHORT_U output vectors accumulate one tap at a
+ *     time from the input shifted by that tap's offset. AVX-512 builds the
+ *     shifted windows from the two aligned neighbours with valignd, which
+ *     beats the unaligned loads (each split over two lines) it replaces;
+ *     narrower ISAs, without a lane-crossing alignr, load them;
+ *   - long: FIR_LONG_U output vectors stay in registers while the taps are
+ *     walked by residue r modulo VF_LANES and, within a residue, in groups
+ *     of up to four taps VF_LANES apart. Output vector u needs tap
+ *     r + q * VF_LANES at window r + (u + q) * VF_LANES, so each window
+ *     loaded serves every (u, q) pair of the group with the same u + q:
+ *     FIR_LONG_U + 3 loads feed 4 * FIR_LONG_U multiply-adds.
+ *
+ * int16 filters multiply pairs of taps with pmaddwd on x86: the even and
+ * odd outputs of a vector accumulate in separate i32 vectors from windows
+ * one sample apart and are interleaved back before rounding and packing.
+ * AArch64 NEON widens one tap at a time with smlal. Outputs past the last
+ * full block, and everything on targets without vectors, go through a
+ * single-vector or scalar loop.
+ */
+
+#include <string.h>
+
+/* ========== Float ========== */
+
+#if VF_LANES > 1
+
+#define FIR_SHORT_U 4
+#if VF_LANES == 16 || defined(WCN_ARM_AARCH64)
+#define FIR_LONG_U 8
+#else
+#define FIR_LONG_U 6
+#endif
+
+/* One output vector at n: a plain tap loop with unaligned loads */
+static inline vf_t fir_vec_f32(const float *x, const float *g,
+                               size_t ntaps) {
+  vf_t acc = VF(mul)(VF(set1)(g[0]), VF(load)(x));
+  for (size_t o = 1; o < ntaps; ++o) {
+    acc = VF(fmadd)(VF(set1)(g[o]), VF(load)(x + o), acc);
+  }
+  return acc;
+}
+
+/* Short filters; returns the number of outputs written */
+static size_t fir_short_f32(const float *x, float *y, size_t count,
+                            const float *g, size_t ntaps) {
+  const size_t block = FIR_SHORT_U * VF_LANES;
+  size_t n = 0;
+#if VF_LANES == 16
+  /* g is padded to 16 taps, so all sixteen registers can be filled */
+  __m512 t[16];
+  for (int o = 0; o < 16; ++o) {
+    t[o] = _mm512_set1_ps(g[o]);
+  }
+  /* The aligned neighbours reach one vector past the first output block */
+  for (; n + block + VF_LANES + 1 <= count + ntaps; n += block) {
+    __m512 v[FIR_SHORT_U + 1], acc[FIR_SHORT_U];
+    for (int u = 0; u <= FIR_SHORT_U; ++u) {
+      v[u] = _mm512_loadu_ps(x + n + u * VF_LANES);
+    }
+    for (int u = 0; u < FIR_SHORT_U; ++u) {
+      acc[u] = _mm512_mul_ps(t[0], v[u]);
+    }
+#define FIR_SHIFT_STEP(o)                                                      \
+  if (ntaps > (o)) {                                                           \
+    for (int u = 0; u < FIR_SHORT_U; ++u) {                                    \
+      const __m512i w = _mm512_alignr_epi32(_mm512_castps_si512(v[u + 1]),     \
+                                            _mm512_castps_si512(v[u]), (o));   \
+      acc[u] = _mm512_fmadd_ps(t[o], _mm512_castsi512_ps(w), acc[u]);          \
+    }                                                                          \
+  }
+    FIR_SHIFT_STEP(1)
+    FIR_SHIFT_STEP(2)
+    FIR_SHIFT_STEP(3)
+    FIR_SHIFT_STEP(4)
+    FIR_SHIFT_STEP(5)
+    FIR_SHIFT_STEP(6)
+    FIR_SHIFT_STEP(7)
+    FIR_SHIFT_STEP(8)
+    FIR_SHIFT_STEP(9)
+    FIR_SHIFT_STEP(10)
+    FIR_SHIFT_STEP(11)
+    FIR_SHIFT_STEP(12)
+    FIR_SHIFT_STEP(13)
+    FIR_SHIFT_STEP(14)
+    FIR_SHIFT_STEP(15)
+#undef FIR_SHIFT_STEP
+    for (int u = 0; u < FIR_SHORT_U; ++u) {
+      _mm512_storeu_ps(y + n + u * VF_LANES, acc[u]);
+    }
+  }
+#else
+  vf_t t[VF_LANES];
+  for (int o = 0; o < VF_LANES; ++o) {
+    t[o] = VF(set1)(g[o]);
+  }
+  for (; n + block <= count; n += block) {
+    vf_t acc[FIR_SHORT_U];
+    for (int u = 0; u < FIR_SHORT_U; ++u) {
+      acc[u] = VF(mul)(t[0], VF(load)(x + n + u * VF_LANES));
+    }
+    for (int o = 1; o < VF_LANES; ++o) {
+      if ((size_t)o < ntaps) {
+        for (int u = 0; u < FIR_SHORT_U; ++u) {
+          acc[u] = VF(fmadd)(t[o], VF(load)(x + n + u * VF_LANES + o),
+                             acc[u]);
+        }
+      }
+    }
+    for (int u = 0; u < FIR_SHORT_U; ++u) {
+      VF(store)(y + n + u * VF_LANES, acc[u]);
+    }
+  }
+#endif
+  return n;
+}
+
+/* acc[u] += taps gr[b * VF_LANES] (b < nb) times the windows at
+ * xr + (u + b) * VF_LANES; nb is a constant after inlining */
+WCN_INLINE void fir_long_group_f32(vf_t *acc, const float *xr,
+                                   const float *gr, const int nb) {
+  vf_t t[4];
+  for (int b = 0; b < nb; ++b) {
+    t[b] = VF(set1)(gr[b * VF_LANES]);
+  }
+  for (int j = 0; j < FIR_LONG_U + nb - 1; ++j) {
+    const vf_t w = VF(load)(xr + j * VF_LANES);
+    for (int b = 0; b < nb; ++b) {
+      if (j - b >= 0 && j - b < FIR_LONG_U) {
+        acc[j - b] = VF(fmadd)(t[b], w, acc[j - b]);
+      }
+    }
+  }
+}
+
+/* Long filters; returns the number of outputs written */
+static size_t fir_long_f32(const float *x, float *y, size_t count,
+                           const float *g, size_t ntaps) {
+  const size_t block = FIR_LONG_U * VF_LANES;
+  /* Taps per residue, counting the zero padding */
+  const size_t qn = (ntaps + VF_LANES - 1) / VF_LANES;
+  size_t n = 0;
+  /* The last group reads qn + FIR_LONG_U - 1 vectors past x + n + r */
+  for (; n + block + qn * VF_LANES <= count + ntaps; n += block) {
+    vf_t acc[FIR_LONG_U];
+    for (int u = 0; u < FIR_LONG_U; ++u) {
+      acc[u] = VF(setzero)();
+    }
+    for (size_t r = 0; r < VF_LANES; ++r) {
+      const float *xr = x + n + r;
+      const float *gr = g + r;
+      size_t q = 0;
+      for (; q + 4 <= qn; q += 4) {
+        fir_long_group_f32(acc, xr + q * VF_LANES, gr + q * VF_LANES, 4);
+      }
+      if (q + 2 <= qn) {
+        fir_long_group_f32(acc, xr + q * VF_LANES, gr + q * VF_LANES, 2);
+        q += 2;
+      }
+      if (q < qn) {
+        fir_long_group_f32(acc, xr + q * VF_LANES, gr + q * VF_LANES, 1);
+      }
+    }
+    for (int u = 0; u < FIR_LONG_U; ++u) {
+      VF(store)(y + n + u * VF_LANES, acc[u]);
+    }
+  }
+  return n;
+}
+
+#endif
+
+static void fir_f32(const float *x, float *y, size_t count, const float *g,
+                    size_t ntaps) {
+  size_t n = 0;
+#if VF_LANES > 1
+  n = ntaps <= VF_LANES ? fir_short_f32(x, y, count, g, ntaps)
+                        : fir_long_f32(x, y, count, g, ntaps);
+  for (; n + VF_LANES <= count; n += VF_LANES) {
+    VF(store)(y + n, fir_vec_f32(x + n, g, ntaps));
+  }
+#endif
+  for (; n < count; ++n) {
+    float acc = 0.0f;
+    for (size_t o = 0; o < ntaps; ++o) {
+      acc += g[o] * x[n + o];
+    }
+    y[n] = acc;
+  }
+}
+
+/* ========== int16 ========== */
+
+/* The 32-bit sum of products, wrapping like the vector lanes, rounded and
+ * shifted right, then saturated */
+static inline int16_t fir_narrow_i16(uint32_t acc, unsigned shift) {
+  if (shift != 0) {
+    acc += (uint32_t)1 << (shift - 1);
+  }
+  int32_t v = (int32_t)acc >> shift;
+  return (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+
+#if defined(VI_BYTES) && defined(WCN_X86_SSE2)
+#define FIR_I16_VECTOR 1
+#define FIR_I16_LANES (VI_BYTES / 2)
+#define FIR_I16_U 4
+
+static inline vi_t fir_madd_i16(vi_t a, vi_t b) {
+#if VI_BYTES == 64
+  a.raw = _mm512_madd_epi16(a.raw, b.raw);
+#elif VI_BYTES == 32
+  a.raw = _mm256_madd_epi16(a.raw, b.raw);
+#else
+  a.raw = _mm_madd_epi16(a.raw, b.raw);
+#endif
+  return a;
+}
+
+static inline vi_t fir_sra_i32(vi_t a, unsigned shift) {
+  const __m128i count = _mm_cvtsi32_si128((int)shift);
+#if VI_BYTES == 64
+  a.raw = _mm512_sra_epi32(a.raw, count);
+#elif VI_BYTES == 32
+  a.raw = _mm256_sra_epi32(a.raw, count);
+#else
+  a.raw = _mm_sra_epi32(a.raw, count);
+#endif
+  return a;
+}
+
+/* nu output vectors at x + n (nu is a constant after inlining) */
+WCN_INLINE void fir_block_i16(const int16_t *x, int16_t *y, const int16_t *g,
+                              size_t ntaps, unsigned shift, const int nu) {
+  vi_t even[FIR_I16_U], odd[FIR_I16_U];
+  for (int u = 0; u < nu; ++u) {
+    even[u] = VI(setzero)();
+    odd[u] = VI(setzero)();
+  }
+  for (size_t o = 0; o < ntaps; o += 2) {
+    const uint32_t pair =
+        (uint16_t)g[o] | (uint32_t)(uint16_t)g[o + 1] << 16;
+    const vi_t t = VI(set1_i32)((int32_t)pair);
+    for (int u = 0; u < nu; ++u) {
+      const int16_t *w = x + u * FIR_I16_LANES + o;
+      even[u] = VI(add_i32)(even[u], fir_madd_i16(VI(load)(w), t));
+      odd[u] = VI(add_i32)(odd[u], fir_madd_i16(VI(load)(w + 1), t));
+    }
+  }
+  const vi_t round = VI(set1_i32)(shift != 0 ? 1 << (shift - 1) : 0);
+  for (int u = 0; u < nu; ++u) {
+    vi_t lo = VI(add_i32)(VI(unpacklo_i32)(even[u], odd[u]), round);
+    vi_t hi = VI(add_i32)(VI(unpackhi_i32)(even[u], odd[u]), round);
+    VI(store)(y + u * FIR_I16_LANES,
+              VI(packs_i32)(fir_sra_i32(lo, shift), fir_sra_i32(hi, shift)));
+  }
+}
+#elif defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64)
+#define FIR_I16_VECTOR 1
+#define FIR_I16_LANES 8
+#define FIR_I16_U 4
+
+WCN_INLINE void fir_block_i16(const int16_t *x, int16_t *y, const int16_t *g,
+                              size_t ntaps, unsigned shift, const int nu) {
+  int32x4_t lo[FIR_I16_U], hi[FIR_I16_U];
+  for (int u = 0; u < nu; ++u) {
+    lo[u] = vdupq_n_s32(0);
+    hi[u] = vdupq_n_s32(0);
+  }
+  for (size_t o = 0; o < ntaps; ++o) {
+    for (int u = 0; u < nu; ++u) {
+      const int16x8_t w = vld1q_s16(x + u * FIR_I16_LANES + o);
+      lo[u] = vmlal_n_s16(lo[u], vget_low_s16(w), g[o]);
+      hi[u] = vmlal_high_n_s16(hi[u], w, g[o]);
+    }
+  }
+  const int32x4_t round = vdupq_n_s32(shift != 0 ? 1 << (shift - 1) : 0);
+  const int32x4_t right = vdupq_n_s32(-(int32_t)shift);
+  for (int u = 0; u < nu; ++u) {
+    const int32x4_t l = vshlq_s32(vaddq_s32(lo[u], round), right);
+    const int32x4_t h = vshlq_s32(vaddq_s32(hi[u], round), right);
+    vst1q_s16(y + u * FIR_I16_LANES,
+              vcombine_s16(vqmovn_s32(l), vqmovn_s32(h)));
+  }
+}
+#endif
+
+static void fir_i16(const int16_t *x, int16_t *y, size_t count,
+                    const int16_t *g, size_t ntaps, unsigned shift) {
+  size_t n = 0;
+#if defined(FIR_I16_VECTOR)
+  /* Tap pairs read one sample past an odd ntaps (from the zero padding),
+   * and the odd windows one sample further */
+  const size_t reach = (ntaps + 1) & ~(size_t)1;
+  for (; n + FIR_I16_U * FIR_I16_LANES + reach <= count + ntaps;
+       n += FIR_I16_U * FIR_I16_LANES) {
+    fir_block_i16(x + n, y + n, g, ntaps, shift, FIR_I16_U);
+  }
+  for (; n + FIR_I16_LANES + reach <= count + ntaps; n += FIR_I16_LANES) {
+    fir_block_i16(x + n, y + n, g, ntaps, shift, 1);
+  }
+#endif
+  for (; n < count; ++n) {
+    uint32_t acc = 0;
+    for (size_t o = 0; o < ntaps; ++o) {
+      acc += (uint32_t)((int32_t)g[o] * x[n + o]);
+    }
+    y[n] = fir_narrow_i16(acc, shift);
+  }
+}
@@ -0,0 +1,320 @@
+/*
+ * WCN_SIMD single-precision matrix multiplication (SGEMM).
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * GotoBLAS / BLIS structure: for each panel of op(B) (kc x nc, sized for the
+ * core's last-level cache share) and each block of op(A) (mc x kc, sized for
+ * L2), both are packed into micro-panels: GEMM_NR columns of B and GEMM_MR
+ * rows of A, consecutive in k and zero-padded at the edges. The micro-kernel
+ * then walks one B micro-panel (L1-resident, it is reused by every A
+ * micro-panel of the block) against one A micro-panel and keeps the whole
+ * GEMM_MR x GEMM_NR tile of C in registers: per k step it loads
+ * GEMM_NR / VF_LANES vectors of B and broadcasts GEMM_MR elements of A into
+ * them with VF(fmadd). Partial tiles are computed into a scratch tile and
+ * merged. Tiles are sized to leave a few registers free for B and the
+ * broadcast: 24 accumulators of 32 on AVX-512, 12 of 16 on AVX2/SSE2.
+ */
+
+#include <string.h>
+
+/* ========== Micro-Kernel Selection ========== */
+
+#if defined(WCN_RISCV_RVV)
+/* Six m4 register groups of 16 floats (VLEN >= 128) and one for B */
+#define GEMM_MR 6
+#define GEMM_NR 16
+#elif VF_LANES == 16
+#define GEMM_MR 12
+#define GEMM_NV 2
+#elif VF_LANES == 8
+#define GEMM_MR 6
+#define GEMM_NV 2
+#elif VF_LANES == 4 && defined(WCN_ARM_AARCH64)
+#define GEMM_MR 8
+#define GEMM_NV 2
+#elif VF_LANES == 4
+#define GEMM_MR 6
+#define GEMM_NV 2
+#else
+#define GEMM_MR 4
+#define GEMM_NR 4
+#endif
+
+#if defined(GEMM_NV)
+#define GEMM_NR (GEMM_NV * VF_LANES)
+#endif
+
+/* Bounds on the panel depth kc, whatever the tuning says */
+#define GEMM_KC_MIN 32
+#define GEMM_KC_MAX 1024
+
+/* ========== Micro-Kernels ========== */
+
+/* c (GEMM_MR x GEMM_NR, row stride ldc) = alpha * pa * pb + beta * c, where
+ * pa and pb are kc-deep packed micro-panels. beta == 0 does not read c. */
+#if defined(WCN_RISCV_RVV)
+
+#define GEMM_RVV_STORE(r, acc)                                                 \
+  do {                                                                         \
+    float *cr = c + (r) * ldc;                                                 \
+    vfloat32m4_t v = __riscv_vfmul_vf_f32m4(acc, alpha, vl);                   \
+    if (beta != 0.0f) {                                                        \
+      v = __riscv_vfmacc_vf_f32m4(v, beta, __riscv_vle32_v_f32m4(cr, vl),      \
+                                  vl);                                         \
+    }                                                                          \
+    __riscv_vse32_v_f32m4(cr, v, vl);                                          \
+  } while (0)
+
+static void gemm_kernel(size_t kc, const float *WCN_RESTRICT pa,
+                        const float *WCN_RESTRICT pb, float *WCN_RESTRICT c,
+                        size_t ldc, float alpha, float beta) {
+  const size_t vl = __riscv_vsetvl_e32m4(GEMM_NR);
+  vfloat32m4_t c0 = __riscv_vfmv_v_f_f32m4(0.0f, vl);
+  vfloat32m4_t c1 = c0, c2 = c0, c3 = c0, c4 = c0, c5 = c0;
+  for (size_t p = 0; p < kc; ++p, pa += GEMM_MR, pb += GEMM_NR) {
+    const vfloat32m4_t b = __riscv_vle32_v_f32m4(pb, vl);
+    c0 = __riscv_vfmacc_vf_f32m4(c0, pa[0], b, vl);
+    c1 = __riscv_vfmacc_vf_f32m4(c1, pa[1], b, vl);
+    c2 = __riscv_vfmacc_vf_f32m4(c2, pa[2], b, vl);
+    c3 = __riscv_vfmacc_vf_f32m4(c3, pa[3], b, vl);
+    c4 = __riscv_vfmacc_vf_f32m4(c4, pa[4], b, vl);
+    c5 = __riscv_vfmacc_vf_f32m4(c5, pa[5], b, vl);
+  }
+  GEMM_RVV_STORE(0, c0);
+  GEMM_RVV_STORE(1, c1);
+  GEMM_RVV_STORE(2, c2);
+  GEMM_RVV_STORE(3, c3);
+  GEMM_RVV_STORE(4, c4);
+  GEMM_RVV_STORE(5, c5);
+}
+
+#undef GEMM_RVV_STORE
+
+#elif defined(GEMM_NV)
+
+static void gemm_kernel(size_t kc, const float *WCN_RESTRICT pa,
+                        const float *WCN_RESTRICT pb, float *WCN_RESTRICT c,
+                        size_t ldc, float alpha, float beta) {
+  /* constant trip counts: the compiler unrolls these loops and keeps acc in
+   * registers */
+  vf_t acc[GEMM_MR][GEMM_NV];
+  for (int r = 0; r < GEMM_MR; ++r) {
+    for (int v = 0; v < GEMM_NV; ++v) {
+      acc[r][v] = VF(setzero)();
+    }
+  }
+
+  for (size_t p = 0; p < kc; ++p, pa += GEMM_MR, pb += GEMM_NR) {
+    vf_t b[GEMM_NV];
+    for (int v = 0; v < GEMM_NV; ++v) {
+      b[v] = VF(load)(pb + v * VF_LANES);
+    }
+    for (int r = 0; r < GEMM_MR; ++r) {
+      const vf_t a = VF(set1)(pa[r]);
+      for (int v = 0; v < GEMM_NV; ++v) {
+        acc[r][v] = VF(fmadd)(a, b[v], acc[r][v]);
+      }
+    }
+  }
+
+  const vf_t va = VF(set1)(alpha);
+  const vf_t vb = VF(set1)(beta);
+  for (int r = 0; r < GEMM_MR; ++r) {
+    float *cr = c + r * ldc;
+    for (int v = 0; v < GEMM_NV; ++v) {
+      vf_t out = VF(mul)(va, acc[r][v]);
+      if (beta != 0.0f) {
+        out = VF(fmadd)(vb, VF(load)(cr + v * VF_LANES), out);
+      }
+      VF(store)(cr + v * VF_LANES, out);
+    }
+  }
+}
+
+#else
+
+static void gemm_kernel(size_t kc, const float *WCN_RESTRICT pa,
+                        const float *WCN_RESTRICT pb, float *WCN_RESTRICT c,
+                        size_t ldc, float alpha, float beta) {
+  float acc[GEMM_MR][GEMM_NR] = {{0.0f}};
+  for (size_t p = 0; p < kc; ++p, pa += GEMM_MR, pb += GEMM_NR) {
+    for (int r = 0; r < GEMM_MR; ++r) {
+      for (int j = 0; j < GEMM_NR; ++j) {
+        acc[r][j] += pa[r] * pb[j];
+      }
+    }
+  }
+  for (int r = 0; r < GEMM_MR; ++r) {
+    for (int j = 0; j < GEMM_NR; ++j) {
+      const float out = alpha * acc[r][j];
+      c[r * ldc + j] = beta != 0.0f ? out + beta * c[r * ldc + j] : out;
+    }
+  }
+}
+
+#endif
+
+/* An mr x nr (at most GEMM_MR x GEMM_NR) tile of C */
+static void gemm_tile(size_t kc, const float *pa, const float *pb, float *c,
+                      size_t ldc, size_t mr, size_t nr, float alpha,
+                      float beta) {
+  if (mr == GEMM_MR && nr == GEMM_NR) {
+    gemm_kernel(kc, pa, pb, c, ldc, alpha, beta);
+    return;
+  }
+  float tile[GEMM_MR * GEMM_NR];
+  gemm_kernel(kc, pa, pb, tile, GEMM_NR, alpha, 0.0f);
+  for (size_t r = 0; r < mr; ++r) {
+    for (size_t j = 0; j < nr; ++j) {
+      const float out = tile[r * GEMM_NR + j];
+      c[r * ldc + j] = beta != 0.0f ? out + beta * c[r * ldc + j] : out;
+    }
+  }
+}
+
+/* ========== Blocking and Packing ========== */
+
+typedef struct {
+  size_t kc, mc, nc;
+} gemm_blocks_t;
+
+static inline size_t gemm_round_up(size_t x, size_t to) {
+  return (x + to - 1) / to * to;
+}
+
+/* Panel depth from the L1 budget for one B micro-panel, split evenly over
+ * k; A blocks from the L2 budget and B panels from the last-level one, both
+ * cut to what the matrix needs */
+static gemm_blocks_t gemm_blocks(size_t m, size_t n, size_t k) {
+  gemm_blocks_t bl;
+  size_t kc = wcn_tuning.gemm_l1_bytes / (GEMM_NR * sizeof(float));
+  kc = kc < GEMM_KC_MIN ? GEMM_KC_MIN : kc > GEMM_KC_MAX ? GEMM_KC_MAX : kc;
+  if (kc >= k) {
+    kc = k;
+  } else {
+    const size_t blocks = (k + kc - 1) / kc;
+    kc = gemm_round_up((k + blocks - 1) / blocks, 4);
+  }
+  bl.kc = kc;
+
+  size_t mc = wcn_tuning.gemm_l2_bytes / (kc * sizeof(float));
+  mc = mc / GEMM_MR * GEMM_MR;
+  mc = mc < GEMM_MR ? GEMM_MR : mc;
+  bl.mc = mc < m ? mc : gemm_round_up(m, GEMM_MR);
+
+  size_t nc = wcn_tuning.gemm_l3_bytes / (kc * sizeof(float));
+  nc = nc / GEMM_NR * GEMM_NR;
+  nc = nc < GEMM_NR ? GEMM_NR : nc;
+  bl.nc = nc < n ? nc : gemm_round_up(n, GEMM_NR);
+  return bl;
+}
+
+/* Floats in the A block, kept a multiple of 64 bytes so B stays aligned */
+static inline size_t gemm_a_floats(const gemm_blocks_t *bl) {
+  return gemm_round_up(bl->mc * bl->kc, 16);
+}
+
+static size_t sgemm_pack_floats(size_t m, size_t n, size_t k) {
+  const gemm_blocks_t bl = gemm_blocks(m, n, k);
+  return gemm_a_floats(&bl) + bl.kc * bl.nc;
+}
+
+/* mb x kb block of op(A) at (ic, pc) as GEMM_MR-row micro-panels */
+static void gemm_pack_a(const wcn_sgemm_args_t *g, size_t ic, size_t pc,
+                        size_t mb, size_t kb, float *WCN_RESTRICT dst) {
+  const size_t lda = g->lda;
+  for (size_t ir = 0; ir < mb; ir += GEMM_MR) {
+    const size_t mr = mb - ir < GEMM_MR ? mb - ir : GEMM_MR;
+    if (g->trans_a) {
+      /* stored k x m: the GEMM_MR elements of a k step are contiguous */
+      const float *src = g->a + pc * lda + ic + ir;
+      for (size_t p = 0; p < kb; ++p, dst += GEMM_MR) {
+        memcpy(dst, src + p * lda, mr * sizeof(float));
+        for (size_t r = mr; r < GEMM_MR; ++r) {
+          dst[r] = 0.0f;
+        }
+      }
+    } else {
+      const float *src = g->a + (ic + ir) * lda + pc;
+      for (size_t p = 0; p < kb; ++p, dst += GEMM_MR) {
+        for (size_t r = 0; r < mr; ++r) {
+          dst[r] = src[r * lda + p];
+        }
+        for (size_t r = mr; r < GEMM_MR; ++r) {
+          dst[r] = 0.0f;
+        }
+      }
+    }
+  }
+}
+
+/* kb x nb panel of op(B) at (pc, jc) as GEMM_NR-column micro-panels */
+static void gemm_pack_b(const wcn_sgemm_args_t *g, size_t pc, size_t jc,
+                        size_t kb, size_t nb, float *WCN_RESTRICT dst) {
+  const size_t ldb = g->ldb;
+  for (size_t jr = 0; jr < nb; jr += GEMM_NR) {
+    const size_t nr = nb - jr < GEMM_NR ? nb - jr : GEMM_NR;
+    if (!g->trans_b) {
+      const float *src = g->b + pc * ldb + jc + jr;
+      for (size_t p = 0; p < kb; ++p, dst += GEMM_NR) {
+        if (nr == GEMM_NR) {
+          memcpy(dst, src + p * ldb, GEMM_NR * sizeof(float));
+          continue;
+        }
+        memcpy(dst, src + p * ldb, nr * sizeof(float));
+        for (size_t j = nr; j < GEMM_NR; ++j) {
+          dst[j] = 0.0f;
+        }
+      }
+    } else {
+      /* stored n x k: each column of op(B) is a contiguous row */
+      const float *src = g->b + (jc + jr) * ldb + pc;
+      for (size_t p = 0; p < kb; ++p, dst += GEMM_NR) {
+        for (size_t j = 0; j < nr; ++j) {
+          dst[j] = src[j * ldb + p];
+        }
+        for (size_t j = nr; j < GEMM_NR; ++j) {
+          dst[j] = 0.0f;
+        }
+      }
+    }
+  }
+}
+
+/* ========== Driver ========== */
+
+/* k > 0; pack holds sgemm_pack_floats(m, n, k) floats, 64-byte aligned */
+static void sgemm_f32(const wcn_sgemm_args_t *g, float *pack) {
+  const gemm_blocks_t bl = gemm_blocks(g->m, g->n, g->k);
+  float *pa = pack;
+  float *pb = pack + gemm_a_floats(&bl);
+
+  for (size_t jc = 0; jc < g->n; jc += bl.nc) {
+    const size_t nb = g->n - jc < bl.nc ? g->n - jc : bl.nc;
+    for (size_t pc = 0; pc < g->k; pc += bl.kc) {
+      const size_t kb = g->k - pc < bl.kc ? g->k - pc : bl.kc;
+      /* later k blocks accumulate onto the first one */
+      const float beta = pc == 0 ? g->beta : 1.0f;
+      gemm_pack_b(g, pc, jc, kb, nb, pb);
+      for (size_t ic = 0; ic < g->m; ic += bl.mc) {
+        const size_t mb = g->m - ic < bl.mc ? g->m - ic : bl.mc;
+        gemm_pack_a(g, ic, pc, mb, kb, pa);
+        /* one B micro-panel stays in L1 across the A micro-panels */
+        for (size_t jr = 0; jr < nb; jr += GEMM_NR) {
+          const size_t nr = nb - jr < GEMM_NR ? nb - jr : GEMM_NR;
+          float *c = g->c + ic * g->ldc + jc + jr;
+          for (size_t ir = 0; ir < mb; ir += GEMM_MR) {
+            const size_t mr = mb - ir < GEMM_MR ? mb - ir : GEMM_MR;
+            gemm_tile(kb, pa + ir * kb, pb + jr * kb, c + ir * g->ldc,
+                      g->ldc, mr, nr, g->alpha, beta);
+          }
+        }
+      }
+    }
+  }
+}
+
+#undef GEMM_KC_MIN
+#undef GEMM_KC_MAX
@@ -0,0 +1,385 @@
+/*
+ * WCN_SIMD 16-bit float (binary16 / bfloat16) array kernels.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * hv_t is a float vector the 16-bit formats widen into: AVX-512F and F16C
+ * convert binary16 in hardware, as does AArch64 NEON; SSE2 uses the
+ * integer bit manipulation of wcn_f16.h lane-wise, and other targets the
+ * scalar functions themselves. bfloat16 is the top half of a float
+ * everywhere, so it only needs a shift (and a rounding add on the way
+ * back). Products and sums are formed in float; a partial vector at the
+ * end goes through the same code on a zero-padded copy.
+ */
+
+#include <string.h>
+
+/* ========== Half Vector Selection ========== */
+
+#if defined(WCN_X86_AVX512F)
+#define HV_LANES 16
+typedef __m512 hv_t;
+
+static inline hv_t hv_load_f16(const uint16_t *p) {
+  return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)p));
+}
+
+static inline void hv_store_f16(uint16_t *p, hv_t v) {
+  _mm256_storeu_si256(
+      (__m256i *)p,
+      _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+
+static inline hv_t hv_load_bf16(const uint16_t *p) {
+  __m512i u = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)p));
+  return _mm512_castsi512_ps(_mm512_slli_epi32(u, 16));
+}
+
+static inline void hv_store_bf16(uint16_t *p, hv_t v) {
+  __m512i u = _mm512_castps_si512(v);
+  __m512i lsb =
+      _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+  __m512i r = _mm512_add_epi32(
+      u, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7FFF)));
+  __mmask16 nan = _mm512_cmpgt_epu32_mask(
+      _mm512_and_si512(u, _mm512_set1_epi32(0x7FFFFFFF)),
+      _mm512_set1_epi32(0x7F800000));
+  r = _mm512_mask_mov_epi32(
+      r, nan, _mm512_or_si512(u, _mm512_set1_epi32(0x400000)));
+  _mm256_storeu_si256((__m256i *)p,
+                      _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16)));
+}
+
+static inline hv_t hv_loadf(const float *p) { return _mm512_loadu_ps(p); }
+static inline void hv_storef(float *p, hv_t v) { _mm512_storeu_ps(p, v); }
+static inline hv_t hv_zero(void) { return _mm512_setzero_ps(); }
+static inline hv_t hv_add(hv_t a, hv_t b) { return _mm512_add_ps(a, b); }
+static inline hv_t hv_fma(hv_t a, hv_t b, hv_t c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+#elif defined(WCN_X86_AVX2) && defined(WCN_X86_F16C)
+#define HV_LANES 8
+typedef __m256 hv_t;
+
+static inline hv_t hv_load_f16(const uint16_t *p) {
+  return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)p));
+}
+
+static inline void hv_store_f16(uint16_t *p, hv_t v) {
+  _mm_storeu_si128((__m128i *)p,
+                   _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT |
+                                          _MM_FROUND_NO_EXC));
+}
+
+static inline hv_t hv_load_bf16(const uint16_t *p) {
+  __m256i u = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p));
+  return _mm256_castsi256_ps(_mm256_slli_epi32(u, 16));
+}
+
+static inline void hv_store_bf16(uint16_t *p, hv_t v) {
+  __m256i u = _mm256_castps_si256(v);
+  __m256i lsb =
+      _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+  __m256i r = _mm256_add_epi32(
+      u, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF)));
+  __m256i nan = _mm256_cmpgt_epi32(
+      _mm256_and_si256(u, _mm256_set1_epi32(0x7FFFFFFF)),
+      _mm256_set1_epi32(0x7F800000));
+  r = _mm256_blendv_epi8(
+      r, _mm256_or_si256(u, _mm256_set1_epi32(0x400000)), nan);
+  r = _mm256_srli_epi32(r, 16);
+  _mm_storeu_si128((__m128i *)p,
+                   _mm_packus_epi32(_mm256_castsi256_si128(r),
+                                    _mm256_extracti128_si256(r, 1)));
+}
+
+static inline hv_t hv_loadf(const float *p) { return _mm256_loadu_ps(p); }
+static inline void hv_storef(float *p, hv_t v) { _mm256_storeu_ps(p, v); }
+static inline hv_t hv_zero(void) { return _mm256_setzero_ps(); }
+static inline hv_t hv_add(hv_t a, hv_t b) { return _mm256_add_ps(a, b); }
+static inline hv_t hv_fma(hv_t a, hv_t b, hv_t c) {
+#if defined(WCN_X86_FMA)
+  return _mm256_fmadd_ps(a, b, c);
+#else
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+#elif defined(WCN_X86_SSE2)
+#define HV_LANES 4
+typedef __m128 hv_t;
+
+/* Four zero-extended 16-bit values from p, one per 32-bit lane */
+static inline __m128i hv_load_u16(const uint16_t *p) {
+  return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p),
+                            _mm_setzero_si128());
+}
+
+/* The low 16 bits of each 32-bit lane of h to p */
+static inline void hv_store_u16(uint16_t *p, __m128i h) {
+  /* sign-extend so the saturating pack keeps the bits */
+  h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+  _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(h, h));
+}
+
+/* (mask & a) | (~mask & b) */
+static inline __m128i hv_select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* wcn_f16_to_float() per lane. Subnormals are rebiased like normals with
+ * an implicit 1 at 2^-14, which a subtraction of normal numbers removes
+ * (exactly, and regardless of denormals-are-zero modes). */
+static inline hv_t hv_load_f16(const uint16_t *p) {
+  const __m128i h = hv_load_u16(p);
+  const __m128i e = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+  const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, e), 16);
+  const __m128i tiny = _mm_cmplt_epi32(e, _mm_set1_epi32(0x400));
+  /* infinity / NaN: rebias once more to reach exponent 255 */
+  const __m128i special = _mm_cmpgt_epi32(e, _mm_set1_epi32(0x7BFF));
+  __m128i bits = _mm_add_epi32(_mm_slli_epi32(e, 13),
+                               _mm_set1_epi32(112 << 23));
+  bits = _mm_add_epi32(bits,
+                       _mm_and_si128(special, _mm_set1_epi32(112 << 23)));
+  bits = _mm_add_epi32(bits, _mm_and_si128(tiny, _mm_set1_epi32(1 << 23)));
+  const __m128 f = _mm_sub_ps(
+      _mm_castsi128_ps(bits),
+      _mm_and_ps(_mm_castsi128_ps(tiny), _mm_set1_ps(6.103515625e-05f)));
+  return _mm_or_ps(f, _mm_castsi128_ps(sign));
+}
+
+/* wcn_float_to_f16() per lane */
+static inline void hv_store_f16(uint16_t *p, hv_t v) {
+  __m128i u = _mm_castps_si128(v);
+  const __m128i sign = _mm_and_si128(u, _mm_set1_epi32((int)0x80000000u));
+  u = _mm_xor_si128(u, sign);
+
+  const __m128i odd = _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(1));
+  __m128i h = _mm_add_epi32(u, _mm_set1_epi32((int)((15u - 127u) << 23) +
+                                              0xFFF));
+  h = _mm_srli_epi32(_mm_add_epi32(h, odd), 13);
+
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128i sub = _mm_sub_epi32(
+      _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), half)),
+      _mm_castps_si128(half));
+  h = hv_select(_mm_cmplt_epi32(u, _mm_set1_epi32(113 << 23)), sub, h);
+
+  const __m128i nan = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x7F800000));
+  const __m128i payload =
+      _mm_or_si128(_mm_set1_epi32(0x0200),
+                   _mm_and_si128(_mm_srli_epi32(u, 13), _mm_set1_epi32(0x3FF)));
+  const __m128i over = _mm_or_si128(_mm_set1_epi32(0x7C00),
+                                    _mm_and_si128(nan, payload));
+  h = hv_select(_mm_cmpgt_epi32(u, _mm_set1_epi32((143 << 23) - 1)), over,
+                h);
+  hv_store_u16(p, _mm_or_si128(h, _mm_srli_epi32(sign, 16)));
+}
+
+static inline hv_t hv_load_bf16(const uint16_t *p) {
+  return _mm_castsi128_ps(_mm_unpacklo_epi16(
+      _mm_setzero_si128(), _mm_loadl_epi64((const __m128i *)p)));
+}
+
+static inline void hv_store_bf16(uint16_t *p, hv_t v) {
+  const __m128i u = _mm_castps_si128(v);
+  const __m128i lsb =
+      _mm_and_si128(_mm_srli_epi32(u, 16), _mm_set1_epi32(1));
+  __m128i r = _mm_add_epi32(u, _mm_add_epi32(lsb, _mm_set1_epi32(0x7FFF)));
+  const __m128i nan =
+      _mm_cmpgt_epi32(_mm_and_si128(u, _mm_set1_epi32(0x7FFFFFFF)),
+                      _mm_set1_epi32(0x7F800000));
+  r = hv_select(nan, _mm_or_si128(u, _mm_set1_epi32(0x400000)), r);
+  hv_store_u16(p, _mm_srli_epi32(r, 16));
+}
+
+static inline hv_t hv_loadf(const float *p) { return _mm_loadu_ps(p); }
+static inline void hv_storef(float *p, hv_t v) { _mm_storeu_ps(p, v); }
+static inline hv_t hv_zero(void) { return _mm_setzero_ps(); }
+static inline hv_t hv_add(hv_t a, hv_t b) { return _mm_add_ps(a, b); }
+static inline hv_t hv_fma(hv_t a, hv_t b, hv_t c) {
+#if defined(WCN_X86_FMA)
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+#elif defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64)
+#define HV_LANES 4
+typedef float32x4_t hv_t;
+
+static inline hv_t hv_load_f16(const uint16_t *p) {
+  return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(p)));
+}
+
+static inline void hv_store_f16(uint16_t *p, hv_t v) {
+  vst1_u16(p, vreinterpret_u16_f16(vcvt_f16_f32(v)));
+}
+
+static inline hv_t hv_load_bf16(const uint16_t *p) {
+  return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(p), 16));
+}
+
+static inline void hv_store_bf16(uint16_t *p, hv_t v) {
+  const uint32x4_t u = vreinterpretq_u32_f32(v);
+  const uint32x4_t lsb = vandq_u32(vshrq_n_u32(u, 16), vdupq_n_u32(1));
+  uint32x4_t r = vaddq_u32(u, vaddq_u32(lsb, vdupq_n_u32(0x7FFF)));
+  const uint32x4_t nan = vcgtq_u32(vandq_u32(u, vdupq_n_u32(0x7FFFFFFF)),
+                                   vdupq_n_u32(0x7F800000));
+  r = vbslq_u32(nan, vorrq_u32(u, vdupq_n_u32(0x400000)), r);
+  vst1_u16(p, vshrn_n_u32(r, 16));
+}
+
+static inline hv_t hv_loadf(const float *p) { return vld1q_f32(p); }
+static inline void hv_storef(float *p, hv_t v) { vst1q_f32(p, v); }
+static inline hv_t hv_zero(void) { return vdupq_n_f32(0.0f); }
+static inline hv_t hv_add(hv_t a, hv_t b) { return vaddq_f32(a, b); }
+static inline hv_t hv_fma(hv_t a, hv_t b, hv_t c) {
+  return vfmaq_f32(c, a, b);
+}
+
+#else
+#define HV_LANES 1
+typedef float hv_t;
+
+static inline hv_t hv_load_f16(const uint16_t *p) {
+  return wcn_f16_to_float(*p);
+}
+
+static inline void hv_store_f16(uint16_t *p, hv_t v) {
+  *p = wcn_float_to_f16(v);
+}
+
+static inline hv_t hv_load_bf16(const uint16_t *p) {
+  return wcn_bf16_to_float(*p);
+}
+
+static inline void hv_store_bf16(uint16_t *p, hv_t v) {
+  *p = wcn_float_to_bf16(v);
+}
+
+static inline hv_t hv_loadf(const float *p) { return *p; }
+static inline void hv_storef(float *p, hv_t v) { *p = v; }
+static inline hv_t hv_zero(void) { return 0.0f; }
+static inline hv_t hv_add(hv_t a, hv_t b) { return a + b; }
+static inline hv_t hv_fma(hv_t a, hv_t b, hv_t c) { return a * b + c; }
+#endif
+
+static inline float hv_hsum(hv_t v) {
+  float lanes[HV_LANES];
+  hv_storef(lanes, v);
+  float sum = 0.0f;
+  for (size_t j = 0; j < HV_LANES; ++j) {
+    sum += lanes[j];
+  }
+  return sum;
+}
+
+/* ========== Conversion and Mixed-Precision Kernels ========== */
+
+/*
+ * Per format: conversion both ways, dot product, c += a * b into float c,
+ * and sum. The tails copy the last count % HV_LANES elements into
+ * zero-filled vectors (zero adds nothing to a sum or product).
+ */
+#define WCN_DEFINE_HALF_KERNELS(fmt)                                           \
+  static void fmt##_to_f32(const uint16_t *WCN_RESTRICT src,                   \
+                           float *WCN_RESTRICT dst, size_t count) {            \
+    size_t i = 0;                                                              \
+    for (; i + HV_LANES <= count; i += HV_LANES) {                             \
+      hv_storef(dst + i, hv_load_##fmt(src + i));                              \
+    }                                                                          \
+    if (i < count) {                                                           \
+      uint16_t in[HV_LANES] = {0};                                             \
+      float out[HV_LANES];                                                     \
+      memcpy(in, src + i, (count - i) * sizeof(uint16_t));                     \
+      hv_storef(out, hv_load_##fmt(in));                                       \
+      memcpy(dst + i, out, (count - i) * sizeof(float));                       \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void f32_to_##fmt(const float *WCN_RESTRICT src,                      \
+                           uint16_t *WCN_RESTRICT dst, size_t count) {         \
+    size_t i = 0;                                                              \
+    for (; i + HV_LANES <= count; i += HV_LANES) {                             \
+      hv_store_##fmt(dst + i, hv_loadf(src + i));                              \
+    }                                                                          \
+    if (i < count) {                                                           \
+      float in[HV_LANES] = {0};                                                \
+      uint16_t out[HV_LANES];                                                  \
+      memcpy(in, src + i, (count - i) * sizeof(float));                        \
+      hv_store_##fmt(out, hv_loadf(in));                                       \
+      memcpy(dst + i, out, (count - i) * sizeof(uint16_t));                    \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static float dot_product_##fmt(const uint16_t *a, const uint16_t *b,         \
+                                 size_t count) {                               \
+    hv_t acc0 = hv_zero();                                                     \
+    hv_t acc1 = acc0;                                                          \
+    size_t i = 0;                                                              \
+    for (; i + 2 * HV_LANES <= count; i += 2 * HV_LANES) {                     \
+      acc0 = hv_fma(hv_load_##fmt(a + i), hv_load_##fmt(b + i), acc0);         \
+      acc1 = hv_fma(hv_load_##fmt(a + i + HV_LANES),                           \
+                    hv_load_##fmt(b + i + HV_LANES), acc1);                    \
+    }                                                                          \
+    for (; i + HV_LANES <= count; i += HV_LANES) {                             \
+      acc0 = hv_fma(hv_load_##fmt(a + i), hv_load_##fmt(b + i), acc0);         \
+    }                                                                          \
+    if (i < count) {                                                           \
+      uint16_t ta[HV_LANES] = {0};                                             \
+      uint16_t tb[HV_LANES] = {0};                                             \
+      memcpy(ta, a + i, (count - i) * sizeof(uint16_t));                       \
+      memcpy(tb, b + i, (count - i) * sizeof(uint16_t));                       \
+      acc1 = hv_fma(hv_load_##fmt(ta), hv_load_##fmt(tb), acc1);               \
+    }                                                                          \
+    return hv_hsum(hv_add(acc0, acc1));                                        \
+  }                                                                            \
+                                                                               \
+  static void fmadd_array_##fmt(const uint16_t *WCN_RESTRICT a,                \
+                                const uint16_t *WCN_RESTRICT b,                \
+                                float *WCN_RESTRICT c, size_t count) {         \
+    size_t i = 0;                                                              \
+    for (; i + HV_LANES <= count; i += HV_LANES) {                             \
+      hv_storef(c + i, hv_fma(hv_load_##fmt(a + i), hv_load_##fmt(b + i),      \
+                              hv_loadf(c + i)));                               \
+    }                                                                          \
+    if (i < count) {                                                           \
+      uint16_t ta[HV_LANES] = {0};                                             \
+      uint16_t tb[HV_LANES] = {0};                                             \
+      float tc[HV_LANES] = {0};                                                \
+      memcpy(ta, a + i, (count - i) * sizeof(uint16_t));                       \
+      memcpy(tb, b + i, (count - i) * sizeof(uint16_t));                       \
+      memcpy(tc, c + i, (count - i) * sizeof(float));                          \
+      hv_storef(tc, hv_fma(hv_load_##fmt(ta), hv_load_##fmt(tb),               \
+                           hv_loadf(tc)));                                     \
+      memcpy(c + i, tc, (count - i) * sizeof(float));                          \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static float reduce_sum_##fmt(const uint16_t *data, size_t count) {          \
+    hv_t acc0 = hv_zero();                                                     \
+    hv_t acc1 = acc0;                                                          \
+    size_t i = 0;                                                              \
+    for (; i + 2 * HV_LANES <= count; i += 2 * HV_LANES) {                     \
+      acc0 = hv_add(acc0, hv_load_##fmt(data + i));                            \
+      acc1 = hv_add(acc1, hv_load_##fmt(data + i + HV_LANES));                 \
+    }                                                                          \
+    for (; i + HV_LANES <= count; i += HV_LANES) {                             \
+      acc0 = hv_add(acc0, hv_load_##fmt(data + i));                            \
+    }                                                                          \
+    if (i < count) {                                                           \
+      uint16_t t[HV_LANES] = {0};                                              \
+      memcpy(t, data + i, (count - i) * sizeof(uint16_t));                     \
+      acc1 = hv_add(acc1, hv_load_##fmt(t));                                   \
+    }                                                                          \
+    return hv_hsum(hv_add(acc0, acc1));                                        \
+  }
+
+WCN_DEFINE_HALF_KERNELS(f16)
+WCN_DEFINE_HALF_KERNELS(bf16)
+
+#undef WCN_DEFINE_HALF_KERNELS
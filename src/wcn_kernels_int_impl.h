@@ -0,0 +1,533 @@
+/*
+ * WCN_SIMD integer array kernel bodies.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * The kernels are built on the portable integer vector API: wcn_v512i_*
+ * with AVX-512BW, wcn_v256i_* with AVX2 and wcn_v128i_* on every other
+ * 128-bit backend (SSE2, NEON, LSX, AltiVec/VSX, WASM SIMD128, MSA). VI(op)
+ * names the widest available flavour of an operation; the few widening
+ * steps whose best instruction differs per width get a small vi_* helper.
+ * Targets without a wcn_v128i_t implementation (RVV, scalar) use the
+ * scalar loops, which the compiler is free to auto-vectorize.
+ *
+ * Sums widen before accumulating (i32/i16 into i64, u8 into u64 via SAD on
+ * x86), so they are exact for any count. min/max and the saturating array
+ * ops finish with one overlapping vector instead of a scalar tail. The
+ * u8 x i8 dot products accumulate in i32 lanes (pmaddubsw/pmaddwd, VNNI,
+ * sdot/usdot or the WASM dot) that are folded into i64 in blocks.
+ */
+
+/* ========== Integer Vector Selection ========== */
+
+#if defined(WCN_X86_AVX512BW)
+#define VI_BYTES 64
+#define VI(op) wcn_v512i_##op
+typedef wcn_v512i_t vi_t;
+#elif defined(WCN_X86_AVX2)
+#define VI_BYTES 32
+#define VI(op) wcn_v256i_##op
+typedef wcn_v256i_t vi_t;
+#elif defined(WCN_X86_SSE2) || defined(WCN_ARM_NEON) ||                       \
+    defined(WCN_LOONGARCH_LSX) || defined(WCN_POWERPC_ALTIVEC) ||             \
+    defined(WCN_WASM_SIMD128) || defined(WCN_MIPS_MSA)
+#define VI_BYTES 16
+#define VI(op) wcn_v128i_##op
+typedef wcn_v128i_t vi_t;
+#endif
+
+#if defined(VI_BYTES)
+
+/* acc(i64) += sign-extended i32 lanes of v */
+static inline vi_t vi_acc_i32_i64(vi_t acc, vi_t v) {
+#if VI_BYTES == 64
+  /* even lanes: shift up and back down arithmetically; odd lanes: shift down */
+  vi_t even = wcn_v512i_srai_i64(wcn_v512i_slli_i64(v, 32), 32);
+  acc = wcn_v512i_add_i64(acc, even);
+  return wcn_v512i_add_i64(acc, wcn_v512i_srai_i64(v, 32));
+#else
+  vi_t sign = VI(cmpgt_i32)(VI(setzero)(), v);
+  acc = VI(add_i64)(acc, VI(unpacklo_i32)(v, sign));
+  return VI(add_i64)(acc, VI(unpackhi_i32)(v, sign));
+#endif
+}
+
+/* Adjacent i16 pairs summed into i32 lanes (cannot overflow) */
+static inline vi_t vi_pairsum_i16(vi_t v) {
+#if VI_BYTES >= 32
+  return VI(madd_i16)(v, VI(set1_i16)(1));
+#else
+  vi_t sign = VI(cmpgt_i16)(VI(setzero)(), v);
+  return VI(add_i32)(VI(unpacklo_i16)(v, sign), VI(unpackhi_i16)(v, sign));
+#endif
+}
+
+/* acc(u64) += all u8 lanes of v */
+static inline vi_t vi_acc_u8_u64(vi_t acc, vi_t v) {
+#if VI_BYTES >= 32
+  return VI(add_i64)(acc, VI(sad_u8)(v, VI(setzero)()));
+#elif defined(WCN_X86_SSE2)
+  acc.raw = _mm_add_epi64(acc.raw, _mm_sad_epu8(v.raw, _mm_setzero_si128()));
+  return acc;
+#else
+  /* zero-extend 8 -> 16 -> 32 -> 64 bits, adding halves at each step */
+  vi_t z = VI(setzero)();
+  vi_t s16 = VI(add_i16)(VI(unpacklo_i8)(v, z), VI(unpackhi_i8)(v, z));
+  vi_t s32 = VI(add_i32)(VI(unpacklo_i16)(s16, z), VI(unpackhi_i16)(s16, z));
+  acc = VI(add_i64)(acc, VI(unpacklo_i32)(s32, z));
+  return VI(add_i64)(acc, VI(unpackhi_i32)(s32, z));
+#endif
+}
+
+static inline int64_t vi_hsum_i64(vi_t v) {
+  int64_t lanes[VI_BYTES / sizeof(int64_t)];
+  VI(store)(lanes, v);
+  int64_t sum = 0;
+  for (size_t j = 0; j < VI_BYTES / sizeof(int64_t); ++j) {
+    sum += lanes[j];
+  }
+  return sum;
+}
+
+#endif /* VI_BYTES */
+
+/* ========== Widening Sums ========== */
+
+static int64_t reduce_sum_i32(const int32_t *data, size_t count) {
+  int64_t sum = 0;
+  size_t i = 0;
+
+#if defined(VI_BYTES)
+  const size_t w = VI_BYTES / sizeof(int32_t);
+  vi_t acc0 = VI(setzero)();
+  vi_t acc1 = acc0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    acc0 = vi_acc_i32_i64(acc0, VI(load)(data + i));
+    acc1 = vi_acc_i32_i64(acc1, VI(load)(data + i + w));
+  }
+  for (; i + w <= count; i += w) {
+    acc0 = vi_acc_i32_i64(acc0, VI(load)(data + i));
+  }
+  sum = vi_hsum_i64(VI(add_i64)(acc0, acc1));
+#endif
+
+  for (; i < count; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+static int64_t reduce_sum_i16(const int16_t *data, size_t count) {
+  int64_t sum = 0;
+  size_t i = 0;
+
+#if defined(VI_BYTES)
+  const size_t w = VI_BYTES / sizeof(int16_t);
+  vi_t acc0 = VI(setzero)();
+  vi_t acc1 = acc0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    acc0 = vi_acc_i32_i64(acc0, vi_pairsum_i16(VI(load)(data + i)));
+    acc1 = vi_acc_i32_i64(acc1, vi_pairsum_i16(VI(load)(data + i + w)));
+  }
+  for (; i + w <= count; i += w) {
+    acc0 = vi_acc_i32_i64(acc0, vi_pairsum_i16(VI(load)(data + i)));
+  }
+  sum = vi_hsum_i64(VI(add_i64)(acc0, acc1));
+#endif
+
+  for (; i < count; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+static uint64_t reduce_sum_u8(const uint8_t *data, size_t count) {
+  uint64_t sum = 0;
+  size_t i = 0;
+
+#if defined(VI_BYTES)
+  const size_t w = VI_BYTES;
+  vi_t acc0 = VI(setzero)();
+  vi_t acc1 = acc0;
+  for (; i + 2 * w <= count; i += 2 * w) {
+    acc0 = vi_acc_u8_u64(acc0, VI(load)(data + i));
+    acc1 = vi_acc_u8_u64(acc1, VI(load)(data + i + w));
+  }
+  for (; i + w <= count; i += w) {
+    acc0 = vi_acc_u8_u64(acc0, VI(load)(data + i));
+  }
+  sum = (uint64_t)vi_hsum_i64(VI(add_i64)(acc0, acc1));
+#endif
+
+  for (; i < count; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+/* ========== Min / Max ========== */
+
+#define WCN_SCALAR_MIN(x, y) ((y) < (x) ? (y) : (x))
+#define WCN_SCALAR_MAX(x, y) ((y) > (x) ? (y) : (x))
+
+#if defined(VI_BYTES)
+/* Two accumulators over full vectors, then one vector aligned to the end of
+ * the array: re-reading a few elements is harmless for min/max */
+#define WCN_DEFINE_REDUCE_MINMAX(name, T, vop, sop)                           \
+  static T name(const T *data, size_t count) {                                \
+    if (count == 0)                                                           \
+      return 0;                                                               \
+    T r = data[0];                                                            \
+    size_t i = 1;                                                             \
+    const size_t w = VI_BYTES / sizeof(T);                                    \
+    if (count >= w) {                                                         \
+      vi_t acc0 = VI(load)(data);                                             \
+      vi_t acc1 = acc0;                                                       \
+      for (i = w; i + 2 * w <= count; i += 2 * w) {                           \
+        acc0 = VI(vop)(acc0, VI(load)(data + i));                             \
+        acc1 = VI(vop)(acc1, VI(load)(data + i + w));                         \
+      }                                                                       \
+      if (i + w <= count) {                                                   \
+        acc0 = VI(vop)(acc0, VI(load)(data + i));                             \
+      }                                                                       \
+      acc1 = VI(vop)(acc1, VI(load)(data + count - w));                       \
+      T lanes[VI_BYTES / sizeof(T)];                                          \
+      VI(store)(lanes, VI(vop)(acc0, acc1));                                  \
+      r = lanes[0];                                                           \
+      for (size_t j = 1; j < w; ++j) {                                        \
+        r = sop(r, lanes[j]);                                                 \
+      }                                                                       \
+      return r;                                                               \
+    }                                                                         \
+    for (; i < count; ++i) {                                                  \
+      r = sop(r, data[i]);                                                    \
+    }                                                                         \
+    return r;                                                                 \
+  }
+#else
+#define WCN_DEFINE_REDUCE_MINMAX(name, T, vop, sop)                           \
+  static T name(const T *data, size_t count) {                                \
+    if (count == 0)                                                           \
+      return 0;                                                               \
+    T r = data[0];                                                            \
+    for (size_t i = 1; i < count; ++i) {                                      \
+      r = sop(r, data[i]);                                                    \
+    }                                                                         \
+    return r;                                                                 \
+  }
+#endif
+
+WCN_DEFINE_REDUCE_MINMAX(reduce_min_i8, int8_t, min_i8, WCN_SCALAR_MIN)
+WCN_DEFINE_REDUCE_MINMAX(reduce_max_i8, int8_t, max_i8, WCN_SCALAR_MAX)
+WCN_DEFINE_REDUCE_MINMAX(reduce_min_u8, uint8_t, min_u8, WCN_SCALAR_MIN)
+WCN_DEFINE_REDUCE_MINMAX(reduce_max_u8, uint8_t, max_u8, WCN_SCALAR_MAX)
+WCN_DEFINE_REDUCE_MINMAX(reduce_min_i16, int16_t, min_i16, WCN_SCALAR_MIN)
+WCN_DEFINE_REDUCE_MINMAX(reduce_max_i16, int16_t, max_i16, WCN_SCALAR_MAX)
+WCN_DEFINE_REDUCE_MINMAX(reduce_min_i32, int32_t, min_i32, WCN_SCALAR_MIN)
+WCN_DEFINE_REDUCE_MINMAX(reduce_max_i32, int32_t, max_i32, WCN_SCALAR_MAX)
+
+#undef WCN_DEFINE_REDUCE_MINMAX
+
+/* ========== Saturating Add / Sub ========== */
+
+static inline int8_t sat_i8(int v) {
+  return (int8_t)(v > INT8_MAX ? INT8_MAX : v < INT8_MIN ? INT8_MIN : v);
+}
+static inline uint8_t sat_u8(int v) {
+  return (uint8_t)(v > UINT8_MAX ? UINT8_MAX : v < 0 ? 0 : v);
+}
+static inline int16_t sat_i16(int v) {
+  return (int16_t)(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v);
+}
+static inline uint16_t sat_u16(int v) {
+  return (uint16_t)(v > UINT16_MAX ? UINT16_MAX : v < 0 ? 0 : v);
+}
+
+#if defined(VI_BYTES)
+/* c = a (op) b, with c allowed to be a or b (in place): every element is
+ * read before it is written, and the last partial vector is finished in
+ * scalar code */
+#define WCN_DEFINE_SATURATING_ARRAY(name, T, vop, sat, sop)                   \
+  static void name(const T *a, const T *b, T *c, size_t count) {              \
+    size_t i = 0;                                                             \
+    const size_t w = VI_BYTES / sizeof(T);                                    \
+    for (; i + 2 * w <= count; i += 2 * w) {                                  \
+      const vi_t v0 = VI(vop)(VI(load)(a + i), VI(load)(b + i));              \
+      const vi_t v1 = VI(vop)(VI(load)(a + i + w), VI(load)(b + i + w));      \
+      VI(store)(c + i, v0);                                                   \
+      VI(store)(c + i + w, v1);                                               \
+    }                                                                         \
+    if (i + w <= count) {                                                     \
+      VI(store)(c + i, VI(vop)(VI(load)(a + i), VI(load)(b + i)));            \
+      i += w;                                                                 \
+    }                                                                         \
+    for (; i < count; ++i) {                                                  \
+      c[i] = sat((int)a[i] sop (int)b[i]);                                    \
+    }                                                                         \
+  }
+#else
+#define WCN_DEFINE_SATURATING_ARRAY(name, T, vop, sat, sop)                   \
+  static void name(const T *a, const T *b, T *c, size_t count) {              \
+    for (size_t i = 0; i < count; ++i) {                                      \
+      c[i] = sat((int)a[i] sop (int)b[i]);                                    \
+    }                                                                         \
+  }
+#endif
+
+WCN_DEFINE_SATURATING_ARRAY(adds_array_i8, int8_t, adds_i8, sat_i8, +)
+WCN_DEFINE_SATURATING_ARRAY(subs_array_i8, int8_t, subs_i8, sat_i8, -)
+WCN_DEFINE_SATURATING_ARRAY(adds_array_u8, uint8_t, adds_u8, sat_u8, +)
+WCN_DEFINE_SATURATING_ARRAY(subs_array_u8, uint8_t, subs_u8, sat_u8, -)
+WCN_DEFINE_SATURATING_ARRAY(adds_array_i16, int16_t, adds_i16, sat_i16, +)
+WCN_DEFINE_SATURATING_ARRAY(subs_array_i16, int16_t, subs_i16, sat_i16, -)
+WCN_DEFINE_SATURATING_ARRAY(adds_array_u16, uint16_t, adds_u16, sat_u16, +)
+WCN_DEFINE_SATURATING_ARRAY(subs_array_u16, uint16_t, subs_u16, sat_u16, -)
+
+#undef WCN_DEFINE_SATURATING_ARRAY
+#undef WCN_SCALAR_MIN
+#undef WCN_SCALAR_MAX
+
+/* ========== Quantized Dot Products (u8 x i8) ========== */
+
+/* Exact 64-bit sum; callers of the GEMV get it saturated to int32 */
+static inline int32_t sat_i32(int64_t v) {
+  return (int32_t)(v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : v);
+}
+
+#if defined(VI_BYTES) && (defined(WCN_X86_SSE2) || defined(WCN_ARM_NEON) ||  \
+                          defined(WCN_WASM_SIMD128))
+#define VI_DOT_U8I8 1
+
+/* Vectors per i32 accumulator before it is folded into i64. Each vector adds
+ * four products of at most 255 * 128 to a lane, so 4096 vectors stay below
+ * 2^29 and no path can overflow (with margin for the sdot bias below). */
+#define VI_DOT_U8I8_BLOCK 4096
+
+/* acc(i32) += sums of four adjacent u8 x i8 products (the vpdpbusd layout) */
+static inline vi_t vi_dot_u8i8(vi_t acc, vi_t a, vi_t b) {
+#if VI_BYTES == 64 && defined(__AVX512VNNI__)
+  acc.raw = _mm512_dpbusd_epi32(acc.raw, a.raw, b.raw);
+#elif VI_BYTES == 64
+  /* pmaddubsw saturates its i16 pair sums once a >= 128 meets |b| near 128.
+   * With the top bit of a split off both halves are exact: 2 * 127 * 128
+   * and 2 * 128 * 128 fit (the latter only as -32768). */
+  const __m512i lo = _mm512_and_si512(a.raw, _mm512_set1_epi8(0x7F));
+  const __m512i hi = _mm512_and_si512(a.raw, _mm512_set1_epi8((char)0x80));
+  const __m512i one = _mm512_set1_epi16(1);
+  acc.raw = _mm512_add_epi32(
+      acc.raw, _mm512_madd_epi16(_mm512_maddubs_epi16(lo, b.raw), one));
+  acc.raw = _mm512_add_epi32(
+      acc.raw, _mm512_madd_epi16(_mm512_maddubs_epi16(hi, b.raw), one));
+#elif VI_BYTES == 32 && defined(__AVXVNNI__)
+  acc.raw = _mm256_dpbusd_avx_epi32(acc.raw, a.raw, b.raw);
+#elif VI_BYTES == 32
+  const __m256i lo = _mm256_and_si256(a.raw, _mm256_set1_epi8(0x7F));
+  const __m256i hi = _mm256_and_si256(a.raw, _mm256_set1_epi8((char)0x80));
+  const __m256i one = _mm256_set1_epi16(1);
+  acc.raw = _mm256_add_epi32(
+      acc.raw, _mm256_madd_epi16(_mm256_maddubs_epi16(lo, b.raw), one));
+  acc.raw = _mm256_add_epi32(
+      acc.raw, _mm256_madd_epi16(_mm256_maddubs_epi16(hi, b.raw), one));
+#elif defined(WCN_X86_SSSE3)
+  const __m128i lo = _mm_and_si128(a.raw, _mm_set1_epi8(0x7F));
+  const __m128i hi = _mm_and_si128(a.raw, _mm_set1_epi8((char)0x80));
+  const __m128i one = _mm_set1_epi16(1);
+  acc.raw = _mm_add_epi32(acc.raw,
+                          _mm_madd_epi16(_mm_maddubs_epi16(lo, b.raw), one));
+  acc.raw = _mm_add_epi32(acc.raw,
+                          _mm_madd_epi16(_mm_maddubs_epi16(hi, b.raw), one));
+#elif defined(WCN_X86_SSE2)
+  /* widen to i16 (zero- resp. sign-extended) and let pmaddwd pair them */
+  const __m128i z = _mm_setzero_si128();
+  const __m128i b_lo = _mm_srai_epi16(_mm_unpacklo_epi8(b.raw, b.raw), 8);
+  const __m128i b_hi = _mm_srai_epi16(_mm_unpackhi_epi8(b.raw, b.raw), 8);
+  acc.raw = _mm_add_epi32(
+      acc.raw, _mm_madd_epi16(_mm_unpacklo_epi8(a.raw, z), b_lo));
+  acc.raw = _mm_add_epi32(
+      acc.raw, _mm_madd_epi16(_mm_unpackhi_epi8(a.raw, z), b_hi));
+#elif defined(WCN_ARM_NEON)
+  const uint8x16_t au = vreinterpretq_u8_s32(a.raw);
+  const int8x16_t bs = vreinterpretq_s8_s32(b.raw);
+#if defined(__ARM_FEATURE_MATMUL_INT8)
+  acc.raw = vusdotq_s32(acc.raw, au, bs);
+#elif defined(__ARM_FEATURE_DOTPROD)
+  /* sdot only: a * b = (a - 128) * b + 128 * b, the bias as two 64 * b */
+  const int8x16_t ab = vreinterpretq_s8_u8(veorq_u8(au, vdupq_n_u8(0x80)));
+  acc.raw = vdotq_s32(acc.raw, ab, bs);
+  acc.raw = vdotq_s32(acc.raw, bs, vdupq_n_s8(64));
+  acc.raw = vdotq_s32(acc.raw, bs, vdupq_n_s8(64));
+#else
+  /* the i16 products cannot overflow (255 * -128 = -32640) */
+  const int16x8_t a_lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(au)));
+  const int16x8_t a_hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(au)));
+  acc.raw = vpadalq_s16(acc.raw,
+                        vmulq_s16(a_lo, vmovl_s8(vget_low_s8(bs))));
+  acc.raw = vpadalq_s16(acc.raw,
+                        vmulq_s16(a_hi, vmovl_s8(vget_high_s8(bs))));
+#endif
+#elif defined(__wasm_relaxed_simd__)
+  /* the relaxed dot is deterministic when its second operand is 7-bit:
+   * feed it the low seven bits of a, then the top bit scaled by 128 */
+  const v128_t lo = wasm_v128_and(a.raw, wasm_u8x16_const_splat(0x7F));
+  const v128_t hi = wasm_i32x4_relaxed_dot_i8x16_i7x16_add(
+      b.raw, wasm_u8x16_shr(a.raw, 7), wasm_i32x4_const_splat(0));
+  acc.raw = wasm_i32x4_relaxed_dot_i8x16_i7x16_add(b.raw, lo, acc.raw);
+  acc.raw = wasm_i32x4_add(acc.raw, wasm_i32x4_shl(hi, 7));
+#else
+  acc.raw = wasm_i32x4_add(
+      acc.raw, wasm_i32x4_dot_i16x8(wasm_u16x8_extend_low_u8x16(a.raw),
+                                    wasm_i16x8_extend_low_i8x16(b.raw)));
+  acc.raw = wasm_i32x4_add(
+      acc.raw, wasm_i32x4_dot_i16x8(wasm_u16x8_extend_high_u8x16(a.raw),
+                                    wasm_i16x8_extend_high_i8x16(b.raw)));
+#endif
+  return acc;
+}
+
+/* VNNI the build did not enable globally: compiled with a function target
+ * attribute and used when wcn_simd_get_features() reports it */
+#if VI_BYTES == 64 && !defined(__AVX512VNNI__) &&                            \
+    defined(WCN_SIMD_HAVE_AVX512VNNI)
+#define VI_VNNI_TARGET __attribute__((target("avx512vnni")))
+#define VI_HAS_VNNI() (wcn_simd_get_features()->has_avx512vnni)
+VI_VNNI_TARGET static inline vi_t vi_dot_u8i8_vnni(vi_t acc, vi_t a,
+                                                   vi_t b) {
+  acc.raw = _mm512_dpbusd_epi32(acc.raw, a.raw, b.raw);
+  return acc;
+}
+#elif VI_BYTES == 32 && !defined(__AVXVNNI__) && defined(WCN_SIMD_HAVE_AVXVNNI)
+#define VI_VNNI_TARGET __attribute__((target("avxvnni")))
+#define VI_HAS_VNNI() (wcn_simd_get_features()->has_avxvnni)
+VI_VNNI_TARGET static inline vi_t vi_dot_u8i8_vnni(vi_t acc, vi_t a,
+                                                   vi_t b) {
+  acc.raw = _mm256_dpbusd_avx_epi32(acc.raw, a.raw, b.raw);
+  return acc;
+}
+#endif
+
+/* The dot product and a GEMV that shares each x vector between four rows of
+ * w. i32 accumulators are folded into i64 every VI_DOT_U8I8_BLOCK vectors;
+ * leftover columns go through the scalar loop. */
+#define WCN_DEFINE_DOT_U8I8(sfx, attr, vdot)                                  \
+  attr static int64_t dot_u8i8_i32##sfx(const uint8_t *a, const int8_t *b,    \
+                                        size_t count) {                       \
+    const size_t w = VI_BYTES;                                                \
+    vi_t wide = VI(setzero)();                                                \
+    size_t i = 0;                                                             \
+    while (i + w <= count) {                                                  \
+      const size_t n = (count - i) / w;                                       \
+      const size_t end =                                                      \
+          i + (n < VI_DOT_U8I8_BLOCK ? n : VI_DOT_U8I8_BLOCK) * w;            \
+      vi_t acc0 = VI(setzero)();                                              \
+      vi_t acc1 = acc0;                                                       \
+      for (; i + 2 * w <= end; i += 2 * w) {                                  \
+        acc0 = vdot(acc0, VI(load)(a + i), VI(load)(b + i));                  \
+        acc1 = vdot(acc1, VI(load)(a + i + w), VI(load)(b + i + w));          \
+      }                                                                       \
+      if (i < end) {                                                          \
+        acc0 = vdot(acc0, VI(load)(a + i), VI(load)(b + i));                  \
+        i += w;                                                               \
+      }                                                                       \
+      wide = vi_acc_i32_i64(wide, acc0);                                      \
+      wide = vi_acc_i32_i64(wide, acc1);                                      \
+    }                                                                         \
+    int64_t sum = vi_hsum_i64(wide);                                          \
+    for (; i < count; ++i) {                                                  \
+      sum += (int32_t)a[i] * b[i];                                            \
+    }                                                                         \
+    return sum;                                                               \
+  }                                                                           \
+                                                                              \
+  attr static void gemv_u8i8_i32##sfx(const int8_t *w, const uint8_t *x,      \
+                                      int32_t *y, size_t rows, size_t cols) { \
+    const size_t vw = VI_BYTES;                                               \
+    const size_t body = cols - cols % vw;                                     \
+    const size_t block = VI_DOT_U8I8_BLOCK * vw;                              \
+    size_t r = 0;                                                             \
+    for (; r + 4 <= rows; r += 4) {                                           \
+      const int8_t *w0 = w + r * cols;                                        \
+      const int8_t *w1 = w0 + cols;                                           \
+      const int8_t *w2 = w1 + cols;                                           \
+      const int8_t *w3 = w2 + cols;                                           \
+      vi_t s0 = VI(setzero)();                                                \
+      vi_t s1 = s0, s2 = s0, s3 = s0;                                         \
+      for (size_t c0 = 0; c0 < body; c0 += block) {                           \
+        const size_t end = body - c0 < block ? body : c0 + block;             \
+        vi_t acc0 = VI(setzero)();                                            \
+        vi_t acc1 = acc0, acc2 = acc0, acc3 = acc0;                           \
+        for (size_t c = c0; c < end; c += vw) {                               \
+          const vi_t xv = VI(load)(x + c);                                    \
+          acc0 = vdot(acc0, xv, VI(load)(w0 + c));                            \
+          acc1 = vdot(acc1, xv, VI(load)(w1 + c));                            \
+          acc2 = vdot(acc2, xv, VI(load)(w2 + c));                            \
+          acc3 = vdot(acc3, xv, VI(load)(w3 + c));                            \
+        }                                                                     \
+        s0 = vi_acc_i32_i64(s0, acc0);                                        \
+        s1 = vi_acc_i32_i64(s1, acc1);                                        \
+        s2 = vi_acc_i32_i64(s2, acc2);                                        \
+        s3 = vi_acc_i32_i64(s3, acc3);                                        \
+      }                                                                       \
+      int64_t t0 = vi_hsum_i64(s0), t1 = vi_hsum_i64(s1);                     \
+      int64_t t2 = vi_hsum_i64(s2), t3 = vi_hsum_i64(s3);                     \
+      for (size_t c = body; c < cols; ++c) {                                  \
+        t0 += (int32_t)x[c] * w0[c];                                          \
+        t1 += (int32_t)x[c] * w1[c];                                          \
+        t2 += (int32_t)x[c] * w2[c];                                          \
+        t3 += (int32_t)x[c] * w3[c];                                          \
+      }                                                                       \
+      y[r] = sat_i32(t0);                                                     \
+      y[r + 1] = sat_i32(t1);                                                 \
+      y[r + 2] = sat_i32(t2);                                                 \
+      y[r + 3] = sat_i32(t3);                                                 \
+    }                                                                         \
+    for (; r < rows; ++r) {                                                   \
+      y[r] = sat_i32(dot_u8i8_i32##sfx(x, w + r * cols, cols));               \
+    }                                                                         \
+  }
+
+WCN_DEFINE_DOT_U8I8(_vi, , vi_dot_u8i8)
+#if defined(VI_VNNI_TARGET)
+WCN_DEFINE_DOT_U8I8(_vnni, VI_VNNI_TARGET, vi_dot_u8i8_vnni)
+#endif
+
+static int64_t dot_u8i8_i32(const uint8_t *a, const int8_t *b, size_t count) {
+#if defined(VI_VNNI_TARGET)
+  if (VI_HAS_VNNI()) {
+    return dot_u8i8_i32_vnni(a, b, count);
+  }
+#endif
+  return dot_u8i8_i32_vi(a, b, count);
+}
+
+static void gemv_u8i8_i32(const int8_t *w, const uint8_t *x, int32_t *y,
+                          size_t rows, size_t cols) {
+#if defined(VI_VNNI_TARGET)
+  if (VI_HAS_VNNI()) {
+    gemv_u8i8_i32_vnni(w, x, y, rows, cols);
+    return;
+  }
+#endif
+  gemv_u8i8_i32_vi(w, x, y, rows, cols);
+}
+
+#undef WCN_DEFINE_DOT_U8I8
+#undef VI_VNNI_TARGET
+#undef VI_HAS_VNNI
+#else
+
+static int64_t dot_u8i8_i32(const uint8_t *a, const int8_t *b, size_t count) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < count; ++i) {
+    sum += (int32_t)a[i] * b[i];
+  }
+  return sum;
+}
+
+static void gemv_u8i8_i32(const int8_t *w, const uint8_t *x, int32_t *y,
+                          size_t rows, size_t cols) {
+  for (size_t r = 0; r < rows; ++r) {
+    y[r] = sat_i32(dot_u8i8_i32(x, w + r * cols, cols));
+  }
+}
+#endif /* VI_DOT_U8I8 */
@@ -0,0 +1,334 @@
+/*
+ * WCN_SIMD vector math array kernel.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * The element functions are the raw kernels wcn_math.h instantiates;
+ * MV(op) names the widest flavour the TU has. Targets without one
+ * instantiate wcn_math_impl.h on plain floats here. The kernels need IEEE
+ * arithmetic for their error terms, so this file is compiled with
+ * fast-math optimizations off even in -ffast-math builds of the library.
+ * It also calls nothing compiled with them (such as wcn_v128f_load()):
+ * GCC can carry an inlined callee's fast-math flags over to the caller.
+ * A partial vector at the end goes through the same code on a padded
+ * copy, so every element gets the same result wherever it is in the array.
+ * The softmax kernels build on the same vectors.
+ */
+
+#include <string.h>
+
+WCN_MATH_PRECISE_BEGIN
+
+/* ========== Math Vector Selection ========== */
+
+#if defined(WCN_X86_AVX512F)
+#define MV_LANES 16
+#define MV(op) wcn_math_v512f_##op
+typedef __m512 mv_t;
+#elif defined(WCN_X86_AVX2)
+#define MV_LANES 8
+#define MV(op) wcn_math_v256f_##op
+typedef __m256 mv_t;
+#elif defined(WCN_X86_SSE2)
+#define MV_LANES 4
+#define MV(op) wcn_math_v128f_##op
+typedef __m128 mv_t;
+#elif defined(WCN_ARM_NEON) && defined(WCN_ARM_AARCH64)
+#define MV_LANES 4
+#define MV(op) wcn_math_v128f_##op
+typedef float32x4_t mv_t;
+#else
+#define MV_LANES 1
+#define MV(op) math_scalar_##op
+typedef float mv_t;
+
+static inline int32_t math_scalar_asi(float f) {
+  int32_t i;
+  memcpy(&i, &f, sizeof(i));
+  return i;
+}
+
+static inline float math_scalar_asf(int32_t i) {
+  float f;
+  memcpy(&f, &i, sizeof(f));
+  return f;
+}
+
+/* Out-of-range inputs give INT32_MIN, as cvtps2dq does */
+static inline int32_t math_scalar_cvtf(float f) {
+  return f >= -2147483648.0f && f < 2147483648.0f ? (int32_t)f : INT32_MIN;
+}
+
+#define WCN_M_F float
+#define WCN_M_I int32_t
+#define WCN_M_K int
+#define WCN_M_FN(name) math_scalar_##name
+#define WCN_M_LANES 1
+#if defined(FP_FAST_FMAF)
+#define WCN_M_FUSED 1
+#define WCN_M_FMA(a, b, c) fmaf(a, b, c)
+#else
+#define WCN_M_FUSED 0
+#define WCN_M_FMA(a, b, c) ((a) * (b) + (c))
+#endif
+#define WCN_M_SET1(c) (c)
+#define WCN_M_ADD(a, b) ((a) + (b))
+#define WCN_M_SUB(a, b) ((a) - (b))
+#define WCN_M_MUL(a, b) ((a) * (b))
+#define WCN_M_DIV(a, b) ((a) / (b))
+#define WCN_M_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define WCN_M_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define WCN_M_LOAD(p) (*(p))
+#define WCN_M_STORE(p, v) (*(p) = (v))
+/* Wrapping int32 arithmetic through uint32_t */
+#define WCN_M_ISET1(c) ((int32_t)(c))
+#define WCN_M_IADD(a, b) ((int32_t)((uint32_t)(a) + (uint32_t)(b)))
+#define WCN_M_ISUB(a, b) ((int32_t)((uint32_t)(a) - (uint32_t)(b)))
+#define WCN_M_IAND(a, b) ((a) & (b))
+#define WCN_M_IXOR(a, b) ((a) ^ (b))
+#define WCN_M_ISLL(a, n) ((int32_t)((uint32_t)(a) << (n)))
+#define WCN_M_ISRA(a, n) ((a) >> (n))
+#define WCN_M_ASI(f) math_scalar_asi(f)
+#define WCN_M_ASF(i) math_scalar_asf(i)
+#define WCN_M_CVTI(i) ((float)(i))
+#define WCN_M_CVTF(f) math_scalar_cvtf(f)
+#define WCN_M_LT(a, b) ((a) < (b))
+#define WCN_M_LE(a, b) ((a) <= (b))
+#define WCN_M_EQ(a, b) ((a) == (b))
+#define WCN_M_UNORD(a, b) ((a) != (a) || (b) != (b))
+#define WCN_M_ITEST(i, m) (((i) & (m)) != 0)
+#define WCN_M_KAND(a, b) ((a) && (b))
+#define WCN_M_KOR(a, b) ((a) || (b))
+#define WCN_M_KANDNOT(a, b) ((a) && !(b))
+#define WCN_M_SEL(k, a, b) ((k) ? (a) : (b))
+#define WCN_M_ANY(k) (k)
+#include "wcn_simd/wcn_math_impl.h"
+#endif
+
+/* ========== Array Kernel ========== */
+
+#define MATH_LOOP(body)                                                        \
+  for (size_t i = 0; i < n; i += MV_LANES) {                                   \
+    body;                                                                      \
+  }
+
+#define MATH_UNARY(fn, f)                                                      \
+  case fn:                                                                     \
+    if (fast) {                                                                \
+      MATH_LOOP(MV(store)(y + i, MV(f##_fast)(MV(load)(a + i))))               \
+    } else {                                                                   \
+      MATH_LOOP(MV(store)(y + i, MV(f)(MV(load)(a + i))))                      \
+    }                                                                          \
+    break;
+
+#define MATH_BINARY(fn, f)                                                     \
+  case fn:                                                                     \
+    if (fast) {                                                                \
+      MATH_LOOP(MV(store)(y + i,                                               \
+                          MV(f##_fast)(MV(load)(a + i), MV(load)(b + i))))     \
+    } else {                                                                   \
+      MATH_LOOP(                                                               \
+          MV(store)(y + i, MV(f)(MV(load)(a + i), MV(load)(b + i))))           \
+    }                                                                          \
+    break;
+
+#define MATH_SINCOS(f)                                                         \
+  do {                                                                         \
+    mv_t vs, vc;                                                               \
+    MV(f)(MV(load)(a + i), &vs, &vc);                                          \
+    MV(store)(y + i, vs);                                                      \
+    MV(store)(c + i, vc);                                                      \
+  } while (0)
+
+/* Run fn over n elements, a multiple of MV_LANES */
+static void math_run(wcn_math_fn_t fn, int fast, const float *a,
+                     const float *b, float *y, float *c, size_t n) {
+  switch (fn) {
+    MATH_UNARY(WCN_MATH_FN_EXP, exp)
+    MATH_UNARY(WCN_MATH_FN_EXP2, exp2)
+    MATH_UNARY(WCN_MATH_FN_LOG, log)
+    MATH_UNARY(WCN_MATH_FN_LOG2, log2)
+    MATH_UNARY(WCN_MATH_FN_LOG1P, log1p)
+    MATH_UNARY(WCN_MATH_FN_SIN, sin)
+    MATH_UNARY(WCN_MATH_FN_COS, cos)
+    MATH_UNARY(WCN_MATH_FN_TAN, tan)
+    MATH_UNARY(WCN_MATH_FN_TANH, tanh)
+    MATH_UNARY(WCN_MATH_FN_ERF, erf)
+    MATH_BINARY(WCN_MATH_FN_ATAN2, atan2)
+    MATH_BINARY(WCN_MATH_FN_POW, pow)
+  case WCN_MATH_FN_SINCOS:
+    if (fast) {
+      MATH_LOOP(MATH_SINCOS(sincos_fast))
+    } else {
+      MATH_LOOP(MATH_SINCOS(sincos))
+    }
+    break;
+  }
+}
+
+static void math_f32(wcn_math_fn_t fn, wcn_math_mode_t mode,
+                     const float *a, const float *b, float *y, float *c,
+                     size_t count) {
+  const int fast = mode == WCN_MATH_FAST;
+  const size_t body = count - count % MV_LANES;
+  math_run(fn, fast, a, b, y, c, body);
+
+  if (body < count) {
+    /* Pad with 1, which is inside every function's fast domain */
+    const size_t rest = count - body;
+    float ta[MV_LANES], tb[MV_LANES], ty[MV_LANES], tc[MV_LANES];
+    for (size_t i = 0; i < MV_LANES; ++i) {
+      ta[i] = i < rest ? a[body + i] : 1.0f;
+      tb[i] = i < rest && b != NULL ? b[body + i] : 1.0f;
+    }
+    math_run(fn, fast, ta, tb, ty, tc, MV_LANES);
+    memcpy(y + body, ty, rest * sizeof(float));
+    if (c != NULL) {
+      memcpy(c + body, tc, rest * sizeof(float));
+    }
+  }
+}
+
+/* ========== Softmax ========== */
+
+/* Elements per online step: the block maximum is found first and the
+ * exponentials are summed while the block is still in L1, so the input is
+ * read from memory once and exp runs once per element. Block sums are
+ * added in double; short blocks keep the float lane sums accurate. */
+#define SOFTMAX_BLOCK 256
+
+/* The vector loop of reduce_max_f32, on the math vectors */
+static float softmax_max(const float *a, size_t n) {
+  mv_t m = MV(set1)(-INFINITY);
+  size_t i = 0;
+  for (; i + MV_LANES <= n; i += MV_LANES) {
+    m = MV(max)(m, MV(load)(a + i));
+  }
+  float t[MV_LANES];
+  MV(store)(t, m);
+  float r = t[0];
+  for (size_t j = 1; j < MV_LANES; ++j) {
+    r = t[j] > r ? t[j] : r;
+  }
+  for (; i < n; ++i) {
+    r = a[i] > r ? a[i] : r;
+  }
+  return r;
+}
+
+/* Sum of exp(a[i] - shift); the last partial vector is padded with -inf */
+static double softmax_expsum(const float *a, float shift, size_t n) {
+  const mv_t vshift = MV(set1)(shift);
+  mv_t s = MV(set1)(0.0f);
+  size_t i = 0;
+  for (; i + MV_LANES <= n; i += MV_LANES) {
+    s = MV(add)(s, MV(exp)(MV(sub)(MV(load)(a + i), vshift)));
+  }
+  float t[MV_LANES];
+  if (i < n) {
+    for (size_t j = 0; j < MV_LANES; ++j) {
+      t[j] = i + j < n ? a[i + j] : -INFINITY;
+    }
+    s = MV(add)(s, MV(exp)(MV(sub)(MV(load)(t), vshift)));
+  }
+  MV(store)(t, s);
+  double r = 0.0;
+  for (size_t j = 0; j < MV_LANES; ++j) {
+    r += t[j];
+  }
+  return r;
+}
+
+/* Online maximum and sum of exp(a[i] - max): each block rescales the sum
+ * of the previous ones when it raises the maximum. A NaN maximum is kept,
+ * and blocks are only checked for NaN while everything so far is -inf. */
+static void softmax_stats_f32(const float *a, size_t count, float *max,
+                              double *sum) {
+  float m = -INFINITY;
+  double s = 0.0;
+  for (size_t i = 0; i < count; i += SOFTMAX_BLOCK) {
+    const size_t n = count - i < SOFTMAX_BLOCK ? count - i : SOFTMAX_BLOCK;
+    const float bm = softmax_max(a + i, n);
+    if (!(bm <= m)) {
+      s *= exp((double)m - (double)bm);
+      m = bm;
+    }
+    if (m > -INFINITY) {
+      s += softmax_expsum(a + i, m, n);
+    } else {
+      /* Nothing but -inf so far, unless the maximum passed over a NaN */
+      for (size_t j = 0; j < n; ++j) {
+        if (a[i + j] != a[i + j]) {
+          s = NAN;
+        }
+      }
+    }
+  }
+  *max = m;
+  *sum = s;
+}
+
+/* exp(x - shift) * scale, with the rounding error of x - shift (up to half
+ * an ulp of the difference, which would be tens of ulp in the result for a
+ * wide range of inputs) recovered exactly and applied as a first-order
+ * correction. x is first raised to a floor at least 128 below shift, whose
+ * exp is already 0, so that the difference stays finite. */
+static inline mv_t exp_scale_step(mv_t x, mv_t vshift, mv_t vfloor,
+                                  mv_t vscale) {
+  x = MV(max)(x, vfloor);
+  const mv_t r = MV(sub)(x, vshift);
+  const mv_t b = MV(sub)(r, x);
+  const mv_t err =
+      MV(sub)(MV(sub)(x, MV(sub)(r, b)), MV(add)(vshift, b));
+  const mv_t e = MV(mul)(MV(exp)(r), vscale);
+  return MV(add)(e, MV(mul)(e, err));
+}
+
+/* y[i] = exp(a[i] - shift) * scale */
+static void exp_scale_f32(const float *a, float shift, float scale, float *y,
+                          size_t count) {
+  const mv_t vshift = MV(set1)(shift);
+  const mv_t vfloor = MV(set1)(shift - 128.0f - fabsf(shift));
+  const mv_t vscale = MV(set1)(scale);
+  size_t i = 0;
+  for (; i + MV_LANES <= count; i += MV_LANES) {
+    MV(store)(y + i,
+              exp_scale_step(MV(load)(a + i), vshift, vfloor, vscale));
+  }
+  if (i < count) {
+    float t[MV_LANES];
+    const size_t rest = count - i;
+    memcpy(t, a + i, rest * sizeof(float));
+    memset(t + rest, 0, (MV_LANES - rest) * sizeof(float));
+    MV(store)(t, exp_scale_step(MV(load)(t), vshift, vfloor, vscale));
+    memcpy(y + i, t, rest * sizeof(float));
+  }
+}
+
+/* Softmax of each row into y and/or its log-sum-exp into lse (either may
+ * be NULL) */
+static void softmax_rows_f32(const float *a, float *y, float *lse,
+                             size_t rows, size_t cols) {
+  for (size_t r = 0; r < rows; ++r) {
+    float m;
+    double s;
+    softmax_stats_f32(a + r * cols, cols, &m, &s);
+    if (lse != NULL) {
+      lse[r] = (float)((double)m + log(s));
+    }
+    if (y != NULL) {
+      exp_scale_f32(a + r * cols, m, (float)(1.0 / s), y + r * cols, cols);
+    }
+  }
+}
+
+#undef SOFTMAX_BLOCK
+#undef MATH_LOOP
+#undef MATH_UNARY
+#undef MATH_BINARY
+#undef MATH_SINCOS
+#undef MV
+#undef MV_LANES
+
+WCN_MATH_PRECISE_END
@@ -0,0 +1,267 @@
+/*
+ * WCN_SIMD memory copy / fill kernels.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason. Reuses the
+ * VI(op) integer vector selection of wcn_kernels_int_impl.h.
+ *
+ * Size classes:
+ *   - up to two vectors: a pair of overlapping loads/stores of the largest
+ *     width that fits (vector, then 32/16 bytes, then 8/4/2/1 scalars), so
+ *     every size is handled without a loop or a byte tail;
+ *   - larger: one unaligned head vector, a 4x unrolled loop of aligned
+ *     stores, and one overlapping unaligned tail vector;
+ *   - with stream set (the caller decides, from the size relative to the
+ *     last-level cache): the same loop with non-temporal stores and an
+ *     sfence, like add_array_f32's use_nt path. Only x86 has such stores;
+ *     elsewhere the flag is ignored.
+ * Targets without an integer vector type use the C library.
+ */
+
+#include <string.h>
+
+#if defined(VI_BYTES)
+
+#if defined(WCN_X86_SSE2)
+#define MEM_HAS_STREAM 1
+static inline void mem_stream(void *p, vi_t v) {
+#if VI_BYTES == 64
+  _mm512_stream_si512(p, v.raw);
+#elif VI_BYTES == 32
+  _mm256_stream_si256((__m256i *)p, v.raw);
+#else
+  _mm_stream_si128((__m128i *)p, v.raw);
+#endif
+}
+#endif
+
+/* ========== Copy ========== */
+
+/* n <= 2 * VI_BYTES */
+static inline void mem_copy_small(unsigned char *d, const unsigned char *s,
+                                  size_t n) {
+  if (n >= VI_BYTES) {
+    const vi_t a = VI(load)(s);
+    const vi_t b = VI(load)(s + n - VI_BYTES);
+    VI(store)(d, a);
+    VI(store)(d + n - VI_BYTES, b);
+    return;
+  }
+#if VI_BYTES > 32
+  if (n >= 32) {
+    const wcn_v256i_t a = wcn_v256i_load(s);
+    const wcn_v256i_t b = wcn_v256i_load(s + n - 32);
+    wcn_v256i_store(d, a);
+    wcn_v256i_store(d + n - 32, b);
+    return;
+  }
+#endif
+#if VI_BYTES > 16
+  if (n >= 16) {
+    const wcn_v128i_t a = wcn_v128i_load(s);
+    const wcn_v128i_t b = wcn_v128i_load(s + n - 16);
+    wcn_v128i_store(d, a);
+    wcn_v128i_store(d + n - 16, b);
+    return;
+  }
+#endif
+  if (n >= 8) {
+    uint64_t a, b;
+    memcpy(&a, s, 8);
+    memcpy(&b, s + n - 8, 8);
+    memcpy(d, &a, 8);
+    memcpy(d + n - 8, &b, 8);
+  } else if (n >= 4) {
+    uint32_t a, b;
+    memcpy(&a, s, 4);
+    memcpy(&b, s + n - 4, 4);
+    memcpy(d, &a, 4);
+    memcpy(d + n - 4, &b, 4);
+  } else if (n >= 2) {
+    uint16_t a, b;
+    memcpy(&a, s, 2);
+    memcpy(&b, s + n - 2, 2);
+    memcpy(d, &a, 2);
+    memcpy(d + n - 2, &b, 2);
+  } else if (n == 1) {
+    *d = *s;
+  }
+}
+
+static void memcpy_bytes(void *WCN_RESTRICT dst, const void *WCN_RESTRICT src,
+                         size_t n, int stream) {
+  unsigned char *d = (unsigned char *)dst;
+  const unsigned char *s = (const unsigned char *)src;
+  if (n <= 2 * VI_BYTES) {
+    mem_copy_small(d, s, n);
+    return;
+  }
+
+  /* Head and tail are unaligned vectors; the body starts at the first
+   * aligned destination address after the head */
+  unsigned char *const d_end = d + n;
+  const vi_t tail = VI(load)(s + n - VI_BYTES);
+  VI(store)(d, VI(load)(s));
+  const size_t skew = VI_BYTES - ((uintptr_t)d & (VI_BYTES - 1));
+  d += skew;
+  s += skew;
+  n -= skew;
+
+#if defined(MEM_HAS_STREAM)
+  if (stream) {
+    WCN_STATS_ADD(WCN_STATS_MEMCPY, stream_runs);
+    for (; n >= 4 * VI_BYTES; n -= 4 * VI_BYTES) {
+      const vi_t v0 = VI(load)(s);
+      const vi_t v1 = VI(load)(s + VI_BYTES);
+      const vi_t v2 = VI(load)(s + 2 * VI_BYTES);
+      const vi_t v3 = VI(load)(s + 3 * VI_BYTES);
+      mem_stream(d, v0);
+      mem_stream(d + VI_BYTES, v1);
+      mem_stream(d + 2 * VI_BYTES, v2);
+      mem_stream(d + 3 * VI_BYTES, v3);
+      s += 4 * VI_BYTES;
+      d += 4 * VI_BYTES;
+    }
+    for (; n > VI_BYTES; n -= VI_BYTES) {
+      mem_stream(d, VI(load)(s));
+      s += VI_BYTES;
+      d += VI_BYTES;
+    }
+    _mm_sfence();
+    VI(store)(d_end - VI_BYTES, tail);
+    return;
+  }
+#else
+  (void)stream;
+#endif
+
+  for (; n >= 4 * VI_BYTES; n -= 4 * VI_BYTES) {
+    const vi_t v0 = VI(load)(s);
+    const vi_t v1 = VI(load)(s + VI_BYTES);
+    const vi_t v2 = VI(load)(s + 2 * VI_BYTES);
+    const vi_t v3 = VI(load)(s + 3 * VI_BYTES);
+    VI(store_aligned)(d, v0);
+    VI(store_aligned)(d + VI_BYTES, v1);
+    VI(store_aligned)(d + 2 * VI_BYTES, v2);
+    VI(store_aligned)(d + 3 * VI_BYTES, v3);
+    s += 4 * VI_BYTES;
+    d += 4 * VI_BYTES;
+  }
+  for (; n > VI_BYTES; n -= VI_BYTES) {
+    VI(store_aligned)(d, VI(load)(s));
+    s += VI_BYTES;
+    d += VI_BYTES;
+  }
+  VI(store)(d_end - VI_BYTES, tail);
+}
+
+/* ========== Fill ========== */
+
+/* n <= 2 * VI_BYTES */
+static inline void mem_fill_small(unsigned char *d, vi_t v, uint8_t byte,
+                                  size_t n) {
+  if (n >= VI_BYTES) {
+    VI(store)(d, v);
+    VI(store)(d + n - VI_BYTES, v);
+    return;
+  }
+#if VI_BYTES > 32
+  if (n >= 32) {
+    const wcn_v256i_t h = wcn_v256i_set1_i8((int8_t)byte);
+    wcn_v256i_store(d, h);
+    wcn_v256i_store(d + n - 32, h);
+    return;
+  }
+#endif
+#if VI_BYTES > 16
+  if (n >= 16) {
+    const wcn_v128i_t h = wcn_v128i_set1_i8((int8_t)byte);
+    wcn_v128i_store(d, h);
+    wcn_v128i_store(d + n - 16, h);
+    return;
+  }
+#endif
+  const uint64_t x = byte * UINT64_C(0x0101010101010101);
+  if (n >= 8) {
+    memcpy(d, &x, 8);
+    memcpy(d + n - 8, &x, 8);
+  } else if (n >= 4) {
+    const uint32_t y = (uint32_t)x;
+    memcpy(d, &y, 4);
+    memcpy(d + n - 4, &y, 4);
+  } else if (n >= 2) {
+    const uint16_t y = (uint16_t)x;
+    memcpy(d, &y, 2);
+    memcpy(d + n - 2, &y, 2);
+  } else if (n == 1) {
+    *d = byte;
+  }
+}
+
+static void memset_bytes(void *dst, int value, size_t n, int stream) {
+  unsigned char *d = (unsigned char *)dst;
+  const uint8_t byte = (uint8_t)value;
+  const vi_t v = VI(set1_i8)((int8_t)byte);
+  if (n <= 2 * VI_BYTES) {
+    mem_fill_small(d, v, byte, n);
+    return;
+  }
+
+  unsigned char *const d_end = d + n;
+  VI(store)(d, v);
+  const size_t skew = VI_BYTES - ((uintptr_t)d & (VI_BYTES - 1));
+  d += skew;
+  n -= skew;
+
+#if defined(MEM_HAS_STREAM)
+  if (stream) {
+    WCN_STATS_ADD(WCN_STATS_MEMSET, stream_runs);
+    for (; n >= 4 * VI_BYTES; n -= 4 * VI_BYTES) {
+      mem_stream(d, v);
+      mem_stream(d + VI_BYTES, v);
+      mem_stream(d + 2 * VI_BYTES, v);
+      mem_stream(d + 3 * VI_BYTES, v);
+      d += 4 * VI_BYTES;
+    }
+    for (; n > VI_BYTES; n -= VI_BYTES) {
+      mem_stream(d, v);
+      d += VI_BYTES;
+    }
+    _mm_sfence();
+    VI(store)(d_end - VI_BYTES, v);
+    return;
+  }
+#else
+  (void)stream;
+#endif
+
+  for (; n >= 4 * VI_BYTES; n -= 4 * VI_BYTES) {
+    VI(store_aligned)(d, v);
+    VI(store_aligned)(d + VI_BYTES, v);
+    VI(store_aligned)(d + 2 * VI_BYTES, v);
+    VI(store_aligned)(d + 3 * VI_BYTES, v);
+    d += 4 * VI_BYTES;
+  }
+  for (; n > VI_BYTES; n -= VI_BYTES) {
+    VI(store_aligned)(d, v);
+    d += VI_BYTES;
+  }
+  VI(store)(d_end - VI_BYTES, v);
+}
+
+#undef MEM_HAS_STREAM
+
+#else /* !VI_BYTES */
+
+static void memcpy_bytes(void *WCN_RESTRICT dst, const void *WCN_RESTRICT src,
+                         size_t n, int stream) {
+  (void)stream;
+  memcpy(dst, src, n);
+}
+
+static void memset_bytes(void *dst, int value, size_t n, int stream) {
+  (void)stream;
+  memset(dst, value, n);
+}
+
+#endif /* VI_BYTES */
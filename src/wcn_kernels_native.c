@@ -0,0 +1,8 @@
+/*
+ * Array kernels built with the library's own target flags. Used on every
+ * architecture without runtime dispatch (ARM, LoongArch, RISC-V, PowerPC,
+ * MIPS, WebAssembly) and on x86 when WCN_SIMD_ENABLE_DISPATCH is off.
+ */
+
+#define WCN_KERNEL_TABLE wcn_kernels_native
+#include "wcn_kernels_impl.h"
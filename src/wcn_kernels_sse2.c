@@ -0,0 +1,11 @@
+/*
+ * x86 baseline array kernels (SSE2). Always present in dispatch builds and
+ * selected when the host has neither AVX2+FMA nor AVX-512.
+ */
+
+#define WCN_KERNEL_TABLE wcn_kernels_sse2
+#include "wcn_kernels_impl.h"
+
+#if !defined(WCN_X86_SSE2)
+#error "wcn_kernels_sse2.c must be compiled with SSE2 enabled"
+#endif
@@ -0,0 +1,256 @@
+/*
+ * WCN_SIMD matrix transpose kernels.
+ *
+ * Included by wcn_kernels_impl.h (and therefore compiled once per kernel
+ * TU / ISA level); not include-guarded for the same reason.
+ *
+ * Cache-oblivious blocking: the matrix is halved along its longer side, at
+ * a multiple of the register tile, until the source block fits in
+ * TR_LEAF_BYTES, so that it and the destination block it maps to stay in
+ * L1 whatever the dimensions and strides. A leaf walks its register tiles
+ * column of tiles by column of tiles, source rows innermost: every
+ * destination row is then written left to right, and the source lines a
+ * tile leaves half-read are still cached when the next column of tiles
+ * comes back to them. Rows and columns past the last whole tile are moved
+ * one element at a time.
+ *
+ * Register tiles (wcn_transpose.h): 16 x 16 floats on AVX-512, 8 x 8 on
+ * AVX, 4 x 4 on 128-bit targets; 8 x 8 u16 and 16 x 16 u8 on every 128-bit
+ * target. Targets without vectors use 1 x 1 "tiles".
+ *
+ * With stream set (the caller decides, from the output size) x86 writes
+ * whole tile rows with non-temporal stores when the destination and its
+ * row stride are tile-row aligned. The u8 tile is left out: its sixteen
+ * destination rows per tile are more concurrent lines than the CPU has
+ * write-combining buffers.
+ */
+
+/* Source bytes per leaf block (a quarter to a third of L1 with the
+ * destination block) */
+#define TR_LEAF_BYTES 8192
+
+/* ========== Register Tiles ========== */
+
+/* tr_tile_<T>: the TILE x TILE block at s (row stride lds) to d (row stride
+ * ldd), transposed; TR_<T>_STREAM when stream is honoured */
+
+#if defined(WCN_X86_AVX512F)
+#define TR_F32_TILE 16
+#define TR_F32_STREAM 1
+static inline void tr_tile_f32(const float *s, size_t lds, float *d,
+                               size_t ldd, int stream) {
+  wcn_v512f_t r[16];
+  for (int i = 0; i < 16; ++i) {
+    r[i] = wcn_v512f_load(s + i * lds);
+  }
+  wcn_v512f_transpose16x16(r);
+  for (int i = 0; i < 16; ++i) {
+    if (stream) {
+      _mm512_stream_ps(d + i * ldd, r[i].raw);
+    } else {
+      wcn_v512f_store(d + i * ldd, r[i]);
+    }
+  }
+}
+#elif defined(WCN_X86_AVX)
+#define TR_F32_TILE 8
+#define TR_F32_STREAM 1
+static inline void tr_tile_f32(const float *s, size_t lds, float *d,
+                               size_t ldd, int stream) {
+  wcn_v256f_t r[8];
+  for (int i = 0; i < 8; ++i) {
+    r[i] = wcn_v256f_load(s + i * lds);
+  }
+  wcn_v256f_transpose8x8(r);
+  for (int i = 0; i < 8; ++i) {
+    if (stream) {
+      _mm256_stream_ps(d + i * ldd, r[i].raw);
+    } else {
+      wcn_v256f_store(d + i * ldd, r[i]);
+    }
+  }
+}
+#elif defined(VI_BYTES)
+#define TR_F32_TILE 4
+#if defined(WCN_X86_SSE2)
+#define TR_F32_STREAM 1
+#endif
+static inline void tr_tile_f32(const float *s, size_t lds, float *d,
+                               size_t ldd, int stream) {
+  wcn_v128f_t r[4];
+  for (int i = 0; i < 4; ++i) {
+    r[i] = wcn_v128f_load(s + i * lds);
+  }
+  wcn_v128f_transpose4x4(r);
+  for (int i = 0; i < 4; ++i) {
+#if defined(WCN_X86_SSE2)
+    if (stream) {
+      _mm_stream_ps(d + i * ldd, r[i].raw);
+      continue;
+    }
+#endif
+    wcn_v128f_store(d + i * ldd, r[i]);
+  }
+  (void)stream;
+}
+#endif
+
+#if defined(VI_BYTES)
+#define TR_U16_TILE 8
+#if defined(WCN_X86_SSE2)
+#define TR_U16_STREAM 1
+#endif
+#define TR_U8_TILE 16
+
+static inline void tr_store_v128i(void *p, wcn_v128i_t v, int stream) {
+#if defined(WCN_X86_SSE2)
+  if (stream) {
+    _mm_stream_si128((__m128i *)p, v.raw);
+    return;
+  }
+#endif
+  wcn_v128i_store(p, v);
+  (void)stream;
+}
+
+static inline void tr_tile_u16(const uint16_t *s, size_t lds, uint16_t *d,
+                               size_t ldd, int stream) {
+  wcn_v128i_t r[8];
+  for (int i = 0; i < 8; ++i) {
+    r[i] = wcn_v128i_load(s + i * lds);
+  }
+  wcn_v128i_transpose8x8_i16(r);
+  for (int i = 0; i < 8; ++i) {
+    tr_store_v128i(d + i * ldd, r[i], stream);
+  }
+}
+
+static inline void tr_tile_u8(const uint8_t *s, size_t lds, uint8_t *d,
+                              size_t ldd, int stream) {
+  wcn_v128i_t r[16];
+  for (int i = 0; i < 16; ++i) {
+    r[i] = wcn_v128i_load(s + i * lds);
+  }
+  wcn_v128i_transpose16x16_i8(r);
+  for (int i = 0; i < 16; ++i) {
+    wcn_v128i_store(d + i * ldd, r[i]);
+  }
+  (void)stream;
+}
+#endif
+
+#if !defined(TR_F32_TILE)
+#define TR_F32_TILE 1
+static inline void tr_tile_f32(const float *s, size_t lds, float *d,
+                               size_t ldd, int stream) {
+  (void)lds, (void)ldd, (void)stream;
+  *d = *s;
+}
+#endif
+
+#if !defined(TR_U16_TILE)
+#define TR_U16_TILE 1
+#define TR_U8_TILE 1
+static inline void tr_tile_u16(const uint16_t *s, size_t lds, uint16_t *d,
+                               size_t ldd, int stream) {
+  (void)lds, (void)ldd, (void)stream;
+  *d = *s;
+}
+static inline void tr_tile_u8(const uint8_t *s, size_t lds, uint8_t *d,
+                              size_t ldd, int stream) {
+  (void)lds, (void)ldd, (void)stream;
+  *d = *s;
+}
+#endif
+
+#if !defined(TR_F32_STREAM)
+#define TR_F32_STREAM 0
+#endif
+#if !defined(TR_U16_STREAM)
+#define TR_U16_STREAM 0
+#endif
+#define TR_U8_STREAM 0
+
+/* ========== Blocking ========== */
+
+/* Half of n rounded down to a multiple of tile; only called for n of at
+ * least 2 * tile */
+static inline size_t tr_split(size_t n, size_t tile) {
+  return n / 2 / tile * tile;
+}
+
+/* transpose_<T>(src, lds, dst, ldd, rows, cols, stream): src is rows x cols
+ * with row stride lds, dst cols x rows with row stride ldd */
+#define TR_DEFINE(T, TYPE, TILE, STREAM, STAT)                                 \
+  static void tr_leaf_##T(const TYPE *s, size_t lds, TYPE *d, size_t ldd,      \
+                          size_t rows, size_t cols, int stream) {              \
+    const size_t rt = rows - rows % (TILE);                                    \
+    const size_t ct = cols - cols % (TILE);                                    \
+    for (size_t j = 0; j < ct; j += (TILE)) {                                  \
+      for (size_t i = 0; i < rt; i += (TILE)) {                                \
+        tr_tile_##T(s + i * lds + j, lds, d + j * ldd + i, ldd, stream);       \
+      }                                                                        \
+      for (size_t jj = j; jj < j + (TILE); ++jj) {                             \
+        for (size_t i = rt; i < rows; ++i) {                                   \
+          d[jj * ldd + i] = s[i * lds + jj];                                   \
+        }                                                                      \
+      }                                                                        \
+    }                                                                          \
+    for (size_t j = ct; j < cols; ++j) {                                       \
+      for (size_t i = 0; i < rows; ++i) {                                      \
+        d[j * ldd + i] = s[i * lds + j];                                       \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  static void tr_block_##T(const TYPE *s, size_t lds, TYPE *d, size_t ldd,     \
+                           size_t rows, size_t cols, int stream) {             \
+    while (rows * cols * sizeof(TYPE) > TR_LEAF_BYTES &&                       \
+           (rows >= 2 * (TILE) || cols >= 2 * (TILE))) {                       \
+      if (rows >= cols) {                                                      \
+        const size_t h = tr_split(rows, (TILE));                               \
+        tr_block_##T(s, lds, d, ldd, h, cols, stream);                         \
+        s += h * lds;                                                          \
+        d += h;                                                                \
+        rows -= h;                                                             \
+      } else {                                                                 \
+        const size_t h = tr_split(cols, (TILE));                               \
+        tr_block_##T(s, lds, d, ldd, rows, h, stream);                         \
+        s += h;                                                                \
+        d += h * ldd;                                                          \
+        cols -= h;                                                             \
+      }                                                                        \
+    }                                                                          \
+    tr_leaf_##T(s, lds, d, ldd, rows, cols, stream);                           \
+  }                                                                            \
+                                                                               \
+  static void transpose_##T(const TYPE *src, size_t lds, TYPE *dst,            \
+                            size_t ldd, size_t rows, size_t cols,              \
+                            int stream) {                                      \
+    const size_t row_bytes = (TILE) * sizeof(TYPE);                            \
+    stream = stream && (STREAM) && ((uintptr_t)dst % row_bytes) == 0 &&        \
+             (ldd * sizeof(TYPE)) % row_bytes == 0;                            \
+    if (stream) {                                                              \
+      WCN_STATS_ADD(STAT, stream_runs);                                        \
+    }                                                                          \
+    tr_block_##T(src, lds, dst, ldd, rows, cols, stream);                      \
+    TR_SFENCE(stream);                                                         \
+  }
+
+#if defined(WCN_X86_SSE2)
+#define TR_SFENCE(stream)                                                      \
+  do {                                                                         \
+    if (stream) {                                                              \
+      _mm_sfence();                                                            \
+    }                                                                          \
+  } while (0)
+#else
+#define TR_SFENCE(stream) ((void)0)
+#endif
+
+TR_DEFINE(f32, float, TR_F32_TILE, TR_F32_STREAM, WCN_STATS_TRANSPOSE_F32)
+TR_DEFINE(u16, uint16_t, TR_U16_TILE, TR_U16_STREAM, WCN_STATS_TRANSPOSE_U16)
+TR_DEFINE(u8, uint8_t, TR_U8_TILE, TR_U8_STREAM, WCN_STATS_TRANSPOSE_U8)
+
+#undef TR_DEFINE
+#undef TR_SFENCE
@@ -0,0 +1,159 @@
+/*
+ * WCN_SIMD vector math: array entry points (see wcn_math.h).
+ *
+ * Every function funnels into the math_f32 or softmax_rows_f32 kernel of
+ * the active table (wcn_kernels_math_impl.h), split across the pool like
+ * the other array algorithms.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+
+/* a and y are always used, b by atan2/pow and c by sincos; traffic is the
+ * number of arrays */
+static void math_array(wcn_stats_kernel_t stat, wcn_math_fn_t fn,
+                       wcn_math_mode_t mode, const float *a, const float *b,
+                       float *y, float *c, size_t count) {
+  (void)stat; /* unused without WCN_SIMD_STATS */
+  WCN_STATS_CALL(stat, count, sizeof(float), 2 + (b != NULL) + (c != NULL),
+                 (uintptr_t)a | (uintptr_t)b | (uintptr_t)y | (uintptr_t)c);
+  if (wcn_parallel_should_split(count)) {
+    WCN_STATS_ADD(stat, parallel_calls);
+    wcn_parallel_math(fn, mode, a, b, y, c, count);
+    return;
+  }
+  wcn_simd_active_kernels()->math_f32(fn, mode, a, b, y, c, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_exp_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_EXP_ARRAY_F32, WCN_MATH_FN_EXP, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_exp2_array_f32(const float *x, float *y, size_t count,
+                             wcn_math_mode_t mode) {
+  math_array(WCN_STATS_EXP2_ARRAY_F32, WCN_MATH_FN_EXP2, mode, x, NULL, y,
+             NULL, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_log_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_LOG_ARRAY_F32, WCN_MATH_FN_LOG, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_log2_array_f32(const float *x, float *y, size_t count,
+                             wcn_math_mode_t mode) {
+  math_array(WCN_STATS_LOG2_ARRAY_F32, WCN_MATH_FN_LOG2, mode, x, NULL, y,
+             NULL, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_log1p_array_f32(const float *x, float *y, size_t count,
+                              wcn_math_mode_t mode) {
+  math_array(WCN_STATS_LOG1P_ARRAY_F32, WCN_MATH_FN_LOG1P, mode, x, NULL, y,
+             NULL, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_sin_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_SIN_ARRAY_F32, WCN_MATH_FN_SIN, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_cos_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_COS_ARRAY_F32, WCN_MATH_FN_COS, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_sincos_array_f32(const float *x, float *s, float *c,
+                               size_t count, wcn_math_mode_t mode) {
+  math_array(WCN_STATS_SINCOS_ARRAY_F32, WCN_MATH_FN_SINCOS, mode, x, NULL, s,
+             c, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_tan_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_TAN_ARRAY_F32, WCN_MATH_FN_TAN, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_tanh_array_f32(const float *x, float *y, size_t count,
+                             wcn_math_mode_t mode) {
+  math_array(WCN_STATS_TANH_ARRAY_F32, WCN_MATH_FN_TANH, mode, x, NULL, y,
+             NULL, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_erf_array_f32(const float *x, float *y, size_t count,
+                            wcn_math_mode_t mode) {
+  math_array(WCN_STATS_ERF_ARRAY_F32, WCN_MATH_FN_ERF, mode, x, NULL, y, NULL,
+             count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_atan2_array_f32(const float *y, const float *x, float *z,
+                              size_t count, wcn_math_mode_t mode) {
+  math_array(WCN_STATS_ATAN2_ARRAY_F32, WCN_MATH_FN_ATAN2, mode, y, x, z,
+             NULL, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_pow_array_f32(const float *x, const float *y, float *z,
+                            size_t count, wcn_math_mode_t mode) {
+  math_array(WCN_STATS_POW_ARRAY_F32, WCN_MATH_FN_POW, mode, x, y, z, NULL,
+             count);
+}
+
+/* ========== Softmax ========== */
+
+/* y and lse as in softmax_rows_f32; softmax reads x twice and writes y */
+static void softmax(wcn_stats_kernel_t stat, const float *x, float *y,
+                    float *lse, size_t rows, size_t cols) {
+  (void)stat; /* unused without WCN_SIMD_STATS */
+  WCN_STATS_CALL(stat, rows * cols, sizeof(float), y != NULL ? 3 : 1,
+                 (uintptr_t)x | (uintptr_t)y);
+  if (wcn_parallel_should_chunk(cols) ||
+      wcn_parallel_should_split(rows * cols)) {
+    WCN_STATS_ADD(stat, parallel_calls);
+    wcn_parallel_softmax(x, y, lse, rows, cols);
+    return;
+  }
+  wcn_simd_active_kernels()->softmax_rows_f32(x, y, lse, rows, cols);
+}
+
+WCN_API_EXPORT
+float wcn_simd_logsumexp_f32(const float *x, size_t count) {
+  float lse;
+  softmax(WCN_STATS_LOGSUMEXP_F32, x, NULL, &lse, 1, count);
+  return lse;
+}
+
+WCN_API_EXPORT
+void wcn_simd_softmax_f32(const float *x, float *y, size_t count) {
+  softmax(WCN_STATS_SOFTMAX_F32, x, y, NULL, 1, count);
+}
+
+WCN_API_EXPORT
+void wcn_simd_logsumexp_rows_f32(const float *x, float *out, size_t rows,
+                                 size_t cols) {
+  softmax(WCN_STATS_LOGSUMEXP_ROWS_F32, x, NULL, out, rows, cols);
+}
+
+WCN_API_EXPORT
+void wcn_simd_softmax_rows_f32(const float *x, float *y, size_t rows,
+                               size_t cols) {
+  softmax(WCN_STATS_SOFTMAX_ROWS_F32, x, y, NULL, rows, cols);
+}
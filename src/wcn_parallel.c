@@ -0,0 +1,571 @@
+/*
+ * WCN_SIMD multi-threaded execution of the array kernels (see
+ * wcn_parallel.h).
+ *
+ * A call is cut into chunks that run on the library pool
+ * (wcn_pool_default()) as one wcn_pool_parallel_for() job whose grain is
+ * the chunk size, so each chunk is one pool task and writes its own result
+ * slot. The pool runs the chunks on the caller's thread when max_threads is
+ * 1 or it is busy with another caller's job, which gives the same result.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "wcn_parallel.h"
+#include "wcn_thread.h"
+#include <math.h>
+
+/* Threads used per call, including the caller; 1 disables the pool */
+static unsigned g_max_threads = 1;
+static size_t g_threshold = WCN_PARALLEL_DEFAULT_THRESHOLD;
+
+/* ========== Configuration ========== */
+
+WCN_API_EXPORT
+void wcn_simd_set_max_threads(unsigned threads) {
+#if defined(WCN_SIMD_NO_THREADS)
+  (void)threads;
+#else
+  if (threads == 0) {
+    threads = wcn_hardware_threads();
+  }
+  if (threads > WCN_PARALLEL_MAX_THREADS) {
+    threads = WCN_PARALLEL_MAX_THREADS;
+  }
+  if (threads != g_max_threads) {
+    g_max_threads = threads;
+    wcn_pool_default_reset();
+  }
+#endif
+}
+
+WCN_API_EXPORT
+unsigned wcn_simd_get_max_threads(void) { return g_max_threads; }
+
+WCN_API_EXPORT
+void wcn_simd_set_parallel_threshold(size_t count) {
+  g_threshold = count > 0 ? count : 1;
+}
+
+int wcn_parallel_should_split(size_t count) {
+  return g_max_threads > 1 && count >= g_threshold;
+}
+
+int wcn_parallel_should_chunk(size_t count) { return count >= g_threshold; }
+
+/* ========== Chunked Kernels ========== */
+
+typedef struct {
+  const wcn_kernel_table_t *k;
+  int op;
+  const void *a;
+  const void *b;
+  void *c;
+  double scalar;
+  size_t count;
+  size_t chunk;
+  double *partial;
+  const wcn_expr_plan_t *plan;
+  const float *const *inputs;
+  wcn_math_mode_t mode;
+  void *d;
+  size_t cols;
+  double shift;
+} par_job_t;
+
+/* Chunk size is a function of count alone, which keeps reductions
+ * reproducible; multiples of 64 elements keep the chunks' alignment. */
+static size_t chunk_size(size_t count) {
+  size_t chunk =
+      (count + WCN_PARALLEL_MAX_CHUNKS - 1) / WCN_PARALLEL_MAX_CHUNKS;
+  chunk = (chunk + 63) & ~(size_t)63;
+  return chunk < WCN_PARALLEL_CHUNK ? WCN_PARALLEL_CHUNK : chunk;
+}
+
+static void job_init(par_job_t *job, int op, size_t count) {
+  job->k = wcn_simd_active_kernels();
+  job->op = op;
+  job->count = count;
+  job->chunk = chunk_size(count);
+}
+
+static size_t job_chunks(const par_job_t *job) {
+  return (job->count + job->chunk - 1) / job->chunk;
+}
+
+/* One pool task per chunk */
+static void run_chunks(par_job_t *job, wcn_pool_range_fn fn) {
+  wcn_pool_parallel_for(NULL, 0, job->count, job->chunk, fn, job);
+}
+
+static void reduce_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  const wcn_kernel_table_t *k = job->k;
+  const size_t n = end - begin;
+  const float *fa = (const float *)job->a;
+  const float *fb = (const float *)job->b;
+  const double *da = (const double *)job->a;
+  const double *db = (const double *)job->b;
+  const uint16_t *ha = (const uint16_t *)job->a;
+  const uint16_t *hb = (const uint16_t *)job->b;
+  double r = 0.0;
+
+  switch ((wcn_par_reduce_t)job->op) {
+  case WCN_PAR_DOT_F32:
+    r = k->dot_product_f32(fa + begin, fb + begin, n);
+    break;
+  case WCN_PAR_DOT_KAHAN_F32:
+    r = k->dot_product_kahan_f32(fa + begin, fb + begin, n);
+    break;
+  case WCN_PAR_DOT_PAIRWISE_F32:
+    r = k->dot_product_pairwise_f32(fa + begin, fb + begin, n);
+    break;
+  case WCN_PAR_SUM_F32:
+    r = k->reduce_sum_f32(fa + begin, n);
+    break;
+  case WCN_PAR_SUM_PAIRWISE_F32:
+    r = k->reduce_sum_pairwise_f32(fa + begin, n);
+    break;
+  case WCN_PAR_MAX_F32:
+    r = k->reduce_max_f32(fa + begin, n);
+    break;
+  case WCN_PAR_MIN_F32:
+    r = k->reduce_min_f32(fa + begin, n);
+    break;
+  case WCN_PAR_DOT_F64:
+    r = k->dot_product_f64(da + begin, db + begin, n);
+    break;
+  case WCN_PAR_SUM_F64:
+    r = k->reduce_sum_f64(da + begin, n);
+    break;
+  case WCN_PAR_MAX_F64:
+    r = k->reduce_max_f64(da + begin, n);
+    break;
+  case WCN_PAR_MIN_F64:
+    r = k->reduce_min_f64(da + begin, n);
+    break;
+  case WCN_PAR_DOT_F16:
+    r = k->dot_product_f16(ha + begin, hb + begin, n);
+    break;
+  case WCN_PAR_DOT_BF16:
+    r = k->dot_product_bf16(ha + begin, hb + begin, n);
+    break;
+  case WCN_PAR_SUM_F16:
+    r = k->reduce_sum_f16(ha + begin, n);
+    break;
+  case WCN_PAR_SUM_BF16:
+    r = k->reduce_sum_bf16(ha + begin, n);
+    break;
+  }
+  job->partial[begin / job->chunk] = r;
+}
+
+double wcn_parallel_reduce(wcn_par_reduce_t op, const void *a, const void *b,
+                           size_t count) {
+  double partial[WCN_PARALLEL_MAX_CHUNKS];
+  par_job_t job = {0};
+  job_init(&job, op, count);
+  job.a = a;
+  job.b = b;
+  job.partial = partial;
+  const size_t n_chunks = job_chunks(&job);
+  run_chunks(&job, reduce_chunk);
+
+  /* Combine in chunk order */
+  double r = partial[0];
+  switch (op) {
+  case WCN_PAR_MAX_F32:
+  case WCN_PAR_MAX_F64:
+    for (size_t i = 1; i < n_chunks; ++i) {
+      r = partial[i] > r ? partial[i] : r;
+    }
+    return r;
+  case WCN_PAR_MIN_F32:
+  case WCN_PAR_MIN_F64:
+    for (size_t i = 1; i < n_chunks; ++i) {
+      r = partial[i] < r ? partial[i] : r;
+    }
+    return r;
+  default:
+    /* Sums are accumulated in double, which is ample for at most
+     * WCN_PARALLEL_MAX_CHUNKS partials */
+    for (size_t i = 1; i < n_chunks; ++i) {
+      r += partial[i];
+    }
+    return r;
+  }
+}
+
+static void map_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  const wcn_kernel_table_t *k = job->k;
+  const size_t n = end - begin;
+  const float *fa = (const float *)job->a;
+  const float *fb = (const float *)job->b;
+  float *fc = (float *)job->c;
+  const double *da = (const double *)job->a;
+  const double *db = (const double *)job->b;
+  double *dc = (double *)job->c;
+  const uint16_t *ha = (const uint16_t *)job->a;
+  const uint16_t *hb = (const uint16_t *)job->b;
+  uint16_t *hc = (uint16_t *)job->c;
+
+  switch ((wcn_par_map_t)job->op) {
+  case WCN_PAR_ADD_F32:
+    k->add_array_f32(fa + begin, fb + begin, fc + begin, n);
+    break;
+  case WCN_PAR_MUL_F32:
+    k->mul_array_f32(fa + begin, fb + begin, fc + begin, n);
+    break;
+  case WCN_PAR_SCALE_F32:
+    k->scale_array_f32(fa + begin, (float)job->scalar, fc + begin, n);
+    break;
+  case WCN_PAR_FMADD_F32:
+    k->fmadd_array_f32(fa + begin, fb + begin, fc + begin, n);
+    break;
+  case WCN_PAR_ADD_F64:
+    k->add_array_f64(da + begin, db + begin, dc + begin, n);
+    break;
+  case WCN_PAR_MUL_F64:
+    k->mul_array_f64(da + begin, db + begin, dc + begin, n);
+    break;
+  case WCN_PAR_SCALE_F64:
+    k->scale_array_f64(da + begin, job->scalar, dc + begin, n);
+    break;
+  case WCN_PAR_FMADD_F64:
+    k->fmadd_array_f64(da + begin, db + begin, dc + begin, n);
+    break;
+  case WCN_PAR_FMADD_F16:
+    k->fmadd_array_f16(ha + begin, hb + begin, fc + begin, n);
+    break;
+  case WCN_PAR_FMADD_BF16:
+    k->fmadd_array_bf16(ha + begin, hb + begin, fc + begin, n);
+    break;
+  case WCN_PAR_F16_TO_F32:
+    k->f16_to_f32(ha + begin, fc + begin, n);
+    break;
+  case WCN_PAR_F32_TO_F16:
+    k->f32_to_f16(fa + begin, hc + begin, n);
+    break;
+  case WCN_PAR_BF16_TO_F32:
+    k->bf16_to_f32(ha + begin, fc + begin, n);
+    break;
+  case WCN_PAR_F32_TO_BF16:
+    k->f32_to_bf16(fa + begin, hc + begin, n);
+    break;
+  }
+}
+
+void wcn_parallel_map(wcn_par_map_t op, const void *a, const void *b, void *c,
+                      double scalar, size_t count) {
+  par_job_t job = {0};
+  job_init(&job, op, count);
+  job.a = a;
+  job.b = b;
+  job.c = c;
+  job.scalar = scalar;
+  run_chunks(&job, map_chunk);
+}
+
+static void expr_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  const size_t n = end - begin;
+  const float *inputs[WCN_EXPR_MAX_INPUTS] = {0};
+  for (size_t i = 0; i < WCN_EXPR_MAX_INPUTS; ++i) {
+    if (job->plan->input_mask & (1u << i)) {
+      inputs[i] = job->inputs[i] + begin;
+    }
+  }
+  job->k->expr_eval_f32(job->plan, inputs, (float *)job->c + begin, n);
+}
+
+void wcn_parallel_expr(const wcn_expr_plan_t *plan, const float *const *inputs,
+                       float *out, size_t count) {
+  par_job_t job = {0};
+  job_init(&job, 0, count);
+  job.plan = plan;
+  job.inputs = inputs;
+  job.c = out;
+  run_chunks(&job, expr_chunk);
+}
+
+static void math_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  const float *b = (const float *)job->b;
+  float *d = (float *)job->d;
+  job->k->math_f32((wcn_math_fn_t)job->op, job->mode,
+                   (const float *)job->a + begin, b ? b + begin : NULL,
+                   (float *)job->c + begin, d ? d + begin : NULL,
+                   end - begin);
+}
+
+void wcn_parallel_math(wcn_math_fn_t fn, wcn_math_mode_t mode, const float *a,
+                       const float *b, float *y, float *c, size_t count) {
+  par_job_t job = {0};
+  job_init(&job, fn, count);
+  job.mode = mode;
+  job.a = a;
+  job.b = b;
+  job.c = y;
+  job.d = c;
+  run_chunks(&job, math_chunk);
+}
+
+static void softmax_rows_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  float *y = (float *)job->c;
+  float *lse = (float *)job->d;
+  job->k->softmax_rows_f32((const float *)job->a + begin * job->cols,
+                           y ? y + begin * job->cols : NULL,
+                           lse ? lse + begin : NULL, end - begin, job->cols);
+}
+
+static void softmax_stats_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  const size_t i = begin / job->chunk;
+  float max;
+  job->k->softmax_stats_f32((const float *)job->a + begin, end - begin, &max,
+                            &job->partial[2 * i + 1]);
+  job->partial[2 * i] = max;
+}
+
+static void exp_scale_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  job->k->exp_scale_f32((const float *)job->a + begin, (float)job->shift,
+                        (float)job->scalar, (float *)job->c + begin,
+                        end - begin);
+}
+
+/* One row: per-chunk (max, sum) pairs merged in chunk order, then the
+ * normalization split the same way */
+static void softmax_row(const float *a, float *y, float *lse, size_t cols) {
+  double partial[2 * WCN_PARALLEL_MAX_CHUNKS];
+  par_job_t job = {0};
+  job_init(&job, 0, cols);
+  job.a = a;
+  job.partial = partial;
+  const size_t n_chunks = job_chunks(&job);
+  run_chunks(&job, softmax_stats_chunk);
+
+  double m = partial[0];
+  for (size_t i = 1; i < n_chunks; ++i) {
+    m = !(partial[2 * i] <= m) ? partial[2 * i] : m;
+  }
+  double s = 0.0;
+  for (size_t i = 0; i < n_chunks; ++i) {
+    /* Equal maxima include the all -inf case, where exp() would see NaN */
+    const double m_i = partial[2 * i];
+    s += partial[2 * i + 1] * (m_i == m ? 1.0 : exp(m_i - m));
+  }
+
+  if (lse != NULL) {
+    *lse = (float)(m + log(s));
+  }
+  if (y != NULL) {
+    job.shift = m;
+    job.scalar = 1.0 / s;
+    job.c = y;
+    run_chunks(&job, exp_scale_chunk);
+  }
+}
+
+void wcn_parallel_softmax(const float *a, float *y, float *lse, size_t rows,
+                          size_t cols) {
+  /* Rows long enough to chunk are always chunked, whatever the thread
+   * count, so that their results match */
+  if (wcn_parallel_should_chunk(cols)) {
+    for (size_t r = 0; r < rows; ++r) {
+      softmax_row(a + r * cols, y ? y + r * cols : NULL,
+                  lse ? lse + r : NULL, cols);
+    }
+    return;
+  }
+  par_job_t job = {0};
+  job_init(&job, 0, rows * cols);
+  job.a = a;
+  job.c = y;
+  job.d = lse;
+  job.cols = cols;
+  /* Whole rows per task, about a chunk's worth of elements */
+  const size_t grain = cols > 0 ? job.chunk / cols : rows;
+  wcn_pool_parallel_for(NULL, 0, rows, grain > 0 ? grain : 1,
+                        softmax_rows_chunk, &job);
+}
+
+static void gemv_u8i8_chunk(void *ctx, size_t begin, size_t end) {
+  par_job_t *job = (par_job_t *)ctx;
+  job->k->gemv_u8i8_i32((const int8_t *)job->a + begin * job->cols,
+                        (const uint8_t *)job->b, (int32_t *)job->c + begin,
+                        end - begin, job->cols);
+}
+
+void wcn_parallel_gemv_u8i8(const int8_t *w, const uint8_t *x, int32_t *y,
+                            size_t rows, size_t cols) {
+  par_job_t job = {0};
+  job_init(&job, 0, rows * cols);
+  job.a = w;
+  job.b = x;
+  job.c = y;
+  job.cols = cols;
+  /* About a chunk's worth of w per task, in multiples of the kernel's four
+   * row block */
+  size_t grain = cols > 0 ? job.chunk / cols : rows;
+  grain = grain >= 4 ? grain & ~(size_t)3 : 4;
+  wcn_pool_parallel_for(NULL, 0, rows, grain, gemv_u8i8_chunk, &job);
+}
+
+typedef struct {
+  const wcn_kernel_table_t *k;
+  const wcn_sgemm_args_t *args;
+  float *pack;
+  size_t pack_floats; /* per task */
+  size_t grain;
+  int by_rows;
+} sgemm_job_t;
+
+static void sgemm_chunk(void *ctx, size_t begin, size_t end) {
+  const sgemm_job_t *job = (const sgemm_job_t *)ctx;
+  wcn_sgemm_args_t sub = *job->args;
+  if (job->by_rows) {
+    sub.m = end - begin;
+    sub.a += sub.trans_a ? begin : begin * sub.lda;
+    sub.c += begin * sub.ldc;
+  } else {
+    sub.n = end - begin;
+    sub.b += sub.trans_b ? begin * sub.ldb : begin;
+    sub.c += begin;
+  }
+  job->k->sgemm_f32(&sub, job->pack + begin / job->grain * job->pack_floats);
+}
+
+int wcn_parallel_sgemm(const wcn_sgemm_args_t *args) {
+  sgemm_job_t job;
+  job.k = wcn_simd_active_kernels();
+  job.args = args;
+  /* One block of C per thread, in multiples of every micro-kernel's tile
+   * (rows of 4, 6, 8 or 12, columns of 4 to 32) */
+  job.by_rows = args->m >= args->n;
+  const size_t len = job.by_rows ? args->m : args->n;
+  const size_t align = job.by_rows ? 48 : 64;
+  job.grain = (len + g_max_threads - 1) / g_max_threads;
+  job.grain = (job.grain + align - 1) / align * align;
+  const size_t tasks = (len + job.grain - 1) / job.grain;
+
+  /* Blocks are packed per task, so scratch is allocated up front and a
+   * failure leaves C untouched */
+  job.pack_floats = job.by_rows
+                        ? job.k->sgemm_pack_floats(job.grain, args->n, args->k)
+                        : job.k->sgemm_pack_floats(args->m, job.grain, args->k);
+  job.pack_floats = (job.pack_floats + 15) & ~(size_t)15;
+  job.pack = (float *)wcn_aligned_alloc(tasks * job.pack_floats * sizeof(float),
+                                        64);
+  if (job.pack == NULL) {
+    return -1;
+  }
+  wcn_pool_parallel_for(NULL, 0, len, job.grain, sgemm_chunk, &job);
+  wcn_aligned_free(job.pack);
+  return 0;
+}
+
+typedef struct {
+  const wcn_kernel_table_t *k;
+  const void *src;
+  void *dst;
+  size_t rows;
+  size_t cols;
+  size_t elem_size;
+  int by_rows;
+  int stream;
+} transpose_job_t;
+
+static void transpose_chunk(void *ctx, size_t begin, size_t end) {
+  const transpose_job_t *job = (const transpose_job_t *)ctx;
+  /* Rows of src are columns of dst and the other way round */
+  size_t rows = job->rows, cols = job->cols, src_off, dst_off;
+  if (job->by_rows) {
+    rows = end - begin;
+    src_off = begin * job->cols;
+    dst_off = begin;
+  } else {
+    cols = end - begin;
+    src_off = begin;
+    dst_off = begin * job->rows;
+  }
+  switch (job->elem_size) {
+  case 4:
+    job->k->transpose_f32((const float *)job->src + src_off, job->cols,
+                          (float *)job->dst + dst_off, job->rows, rows, cols,
+                          job->stream);
+    break;
+  case 2:
+    job->k->transpose_u16((const uint16_t *)job->src + src_off, job->cols,
+                          (uint16_t *)job->dst + dst_off, job->rows, rows,
+                          cols, job->stream);
+    break;
+  default:
+    job->k->transpose_u8((const uint8_t *)job->src + src_off, job->cols,
+                         (uint8_t *)job->dst + dst_off, job->rows, rows, cols,
+                         job->stream);
+    break;
+  }
+}
+
+void wcn_parallel_transpose(size_t elem_size, const void *src, void *dst,
+                            size_t rows, size_t cols, int stream) {
+  transpose_job_t job;
+  job.k = wcn_simd_active_kernels();
+  job.src = src;
+  job.dst = dst;
+  job.rows = rows;
+  job.cols = cols;
+  job.elem_size = elem_size;
+  job.by_rows = rows >= cols;
+  job.stream = stream;
+  /* One band of the longer side per thread, in multiples of 64 so that
+   * every register tile and every streamed destination row stays aligned */
+  const size_t len = job.by_rows ? rows : cols;
+  size_t grain = (len + g_max_threads - 1) / g_max_threads;
+  grain = (grain + 63) & ~(size_t)63;
+  wcn_pool_parallel_for(NULL, 0, len, grain, transpose_chunk, &job);
+}
+
+typedef struct {
+  const wcn_kernel_table_t *k;
+  const void *x;
+  void *y;
+  const void *g;
+  size_t ntaps;
+  size_t elem_size;
+  unsigned shift;
+} fir_job_t;
+
+static void fir_chunk(void *ctx, size_t begin, size_t end) {
+  const fir_job_t *job = (const fir_job_t *)ctx;
+  if (job->elem_size == sizeof(float)) {
+    job->k->fir_f32((const float *)job->x + begin, (float *)job->y + begin,
+                    end - begin, (const float *)job->g, job->ntaps);
+  } else {
+    job->k->fir_i16((const int16_t *)job->x + begin,
+                    (int16_t *)job->y + begin, end - begin,
+                    (const int16_t *)job->g, job->ntaps, job->shift);
+  }
+}
+
+void wcn_parallel_fir(size_t elem_size, const void *x, void *y, size_t count,
+                      const void *g, size_t ntaps, unsigned shift) {
+  fir_job_t job;
+  job.k = wcn_simd_active_kernels();
+  job.x = x;
+  job.y = y;
+  job.g = g;
+  job.ntaps = ntaps;
+  job.elem_size = elem_size;
+  job.shift = shift;
+  /* Multiples of 64 outputs keep every block but the last on whole output
+   * tiles */
+  size_t grain = (count + g_max_threads - 1) / g_max_threads;
+  grain = (grain + 63) & ~(size_t)63;
+  wcn_pool_parallel_for(NULL, 0, count, grain, fir_chunk, &job);
+}
@@ -0,0 +1,127 @@
+#ifndef WCN_PARALLEL_H
+#define WCN_PARALLEL_H
+
+/*
+ * WCN_SIMD multi-threaded execution of the array kernels.
+ *
+ * Large calls are split into fixed chunks that each run the regular
+ * (dispatched) SIMD kernel on the library's work-stealing pool
+ * (wcn_pool_default(), see wcn_pool.c). The chunk boundaries depend only
+ * on the element count, and reductions combine the per-chunk partials
+ * serially in chunk order, so a result never depends on thread count or
+ * scheduling. Reductions take the chunked path from the parallel threshold
+ * up even when they run on the caller's thread alone (max_threads == 1,
+ * or builds without threads); other calls then skip it.
+ */
+
+#include "wcn_kernels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Elements per chunk; larger arrays use bigger chunks so that there are at
+ * most WCN_PARALLEL_MAX_CHUNKS of them */
+#define WCN_PARALLEL_CHUNK ((size_t)1 << 16)
+#define WCN_PARALLEL_MAX_CHUNKS 1024
+
+/* Default element count below which calls stay single-threaded */
+#define WCN_PARALLEL_DEFAULT_THRESHOLD ((size_t)1 << 18)
+
+/* Upper bound on pool size (including the calling thread) */
+#define WCN_PARALLEL_MAX_THREADS 64
+
+typedef enum {
+  WCN_PAR_DOT_F32,
+  WCN_PAR_DOT_KAHAN_F32,
+  WCN_PAR_DOT_PAIRWISE_F32,
+  WCN_PAR_SUM_F32,
+  WCN_PAR_SUM_PAIRWISE_F32,
+  WCN_PAR_MAX_F32,
+  WCN_PAR_MIN_F32,
+  WCN_PAR_DOT_F64,
+  WCN_PAR_SUM_F64,
+  WCN_PAR_MAX_F64,
+  WCN_PAR_MIN_F64,
+  WCN_PAR_DOT_F16,
+  WCN_PAR_DOT_BF16,
+  WCN_PAR_SUM_F16,
+  WCN_PAR_SUM_BF16
+} wcn_par_reduce_t;
+
+typedef enum {
+  WCN_PAR_ADD_F32,
+  WCN_PAR_MUL_F32,
+  WCN_PAR_SCALE_F32,
+  WCN_PAR_FMADD_F32,
+  WCN_PAR_ADD_F64,
+  WCN_PAR_MUL_F64,
+  WCN_PAR_SCALE_F64,
+  WCN_PAR_FMADD_F64,
+  WCN_PAR_FMADD_F16,
+  WCN_PAR_FMADD_BF16,
+  WCN_PAR_F16_TO_F32,
+  WCN_PAR_F32_TO_F16,
+  WCN_PAR_BF16_TO_F32,
+  WCN_PAR_F32_TO_BF16
+} wcn_par_map_t;
+
+/* Non-zero if a call over count elements should be split across threads */
+int wcn_parallel_should_split(size_t count);
+
+/* Non-zero if a reduction over count elements takes the chunked path. The
+ * thread count plays no part, so the result is the same on every host. */
+int wcn_parallel_should_chunk(size_t count);
+
+/* Chunked reduction of a (and b for dot products); the result is returned
+ * in double and narrowed by the caller */
+double wcn_parallel_reduce(wcn_par_reduce_t op, const void *a, const void *b,
+                           size_t count);
+
+/* Chunked element-wise kernel; scalar is used by the scale ops only */
+void wcn_parallel_map(wcn_par_map_t op, const void *a, const void *b, void *c,
+                      double scalar, size_t count);
+
+/* Chunked wcn_expr_eval() */
+void wcn_parallel_expr(const wcn_expr_plan_t *plan, const float *const *inputs,
+                       float *out, size_t count);
+
+/* Chunked math_f32 kernel */
+void wcn_parallel_math(wcn_math_fn_t fn, wcn_math_mode_t mode, const float *a,
+                       const float *b, float *y, float *c, size_t count);
+
+/* Chunked softmax_rows_f32: rows are spread across the pool, and when
+ * there are fewer rows than threads each row is split into chunks whose
+ * (max, sum) pairs are merged in chunk order */
+void wcn_parallel_softmax(const float *a, float *y, float *lse, size_t rows,
+                          size_t cols);
+
+/* Chunked gemv_u8i8_i32: whole rows of w per task */
+void wcn_parallel_gemv_u8i8(const int8_t *w, const uint8_t *x, int32_t *y,
+                            size_t rows, size_t cols);
+
+/* sgemm_f32 with C split into one block of rows (or of columns, when C is
+ * wider than tall) per thread. The k blocking does not depend on the
+ * split, so neither does the result. Returns -1, with C untouched, if the
+ * packing buffers could not be allocated. */
+int wcn_parallel_sgemm(const wcn_sgemm_args_t *args);
+
+/* transpose_f32 / _u16 / _u8 (by elem_size) of a contiguous rows x cols
+ * matrix, with the longer side split into one band per thread */
+void wcn_parallel_transpose(size_t elem_size, const void *src, void *dst,
+                            size_t rows, size_t cols, int stream);
+
+/* fir_f32 / fir_i16 (by elem_size) with the outputs split into one block
+ * per thread; each block reads its own ntaps - 1 samples of lookahead */
+void wcn_parallel_fir(size_t elem_size, const void *x, void *y, size_t count,
+                      const void *g, size_t ntaps, unsigned shift);
+
+/* Destroy the library pool so that the next wcn_pool_default() call
+ * recreates it with the current max_threads */
+void wcn_pool_default_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WCN_PARALLEL_H */
@@ -0,0 +1,593 @@
+/*
+ * WCN_SIMD work-stealing thread pool (see wcn_pool.h).
+ *
+ * Every participant -- the calling thread is participant 0, worker i is
+ * participant i -- owns a fixed-size Chase-Lev deque of index ranges. A job
+ * starts with one contiguous seed range per participant. A participant
+ * halves its range at grain boundaries, pushes the upper half onto the
+ * bottom of its own deque and keeps going with the lower half until one
+ * chunk is left, runs it, and then pops its own deque. Idle participants
+ * first claim seeds nobody has started and then steal from the top of a
+ * random victim's deque, where the largest pending ranges are. The job is
+ * over once the count of unrun elements drops to zero.
+ *
+ * Between jobs workers spin on the job generation for a while and then
+ * park on a condition variable: back-to-back jobs are picked up without a
+ * system call, and an idle pool uses no CPU.
+ *
+ * Job hand-over: the owning caller makes the generation odd, waits until
+ * no worker is still inside the previous job, writes the job and makes the
+ * generation even again. A worker registers in `active` before it re-reads
+ * the generation, so it either sees the new job complete or holds the
+ * caller off until it has left.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "wcn_parallel.h"
+#include "wcn_thread.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Ranges per deque (a power of two). Splitting in halves leaves at most
+ * log2(chunks) ranges in a deque; a full deque just runs more in place. */
+#define POOL_DEQUE_SIZE 128
+
+/* Pause iterations a worker waits for the next job before it parks */
+#define POOL_SPIN 4096
+
+#define POOL_CACHE_LINE 64
+
+/* ========== Synchronization Primitives ========== */
+
+/* Full fence for the deque's owner/thief race on the last range */
+#if defined(WCN_X86_SSE2) || defined(WCN_ARM_NEON) ||                         \
+    defined(WCN_LOONGARCH_LSX) || defined(WCN_RISCV_RVV) ||                   \
+    defined(WCN_POWERPC_ALTIVEC)
+#define POOL_FENCE() wcn_atomic_thread_fence(WCN_MEMORY_ORDER_SEQ_CST)
+#elif defined(WCN_HAS_GCC_ATOMIC)
+#define POOL_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#elif defined(_WIN32)
+#define POOL_FENCE() MemoryBarrier()
+#endif
+
+#if !defined(WCN_SIMD_NO_THREADS) && !defined(WCN_ATOMIC_HAS_SCALAR)
+#error "the thread pool needs the scalar atomics of wcn_atomic.h"
+#endif
+
+static inline void pool_pause(void) {
+#if defined(WCN_X86_SSE2)
+  _mm_pause();
+#elif defined(WCN_HAS_GCC_ATOMIC) &&                                          \
+    (defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+  __asm__ volatile("yield" ::: "memory");
+#endif
+}
+
+/* ========== Pool State ========== */
+
+typedef struct {
+  volatile int64_t begin;
+  volatile int64_t end;
+} pool_range_t;
+
+/* One participant. Thieves write top and the owner writes bottom, so each
+ * gets its own cache line. */
+typedef struct {
+  volatile int64_t top;
+  char pad0[POOL_CACHE_LINE - sizeof(int64_t)];
+  volatile int64_t bottom;
+  char pad1[POOL_CACHE_LINE - sizeof(int64_t)];
+  pool_range_t ranges[POOL_DEQUE_SIZE];
+  struct wcn_pool *pool;
+  unsigned id;
+  uint32_t rng;
+#if !defined(WCN_SIMD_NO_THREADS)
+  wcn_thread_t thread;
+#endif
+  char pad2[POOL_CACHE_LINE];
+} pool_slot_t;
+
+struct wcn_pool {
+  unsigned size; /* participants, including the caller */
+  unsigned flags;
+  pool_slot_t *slots; /* slots[0] belongs to the calling thread */
+  void *slot_mem;
+
+  /* Current job; written by its caller while the generation is odd */
+  wcn_pool_range_fn fn;
+  void *ctx;
+  size_t grain;
+  size_t seed[WCN_PARALLEL_MAX_THREADS + 1]; /* seed i: [seed[i], seed[i+1]) */
+  volatile int32_t claimed[WCN_PARALLEL_MAX_THREADS];
+
+  char pad0[POOL_CACHE_LINE];
+  volatile int64_t remaining; /* elements not yet run */
+  char pad1[POOL_CACHE_LINE - sizeof(int64_t)];
+  volatile int64_t generation; /* odd while a job is being set up */
+  volatile int32_t active;     /* workers inside the current job */
+  volatile int32_t sleepers;   /* workers parked on wake */
+  volatile int32_t shutdown;
+  char pad2[POOL_CACHE_LINE];
+
+#if !defined(WCN_SIMD_NO_THREADS)
+  wcn_mutex_t busy; /* held by the caller that owns the current job */
+  wcn_mutex_t lock; /* guards parking */
+  wcn_cond_t wake;
+#endif
+};
+
+static void run_serial(size_t begin, size_t end, size_t grain,
+                       wcn_pool_range_fn fn, void *ctx) {
+  while (begin < end) {
+    const size_t n = end - begin < grain ? end - begin : grain;
+    fn(ctx, begin, begin + n);
+    begin += n;
+  }
+}
+
+#if !defined(WCN_SIMD_NO_THREADS)
+
+/* ========== Range Deque ========== */
+
+/* Owner only */
+static int deque_push(pool_slot_t *s, size_t begin, size_t end) {
+  const int64_t b = wcn_atomic_load_i64(&s->bottom, WCN_MEMORY_ORDER_RELAXED);
+  const int64_t t = wcn_atomic_load_i64(&s->top, WCN_MEMORY_ORDER_ACQUIRE);
+  if (b - t >= POOL_DEQUE_SIZE) {
+    return 0;
+  }
+  pool_range_t *r = &s->ranges[b & (POOL_DEQUE_SIZE - 1)];
+  wcn_atomic_store_i64(&r->begin, (int64_t)begin, WCN_MEMORY_ORDER_RELAXED);
+  wcn_atomic_store_i64(&r->end, (int64_t)end, WCN_MEMORY_ORDER_RELAXED);
+  wcn_atomic_store_i64(&s->bottom, b + 1, WCN_MEMORY_ORDER_RELEASE);
+  return 1;
+}
+
+/* Owner only: take the most recently pushed (smallest) range */
+static int deque_pop(pool_slot_t *s, size_t *begin, size_t *end) {
+  const int64_t b =
+      wcn_atomic_load_i64(&s->bottom, WCN_MEMORY_ORDER_RELAXED) - 1;
+  wcn_atomic_store_i64(&s->bottom, b, WCN_MEMORY_ORDER_RELAXED);
+  POOL_FENCE();
+  int64_t t = wcn_atomic_load_i64(&s->top, WCN_MEMORY_ORDER_RELAXED);
+  if (t > b) {
+    wcn_atomic_store_i64(&s->bottom, b + 1, WCN_MEMORY_ORDER_RELAXED);
+    return 0;
+  }
+
+  const pool_range_t *r = &s->ranges[b & (POOL_DEQUE_SIZE - 1)];
+  *begin = (size_t)wcn_atomic_load_i64(&r->begin, WCN_MEMORY_ORDER_RELAXED);
+  *end = (size_t)wcn_atomic_load_i64(&r->end, WCN_MEMORY_ORDER_RELAXED);
+  if (t < b) {
+    return 1;
+  }
+
+  /* Last range: race the thieves for it */
+  const int won = wcn_atomic_compare_exchange_i64(
+      &s->top, &t, t + 1, WCN_MEMORY_ORDER_SEQ_CST, WCN_MEMORY_ORDER_RELAXED);
+  wcn_atomic_store_i64(&s->bottom, b + 1, WCN_MEMORY_ORDER_RELAXED);
+  return won;
+}
+
+/* Any thread: take the oldest (largest) range */
+static int deque_steal(pool_slot_t *s, size_t *begin, size_t *end) {
+  int64_t t = wcn_atomic_load_i64(&s->top, WCN_MEMORY_ORDER_ACQUIRE);
+  POOL_FENCE();
+  const int64_t b = wcn_atomic_load_i64(&s->bottom, WCN_MEMORY_ORDER_ACQUIRE);
+  if (t >= b) {
+    return 0;
+  }
+
+  /* The slot cannot be reused before top moves past t, in which case the
+   * exchange fails and the values read here are dropped */
+  const pool_range_t *r = &s->ranges[t & (POOL_DEQUE_SIZE - 1)];
+  *begin = (size_t)wcn_atomic_load_i64(&r->begin, WCN_MEMORY_ORDER_RELAXED);
+  *end = (size_t)wcn_atomic_load_i64(&r->end, WCN_MEMORY_ORDER_RELAXED);
+  return wcn_atomic_compare_exchange_i64(&s->top, &t, t + 1,
+                                         WCN_MEMORY_ORDER_SEQ_CST,
+                                         WCN_MEMORY_ORDER_RELAXED);
+}
+
+/* ========== Job Execution ========== */
+
+static void pool_run(wcn_pool_t *pool, pool_slot_t *self, size_t begin,
+                     size_t end) {
+  const size_t grain = pool->grain;
+
+  /* Leave the upper halves for whoever is idle */
+  while (end - begin > grain) {
+    const size_t chunks = (end - begin - 1) / grain + 1;
+    const size_t mid = begin + chunks / 2 * grain;
+    if (!deque_push(self, mid, end)) {
+      break;
+    }
+    end = mid;
+  }
+
+  run_serial(begin, end, grain, pool->fn, pool->ctx);
+  wcn_atomic_fetch_add_i64(&pool->remaining, -(int64_t)(end - begin),
+                           WCN_MEMORY_ORDER_ACQ_REL);
+}
+
+static int pool_claim_seed(wcn_pool_t *pool, pool_slot_t *self,
+                           size_t *begin, size_t *end) {
+  const unsigned n = pool->size;
+  for (unsigned k = 0, i = self->id; k < n; ++k, i = i + 1 == n ? 0 : i + 1) {
+    if (wcn_atomic_load_i32(&pool->claimed[i], WCN_MEMORY_ORDER_RELAXED) ==
+            0 &&
+        wcn_atomic_exchange_i32(&pool->claimed[i], 1,
+                                WCN_MEMORY_ORDER_ACQ_REL) == 0 &&
+        pool->seed[i] < pool->seed[i + 1]) {
+      *begin = pool->seed[i];
+      *end = pool->seed[i + 1];
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int pool_steal(wcn_pool_t *pool, pool_slot_t *self, size_t *begin,
+                      size_t *end) {
+  const unsigned n = pool->size;
+  uint32_t x = self->rng;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  self->rng = x;
+
+  for (unsigned k = 0, v = x % n; k < n; ++k, v = v + 1 == n ? 0 : v + 1) {
+    if (v != self->id && deque_steal(&pool->slots[v], begin, end)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* Take part in the current job until all of it has run */
+static void pool_work(wcn_pool_t *pool, pool_slot_t *self) {
+  size_t begin, end;
+  for (;;) {
+    if (deque_pop(self, &begin, &end)) {
+      pool_run(pool, self, begin, end);
+      continue;
+    }
+    if (wcn_atomic_load_i64(&pool->remaining, WCN_MEMORY_ORDER_ACQUIRE) ==
+        0) {
+      return;
+    }
+    if (pool_claim_seed(pool, self, &begin, &end) ||
+        pool_steal(pool, self, &begin, &end)) {
+      pool_run(pool, self, begin, end);
+      continue;
+    }
+    pool_pause();
+  }
+}
+
+/* ========== Workers ========== */
+
+/* Wait for a generation other than seen; returns -1 on shutdown */
+static int64_t pool_wait(wcn_pool_t *pool, int64_t seen) {
+  int64_t gen;
+  for (unsigned spin = 0; spin < POOL_SPIN; ++spin) {
+    gen = wcn_atomic_load_i64(&pool->generation, WCN_MEMORY_ORDER_ACQUIRE);
+    if (gen != seen && !(gen & 1)) {
+      return gen;
+    }
+    if (wcn_atomic_load_i32(&pool->shutdown, WCN_MEMORY_ORDER_RELAXED)) {
+      return -1;
+    }
+    pool_pause();
+  }
+
+  /* Park. The caller publishes a job before it checks for sleepers, and a
+   * sleeper registers before it re-checks for a job, so one of the two
+   * always sees the other. */
+  wcn_mutex_lock(&pool->lock);
+  wcn_atomic_fetch_add_i32(&pool->sleepers, 1, WCN_MEMORY_ORDER_SEQ_CST);
+  for (;;) {
+    gen = wcn_atomic_load_i64(&pool->generation, WCN_MEMORY_ORDER_SEQ_CST);
+    if (wcn_atomic_load_i32(&pool->shutdown, WCN_MEMORY_ORDER_SEQ_CST)) {
+      gen = -1;
+      break;
+    }
+    if (gen != seen && !(gen & 1)) {
+      break;
+    }
+    wcn_cond_wait(&pool->wake, &pool->lock);
+  }
+  wcn_atomic_fetch_add_i32(&pool->sleepers, -1, WCN_MEMORY_ORDER_RELAXED);
+  wcn_mutex_unlock(&pool->lock);
+  return gen;
+}
+
+static void pool_worker(void *arg) {
+  pool_slot_t *self = (pool_slot_t *)arg;
+  wcn_pool_t *pool = self->pool;
+  int64_t seen = 0;
+
+  if (pool->flags & WCN_POOL_PIN_THREADS) {
+    wcn_thread_pin_self(self->id % wcn_hardware_threads());
+  }
+
+  for (;;) {
+    const int64_t gen = pool_wait(pool, seen);
+    if (gen < 0) {
+      return;
+    }
+    seen = gen;
+    wcn_atomic_fetch_add_i32(&pool->active, 1, WCN_MEMORY_ORDER_SEQ_CST);
+    if (wcn_atomic_load_i64(&pool->generation, WCN_MEMORY_ORDER_SEQ_CST) ==
+        gen) {
+      pool_work(pool, self);
+    }
+    wcn_atomic_fetch_add_i32(&pool->active, -1, WCN_MEMORY_ORDER_RELEASE);
+  }
+}
+
+/* Publish a job; the caller holds pool->busy */
+static void pool_start(wcn_pool_t *pool, size_t begin, size_t end,
+                       size_t grain, wcn_pool_range_fn fn, void *ctx) {
+  const int64_t gen =
+      wcn_atomic_load_i64(&pool->generation, WCN_MEMORY_ORDER_RELAXED);
+  wcn_atomic_store_i64(&pool->generation, gen + 1, WCN_MEMORY_ORDER_SEQ_CST);
+  while (wcn_atomic_load_i32(&pool->active, WCN_MEMORY_ORDER_SEQ_CST) != 0) {
+    pool_pause();
+  }
+
+  pool->fn = fn;
+  pool->ctx = ctx;
+  pool->grain = grain;
+
+  /* Spread whole chunks as evenly as possible over the participants */
+  const unsigned n = pool->size;
+  const size_t chunks = (end - begin - 1) / grain + 1;
+  const size_t q = chunks / n;
+  const size_t r = chunks % n;
+  for (unsigned i = 0; i <= n; ++i) {
+    const size_t c = q * i + (i < r ? i : r);
+    pool->seed[i] = c == chunks ? end : begin + c * grain;
+  }
+  for (unsigned i = 0; i < n; ++i) {
+    wcn_atomic_store_i32(&pool->claimed[i], 0, WCN_MEMORY_ORDER_RELAXED);
+  }
+  wcn_atomic_store_i64(&pool->remaining, (int64_t)(end - begin),
+                       WCN_MEMORY_ORDER_RELAXED);
+
+  wcn_atomic_store_i64(&pool->generation, gen + 2, WCN_MEMORY_ORDER_SEQ_CST);
+  if (wcn_atomic_load_i32(&pool->sleepers, WCN_MEMORY_ORDER_SEQ_CST) > 0) {
+    wcn_mutex_lock(&pool->lock);
+    wcn_cond_broadcast(&pool->wake);
+    wcn_mutex_unlock(&pool->lock);
+  }
+}
+
+#endif /* !WCN_SIMD_NO_THREADS */
+
+/* ========== Pool Management ========== */
+
+WCN_API_EXPORT
+wcn_pool_t *wcn_pool_create(unsigned threads, unsigned flags) {
+#if defined(WCN_SIMD_NO_THREADS)
+  threads = 1;
+#else
+  if (threads == 0) {
+    threads = wcn_hardware_threads();
+  }
+  if (threads > WCN_PARALLEL_MAX_THREADS) {
+    threads = WCN_PARALLEL_MAX_THREADS;
+  }
+#endif
+
+  wcn_pool_t *pool = (wcn_pool_t *)calloc(1, sizeof(wcn_pool_t));
+  if (!pool) {
+    return NULL;
+  }
+  pool->slot_mem = calloc((size_t)threads + 1, sizeof(pool_slot_t));
+  if (!pool->slot_mem) {
+    free(pool);
+    return NULL;
+  }
+  pool->slots = (pool_slot_t *)(((uintptr_t)pool->slot_mem +
+                                 POOL_CACHE_LINE - 1) &
+                                ~(uintptr_t)(POOL_CACHE_LINE - 1));
+  pool->flags = flags;
+  pool->size = 1;
+  for (unsigned i = 0; i < threads; ++i) {
+    pool->slots[i].pool = pool;
+    pool->slots[i].id = i;
+    pool->slots[i].rng = 0x9E3779B9u * (i + 1);
+  }
+
+#if !defined(WCN_SIMD_NO_THREADS)
+  wcn_mutex_init(&pool->busy);
+  wcn_mutex_init(&pool->lock);
+  wcn_cond_init(&pool->wake);
+
+  /* A pool that could not start every worker runs with the ones it has */
+  for (unsigned i = 1; i < threads; ++i) {
+    if (wcn_thread_create(&pool->slots[i].thread, pool_worker,
+                          &pool->slots[i]) != 0) {
+      break;
+    }
+    pool->size = i + 1;
+  }
+#endif
+  return pool;
+}
+
+WCN_API_EXPORT
+void wcn_pool_destroy(wcn_pool_t *pool) {
+  if (!pool) {
+    return;
+  }
+#if !defined(WCN_SIMD_NO_THREADS)
+  wcn_atomic_store_i32(&pool->shutdown, 1, WCN_MEMORY_ORDER_SEQ_CST);
+  wcn_mutex_lock(&pool->lock);
+  wcn_cond_broadcast(&pool->wake);
+  wcn_mutex_unlock(&pool->lock);
+  for (unsigned i = 1; i < pool->size; ++i) {
+    wcn_thread_join(pool->slots[i].thread);
+  }
+  wcn_cond_destroy(&pool->wake);
+  wcn_mutex_destroy(&pool->lock);
+  wcn_mutex_destroy(&pool->busy);
+#endif
+  free(pool->slot_mem);
+  free(pool);
+}
+
+WCN_API_EXPORT
+unsigned wcn_pool_size(const wcn_pool_t *pool) {
+  return pool ? pool->size : 1;
+}
+
+/* ========== Library Pool ========== */
+
+#if !defined(WCN_SIMD_NO_THREADS)
+
+static wcn_mutex_t g_default_lock = WCN_MUTEX_INIT;
+static wcn_pool_t *g_default_pool;
+static int g_default_atexit;
+
+static void default_pool_atexit(void) { wcn_pool_default_reset(); }
+
+#endif
+
+WCN_API_EXPORT
+wcn_pool_t *wcn_pool_default(void) {
+#if defined(WCN_SIMD_NO_THREADS)
+  return NULL;
+#else
+  const unsigned threads = wcn_simd_get_max_threads();
+  if (threads <= 1) {
+    return NULL;
+  }
+  wcn_mutex_lock(&g_default_lock);
+  if (!g_default_pool) {
+    g_default_pool = wcn_pool_create(threads, 0);
+    if (!g_default_atexit) {
+      g_default_atexit = 1;
+      atexit(default_pool_atexit);
+    }
+  }
+  wcn_pool_t *pool = g_default_pool;
+  wcn_mutex_unlock(&g_default_lock);
+  return pool;
+#endif
+}
+
+void wcn_pool_default_reset(void) {
+#if !defined(WCN_SIMD_NO_THREADS)
+  wcn_mutex_lock(&g_default_lock);
+  wcn_pool_destroy(g_default_pool);
+  g_default_pool = NULL;
+  wcn_mutex_unlock(&g_default_lock);
+#endif
+}
+
+/* ========== Parallel Loops ========== */
+
+WCN_API_EXPORT
+void wcn_pool_parallel_for(wcn_pool_t *pool, size_t begin, size_t end,
+                           size_t grain, wcn_pool_range_fn fn, void *ctx) {
+  if (end <= begin) {
+    return;
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+  if (!pool) {
+    pool = wcn_pool_default();
+  }
+
+#if !defined(WCN_SIMD_NO_THREADS)
+  if (pool && pool->size > 1 && end - begin > grain &&
+      wcn_mutex_trylock(&pool->busy) == 0) {
+    pool_start(pool, begin, end, grain, fn, ctx);
+    pool_work(pool, &pool->slots[0]);
+    wcn_mutex_unlock(&pool->busy);
+    return;
+  }
+#endif
+
+  run_serial(begin, end, grain, fn, ctx);
+}
+
+typedef struct {
+  wcn_pool_reduce_fn map;
+  void *ctx;
+  size_t begin;
+  size_t grain;
+  size_t partial_size;
+  unsigned char *partials;
+} pool_reduce_t;
+
+static void reduce_chunk(void *arg, size_t begin, size_t end) {
+  const pool_reduce_t *r = (const pool_reduce_t *)arg;
+  const size_t k = (begin - r->begin) / r->grain;
+  r->map(r->ctx, begin, end, r->partials + k * r->partial_size);
+}
+
+WCN_API_EXPORT
+int wcn_pool_parallel_reduce(wcn_pool_t *pool, size_t begin, size_t end,
+                             size_t grain, size_t partial_size,
+                             wcn_pool_reduce_fn map,
+                             wcn_pool_combine_fn combine, void *ctx,
+                             void *result) {
+  if (end <= begin) {
+    return 0;
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+  if (!pool) {
+    pool = wcn_pool_default();
+  }
+
+  const size_t chunks = (end - begin - 1) / grain + 1;
+  unsigned char *partials = NULL;
+  if (wcn_pool_size(pool) > 1 && chunks > 1 && partial_size > 0 &&
+      chunks <= SIZE_MAX / partial_size) {
+    partials = (unsigned char *)malloc(chunks * partial_size);
+  }
+
+  if (partials) {
+    pool_reduce_t r = {map, ctx, begin, grain, partial_size, partials};
+    wcn_pool_parallel_for(pool, begin, end, grain, reduce_chunk, &r);
+    for (size_t k = 0; k < chunks; ++k) {
+      combine(ctx, result, partials + k * partial_size);
+    }
+    free(partials);
+    return 0;
+  }
+
+  /* Same chunks and order on this thread, one partial at a time */
+  union {
+    max_align_t align;
+    unsigned char bytes[256];
+  } local;
+  unsigned char *partial = partial_size <= sizeof(local)
+                               ? local.bytes
+                               : (unsigned char *)malloc(partial_size);
+  if (!partial) {
+    return -1;
+  }
+  while (begin < end) {
+    const size_t n = end - begin < grain ? end - begin : grain;
+    map(ctx, begin, begin + n, partial);
+    combine(ctx, result, partial);
+    begin += n;
+  }
+  if (partial != local.bytes) {
+    free(partial);
+  }
+  return 0;
+}
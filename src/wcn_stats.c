@@ -0,0 +1,210 @@
+/*
+ * WCN_SIMD kernel statistics (see wcn_stats.h).
+ *
+ * Each thread counts into its own block, so the hot path is an increment
+ * of thread-local memory with no atomics. A thread allocates its block on
+ * its first counted call and links it into a global list, under a mutex,
+ * where readers find it; blocks are never unlinked, so the counts of
+ * exited threads stay in the totals until the next reset.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_thread.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const g_kernel_names[WCN_STATS_KERNEL_COUNT] = {
+    "dot_product_f32",
+    "dot_product_kahan_f32",
+    "dot_product_pairwise_f32",
+    "add_array_f32",
+    "mul_array_f32",
+    "scale_array_f32",
+    "fmadd_array_f32",
+    "reduce_max_f32",
+    "reduce_min_f32",
+    "reduce_sum_f32",
+    "reduce_sum_pairwise_f32",
+    "dot_product_f64",
+    "add_array_f64",
+    "mul_array_f64",
+    "scale_array_f64",
+    "fmadd_array_f64",
+    "reduce_max_f64",
+    "reduce_min_f64",
+    "reduce_sum_f64",
+    "reduce_sum_i32",
+    "reduce_sum_i16",
+    "reduce_sum_u8",
+    "reduce_min_i8",
+    "reduce_max_i8",
+    "reduce_min_u8",
+    "reduce_max_u8",
+    "reduce_min_i16",
+    "reduce_max_i16",
+    "reduce_min_i32",
+    "reduce_max_i32",
+    "adds_array_i8",
+    "subs_array_i8",
+    "adds_array_u8",
+    "subs_array_u8",
+    "adds_array_i16",
+    "subs_array_i16",
+    "adds_array_u16",
+    "subs_array_u16",
+    "memcpy",
+    "memset",
+    "expr_eval",
+    "exp_array_f32",
+    "exp2_array_f32",
+    "log_array_f32",
+    "log2_array_f32",
+    "log1p_array_f32",
+    "sin_array_f32",
+    "cos_array_f32",
+    "sincos_array_f32",
+    "tan_array_f32",
+    "tanh_array_f32",
+    "erf_array_f32",
+    "atan2_array_f32",
+    "pow_array_f32",
+    "logsumexp_f32",
+    "softmax_f32",
+    "logsumexp_rows_f32",
+    "softmax_rows_f32",
+    "f16_to_f32",
+    "f32_to_f16",
+    "bf16_to_f32",
+    "f32_to_bf16",
+    "dot_product_f16",
+    "dot_product_bf16",
+    "fmadd_array_f16",
+    "fmadd_array_bf16",
+    "reduce_sum_f16",
+    "reduce_sum_bf16",
+    "dot_u8i8_i32",
+    "gemv_u8i8_i32",
+    "sgemm",
+    "transpose_f32",
+    "transpose_u16",
+    "transpose_u8",
+    "fir_f32",
+    "fir_i16",
+    "fft_c2c",
+    "fft_r2c",
+    "fft_c2r",
+};
+
+WCN_API_EXPORT
+const char *wcn_simd_stats_kernel_name(wcn_stats_kernel_t kernel) {
+  if ((unsigned)kernel >= WCN_STATS_KERNEL_COUNT) {
+    return NULL;
+  }
+  return g_kernel_names[kernel];
+}
+
+#if defined(WCN_SIMD_STATS)
+
+typedef struct stats_block {
+  wcn_simd_kernel_stats_t kernel[WCN_STATS_KERNEL_COUNT];
+  struct stats_block *next;
+} stats_block;
+
+WCN_THREAD_LOCAL wcn_simd_kernel_stats_t *wcn_stats_tls;
+
+static stats_block *g_blocks;
+
+/* Shared by threads whose block could not be allocated */
+static stats_block g_fallback;
+
+#if !defined(WCN_SIMD_NO_THREADS)
+static wcn_mutex_t g_lock = WCN_MUTEX_INIT;
+#define STATS_LOCK() wcn_mutex_lock(&g_lock)
+#define STATS_UNLOCK() wcn_mutex_unlock(&g_lock)
+#else
+#define STATS_LOCK() ((void)0)
+#define STATS_UNLOCK() ((void)0)
+#endif
+
+wcn_simd_kernel_stats_t *wcn_stats_attach(void) {
+  stats_block *b = (stats_block *)calloc(1, sizeof(*b));
+  if (b == NULL) {
+    wcn_stats_tls = g_fallback.kernel;
+    return wcn_stats_tls;
+  }
+  STATS_LOCK();
+  b->next = g_blocks;
+  g_blocks = b;
+  STATS_UNLOCK();
+  wcn_stats_tls = b->kernel;
+  return wcn_stats_tls;
+}
+
+void wcn_stats_call(wcn_stats_kernel_t k, size_t count, size_t elem_size,
+                    unsigned traffic, uintptr_t addr) {
+  wcn_simd_kernel_stats_t *s = wcn_stats_local(k);
+  const size_t vector_bytes = wcn_simd_active_kernels()->vector_bytes;
+  s->calls++;
+  s->elements += count;
+  s->bytes += (uint64_t)count * elem_size * traffic;
+  if ((addr & (vector_bytes - 1)) != 0) {
+    s->misaligned_calls++;
+  }
+  if (((count * elem_size) & (vector_bytes - 1)) != 0) {
+    s->tail_calls++;
+  }
+}
+
+static void stats_accumulate(wcn_simd_stats_t *out, const stats_block *b) {
+  for (int k = 0; k < WCN_STATS_KERNEL_COUNT; k++) {
+    wcn_simd_kernel_stats_t *d = &out->kernel[k];
+    const wcn_simd_kernel_stats_t *s = &b->kernel[k];
+    d->calls += s->calls;
+    d->elements += s->elements;
+    d->bytes += s->bytes;
+    d->misaligned_calls += s->misaligned_calls;
+    d->tail_calls += s->tail_calls;
+    d->parallel_calls += s->parallel_calls;
+    d->prologue_runs += s->prologue_runs;
+    d->stream_runs += s->stream_runs;
+  }
+}
+
+WCN_API_EXPORT
+void wcn_simd_get_stats(wcn_simd_stats_t *stats) {
+  memset(stats, 0, sizeof(*stats));
+  stats->enabled = 1;
+  STATS_LOCK();
+  for (const stats_block *b = g_blocks; b != NULL; b = b->next) {
+    stats_accumulate(stats, b);
+  }
+  STATS_UNLOCK();
+  stats_accumulate(stats, &g_fallback);
+}
+
+WCN_API_EXPORT
+void wcn_simd_reset_stats(void) {
+  STATS_LOCK();
+  for (stats_block *b = g_blocks; b != NULL; b = b->next) {
+    memset(b->kernel, 0, sizeof(b->kernel));
+  }
+  STATS_UNLOCK();
+  memset(g_fallback.kernel, 0, sizeof(g_fallback.kernel));
+}
+
+#else /* !WCN_SIMD_STATS */
+
+WCN_API_EXPORT
+void wcn_simd_get_stats(wcn_simd_stats_t *stats) {
+  memset(stats, 0, sizeof(*stats));
+}
+
+WCN_API_EXPORT
+void wcn_simd_reset_stats(void) {}
+
+#endif /* WCN_SIMD_STATS */
@@ -0,0 +1,217 @@
+#ifndef WCN_THREAD_H
+#define WCN_THREAD_H
+
+/*
+ * Minimal OS threading shim for the parallel kernels: threads, a mutex, a
+ * condition variable, one-time initialization and CPU pinning, with POSIX
+ * and Win32 implementations. Pinning needs _GNU_SOURCE on Linux and is a
+ * no-op elsewhere. Builds without threads (Emscripten, or
+ * WCN_SIMD_ENABLE_THREADS=OFF) define WCN_SIMD_NO_THREADS and never include
+ * the bodies below.
+ */
+
+#if !defined(WCN_SIMD_NO_THREADS)
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+typedef HANDLE wcn_thread_t;
+typedef SRWLOCK wcn_mutex_t;
+typedef CONDITION_VARIABLE wcn_cond_t;
+typedef INIT_ONCE wcn_once_t;
+
+#define WCN_MUTEX_INIT SRWLOCK_INIT
+#define WCN_COND_INIT CONDITION_VARIABLE_INIT
+#define WCN_ONCE_INIT INIT_ONCE_STATIC_INIT
+
+typedef struct {
+  void (*fn)(void *);
+  void *arg;
+} wcn_thread_start_t;
+
+static DWORD WINAPI wcn_thread_trampoline(LPVOID p) {
+  wcn_thread_start_t start = *(wcn_thread_start_t *)p;
+  HeapFree(GetProcessHeap(), 0, p);
+  start.fn(start.arg);
+  return 0;
+}
+
+static inline int wcn_thread_create(wcn_thread_t *t, void (*fn)(void *),
+                                    void *arg) {
+  wcn_thread_start_t *start = (wcn_thread_start_t *)HeapAlloc(
+      GetProcessHeap(), 0, sizeof(wcn_thread_start_t));
+  if (!start) {
+    return -1;
+  }
+  start->fn = fn;
+  start->arg = arg;
+  *t = CreateThread(NULL, 0, wcn_thread_trampoline, start, 0, NULL);
+  if (!*t) {
+    HeapFree(GetProcessHeap(), 0, start);
+    return -1;
+  }
+  return 0;
+}
+
+static inline void wcn_thread_join(wcn_thread_t t) {
+  WaitForSingleObject(t, INFINITE);
+  CloseHandle(t);
+}
+
+static inline void wcn_mutex_init(wcn_mutex_t *m) { InitializeSRWLock(m); }
+static inline void wcn_mutex_destroy(wcn_mutex_t *m) { (void)m; }
+static inline void wcn_mutex_lock(wcn_mutex_t *m) {
+  AcquireSRWLockExclusive(m);
+}
+static inline int wcn_mutex_trylock(wcn_mutex_t *m) {
+  return TryAcquireSRWLockExclusive(m) ? 0 : -1;
+}
+static inline void wcn_mutex_unlock(wcn_mutex_t *m) {
+  ReleaseSRWLockExclusive(m);
+}
+
+static inline void wcn_cond_init(wcn_cond_t *c) {
+  InitializeConditionVariable(c);
+}
+static inline void wcn_cond_destroy(wcn_cond_t *c) { (void)c; }
+static inline void wcn_cond_wait(wcn_cond_t *c, wcn_mutex_t *m) {
+  SleepConditionVariableSRW(c, m, INFINITE, 0);
+}
+static inline void wcn_cond_signal(wcn_cond_t *c) { WakeConditionVariable(c); }
+static inline void wcn_cond_broadcast(wcn_cond_t *c) {
+  WakeAllConditionVariable(c);
+}
+
+static BOOL CALLBACK wcn_once_trampoline(PINIT_ONCE once, PVOID fn,
+                                        PVOID *ctx) {
+  (void)once;
+  (void)ctx;
+  (*(void (**)(void))fn)();
+  return TRUE;
+}
+
+/* Run fn exactly once per o; every caller returns after it has finished */
+static inline void wcn_once(wcn_once_t *o, void (*fn)(void)) {
+  InitOnceExecuteOnce(o, wcn_once_trampoline, (PVOID)&fn, NULL);
+}
+
+static inline unsigned wcn_hardware_threads(void) {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors ? (unsigned)info.dwNumberOfProcessors : 1;
+}
+
+/* Bind the calling thread to one logical CPU; returns 0 on success */
+static inline int wcn_thread_pin_self(unsigned cpu) {
+  if (cpu >= sizeof(DWORD_PTR) * 8) {
+    return -1;
+  }
+  return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) ? 0
+                                                                        : -1;
+}
+
+#else /* POSIX */
+#include <pthread.h>
+#include <stdlib.h>
+#if defined(__linux__) && defined(_GNU_SOURCE)
+#include <sched.h>
+#endif
+#include <unistd.h>
+
+typedef pthread_t wcn_thread_t;
+typedef pthread_mutex_t wcn_mutex_t;
+typedef pthread_cond_t wcn_cond_t;
+typedef pthread_once_t wcn_once_t;
+
+#define WCN_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define WCN_COND_INIT PTHREAD_COND_INITIALIZER
+#define WCN_ONCE_INIT PTHREAD_ONCE_INIT
+
+typedef struct {
+  void (*fn)(void *);
+  void *arg;
+} wcn_thread_start_t;
+
+static void *wcn_thread_trampoline(void *p) {
+  wcn_thread_start_t start = *(wcn_thread_start_t *)p;
+  free(p);
+  start.fn(start.arg);
+  return NULL;
+}
+
+static inline int wcn_thread_create(wcn_thread_t *t, void (*fn)(void *),
+                                    void *arg) {
+  wcn_thread_start_t *start =
+      (wcn_thread_start_t *)malloc(sizeof(wcn_thread_start_t));
+  if (!start) {
+    return -1;
+  }
+  start->fn = fn;
+  start->arg = arg;
+  if (pthread_create(t, NULL, wcn_thread_trampoline, start) != 0) {
+    free(start);
+    return -1;
+  }
+  return 0;
+}
+
+static inline void wcn_thread_join(wcn_thread_t t) { pthread_join(t, NULL); }
+
+static inline void wcn_mutex_init(wcn_mutex_t *m) {
+  pthread_mutex_init(m, NULL);
+}
+static inline void wcn_mutex_destroy(wcn_mutex_t *m) {
+  pthread_mutex_destroy(m);
+}
+static inline void wcn_mutex_lock(wcn_mutex_t *m) { pthread_mutex_lock(m); }
+static inline int wcn_mutex_trylock(wcn_mutex_t *m) {
+  return pthread_mutex_trylock(m) == 0 ? 0 : -1;
+}
+static inline void wcn_mutex_unlock(wcn_mutex_t *m) {
+  pthread_mutex_unlock(m);
+}
+
+static inline void wcn_cond_init(wcn_cond_t *c) { pthread_cond_init(c, NULL); }
+static inline void wcn_cond_destroy(wcn_cond_t *c) { pthread_cond_destroy(c); }
+static inline void wcn_cond_wait(wcn_cond_t *c, wcn_mutex_t *m) {
+  pthread_cond_wait(c, m);
+}
+static inline void wcn_cond_signal(wcn_cond_t *c) { pthread_cond_signal(c); }
+static inline void wcn_cond_broadcast(wcn_cond_t *c) {
+  pthread_cond_broadcast(c);
+}
+
+/* Run fn exactly once per o; every caller returns after it has finished */
+static inline void wcn_once(wcn_once_t *o, void (*fn)(void)) {
+  pthread_once(o, fn);
+}
+
+static inline unsigned wcn_hardware_threads(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned)n : 1;
+}
+
+/* Bind the calling thread to one logical CPU; returns 0 on success */
+static inline int wcn_thread_pin_self(unsigned cpu) {
+#if defined(__linux__) && defined(_GNU_SOURCE)
+  cpu_set_t set;
+  if (cpu >= CPU_SETSIZE) {
+    return -1;
+  }
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? 0
+                                                                         : -1;
+#else
+  (void)cpu;
+  return -1;
+#endif
+}
+#endif
+
+#endif /* !WCN_SIMD_NO_THREADS */
+
+#endif /* WCN_THREAD_H */
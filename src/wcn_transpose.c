@@ -0,0 +1,60 @@
+/*
+ * WCN_SIMD matrix transpose: entry points (see wcn_transpose.h).
+ *
+ * The register tiles and the recursive blocking live in
+ * wcn_kernels_transpose_impl.h. These decide on non-temporal stores from
+ * the size of the output, as wcn_simd_memcpy_aligned() does, and hand large
+ * matrices to wcn_parallel_transpose(). Statistics count every element
+ * read once and written once.
+ */
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include "wcn_parallel.h"
+
+WCN_API_EXPORT
+void wcn_simd_transpose_f32(const float *src, float *dst, size_t rows,
+                            size_t cols) {
+  WCN_STATS_CALL(WCN_STATS_TRANSPOSE_F32, rows * cols, sizeof(float), 2,
+                 (uintptr_t)src | (uintptr_t)dst);
+  const int stream =
+      rows * cols * sizeof(float) >= wcn_tuning.stream_threshold;
+  if (wcn_parallel_should_split(rows * cols)) {
+    WCN_STATS_ADD(WCN_STATS_TRANSPOSE_F32, parallel_calls);
+    wcn_parallel_transpose(sizeof(float), src, dst, rows, cols, stream);
+    return;
+  }
+  wcn_simd_active_kernels()->transpose_f32(src, cols, dst, rows, rows, cols,
+                                           stream);
+}
+
+WCN_API_EXPORT
+void wcn_simd_transpose_u16(const uint16_t *src, uint16_t *dst, size_t rows,
+                            size_t cols) {
+  WCN_STATS_CALL(WCN_STATS_TRANSPOSE_U16, rows * cols, sizeof(uint16_t), 2,
+                 (uintptr_t)src | (uintptr_t)dst);
+  const int stream =
+      rows * cols * sizeof(uint16_t) >= wcn_tuning.stream_threshold;
+  if (wcn_parallel_should_split(rows * cols)) {
+    WCN_STATS_ADD(WCN_STATS_TRANSPOSE_U16, parallel_calls);
+    wcn_parallel_transpose(sizeof(uint16_t), src, dst, rows, cols, stream);
+    return;
+  }
+  wcn_simd_active_kernels()->transpose_u16(src, cols, dst, rows, rows, cols,
+                                           stream);
+}
+
+WCN_API_EXPORT
+void wcn_simd_transpose_u8(const uint8_t *src, uint8_t *dst, size_t rows,
+                           size_t cols) {
+  WCN_STATS_CALL(WCN_STATS_TRANSPOSE_U8, rows * cols, sizeof(uint8_t), 2,
+                 (uintptr_t)src | (uintptr_t)dst);
+  const int stream = rows * cols >= wcn_tuning.stream_threshold;
+  if (wcn_parallel_should_split(rows * cols)) {
+    WCN_STATS_ADD(WCN_STATS_TRANSPOSE_U8, parallel_calls);
+    wcn_parallel_transpose(sizeof(uint8_t), src, dst, rows, cols, stream);
+    return;
+  }
+  wcn_simd_active_kernels()->transpose_u8(src, cols, dst, rows, rows, cols,
+                                          stream);
+}
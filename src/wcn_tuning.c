@@ -0,0 +1,273 @@
+/*
+ * WCN_SIMD cache-dependent kernel tuning (see wcn_simd_tuning_t).
+ *
+ * wcn_simd_init() derives the parameters from the cache topology it
+ * detected; wcn_simd_calibrate() replaces them with measured ones:
+ *
+ *   prefetch_distance  mul_array_f32 over arrays well past the L2 with
+ *                      every candidate distance; the fastest wins, a
+ *                      shorter one on ties.
+ *   stream_threshold   add_array_f32 with and without non-temporal stores
+ *                      over doubling output sizes; the smallest size from
+ *                      which streaming wins at every larger size becomes
+ *                      the threshold. If it never wins, the derived value
+ *                      stays: a single kernel timing cannot see the benefit
+ *                      of not evicting the caller's other data.
+ *
+ * The SGEMM cache budgets are only derived: the blocking follows from the
+ * cache sizes and measuring it would take far longer than the rest.
+ *
+ * The calibration calls the selected kernel table directly, on the calling
+ * thread, so neither the thread pool nor the statistics are involved.
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "WCN_SIMD.h"
+#include "wcn_kernels.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Used while the topology is unknown: above the per-core share of a
+ * typical last-level cache, and eight 64-byte lines */
+#define TUNING_DEFAULT_STREAM ((size_t)4 << 20)
+#define TUNING_DEFAULT_LINE 64
+#define TUNING_PREFETCH_LINES 8
+/* GEMM budgets for a 32K L1d, 256K L2 and 2M last-level share */
+#define TUNING_DEFAULT_GEMM_L1 ((size_t)16 << 10)
+#define TUNING_DEFAULT_GEMM_L2 ((size_t)128 << 10)
+#define TUNING_DEFAULT_GEMM_L3 ((size_t)1 << 20)
+
+wcn_simd_tuning_t wcn_tuning = {
+    TUNING_DEFAULT_STREAM,
+    TUNING_PREFETCH_LINES * TUNING_DEFAULT_LINE,
+    TUNING_DEFAULT_GEMM_L1,
+    TUNING_DEFAULT_GEMM_L2,
+    TUNING_DEFAULT_GEMM_L3,
+};
+
+void wcn_tuning_init(const wcn_simd_features_t *f) {
+  const size_t line =
+      f->cache_line_size > 0 ? (size_t)f->cache_line_size : TUNING_DEFAULT_LINE;
+  wcn_tuning.prefetch_distance = TUNING_PREFETCH_LINES * line;
+  wcn_tuning.gemm_l1_bytes = f->l1d_cache_size > 0 ? f->l1d_cache_size / 2
+                                                   : TUNING_DEFAULT_GEMM_L1;
+  wcn_tuning.gemm_l2_bytes = f->l2_cache_size > 0 ? f->l2_cache_size / 2
+                                                  : TUNING_DEFAULT_GEMM_L2;
+
+  /* One core's share of the last-level cache; SMT siblings share it
+   * with each other as well, so count cores rather than logical CPUs */
+  const int smt = f->cpu_cores > 0 && f->cpu_threads >= f->cpu_cores
+                      ? f->cpu_threads / f->cpu_cores
+                      : 1;
+  size_t llc = f->l3_cache_size;
+  int shared = f->l3_shared_cpus;
+  if (llc == 0) {
+    llc = f->l2_cache_size;
+    shared = f->l2_shared_cpus;
+  }
+  if (llc == 0) {
+    wcn_tuning.stream_threshold = TUNING_DEFAULT_STREAM;
+    wcn_tuning.gemm_l3_bytes = TUNING_DEFAULT_GEMM_L3;
+    return;
+  }
+  const int cores = shared > smt ? shared / smt : 1;
+  size_t threshold = llc / (size_t)cores;
+  if (threshold < f->l2_cache_size) {
+    threshold = f->l2_cache_size;
+  }
+  wcn_tuning.stream_threshold = threshold;
+  /* The B panel is shared by every block of A, but not across cores */
+  wcn_tuning.gemm_l3_bytes = llc / (size_t)cores / 2;
+  if (wcn_tuning.gemm_l3_bytes < wcn_tuning.gemm_l2_bytes) {
+    wcn_tuning.gemm_l3_bytes = wcn_tuning.gemm_l2_bytes;
+  }
+}
+
+WCN_API_EXPORT
+void wcn_simd_get_tuning(wcn_simd_tuning_t *tuning) {
+  wcn_simd_init();
+  *tuning = wcn_tuning;
+}
+
+WCN_API_EXPORT
+void wcn_simd_set_tuning(const wcn_simd_tuning_t *tuning) {
+  wcn_simd_init();
+  if (tuning->stream_threshold != 0) {
+    wcn_tuning.stream_threshold = tuning->stream_threshold;
+  }
+  if (tuning->prefetch_distance != 0) {
+    wcn_tuning.prefetch_distance = tuning->prefetch_distance;
+  }
+  if (tuning->gemm_l1_bytes != 0) {
+    wcn_tuning.gemm_l1_bytes = tuning->gemm_l1_bytes;
+  }
+  if (tuning->gemm_l2_bytes != 0) {
+    wcn_tuning.gemm_l2_bytes = tuning->gemm_l2_bytes;
+  }
+  if (tuning->gemm_l3_bytes != 0) {
+    wcn_tuning.gemm_l3_bytes = tuning->gemm_l3_bytes;
+  }
+}
+
+/* ========== Calibration ========== */
+
+/* Largest array the calibration uses; it allocates three */
+#define CALIB_MAX_BYTES ((size_t)64 << 20)
+/* Each sample runs the kernel over at least this many bytes */
+#define CALIB_SAMPLE_BYTES ((size_t)8 << 20)
+#define CALIB_SAMPLES 5
+/* Margin a candidate must win by to count as faster */
+#define CALIB_MARGIN 0.98
+
+static double now_ns(void) {
+#if defined(_WIN32)
+  static LARGE_INTEGER freq;
+  LARGE_INTEGER t;
+  if (freq.QuadPart == 0) {
+    QueryPerformanceFrequency(&freq);
+  }
+  QueryPerformanceCounter(&t);
+  return (double)t.QuadPart * 1e9 / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+typedef struct {
+  const wcn_kernel_table_t *k;
+  float *a, *b, *c;
+  size_t count;
+} calib_t;
+
+typedef void (*calib_fn)(const calib_t *);
+
+static void run_mul(const calib_t *t) {
+  t->k->mul_array_f32(t->a, t->b, t->c, t->count);
+}
+
+static void run_add(const calib_t *t) {
+  t->k->add_array_f32(t->a, t->b, t->c, t->count);
+}
+
+/* Fastest of CALIB_SAMPLES samples, in ns per call */
+static double time_min(calib_fn fn, const calib_t *t) {
+  const size_t bytes = t->count * sizeof(float);
+  const size_t iters = bytes >= CALIB_SAMPLE_BYTES
+                           ? 1
+                           : CALIB_SAMPLE_BYTES / bytes;
+  double best = 0.0;
+  fn(t);
+  for (int s = 0; s < CALIB_SAMPLES; s++) {
+    const double t0 = now_ns();
+    for (size_t it = 0; it < iters; it++) {
+      fn(t);
+    }
+    const double ns = (now_ns() - t0) / (double)iters;
+    if (s == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+static size_t calibrate_prefetch(calib_t *t, size_t line, size_t l2) {
+  static const unsigned lines[] = {0, 1, 2, 4, 8, 16, 32, 64};
+  size_t bytes = 4 * l2;
+  if (bytes < ((size_t)4 << 20)) {
+    bytes = (size_t)4 << 20;
+  }
+  if (bytes > CALIB_MAX_BYTES) {
+    bytes = CALIB_MAX_BYTES;
+  }
+  t->count = bytes / sizeof(float);
+
+  size_t best_distance = wcn_tuning.prefetch_distance;
+  double best = 0.0;
+  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    wcn_tuning.prefetch_distance = lines[i] * line;
+    const double ns = time_min(run_mul, t);
+    if (i == 0 || ns < best * CALIB_MARGIN) {
+      best = ns;
+      best_distance = lines[i] * line;
+    }
+  }
+  return best_distance;
+}
+
+static size_t calibrate_stream(calib_t *t, size_t l2, size_t fallback) {
+  size_t first_win = 0;
+  size_t bytes = l2 / 2;
+  if (bytes < ((size_t)256 << 10)) {
+    bytes = (size_t)256 << 10;
+  }
+  for (; bytes <= CALIB_MAX_BYTES; bytes *= 2) {
+    t->count = bytes / sizeof(float);
+    wcn_tuning.stream_threshold = SIZE_MAX;
+    const double cached = time_min(run_add, t);
+    wcn_tuning.stream_threshold = 0;
+    const double streamed = time_min(run_add, t);
+    if (streamed < cached * CALIB_MARGIN) {
+      if (first_win == 0) {
+        first_win = bytes;
+      }
+    } else {
+      first_win = 0;
+    }
+  }
+  return first_win != 0 ? first_win : fallback;
+}
+
+WCN_API_EXPORT
+int wcn_simd_calibrate(void) {
+  const wcn_simd_features_t *f = wcn_simd_get_features();
+  const size_t line = f->cache_line_size > 0 ? (size_t)f->cache_line_size
+                                             : TUNING_DEFAULT_LINE;
+  const size_t l2 =
+      f->l2_cache_size != 0 ? f->l2_cache_size : (size_t)1 << 20;
+  calib_t t;
+
+  t.k = wcn_simd_active_kernels();
+  t.a = (float *)wcn_aligned_alloc(CALIB_MAX_BYTES, 64);
+  t.b = (float *)wcn_aligned_alloc(CALIB_MAX_BYTES, 64);
+  t.c = (float *)wcn_aligned_alloc(CALIB_MAX_BYTES, 64);
+  if (t.a == NULL || t.b == NULL || t.c == NULL) {
+    wcn_aligned_free(t.a);
+    wcn_aligned_free(t.b);
+    wcn_aligned_free(t.c);
+    return -1;
+  }
+  for (size_t i = 0; i < CALIB_MAX_BYTES / sizeof(float); i++) {
+    t.a[i] = (float)(i & 255);
+    t.b[i] = 0.5f;
+  }
+  memset(t.c, 0, CALIB_MAX_BYTES);
+
+  const wcn_simd_tuning_t derived = wcn_tuning;
+  /* Prefetching is timed with cached stores, streaming with the new
+   * prefetch distance */
+  wcn_tuning.stream_threshold = SIZE_MAX;
+  const size_t distance = calibrate_prefetch(&t, line, l2);
+  wcn_tuning.prefetch_distance = distance;
+  const size_t threshold =
+      calibrate_stream(&t, l2, derived.stream_threshold);
+  wcn_tuning.stream_threshold = threshold;
+
+  wcn_aligned_free(t.a);
+  wcn_aligned_free(t.b);
+  wcn_aligned_free(t.c);
+  return 0;
+}